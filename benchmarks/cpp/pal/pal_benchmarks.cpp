@@ -0,0 +1,465 @@
+// Scaling benchmarks for the PAL physics backends. Every scenario runs on every selected backend for each body
+// count and worker thread count, and prints percentiles of the time per sample, which is one fixed step plus the
+// scenario's extra work (queries for raycast, body creation and destruction for churn).
+//
+//   pal_benchmarks [--backends simple,box2d] [--scenarios pyramid,pile,sleeping,raycast,churn]
+//                  [--bodies 1000,4000,16000] [--threads 1,2,4,8] [--samples 300] [--warmup 120] [--csv]
+//
+// Build in a release configuration; thread count 1 steps without a task scheduler.
+#include <pal/box2d/box2d_physics_world_factory.h>
+#include <pal/iphysics_world.h>
+#include <pal/simple/simple_physics_world_factory.h>
+#include <piece_core/core/job_system.h>
+#include <piece_core/core/job_system_task_scheduler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Piece::PAL;
+
+namespace
+{
+constexpr float kStep = 1.0f / 60.0f;
+// Most steps a scenario may take to settle before sampling, on top of --warmup.
+constexpr int kMaxSettleSteps = 1200;
+
+// The world and bodies of one benchmark run.
+struct BenchmarkContext
+{
+    IPhysicsWorld *world = nullptr;
+    uint32_t body_count = 0;
+    std::vector<std::unique_ptr<IPhysicsBody>> bodies;
+    std::vector<RayCastInput> rays;
+    std::vector<RayCastHit> hits;
+    std::mt19937 random{12345};
+    uint32_t sample = 0;
+};
+
+struct Scenario
+{
+    const char *name;
+    // Creates the bodies.
+    void (*build)(BenchmarkContext &context);
+    // Steps until the scene is ready to sample, if it needs more than the warmup steps.
+    void (*settle)(BenchmarkContext &context);
+    // The work measured per sample.
+    void (*run_sample)(BenchmarkContext &context);
+};
+
+RigidBodyCreationInfo MakeBody(BodyType type, const glm::vec3 &position, const glm::vec3 &half_extents)
+{
+    RigidBodyCreationInfo info;
+    info.body_type = type;
+    info.position = position;
+    info.half_extents = half_extents;
+    return info;
+}
+
+// A static floor with its top at y = 0 and walls at +-half_width. Bodies are laid out in the xy plane so that the
+// 2D and 3D backends simulate the same scene.
+void BuildContainer(BenchmarkContext &context, float half_width)
+{
+    context.bodies.push_back(context.world->CreatePhysicsBody(
+        MakeBody(BodyType::Static, glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(half_width + 1.0f, 0.5f, 1.0f))));
+    for (float side : {-1.0f, 1.0f})
+    {
+        context.bodies.push_back(context.world->CreatePhysicsBody(MakeBody(
+            BodyType::Static, glm::vec3(side * (half_width + 0.5f), 50.0f, 0.0f), glm::vec3(0.5f, 50.0f, 1.0f))));
+    }
+}
+
+// A dynamic box or sphere of size 1 at the given position, alternating by index.
+std::unique_ptr<IPhysicsBody> CreatePileBody(BenchmarkContext &context, uint32_t index, const glm::vec3 &position)
+{
+    RigidBodyCreationInfo info = MakeBody(BodyType::Dynamic, position, glm::vec3(0.5f));
+    if (index % 2 == 1)
+    {
+        info.shape = ColliderShapeType::Sphere;
+        info.radius = 0.5f;
+    }
+    return context.world->CreatePhysicsBody(info);
+}
+
+uint32_t PileColumns(uint32_t body_count)
+{
+    return std::max(8u, static_cast<uint32_t>(std::sqrt(static_cast<float>(body_count))));
+}
+
+glm::vec3 PilePosition(BenchmarkContext &context, uint32_t slot, uint32_t columns)
+{
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+    float x = (static_cast<float>(slot % columns) - 0.5f * static_cast<float>(columns - 1)) * 1.1f;
+    float y = 1.0f + static_cast<float>(slot / columns) * 1.1f;
+    return glm::vec3(x + jitter(context.random), y, 0.0f);
+}
+
+// Side-by-side pyramids of 20 rows, the classic solver stress test.
+void BuildPyramids(BenchmarkContext &context)
+{
+    constexpr uint32_t kRows = 20;
+    constexpr uint32_t kPerPyramid = kRows * (kRows + 1) / 2;
+    uint32_t pyramids = (context.body_count + kPerPyramid - 1) / kPerPyramid;
+    float pitch = static_cast<float>(kRows) + 4.0f;
+    float half_width = 0.5f * pitch * static_cast<float>(pyramids);
+    BuildContainer(context, half_width);
+    uint32_t created = 0;
+    for (uint32_t p = 0; p < pyramids; ++p)
+    {
+        float center = -half_width + pitch * (static_cast<float>(p) + 0.5f);
+        for (uint32_t row = 0; row < kRows; ++row)
+        {
+            uint32_t width = kRows - row;
+            for (uint32_t i = 0; i < width && created < context.body_count; ++i, ++created)
+            {
+                float x = center + static_cast<float>(i) - 0.5f * static_cast<float>(width - 1);
+                glm::vec3 position(x, 0.5f + static_cast<float>(row), 0.0f);
+                context.bodies.push_back(
+                    context.world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, position, glm::vec3(0.5f))));
+            }
+        }
+    }
+}
+
+// Boxes and spheres dropped into a container, where they form one large contact island.
+void BuildPile(BenchmarkContext &context)
+{
+    uint32_t columns = PileColumns(context.body_count);
+    BuildContainer(context, 0.55f * static_cast<float>(columns) + 1.0f);
+    for (uint32_t i = 0; i < context.body_count; ++i)
+    {
+        context.bodies.push_back(CreatePileBody(context, i, PilePosition(context, i, columns)));
+    }
+}
+
+// Single boxes resting apart on the floor, each its own island.
+void BuildSleeping(BenchmarkContext &context)
+{
+    float half_width = static_cast<float>(context.body_count) + 1.0f;
+    BuildContainer(context, half_width);
+    for (uint32_t i = 0; i < context.body_count; ++i)
+    {
+        glm::vec3 position(-half_width + 1.0f + 2.0f * static_cast<float>(i), 0.5f, 0.0f);
+        context.bodies.push_back(
+            context.world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, position, glm::vec3(0.5f))));
+    }
+}
+
+void SettleNothing(BenchmarkContext &)
+{
+}
+
+void SettleUntilAsleep(BenchmarkContext &context)
+{
+    for (int i = 0; i < kMaxSettleSteps && context.world->GetAwakeBodyCount() > 0; ++i)
+    {
+        context.world->Step(kStep);
+    }
+}
+
+// Builds a batch of body_count rays across the pile, half straight down and half at random angles.
+void SettleAndAimRays(BenchmarkContext &context)
+{
+    SettleUntilAsleep(context);
+    float half_width = 0.55f * static_cast<float>(PileColumns(context.body_count));
+    std::uniform_real_distribution<float> across(-half_width, half_width);
+    std::uniform_real_distribution<float> angle(-1.2f, 1.2f);
+    context.rays.resize(context.body_count);
+    context.hits.resize(context.body_count);
+    for (uint32_t i = 0; i < context.body_count; ++i)
+    {
+        RayCastInput &ray = context.rays[i];
+        ray.origin = glm::vec3(across(context.random), 2.0f * half_width + 10.0f, 0.0f);
+        float theta = i % 2 == 0 ? 0.0f : angle(context.random);
+        ray.direction = glm::vec3(std::sin(theta), -std::cos(theta), 0.0f);
+        ray.max_distance = 4.0f * half_width + 20.0f;
+    }
+}
+
+void StepOnce(BenchmarkContext &context)
+{
+    context.world->Step(kStep);
+}
+
+// Wakes one percent of the sleeping boxes per sample, the rest stay asleep.
+void KickAndStep(BenchmarkContext &context)
+{
+    uint32_t kicks = std::max(1u, context.body_count / 100);
+    for (uint32_t k = 0; k < kicks; ++k)
+    {
+        // Skip the three static container bodies at the front.
+        uint32_t index = 3 + (context.sample * kicks + k) % context.body_count;
+        context.bodies[index]->SetLinearVelocity(glm::vec3(0.0f, 3.0f, 0.0f));
+    }
+    context.world->Step(kStep);
+}
+
+// Queries only; the settled pile is not stepped.
+void CastRayBatch(BenchmarkContext &context)
+{
+    context.world->CastRays(context.rays.data(), static_cast<uint32_t>(context.rays.size()), context.hits.data());
+}
+
+// Replaces five percent of the pile per sample with new bodies dropped from above.
+void ChurnAndStep(BenchmarkContext &context)
+{
+    uint32_t columns = PileColumns(context.body_count);
+    uint32_t churn = std::max(1u, context.body_count / 20);
+    std::uniform_int_distribution<uint32_t> pick(3, static_cast<uint32_t>(context.bodies.size()) - 1);
+    uint32_t top_row = context.body_count / columns + 4;
+    for (uint32_t i = 0; i < churn; ++i)
+    {
+        uint32_t index = pick(context.random);
+        context.bodies[index].reset();
+        context.bodies[index] = CreatePileBody(context, index, PilePosition(context, top_row * columns + i, columns));
+    }
+    context.world->Step(kStep);
+}
+
+const Scenario kScenarios[] = {
+    {"pyramid", BuildPyramids, SettleNothing, StepOnce},
+    {"pile", BuildPile, SettleNothing, StepOnce},
+    {"sleeping", BuildSleeping, SettleUntilAsleep, KickAndStep},
+    {"raycast", BuildPile, SettleAndAimRays, CastRayBatch},
+    {"churn", BuildPile, SettleNothing, ChurnAndStep},
+};
+
+std::unique_ptr<Piece::Core::IPhysicsWorldFactory> CreateFactory(const std::string &backend)
+{
+    if (backend == "simple")
+    {
+        return std::unique_ptr<Piece::Core::IPhysicsWorldFactory>(CreateSimplePhysicsWorldFactory());
+    }
+    if (backend == "box2d")
+    {
+        return std::unique_ptr<Piece::Core::IPhysicsWorldFactory>(CreateBox2DPhysicsWorldFactory());
+    }
+    return nullptr;
+}
+
+struct Options
+{
+    std::vector<std::string> backends = {"simple", "box2d"};
+    std::vector<std::string> scenarios = {"pyramid", "pile", "sleeping", "raycast", "churn"};
+    std::vector<uint32_t> body_counts = {1000, 4000, 16000};
+    std::vector<uint32_t> thread_counts = {1, 2, 4, 8};
+    uint32_t samples = 300;
+    uint32_t warmup = 120;
+    bool csv = false;
+};
+
+std::vector<std::string> SplitList(const char *list)
+{
+    std::vector<std::string> items;
+    std::string item;
+    for (const char *c = list;; ++c)
+    {
+        if (*c == ',' || *c == '\0')
+        {
+            if (!item.empty())
+            {
+                items.push_back(item);
+            }
+            item.clear();
+            if (*c == '\0')
+            {
+                return items;
+            }
+        }
+        else
+        {
+            item += *c;
+        }
+    }
+}
+
+bool ParseCounts(const char *list, std::vector<uint32_t> &counts)
+{
+    counts.clear();
+    for (const std::string &item : SplitList(list))
+    {
+        char *end = nullptr;
+        unsigned long value = std::strtoul(item.c_str(), &end, 10);
+        if (*end != '\0' || value == 0)
+        {
+            return false;
+        }
+        counts.push_back(static_cast<uint32_t>(value));
+    }
+    return !counts.empty();
+}
+
+bool ParseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        std::vector<uint32_t> counts;
+        if (std::strcmp(arg, "--csv") == 0)
+        {
+            options.csv = true;
+            continue;
+        }
+        if (!value)
+        {
+            return false;
+        }
+        ++i;
+        if (std::strcmp(arg, "--backends") == 0)
+        {
+            options.backends = SplitList(value);
+        }
+        else if (std::strcmp(arg, "--scenarios") == 0)
+        {
+            options.scenarios = SplitList(value);
+        }
+        else if (std::strcmp(arg, "--bodies") == 0)
+        {
+            if (!ParseCounts(value, options.body_counts))
+            {
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--threads") == 0)
+        {
+            if (!ParseCounts(value, options.thread_counts))
+            {
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--samples") == 0 && ParseCounts(value, counts))
+        {
+            options.samples = counts[0];
+        }
+        else if (std::strcmp(arg, "--warmup") == 0)
+        {
+            options.warmup = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Nearest-rank percentile of sorted samples.
+double Percentile(const std::vector<double> &sorted, double percentile)
+{
+    size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+// Runs one scenario and returns the sample times in milliseconds, or nothing if the backend is unavailable.
+std::vector<double> RunBenchmark(const std::string &backend, const Scenario &scenario, uint32_t body_count,
+                                 uint32_t thread_count, const Options &options)
+{
+    std::unique_ptr<Piece::Core::IPhysicsWorldFactory> factory = CreateFactory(backend);
+    if (!factory)
+    {
+        return {};
+    }
+    // Declared before the world so they outlive it.
+    std::unique_ptr<Piece::Core::JobSystem> job_system;
+    std::unique_ptr<Piece::Core::JobSystemTaskScheduler> scheduler;
+    Piece::Core::NativePhysicsOptions physics_options = {kStep, 1, 4};
+    std::unique_ptr<IPhysicsWorld> world = factory->CreatePhysicsWorld(&physics_options);
+    if (!world)
+    {
+        return {};
+    }
+    if (thread_count > 1)
+    {
+        job_system = std::make_unique<Piece::Core::JobSystem>(thread_count - 1);
+        scheduler = std::make_unique<Piece::Core::JobSystemTaskScheduler>(*job_system);
+        world->SetTaskScheduler(scheduler.get());
+    }
+    world->Init();
+
+    BenchmarkContext context;
+    context.world = world.get();
+    context.body_count = body_count;
+    scenario.build(context);
+    for (uint32_t i = 0; i < options.warmup; ++i)
+    {
+        world->Step(kStep);
+    }
+    scenario.settle(context);
+
+    std::vector<double> times;
+    times.reserve(options.samples);
+    for (context.sample = 0; context.sample < options.samples; ++context.sample)
+    {
+        auto start = std::chrono::steady_clock::now();
+        scenario.run_sample(context);
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    context.bodies.clear();
+    return times;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "usage: %s [--backends simple,box2d] [--scenarios pyramid,pile,sleeping,raycast,churn]\n"
+                             "       [--bodies 1000,4000] [--threads 1,4] [--samples N] [--warmup N] [--csv]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    const char *format = options.csv ? "%s,%s,%u,%u,%.4f,%.4f,%.4f,%.4f,%.4f\n"
+                                     : "%-8s %-10s %8u %8u %10.4f %10.4f %10.4f %10.4f %10.4f\n";
+    std::printf(options.csv ? "%s,%s,%s,%s,%s,%s,%s,%s,%s\n" : "%-8s %-10s %8s %8s %10s %10s %10s %10s %10s\n",
+                "backend", "scenario", "bodies", "threads", "mean_ms", "p50_ms", "p90_ms", "p99_ms", "max_ms");
+    for (const std::string &scenario_name : options.scenarios)
+    {
+        const Scenario *scenario = nullptr;
+        for (const Scenario &candidate : kScenarios)
+        {
+            scenario = scenario_name == candidate.name ? &candidate : scenario;
+        }
+        if (!scenario)
+        {
+            std::fprintf(stderr, "Unknown scenario '%s'.\n", scenario_name.c_str());
+            return 1;
+        }
+        for (const std::string &backend : options.backends)
+        {
+            for (uint32_t body_count : options.body_counts)
+            {
+                for (uint32_t thread_count : options.thread_counts)
+                {
+                    std::vector<double> times = RunBenchmark(backend, *scenario, body_count, thread_count, options);
+                    if (times.empty())
+                    {
+                        std::fprintf(stderr, "Backend '%s' is not available.\n", backend.c_str());
+                        return 1;
+                    }
+                    double mean = 0.0;
+                    for (double time : times)
+                    {
+                        mean += time / static_cast<double>(times.size());
+                    }
+                    std::sort(times.begin(), times.end());
+                    std::printf(format, backend.c_str(), scenario->name, body_count, thread_count, mean,
+                                Percentile(times, 50.0), Percentile(times, 90.0), Percentile(times, 99.0),
+                                times.back());
+                    std::fflush(stdout);
+                }
+            }
+        }
+    }
+    return 0;
+}
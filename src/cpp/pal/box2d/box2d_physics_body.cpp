@@ -0,0 +1,75 @@
+#include "box2d_physics_body.h"
+
+#include <cmath>
+
+namespace Piece {
+    namespace PAL {
+        Box2DBody::Box2DBody(b2BodyId body_id) : body_id_(body_id) {}
+
+        Box2DBody::~Box2DBody() {
+            // The world may already be gone, which destroys its bodies with it.
+            if (b2Body_IsValid(body_id_)) {
+                b2DestroyBody(body_id_);
+            }
+        }
+
+        BodyId Box2DBody::GetId() const { return ToBodyId(body_id_); }
+
+        void Box2DBody::SetPosition(const glm::vec3 &position) {
+            b2Body_SetTransform(body_id_, b2Vec2{position.x, position.y}, b2Body_GetRotation(body_id_));
+        }
+
+        glm::vec3 Box2DBody::GetPosition() const {
+            b2Vec2 position = b2Body_GetPosition(body_id_);
+            return glm::vec3(position.x, position.y, 0.0f);
+        }
+
+        void Box2DBody::SetRotation(const glm::quat &rotation) {
+            b2Body_SetTransform(body_id_, b2Body_GetPosition(body_id_), b2MakeRot(GetRotationAngleZ(rotation)));
+        }
+
+        glm::quat Box2DBody::GetRotation() const {
+            return glm::angleAxis(b2Rot_GetAngle(b2Body_GetRotation(body_id_)), glm::vec3(0.0f, 0.0f, 1.0f));
+        }
+
+        void Box2DBody::ApplyForce(const glm::vec3 &force) {
+            b2Body_ApplyForceToCenter(body_id_, b2Vec2{force.x, force.y}, true);
+        }
+
+        void Box2DBody::ApplyImpulse(const glm::vec3 &impulse) {
+            b2Body_ApplyLinearImpulseToCenter(body_id_, b2Vec2{impulse.x, impulse.y}, true);
+        }
+
+        void Box2DBody::SetLinearVelocity(const glm::vec3 &velocity) {
+            b2Body_SetLinearVelocity(body_id_, b2Vec2{velocity.x, velocity.y});
+        }
+
+        glm::vec3 Box2DBody::GetLinearVelocity() const {
+            b2Vec2 velocity = b2Body_GetLinearVelocity(body_id_);
+            return glm::vec3(velocity.x, velocity.y, 0.0f);
+        }
+
+        void Box2DBody::SetAngularVelocity(const glm::vec3 &velocity) {
+            b2Body_SetAngularVelocity(body_id_, velocity.z);
+        }
+
+        glm::vec3 Box2DBody::GetAngularVelocity() const {
+            return glm::vec3(0.0f, 0.0f, b2Body_GetAngularVelocity(body_id_));
+        }
+
+        // Box2D puts the whole island to sleep or wakes it.
+        void Box2DBody::SetAwake(bool awake) { b2Body_SetAwake(body_id_, awake); }
+
+        bool Box2DBody::IsAwake() const { return b2Body_IsAwake(body_id_); }
+
+        void Box2DBody::SetSleepThreshold(float threshold) { b2Body_SetSleepThreshold(body_id_, threshold); }
+
+        float Box2DBody::GetSleepThreshold() const { return b2Body_GetSleepThreshold(body_id_); }
+
+        float GetRotationAngleZ(const glm::quat &rotation) {
+            // Yaw of the quaternion; exact for rotations about Z, the projection onto the plane otherwise.
+            return std::atan2(2.0f * (rotation.w * rotation.z + rotation.x * rotation.y),
+                              1.0f - 2.0f * (rotation.y * rotation.y + rotation.z * rotation.z));
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <pal/iphysics_body.h>
+
+namespace Piece {
+    namespace PAL {
+        // Rigid body backed by a Box2D body. Box2D simulates the engine's XY plane:
+        // Z components are ignored on input and zero on output, rotations are about Z.
+        class Box2DBody : public IPhysicsBody {
+        public:
+            explicit Box2DBody(b2BodyId body_id);
+            ~Box2DBody() override;
+
+            Box2DBody(const Box2DBody &) = delete;
+            Box2DBody &operator=(const Box2DBody &) = delete;
+
+            // IPhysicsBody interface
+            BodyId GetId() const override;
+            void SetPosition(const glm::vec3 &position) override;
+            glm::vec3 GetPosition() const override;
+            void SetRotation(const glm::quat &rotation) override;
+            glm::quat GetRotation() const override;
+            void ApplyForce(const glm::vec3 &force) override;
+            void ApplyImpulse(const glm::vec3 &impulse) override;
+            void SetLinearVelocity(const glm::vec3 &velocity) override;
+            glm::vec3 GetLinearVelocity() const override;
+            void SetAngularVelocity(const glm::vec3 &velocity) override;
+            glm::vec3 GetAngularVelocity() const override;
+            void SetAwake(bool awake) override;
+            bool IsAwake() const override;
+            void SetSleepThreshold(float threshold) override;
+            float GetSleepThreshold() const override;
+
+            b2BodyId GetBodyId() const { return body_id_; }
+
+        private:
+            b2BodyId body_id_;
+        };
+
+        // Angle about Z of a rotation, in radians.
+        float GetRotationAngleZ(const glm::quat &rotation);
+
+        // Engine body id of a Box2D body: its slot in the world's body array.
+        inline BodyId ToBodyId(b2BodyId body_id) { return static_cast<BodyId>(body_id.index1 - 1); }
+    }
+}
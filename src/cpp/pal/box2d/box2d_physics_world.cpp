@@ -0,0 +1,539 @@
+#include "box2d_physics_world.h"
+
+#include <pal/physics_snapshot.h>
+#include <pal/physics_state_hash.h>
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#include "box2d_physics_body.h"
+
+namespace Piece {
+    namespace PAL {
+        // Box2D keeps per-worker scratch data for at most this many workers.
+        constexpr uint32_t kMaxBox2DWorkers = 64;
+
+        // Identifies snapshots of this backend and their layout.
+        constexpr uint32_t kSnapshotFormat = 0x31443242; // "B2D1"
+
+        // Queries per scheduler sub-range.
+        constexpr uint32_t kQueryBatchSize = 64;
+
+        namespace {
+            // Box2D collision proxy of a box or circle centered at center, in the XY plane.
+            b2ShapeProxy MakeProxy(ColliderShapeType shape, const glm::vec3 &center, const glm::vec3 &half_extents,
+                                   float radius) {
+                if (shape == ColliderShapeType::Box) {
+                    b2Vec2 points[4] = {{center.x - half_extents.x, center.y - half_extents.y},
+                                        {center.x + half_extents.x, center.y - half_extents.y},
+                                        {center.x + half_extents.x, center.y + half_extents.y},
+                                        {center.x - half_extents.x, center.y + half_extents.y}};
+                    return b2MakeProxy(points, 4, 0.0f);
+                }
+                b2Vec2 point = {center.x, center.y};
+                return b2MakeProxy(&point, 1, radius);
+            }
+
+            // Keeps the closest hit of a shape cast.
+            float ClosestCastResult(b2ShapeId shape_id, b2Vec2 point, b2Vec2 normal, float fraction, void *context) {
+                auto *result = static_cast<std::pair<RayCastHit, float> *>(context);
+                result->first.body = ToBodyId(b2Shape_GetBody(shape_id));
+                result->first.normal = glm::vec3(normal.x, normal.y, 0.0f);
+                result->second = fraction;
+                return fraction;
+            }
+
+            struct OverlapResults {
+                BodyId *results;
+                uint32_t capacity;
+                uint32_t count;
+            };
+
+            bool CollectOverlap(b2ShapeId shape_id, void *context) {
+                auto *overlaps = static_cast<OverlapResults *>(context);
+                overlaps->results[overlaps->count++] = ToBodyId(b2Shape_GetBody(shape_id));
+                return overlaps->count < overlaps->capacity;
+            }
+        }
+
+        Box2DWorld::Box2DWorld(const Core::NativePhysicsOptions &options)
+            : fixed_delta_time_(options.fixed_delta_time > 0.0f ? options.fixed_delta_time : 1.0f / 60.0f),
+              max_steps_(std::max(options.max_physics_steps, 1u)),
+              sub_step_count_(static_cast<int>(std::max(options.sub_step_count, 1u))) {}
+
+        Box2DWorld::~Box2DWorld() {
+            if (b2World_IsValid(world_id_)) {
+                b2DestroyWorld(world_id_);
+            }
+        }
+
+        void Box2DWorld::SetTaskScheduler(IPhysicsTaskScheduler *scheduler) {
+            if (b2World_IsValid(world_id_)) {
+                std::cerr << "Box2DWorld: SetTaskScheduler must be called before Init, ignoring." << std::endl;
+                return;
+            }
+            scheduler_ = scheduler;
+        }
+
+        void Box2DWorld::Init() {
+            if (b2World_IsValid(world_id_)) {
+                return;
+            }
+            b2WorldDef world_def = b2DefaultWorldDef();
+            world_def.enableSleep = sleeping_enabled_;
+            if (scheduler_ && scheduler_->GetWorkerCount() > kMaxBox2DWorkers) {
+                // Box2D indexes its per-worker data with the scheduler's worker indices, so it cannot be capped here.
+                std::cerr << "Box2DWorld: task scheduler has more than " << kMaxBox2DWorkers
+                          << " workers, stepping single-threaded." << std::endl;
+                scheduler_ = nullptr;
+            }
+            if (scheduler_) {
+                world_def.workerCount = static_cast<int>(scheduler_->GetWorkerCount());
+                world_def.enqueueTask = &Box2DWorld::EnqueueTask;
+                world_def.finishTask = &Box2DWorld::FinishTask;
+                world_def.userTaskContext = scheduler_;
+            }
+            world_id_ = b2CreateWorld(&world_def);
+        }
+
+        void Box2DWorld::Step(float delta_time) {
+            if (!b2World_IsValid(world_id_)) {
+                return;
+            }
+            moved_bodies_.clear();
+            ++step_stamp_;
+            accumulator_ += delta_time;
+            uint32_t steps = 0;
+            while (accumulator_ >= fixed_delta_time_ && steps < max_steps_) {
+                b2World_Step(world_id_, fixed_delta_time_, sub_step_count_);
+                CollectMovedBodies();
+                if (contact_events_.IsEnabled()) {
+                    CollectContactEvents();
+                }
+                accumulator_ -= fixed_delta_time_;
+                ++steps;
+            }
+            // When the step budget runs out, drop the backlog instead of letting it grow every frame.
+            accumulator_ = std::min(accumulator_, fixed_delta_time_);
+        }
+
+        std::unique_ptr<IPhysicsBody> Box2DWorld::CreatePhysicsBody(const RigidBodyCreationInfo &info) {
+            if (!b2World_IsValid(world_id_)) {
+                std::cerr << "Box2DWorld: CreatePhysicsBody called before Init." << std::endl;
+                return nullptr;
+            }
+
+            b2BodyDef body_def = b2DefaultBodyDef();
+            body_def.type = info.body_type == BodyType::Static      ? b2_staticBody
+                            : info.body_type == BodyType::Kinematic ? b2_kinematicBody
+                                                                    : b2_dynamicBody;
+            body_def.position = b2Vec2{info.position.x, info.position.y};
+            body_def.rotation = b2MakeRot(GetRotationAngleZ(info.rotation));
+            body_def.linearVelocity = b2Vec2{info.linear_velocity.x, info.linear_velocity.y};
+            // Island sleep and wake-on-contact are native to Box2D; resting islands leave the solver entirely.
+            body_def.isAwake = info.is_awake;
+            body_def.enableSleep = info.enable_sleep;
+            body_def.sleepThreshold = info.sleep_threshold;
+            b2BodyId body_id = b2CreateBody(world_id_, &body_def);
+
+            b2ShapeDef shape_def = b2DefaultShapeDef();
+            shape_def.density = info.density;
+            shape_def.material.friction = info.friction;
+            shape_def.material.restitution = info.restitution;
+            shape_def.isSensor = info.is_sensor;
+            shape_def.enableContactEvents = true;
+            shape_def.enableSensorEvents = true;
+            b2ShapeId shape_id = {};
+            if (info.shape == ColliderShapeType::Box) {
+                b2Polygon box = b2MakeBox(info.half_extents.x, info.half_extents.y);
+                shape_id = b2CreatePolygonShape(body_id, &shape_def, &box);
+            } else if (info.shape == ColliderShapeType::Sphere) {
+                b2Circle circle = {b2Vec2{0.0f, 0.0f}, info.radius};
+                shape_id = b2CreateCircleShape(body_id, &shape_def, &circle);
+            }
+
+            BodyId id = ToBodyId(body_id);
+            if (shape_id.index1 > 0) {
+                if (static_cast<size_t>(shape_id.index1) > shape_bodies_.size()) {
+                    shape_bodies_.resize(shape_id.index1, kInvalidBodyId);
+                }
+                shape_bodies_[shape_id.index1 - 1] = id;
+            }
+            if (id >= bodies_.size()) {
+                bodies_.resize(id + 1, b2_nullBodyId);
+                moved_stamps_.resize(id + 1, 0);
+            }
+            bodies_[id] = body_id;
+            return std::make_unique<Box2DBody>(body_id);
+        }
+
+        uint32_t Box2DWorld::GetBodyCount() const {
+            if (!b2World_IsValid(world_id_)) {
+                return 0;
+            }
+            return static_cast<uint32_t>(b2World_GetCounters(world_id_).bodyCount);
+        }
+
+        uint32_t Box2DWorld::GetAwakeBodyCount() const {
+            if (!b2World_IsValid(world_id_)) {
+                return 0;
+            }
+            return static_cast<uint32_t>(b2World_GetAwakeBodyCount(world_id_));
+        }
+
+        void Box2DWorld::SetSleepingEnabled(bool enabled) {
+            sleeping_enabled_ = enabled;
+            if (b2World_IsValid(world_id_)) {
+                b2World_EnableSleeping(world_id_, enabled);
+            }
+        }
+
+        void Box2DWorld::SetDeterministic(bool) {
+            // Nothing to do: Box2D v3 always steps bit-identically for any worker count, as its parallel stages
+            // write to per-body or per-color slots and merge them in a fixed order.
+        }
+
+        uint64_t Box2DWorld::GetStateHash() const { return state_hash_; }
+
+        uint32_t Box2DWorld::ReadBodyStates(const BodyStateArrays &states, uint32_t capacity, bool moved_only) {
+            if (!states.ids) {
+                return 0;
+            }
+            uint32_t written = 0;
+            auto write = [&](BodyId id, b2BodyId body_id) {
+                states.ids[written] = id;
+                if (states.positions || states.rotations) {
+                    b2Transform transform = b2Body_GetTransform(body_id);
+                    if (states.positions) {
+                        states.positions[written] = glm::vec3(transform.p.x, transform.p.y, 0.0f);
+                    }
+                    if (states.rotations) {
+                        states.rotations[written] = glm::angleAxis(b2Rot_GetAngle(transform.q), glm::vec3(0.0f, 0.0f, 1.0f));
+                    }
+                }
+                if (states.linear_velocities) {
+                    b2Vec2 velocity = b2Body_GetLinearVelocity(body_id);
+                    states.linear_velocities[written] = glm::vec3(velocity.x, velocity.y, 0.0f);
+                }
+                if (states.angular_velocities) {
+                    states.angular_velocities[written] = glm::vec3(0.0f, 0.0f, b2Body_GetAngularVelocity(body_id));
+                }
+                ++written;
+            };
+
+            if (moved_only) {
+                for (size_t i = 0; i < moved_bodies_.size() && written < capacity; ++i) {
+                    b2BodyId body_id = FindBody(moved_bodies_[i]);
+                    if (B2_IS_NON_NULL(body_id)) {
+                        write(moved_bodies_[i], body_id);
+                    }
+                }
+            } else {
+                for (BodyId id = 0; id < bodies_.size() && written < capacity; ++id) {
+                    if (b2Body_IsValid(bodies_[id])) {
+                        write(id, bodies_[id]);
+                    }
+                }
+            }
+            return written;
+        }
+
+        void Box2DWorld::WriteBodyStates(const BodyStateArrays &states, uint32_t count) {
+            if (!states.ids) {
+                return;
+            }
+            for (uint32_t i = 0; i < count; ++i) {
+                b2BodyId body_id = FindBody(states.ids[i]);
+                if (B2_IS_NULL(body_id)) {
+                    continue;
+                }
+                if (states.positions || states.rotations) {
+                    b2Transform transform = b2Body_GetTransform(body_id);
+                    if (states.positions) {
+                        transform.p = b2Vec2{states.positions[i].x, states.positions[i].y};
+                    }
+                    if (states.rotations) {
+                        transform.q = b2MakeRot(GetRotationAngleZ(states.rotations[i]));
+                    }
+                    b2Body_SetTransform(body_id, transform.p, transform.q);
+                }
+                if (states.linear_velocities) {
+                    b2Body_SetLinearVelocity(body_id, b2Vec2{states.linear_velocities[i].x, states.linear_velocities[i].y});
+                }
+                if (states.angular_velocities) {
+                    b2Body_SetAngularVelocity(body_id, states.angular_velocities[i].z);
+                }
+            }
+        }
+
+        void Box2DWorld::ApplyImpulses(const BodyId *ids, const glm::vec3 *impulses, uint32_t count) {
+            for (uint32_t i = 0; i < count; ++i) {
+                b2BodyId body_id = FindBody(ids[i]);
+                if (B2_IS_NULL(body_id)) {
+                    continue;
+                }
+                b2Body_ApplyLinearImpulseToCenter(body_id, b2Vec2{impulses[i].x, impulses[i].y}, true);
+            }
+        }
+
+        void Box2DWorld::CastRays(const RayCastInput *rays, uint32_t count, RayCastHit *hits) {
+            auto cast = [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    const RayCastInput &ray = rays[i];
+                    hits[i] = RayCastHit();
+                    if (!b2World_IsValid(world_id_)) {
+                        continue;
+                    }
+                    b2Vec2 translation = {ray.direction.x * ray.max_distance, ray.direction.y * ray.max_distance};
+                    b2RayResult result = b2World_CastRayClosest(world_id_, b2Vec2{ray.origin.x, ray.origin.y},
+                                                                translation, b2DefaultQueryFilter());
+                    if (result.hit) {
+                        hits[i].body = ToBodyId(b2Shape_GetBody(result.shapeId));
+                        hits[i].distance = result.fraction * ray.max_distance;
+                        hits[i].point = glm::vec3(result.point.x, result.point.y, ray.origin.z);
+                        hits[i].normal = glm::vec3(result.normal.x, result.normal.y, 0.0f);
+                    }
+                }
+            };
+            RunParallel(scheduler_, count, kQueryBatchSize, cast);
+        }
+
+        void Box2DWorld::CastShapes(const ShapeCastInput *casts, uint32_t count, RayCastHit *hits) {
+            auto cast = [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    const ShapeCastInput &input = casts[i];
+                    hits[i] = RayCastHit();
+                    if (!b2World_IsValid(world_id_)) {
+                        continue;
+                    }
+                    b2ShapeProxy proxy = MakeProxy(input.shape, input.origin, input.half_extents, input.radius);
+                    b2Vec2 translation = {input.direction.x * input.max_distance, input.direction.y * input.max_distance};
+                    std::pair<RayCastHit, float> result(RayCastHit(), 1.0f);
+                    b2World_CastShape(world_id_, &proxy, translation, b2DefaultQueryFilter(), &ClosestCastResult, &result);
+                    if (result.first.body != kInvalidBodyId) {
+                        hits[i] = result.first;
+                        hits[i].distance = result.second * input.max_distance;
+                        hits[i].point = input.origin + input.direction * hits[i].distance;
+                    }
+                }
+            };
+            RunParallel(scheduler_, count, kQueryBatchSize, cast);
+        }
+
+        void Box2DWorld::QueryOverlaps(const OverlapInput *queries, uint32_t count, BodyId *results,
+                                       uint32_t max_results_per_query, uint32_t *result_counts) {
+            auto query = [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    OverlapResults overlaps = {results + static_cast<size_t>(i) * max_results_per_query,
+                                               max_results_per_query, 0};
+                    if (b2World_IsValid(world_id_) && max_results_per_query > 0) {
+                        const OverlapInput &input = queries[i];
+                        b2ShapeProxy proxy = MakeProxy(input.shape, input.center, input.half_extents, input.radius);
+                        b2World_OverlapShape(world_id_, &proxy, b2DefaultQueryFilter(), &CollectOverlap, &overlaps);
+                    }
+                    result_counts[i] = overlaps.count;
+                }
+            };
+            RunParallel(scheduler_, count, kQueryBatchSize, query);
+        }
+
+        void Box2DWorld::ConfigureContactEvents(const ContactEventOptions &options) {
+            contact_events_.SetCapacity(options.capacity);
+            report_persist_ = options.report_persist;
+            touching_pairs_.clear();
+        }
+
+        uint32_t Box2DWorld::ReadContactEvents(ContactEvent *events, uint32_t capacity) {
+            return contact_events_.Read(events, capacity);
+        }
+
+        uint64_t Box2DWorld::GetDroppedContactEventCount() const { return contact_events_.GetDroppedCount(); }
+
+        size_t Box2DWorld::SaveSnapshot(void *buffer, size_t capacity) {
+            // Box2D has no world serialization, so the snapshot holds the state of every body. Contact and solver
+            // caches are rebuilt after a restore, so resimulation is close to but not bit-identical with the original.
+            snapshot_ids_.clear();
+            snapshot_transforms_.clear();
+            snapshot_linear_velocities_.clear();
+            snapshot_angular_velocities_.clear();
+            snapshot_awake_.clear();
+            for (BodyId id = 0; id < bodies_.size(); ++id) {
+                b2BodyId body_id = bodies_[id];
+                if (!b2Body_IsValid(body_id)) {
+                    continue;
+                }
+                snapshot_ids_.push_back(id);
+                snapshot_transforms_.push_back(b2Body_GetTransform(body_id));
+                snapshot_linear_velocities_.push_back(b2Body_GetLinearVelocity(body_id));
+                snapshot_angular_velocities_.push_back(b2Body_GetAngularVelocity(body_id));
+                snapshot_awake_.push_back(b2Body_IsAwake(body_id) ? 1 : 0);
+            }
+
+            PhysicsSnapshotWriter writer(buffer, capacity);
+            writer.Write(kSnapshotFormat);
+            writer.Write(accumulator_);
+            writer.Write(state_hash_);
+            writer.WriteArray(snapshot_ids_);
+            writer.WriteArray(snapshot_transforms_);
+            writer.WriteArray(snapshot_linear_velocities_);
+            writer.WriteArray(snapshot_angular_velocities_);
+            writer.WriteArray(snapshot_awake_);
+            return writer.GetSize();
+        }
+
+        bool Box2DWorld::RestoreSnapshot(const void *snapshot, size_t size) {
+            if (!b2World_IsValid(world_id_)) {
+                return false;
+            }
+            PhysicsSnapshotReader reader(snapshot, size);
+            uint32_t format = 0;
+            float accumulator = 0.0f;
+            uint64_t state_hash = 0;
+            reader.Read(format);
+            reader.Read(accumulator);
+            reader.Read(state_hash);
+            reader.ReadArray(snapshot_ids_);
+            reader.ReadArray(snapshot_transforms_);
+            reader.ReadArray(snapshot_linear_velocities_);
+            reader.ReadArray(snapshot_angular_velocities_);
+            reader.ReadArray(snapshot_awake_);
+            size_t count = snapshot_ids_.size();
+            if (format != kSnapshotFormat || !reader.IsComplete() || snapshot_transforms_.size() != count ||
+                snapshot_linear_velocities_.size() != count || snapshot_angular_velocities_.size() != count ||
+                snapshot_awake_.size() != count) {
+                std::cerr << "Box2DWorld: RestoreSnapshot got an invalid snapshot." << std::endl;
+                return false;
+            }
+            bool same_bodies = count == GetBodyCount();
+            for (size_t i = 0; same_bodies && i < count; ++i) {
+                same_bodies = B2_IS_NON_NULL(FindBody(snapshot_ids_[i]));
+            }
+            if (!same_bodies) {
+                std::cerr << "Box2DWorld: RestoreSnapshot bodies do not match the world's bodies." << std::endl;
+                return false;
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                b2BodyId body_id = bodies_[snapshot_ids_[i]];
+                b2Body_SetTransform(body_id, snapshot_transforms_[i].p, snapshot_transforms_[i].q);
+                b2Body_SetLinearVelocity(body_id, snapshot_linear_velocities_[i]);
+                b2Body_SetAngularVelocity(body_id, snapshot_angular_velocities_[i]);
+                // Last, since setting a velocity wakes the body.
+                b2Body_SetAwake(body_id, snapshot_awake_[i] != 0);
+            }
+            accumulator_ = accumulator;
+            state_hash_ = state_hash;
+            moved_bodies_.assign(snapshot_ids_.begin(), snapshot_ids_.end());
+            return true;
+        }
+
+        void Box2DWorld::CollectMovedBodies() {
+            b2BodyEvents events = b2World_GetBodyEvents(world_id_);
+            // Box2D reports every body its solver moved, which are the awake bodies the state hash covers.
+            uint64_t body_hash_sum = 0;
+            for (int i = 0; i < events.moveCount; ++i) {
+                const b2BodyMoveEvent &event = events.moveEvents[i];
+                BodyId id = ToBodyId(event.bodyId);
+                body_hash_sum += HashBodyState(id, event.transform.p, event.transform.q,
+                                               b2Body_GetLinearVelocity(event.bodyId),
+                                               b2Body_GetAngularVelocity(event.bodyId));
+                if (id < moved_stamps_.size() && moved_stamps_[id] != step_stamp_) {
+                    moved_stamps_[id] = step_stamp_;
+                    moved_bodies_.push_back(id);
+                }
+            }
+            state_hash_ = ChainStepHash(state_hash_, body_hash_sum, static_cast<uint32_t>(events.moveCount));
+        }
+
+        void Box2DWorld::CollectContactEvents() {
+            auto pair_key = [](BodyId a, BodyId b) {
+                return a < b ? static_cast<uint64_t>(a) << 32 | b : static_cast<uint64_t>(b) << 32 | a;
+            };
+            // Box2D reports a contact begin with its manifold and an end for every contact that stops touching,
+            // including those of destroyed shapes, so only Persist needs the touching pairs tracked here.
+            b2ContactEvents contacts = b2World_GetContactEvents(world_id_);
+            for (int i = 0; i < contacts.endCount; ++i) {
+                ContactEvent event;
+                event.type = ContactEventType::End;
+                event.body_a = GetShapeBody(contacts.endEvents[i].shapeIdA);
+                event.body_b = GetShapeBody(contacts.endEvents[i].shapeIdB);
+                contact_events_.Push(event);
+                auto it = std::lower_bound(touching_pairs_.begin(), touching_pairs_.end(),
+                                           pair_key(event.body_a, event.body_b));
+                if (it != touching_pairs_.end() && *it == pair_key(event.body_a, event.body_b)) {
+                    touching_pairs_.erase(it);
+                }
+            }
+            if (report_persist_) {
+                // Pairs that began in this step get a Begin, not a Persist.
+                for (uint64_t key : touching_pairs_) {
+                    ContactEvent event;
+                    event.type = ContactEventType::Persist;
+                    event.body_a = static_cast<BodyId>(key >> 32);
+                    event.body_b = static_cast<BodyId>(key);
+                    contact_events_.Push(event);
+                }
+            }
+            for (int i = 0; i < contacts.beginCount; ++i) {
+                const b2ContactBeginTouchEvent &begin = contacts.beginEvents[i];
+                ContactEvent event;
+                event.type = ContactEventType::Begin;
+                event.body_a = GetShapeBody(begin.shapeIdA);
+                event.body_b = GetShapeBody(begin.shapeIdB);
+                event.normal = glm::vec3(begin.manifold.normal.x, begin.manifold.normal.y, 0.0f);
+                for (int p = 0; p < begin.manifold.pointCount; ++p) {
+                    const b2ManifoldPoint &point = begin.manifold.points[p];
+                    event.point = glm::vec3(point.point.x, point.point.y, 0.0f);
+                    event.approach_speed = std::max(event.approach_speed, -point.normalVelocity);
+                }
+                contact_events_.Push(event);
+                uint64_t key = pair_key(event.body_a, event.body_b);
+                auto it = std::lower_bound(touching_pairs_.begin(), touching_pairs_.end(), key);
+                if (it == touching_pairs_.end() || *it != key) {
+                    touching_pairs_.insert(it, key);
+                }
+            }
+
+            b2SensorEvents sensors = b2World_GetSensorEvents(world_id_);
+            for (int i = 0; i < sensors.beginCount; ++i) {
+                ContactEvent event;
+                event.type = ContactEventType::SensorBegin;
+                event.body_a = GetShapeBody(sensors.beginEvents[i].sensorShapeId);
+                event.body_b = GetShapeBody(sensors.beginEvents[i].visitorShapeId);
+                contact_events_.Push(event);
+            }
+            for (int i = 0; i < sensors.endCount; ++i) {
+                ContactEvent event;
+                event.type = ContactEventType::SensorEnd;
+                event.body_a = GetShapeBody(sensors.endEvents[i].sensorShapeId);
+                event.body_b = GetShapeBody(sensors.endEvents[i].visitorShapeId);
+                contact_events_.Push(event);
+            }
+        }
+
+        BodyId Box2DWorld::GetShapeBody(b2ShapeId shape_id) const {
+            if (b2Shape_IsValid(shape_id)) {
+                return ToBodyId(b2Shape_GetBody(shape_id));
+            }
+            size_t index = static_cast<size_t>(shape_id.index1) - 1;
+            return index < shape_bodies_.size() ? shape_bodies_[index] : kInvalidBodyId;
+        }
+
+        b2BodyId Box2DWorld::FindBody(BodyId id) const {
+            if (id >= bodies_.size() || !b2Body_IsValid(bodies_[id])) {
+                return b2_nullBodyId;
+            }
+            return bodies_[id];
+        }
+
+        void *Box2DWorld::EnqueueTask(b2TaskCallback *task, int item_count, int min_range, void *task_context,
+                                      void *user_context) {
+            return static_cast<IPhysicsTaskScheduler *>(user_context)->EnqueueTask(task, item_count, min_range, task_context);
+        }
+
+        void Box2DWorld::FinishTask(void *user_task, void *user_context) {
+            static_cast<IPhysicsTaskScheduler *>(user_context)->FinishTask(user_task);
+        }
+    }
+}
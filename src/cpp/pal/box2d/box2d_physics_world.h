@@ -0,0 +1,95 @@
+#pragma once
+
+#include <box2d/box2d.h>
+#include <pal/contact_event_buffer.h>
+#include <pal/iphysics_task_scheduler.h>
+#include <pal/iphysics_world.h>
+#include <piece_core/native_interop_types.h>
+
+#include <vector>
+
+namespace Piece {
+    namespace PAL {
+        // Physics world backed by a Box2D v3 world. Step runs a fixed-timestep accumulator and hands
+        // Box2D's parallel stages (broadphase, narrowphase, island solving) to the task scheduler.
+        class Box2DWorld : public IPhysicsWorld {
+        public:
+            explicit Box2DWorld(const Core::NativePhysicsOptions &options);
+            ~Box2DWorld() override;
+
+            Box2DWorld(const Box2DWorld &) = delete;
+            Box2DWorld &operator=(const Box2DWorld &) = delete;
+
+            // IPhysicsWorld interface
+            void SetTaskScheduler(IPhysicsTaskScheduler *scheduler) override;
+            void Init() override;
+            void Step(float delta_time) override;
+            std::unique_ptr<IPhysicsBody> CreatePhysicsBody(const RigidBodyCreationInfo &info) override;
+            uint32_t GetBodyCount() const override;
+            uint32_t GetAwakeBodyCount() const override;
+            void SetSleepingEnabled(bool enabled) override;
+            void SetDeterministic(bool enabled) override;
+            uint64_t GetStateHash() const override;
+            uint32_t ReadBodyStates(const BodyStateArrays &states, uint32_t capacity, bool moved_only) override;
+            void WriteBodyStates(const BodyStateArrays &states, uint32_t count) override;
+            void ApplyImpulses(const BodyId *ids, const glm::vec3 *impulses, uint32_t count) override;
+            void CastRays(const RayCastInput *rays, uint32_t count, RayCastHit *hits) override;
+            void CastShapes(const ShapeCastInput *casts, uint32_t count, RayCastHit *hits) override;
+            void QueryOverlaps(const OverlapInput *queries, uint32_t count, BodyId *results,
+                               uint32_t max_results_per_query, uint32_t *result_counts) override;
+            void ConfigureContactEvents(const ContactEventOptions &options) override;
+            uint32_t ReadContactEvents(ContactEvent *events, uint32_t capacity) override;
+            uint64_t GetDroppedContactEventCount() const override;
+            size_t SaveSnapshot(void *buffer, size_t capacity) override;
+            bool RestoreSnapshot(const void *snapshot, size_t size) override;
+
+            b2WorldId GetWorldId() const { return world_id_; }
+
+        private:
+            // Box2D task callbacks forwarding to the scheduler passed as user context.
+            static void *EnqueueTask(b2TaskCallback *task, int item_count, int min_range, void *task_context,
+                                     void *user_context);
+            static void FinishTask(void *user_task, void *user_context);
+
+            // Appends the bodies reported by Box2D's move events of the last b2World_Step to moved_bodies_ and
+            // chains them onto the state hash.
+            void CollectMovedBodies();
+            // Converts Box2D's contact and sensor events of the last b2World_Step into contact events.
+            void CollectContactEvents();
+            // Engine body id of a shape, also for shapes destroyed since their events were recorded.
+            BodyId GetShapeBody(b2ShapeId shape_id) const;
+            // Resolves an engine body id, returning b2_nullBodyId for unknown or destroyed bodies.
+            b2BodyId FindBody(BodyId id) const;
+
+            IPhysicsTaskScheduler *scheduler_ = nullptr;
+            b2WorldId world_id_ = b2_nullWorldId;
+            float fixed_delta_time_;
+            uint32_t max_steps_;
+            int sub_step_count_;
+            float accumulator_ = 0.0f;
+            ContactEventBuffer contact_events_;
+            bool report_persist_ = false;
+            bool sleeping_enabled_ = true;
+            uint64_t state_hash_ = 0;
+
+            // Engine body id by Box2D shape index, so end events of destroyed shapes still name their body.
+            std::vector<BodyId> shape_bodies_;
+            // Touching non-sensor pairs as (lower id << 32 | higher id), sorted, to report Persist events.
+            std::vector<uint64_t> touching_pairs_;
+            // Box2D ids by engine body id. Entries of destroyed bodies fail b2Body_IsValid.
+            std::vector<b2BodyId> bodies_;
+            // Bodies moved during the last Step, each listed once.
+            std::vector<BodyId> moved_bodies_;
+            // Per body, the step_stamp_ of the Step it was last added to moved_bodies_ in.
+            std::vector<uint32_t> moved_stamps_;
+            uint32_t step_stamp_ = 0;
+
+            // Per-body state of the last saved or restored snapshot, as the arrays written to the buffer.
+            std::vector<BodyId> snapshot_ids_;
+            std::vector<b2Transform> snapshot_transforms_;
+            std::vector<b2Vec2> snapshot_linear_velocities_;
+            std::vector<float> snapshot_angular_velocities_;
+            std::vector<uint8_t> snapshot_awake_;
+        };
+    }
+}
@@ -1,5 +1,16 @@
 #include "box2d_physics_world_factory.h"
 
+#include "box2d_physics_world.h"
+
+namespace Piece {
+    namespace Core {
+        std::unique_ptr<PAL::IPhysicsWorld> Box2DPhysicsWorldFactory::CreatePhysicsWorld(const NativePhysicsOptions *options) {
+            NativePhysicsOptions defaults = {1.0f / 60.0f, 4, 4};
+            return std::make_unique<PAL::Box2DWorld>(options ? *options : defaults);
+        }
+    }
+}
+
 extern "C" {
     PAL_BOX2D_API Piece::Core::IPhysicsWorldFactory* CreateBox2DPhysicsWorldFactory() {
         return new Piece::Core::Box2DPhysicsWorldFactory();
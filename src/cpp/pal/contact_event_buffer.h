@@ -0,0 +1,121 @@
+/**
+ * @file contact_event_buffer.h
+ * @brief Defines the ring buffer physics backends use to implement IPhysicsWorld contact events.
+ */
+#ifndef PIECE_PAL_CONTACT_EVENT_BUFFER_H_
+#define PIECE_PAL_CONTACT_EVENT_BUFFER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "pal_types.h"
+
+namespace Piece
+{
+namespace PAL
+{
+
+/**
+ * @brief A fixed-capacity FIFO of contact events.
+ * @details Storage is allocated once by SetCapacity; Push never allocates. When the buffer is full new events are
+ *          dropped rather than overwriting older ones, so a reader that keeps up always sees every Begin before
+ *          its End. The buffer is written and read by whichever thread holds the world.
+ */
+class ContactEventBuffer
+{
+  public:
+    /**
+     * @brief Reallocates the storage and discards buffered events.
+     * @param capacity The number of events the buffer holds; 0 disables it.
+     */
+    void SetCapacity(uint32_t capacity)
+    {
+        events_.assign(capacity, ContactEvent());
+        head_ = 0;
+        count_ = 0;
+        dropped_ = 0;
+    }
+
+    /**
+     * @brief Checks whether events are being recorded at all.
+     * @return True if the capacity is not 0.
+     */
+    bool IsEnabled() const
+    {
+        return !events_.empty();
+    }
+
+    /**
+     * @brief Appends an event, or counts it as dropped if the buffer is full.
+     * @param event The event.
+     */
+    void Push(const ContactEvent &event)
+    {
+        uint32_t capacity = static_cast<uint32_t>(events_.size());
+        if (count_ == capacity)
+        {
+            ++dropped_;
+            return;
+        }
+        uint32_t tail = head_ + count_;
+        events_[tail < capacity ? tail : tail - capacity] = event;
+        ++count_;
+    }
+
+    /**
+     * @brief Moves the oldest events out of the buffer.
+     * @param events Receives the events, oldest first.
+     * @param capacity The number of events the array holds.
+     * @return The number of events written.
+     */
+    uint32_t Read(ContactEvent *events, uint32_t capacity)
+    {
+        uint32_t count = std::min(capacity, count_);
+        if (!events || count == 0)
+        {
+            return 0;
+        }
+        // At most two contiguous copies: up to the end of storage, then from its start.
+        uint32_t size = static_cast<uint32_t>(events_.size());
+        uint32_t first = std::min(count, size - head_);
+        std::copy_n(events_.begin() + head_, first, events);
+        std::copy_n(events_.begin(), count - first, events + first);
+        head_ = (head_ + count) % size;
+        count_ -= count;
+        return count;
+    }
+
+    /**
+     * @brief Gets the number of buffered events.
+     * @return The event count.
+     */
+    uint32_t GetCount() const
+    {
+        return count_;
+    }
+
+    /**
+     * @brief Gets the number of events dropped because the buffer was full.
+     * @return The dropped event count.
+     */
+    uint64_t GetDroppedCount() const
+    {
+        return dropped_;
+    }
+
+  private:
+    /** @brief The ring storage. */
+    std::vector<ContactEvent> events_;
+    /** @brief The index of the oldest event. */
+    uint32_t head_ = 0;
+    /** @brief The number of buffered events. */
+    uint32_t count_ = 0;
+    /** @brief The number of events dropped since SetCapacity. */
+    uint64_t dropped_ = 0;
+};
+
+} // namespace PAL
+} // namespace Piece
+
+#endif // PIECE_PAL_CONTACT_EVENT_BUFFER_H_
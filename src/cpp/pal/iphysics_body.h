@@ -8,6 +8,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include "pal_types.h"
+
 namespace Piece
 {
 namespace PAL
@@ -26,6 +28,12 @@ class IPhysicsBody
      */
     virtual ~IPhysicsBody() = default;
 
+    /**
+     * @brief Gets the id of the body, used by the bulk state functions of IPhysicsWorld.
+     * @return The body id.
+     */
+    virtual BodyId GetId() const = 0;
+
     /**
      * @brief Sets the position of the physics body.
      * @param position The new position of the body in world space.
@@ -85,6 +93,32 @@ class IPhysicsBody
      * @return The current angular velocity of the body.
      */
     virtual glm::vec3 GetAngularVelocity() const = 0;
+
+    /**
+     * @brief Wakes the body or puts it to sleep. Sleeping bodies are skipped by Step until woken.
+     *        Forces, impulses, non-zero velocities and contact with an awake body wake a sleeping body.
+     * @param awake True to wake the body, false to put it to sleep.
+     */
+    virtual void SetAwake(bool awake) = 0;
+
+    /**
+     * @brief Checks whether the body is awake.
+     * @return True if the body is simulated by Step, false if it is asleep. Static bodies are never awake.
+     */
+    virtual bool IsAwake() const = 0;
+
+    /**
+     * @brief Sets the speed below which the body counts as resting.
+     *        A body falls asleep with its island once every body of the island has rested for a short time.
+     * @param threshold The speed in units per second.
+     */
+    virtual void SetSleepThreshold(float threshold) = 0;
+
+    /**
+     * @brief Gets the speed below which the body counts as resting.
+     * @return The speed in units per second.
+     */
+    virtual float GetSleepThreshold() const = 0;
 };
 
 } // namespace PAL
@@ -0,0 +1,102 @@
+/**
+ * @file iphysics_task_scheduler.h
+ * @brief Defines the IPhysicsTaskScheduler interface, through which physics backends run parallel work on the
+ *        engine's worker threads.
+ */
+#ifndef PIECE_PAL_IPHYSICS_TASK_SCHEDULER_H_
+#define PIECE_PAL_IPHYSICS_TASK_SCHEDULER_H_
+
+#include <cstdint>
+
+namespace Piece
+{
+namespace PAL
+{
+
+/**
+ * @brief Interface for the task system a physics world uses for its parallel stages.
+ * @details The shape follows the task callbacks of Box2D and similar solvers: a task is a range of items split into
+ *          sub-ranges that may run concurrently. Each invocation receives a worker index that is unique among the
+ *          threads executing tasks at the same time, so backends can keep per-worker scratch data without locking.
+ *          The thread stepping the world uses worker index 0.
+ */
+class IPhysicsTaskScheduler
+{
+  public:
+    /**
+     * @brief A task body processing the items in [start_index, end_index).
+     */
+    using TaskFunction = void (*)(int start_index, int end_index, uint32_t worker_index, void *task_context);
+
+    /**
+     * @brief Virtual destructor for the task scheduler.
+     */
+    virtual ~IPhysicsTaskScheduler() = default;
+
+    /**
+     * @brief Gets the number of distinct worker indices the scheduler may pass, including the stepping thread.
+     * @return The worker count, at least 1.
+     */
+    virtual uint32_t GetWorkerCount() const = 0;
+
+    /**
+     * @brief Starts a task.
+     * @param task The task body.
+     * @param item_count The number of items.
+     * @param min_range The smallest number of items worth running as one sub-range.
+     * @param task_context Opaque data passed to the task body.
+     * @return A handle to pass to FinishTask, or nullptr if the task already ran to completion on the calling thread.
+     */
+    virtual void *EnqueueTask(TaskFunction task, int item_count, int min_range, void *task_context) = 0;
+
+    /**
+     * @brief Blocks until a task started by EnqueueTask has finished and releases its handle.
+     * @param task_handle The handle returned by EnqueueTask.
+     */
+    virtual void FinishTask(void *task_handle) = 0;
+};
+
+/**
+ * @brief Runs function(begin, end, worker_index) over [0, count) in sub-ranges on a scheduler and waits for completion.
+ *        The worker index is below the scheduler's worker count, so function can write to per-worker scratch data.
+ * @param scheduler The scheduler, or nullptr to run everything on the calling thread as worker 0.
+ * @param count The number of items.
+ * @param min_range The smallest number of items worth running as one sub-range.
+ * @param function The callable, invoked concurrently from several threads.
+ */
+template <typename Function>
+void RunParallelPerWorker(IPhysicsTaskScheduler *scheduler, uint32_t count, uint32_t min_range, Function &function)
+{
+    if (!scheduler || count <= min_range)
+    {
+        function(0u, count, 0u);
+        return;
+    }
+    auto task = [](int start_index, int end_index, uint32_t worker_index, void *task_context) {
+        (*static_cast<Function *>(task_context))(static_cast<uint32_t>(start_index), static_cast<uint32_t>(end_index),
+                                                 worker_index);
+    };
+    if (void *handle = scheduler->EnqueueTask(task, static_cast<int>(count), static_cast<int>(min_range), &function))
+    {
+        scheduler->FinishTask(handle);
+    }
+}
+
+/**
+ * @brief Runs function(begin, end) over [0, count) in sub-ranges on a scheduler and waits for completion.
+ * @param scheduler The scheduler, or nullptr to run everything on the calling thread.
+ * @param count The number of items.
+ * @param min_range The smallest number of items worth running as one sub-range.
+ * @param function The callable, invoked concurrently from several threads.
+ */
+template <typename Function>
+void RunParallel(IPhysicsTaskScheduler *scheduler, uint32_t count, uint32_t min_range, Function &function)
+{
+    auto ranged = [&function](uint32_t begin, uint32_t end, uint32_t) { function(begin, end); };
+    RunParallelPerWorker(scheduler, count, min_range, ranged);
+}
+
+} // namespace PAL
+} // namespace Piece
+
+#endif // PIECE_PAL_IPHYSICS_TASK_SCHEDULER_H_
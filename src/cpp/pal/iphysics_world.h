@@ -5,9 +5,13 @@
 #ifndef PIECE_PAL_IPHYSICS_WORLD_H_
 #define PIECE_PAL_IPHYSICS_WORLD_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 #include "iphysics_body.h"
+#include "iphysics_task_scheduler.h"
+#include "pal_types.h"
 
 namespace Piece
 {
@@ -27,6 +31,13 @@ class IPhysicsWorld
      */
     virtual ~IPhysicsWorld() = default;
 
+    /**
+     * @brief Sets the task scheduler used to run the parallel stages of Step.
+     *        Must be called before Init. Without a scheduler the world steps on the calling thread only.
+     * @param scheduler The scheduler. Must outlive the world.
+     */
+    virtual void SetTaskScheduler(IPhysicsTaskScheduler *scheduler) = 0;
+
     /**
      * @brief Initializes the physics world.
      */
@@ -40,9 +51,145 @@ class IPhysicsWorld
 
     /**
      * @brief Creates a new physics body in the world.
-     * @return A unique pointer to the newly created IPhysicsBody.
+     * @param info The body and collider description.
+     * @return A unique pointer to the newly created IPhysicsBody, or nullptr if the world is not initialized.
+     */
+    virtual std::unique_ptr<IPhysicsBody> CreatePhysicsBody(const RigidBodyCreationInfo &info) = 0;
+
+    /**
+     * @brief Gets the number of bodies in the world.
+     * @return The body count, an upper bound for the result of ReadBodyStates.
+     */
+    virtual uint32_t GetBodyCount() const = 0;
+
+    /**
+     * @brief Gets the number of awake bodies, the bodies Step actually simulates.
+     * @return The awake body count. Static and sleeping bodies are not counted.
+     */
+    virtual uint32_t GetAwakeBodyCount() const = 0;
+
+    /**
+     * @brief Enables or disables sleeping for the whole world.
+     *        Bodies touching each other form islands; an island falls asleep once all of its bodies have rested
+     *        below their sleep threshold for a short time, and wakes as a whole when an awake body touches it.
+     *        Disabling sleeping wakes every body. Enabled by default.
+     * @param enabled True to let resting islands sleep.
+     */
+    virtual void SetSleepingEnabled(bool enabled) = 0;
+
+    /**
+     * @brief Copies the state of many bodies into caller-provided arrays in one call.
+     * @param states The destination arrays. ids must be set; every set array must hold capacity elements.
+     * @param capacity The number of elements the arrays hold.
+     * @param moved_only If true, only bodies moved by the simulation during the last Step are written.
+     * @return The number of bodies written.
+     */
+    virtual uint32_t ReadBodyStates(const BodyStateArrays &states, uint32_t capacity, bool moved_only) = 0;
+
+    /**
+     * @brief Sets the state of many bodies from caller-provided arrays in one call.
+     *        Attributes whose array is nullptr are left unchanged; unknown ids are skipped.
+     * @param states The source arrays. ids must be set; every set array must hold count elements.
+     * @param count The number of bodies to update.
+     */
+    virtual void WriteBodyStates(const BodyStateArrays &states, uint32_t count) = 0;
+
+    /**
+     * @brief Applies a linear impulse at the center of mass of many bodies in one call, waking them.
+     *        Unknown ids and static bodies are skipped.
+     * @param ids The bodies.
+     * @param impulses One impulse per body, in world space.
+     * @param count The number of bodies.
+     */
+    virtual void ApplyImpulses(const BodyId *ids, const glm::vec3 *impulses, uint32_t count) = 0;
+
+    /**
+     * @brief Finds the closest hit of each ray. Queries run in parallel on the task scheduler when one is set.
+     *        Must not be called while the world is stepping or bodies are created or destroyed.
+     * @param rays The rays.
+     * @param count The number of rays.
+     * @param hits Receives one hit per ray; RayCastHit::body is kInvalidBodyId for misses.
+     */
+    virtual void CastRays(const RayCastInput *rays, uint32_t count, RayCastHit *hits) = 0;
+
+    /**
+     * @brief Finds the first body each swept shape touches. Same threading rules as CastRays.
+     * @param casts The shape casts.
+     * @param count The number of casts.
+     * @param hits Receives one hit per cast; RayCastHit::body is kInvalidBodyId for misses.
+     */
+    virtual void CastShapes(const ShapeCastInput *casts, uint32_t count, RayCastHit *hits) = 0;
+
+    /**
+     * @brief Finds the bodies overlapping each shape. Same threading rules as CastRays.
+     * @param queries The shapes.
+     * @param count The number of shapes.
+     * @param results Receives the overlapping bodies of query i at results[i * max_results_per_query].
+     * @param max_results_per_query The number of result slots per query; further overlaps are dropped.
+     * @param result_counts Receives the number of results written for each query.
+     */
+    virtual void QueryOverlaps(const OverlapInput *queries, uint32_t count, BodyId *results,
+                               uint32_t max_results_per_query, uint32_t *result_counts) = 0;
+
+    /**
+     * @brief Configures contact event reporting. Events pending from before are discarded.
+     * @param options The buffer capacity and the kinds of events to report.
+     */
+    virtual void ConfigureContactEvents(const ContactEventOptions &options) = 0;
+
+    /**
+     * @brief Moves the oldest buffered contact events into a caller-provided array.
+     *        Step appends the events of each fixed step to a preallocated ring buffer, so reporting never
+     *        allocates or calls back into the caller. Events that find the buffer full are dropped and counted.
+     * @param events Receives the events, oldest first.
+     * @param capacity The number of events the array holds.
+     * @return The number of events written; events beyond capacity stay buffered for the next call.
+     */
+    virtual uint32_t ReadContactEvents(ContactEvent *events, uint32_t capacity) = 0;
+
+    /**
+     * @brief Gets the number of contact events dropped because the buffer was full.
+     * @return The number of events dropped since reporting was configured.
+     */
+    virtual uint64_t GetDroppedContactEventCount() const = 0;
+
+    /**
+     * @brief Enables or disables deterministic stepping.
+     *        When enabled, Step produces bit-identical results for identical inputs regardless of the worker count of
+     *        the task scheduler, so multi-threaded runs can be checked against single-threaded ones and lockstep
+     *        peers stay in sync. Backends may give up some parallel load balancing for it. Disabled by default.
+     * @param enabled True to make stepping independent of the worker count.
+     */
+    virtual void SetDeterministic(bool enabled) = 0;
+
+    /**
+     * @brief Gets a hash of the simulation history, updated by every fixed step.
+     *        Each fixed step chains a hash of the state of its awake bodies onto the previous value, so two worlds
+     *        report equal hashes only if they went through the same states. Sleeping bodies do not change and cost
+     *        nothing. Snapshots save and restore the hash.
+     * @return The hash after the last fixed step, 0 before the first.
+     */
+    virtual uint64_t GetStateHash() const = 0;
+
+    /**
+     * @brief Saves the complete simulation state into a caller-provided buffer, for rollback and forked simulations.
+     *        Call with a null buffer to get the required size. The layout is backend specific and only meant for
+     *        RestoreSnapshot on the same world or one of the same backend holding the same bodies.
+     * @param buffer The destination, or nullptr to only measure.
+     * @param capacity The size of buffer in bytes.
+     * @return The snapshot size in bytes. If it exceeds capacity, nothing usable was written.
+     */
+    virtual size_t SaveSnapshot(void *buffer, size_t capacity) = 0;
+
+    /**
+     * @brief Restores a state saved by SaveSnapshot.
+     *        Bodies are matched by id: the world must contain exactly the bodies it contained when the snapshot was
+     *        saved. Afterwards every body counts as moved for ReadBodyStates.
+     * @param snapshot The snapshot.
+     * @param size The size of the snapshot in bytes.
+     * @return False if the snapshot is invalid or its bodies differ from the world's; the world is unchanged then.
      */
-    virtual std::unique_ptr<IPhysicsBody> CreatePhysicsBody() = 0;
+    virtual bool RestoreSnapshot(const void *snapshot, size_t size) = 0;
 };
 
 } // namespace PAL
@@ -0,0 +1,207 @@
+/**
+ * @file pal_types.h
+ * @brief Defines common types and enums shared by the Physics Abstraction Layer interfaces and backends.
+ */
+#ifndef PIECE_PAL_PAL_TYPES_H_
+#define PIECE_PAL_PAL_TYPES_H_
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+
+namespace Piece
+{
+namespace PAL
+{
+
+/**
+ * @brief How a body takes part in the simulation.
+ */
+enum class BodyType : uint8_t
+{
+    Static = 0,    /**< Never moves, infinite mass. */
+    Kinematic = 1, /**< Moved by its velocity only, unaffected by forces and contacts. */
+    Dynamic = 2    /**< Fully simulated. */
+};
+
+/**
+ * @brief The collision shape of a body.
+ */
+enum class ColliderShapeType : uint8_t
+{
+    None = 0,   /**< No collider; the body does not collide. */
+    Box = 1,    /**< Box described by RigidBodyCreationInfo::half_extents. */
+    Sphere = 2  /**< Sphere described by RigidBodyCreationInfo::radius. */
+};
+
+/** @brief Identifies a body within its world. Ids of destroyed bodies may be reused. */
+using BodyId = uint32_t;
+
+/** @brief A BodyId that never refers to a body. */
+constexpr BodyId kInvalidBodyId = 0xFFFFFFFFu;
+
+/**
+ * @brief Caller-owned structure-of-arrays buffers for bulk body state transfers.
+ * @details Element i of every array describes the body ids[i]. Any array except ids may be nullptr to skip that
+ *          attribute. Two-dimensional backends read and write the XY plane and the rotation about Z.
+ */
+struct BodyStateArrays
+{
+    /** @brief Body ids. */
+    BodyId *ids = nullptr;
+    /** @brief World-space positions. */
+    glm::vec3 *positions = nullptr;
+    /** @brief Rotations. */
+    glm::quat *rotations = nullptr;
+    /** @brief Linear velocities. */
+    glm::vec3 *linear_velocities = nullptr;
+    /** @brief Angular velocities. */
+    glm::vec3 *angular_velocities = nullptr;
+};
+
+/**
+ * @brief Describes a rigid body and its collider for IPhysicsWorld::CreatePhysicsBody.
+ * @details Two-dimensional backends use the XY plane and the rotation about Z.
+ */
+struct RigidBodyCreationInfo
+{
+    /** @brief How the body is simulated. */
+    BodyType body_type = BodyType::Dynamic;
+    /** @brief The initial position in world space. */
+    glm::vec3 position = glm::vec3(0.0f);
+    /** @brief The initial rotation. */
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    /** @brief The initial linear velocity. */
+    glm::vec3 linear_velocity = glm::vec3(0.0f);
+    /** @brief The collider shape. */
+    ColliderShapeType shape = ColliderShapeType::Box;
+    /** @brief Half size of a box collider along each axis. */
+    glm::vec3 half_extents = glm::vec3(0.5f);
+    /** @brief Radius of a sphere collider. */
+    float radius = 0.5f;
+    /** @brief Mass per unit volume (per unit area in 2D). */
+    float density = 1.0f;
+    /** @brief Coulomb friction coefficient. */
+    float friction = 0.6f;
+    /** @brief Bounciness, 0 for none and 1 for perfectly elastic. */
+    float restitution = 0.0f;
+    /** @brief Whether the body starts awake. A body created asleep is woken by contact like any sleeping body. */
+    bool is_awake = true;
+    /** @brief Whether the body may fall asleep. Bodies that must react to every frame, such as players, opt out. */
+    bool enable_sleep = true;
+    /** @brief Speed in units per second below which the body counts as resting and may fall asleep. */
+    float sleep_threshold = 0.05f;
+    /** @brief Whether the collider is a sensor, which reports bodies entering and leaving it but does not collide. */
+    bool is_sensor = false;
+};
+
+/**
+ * @brief A ray for IPhysicsWorld::CastRays.
+ */
+struct RayCastInput
+{
+    /** @brief The start point in world space. Colliders containing it are not reported. */
+    glm::vec3 origin = glm::vec3(0.0f);
+    /** @brief The unit-length direction. */
+    glm::vec3 direction = glm::vec3(1.0f, 0.0f, 0.0f);
+    /** @brief The length of the ray. */
+    float max_distance = 1.0f;
+};
+
+/**
+ * @brief A collider swept along a direction for IPhysicsWorld::CastShapes.
+ */
+struct ShapeCastInput
+{
+    /** @brief The swept shape, ColliderShapeType::Box or ColliderShapeType::Sphere. */
+    ColliderShapeType shape = ColliderShapeType::Sphere;
+    /** @brief Half size of a box along each axis. */
+    glm::vec3 half_extents = glm::vec3(0.5f);
+    /** @brief Radius of a sphere. */
+    float radius = 0.5f;
+    /** @brief The start position of the shape's center. */
+    glm::vec3 origin = glm::vec3(0.0f);
+    /** @brief The unit-length sweep direction. */
+    glm::vec3 direction = glm::vec3(1.0f, 0.0f, 0.0f);
+    /** @brief The sweep length. */
+    float max_distance = 1.0f;
+};
+
+/**
+ * @brief The closest hit of a ray or shape cast.
+ */
+struct RayCastHit
+{
+    /** @brief The body hit, or kInvalidBodyId if nothing was hit. */
+    BodyId body = kInvalidBodyId;
+    /** @brief The distance along the direction to the hit. */
+    float distance = 0.0f;
+    /** @brief The hit point of a ray, or the center of a cast shape at the time of impact. */
+    glm::vec3 point = glm::vec3(0.0f);
+    /** @brief The surface normal at the hit, pointing against the direction of travel. */
+    glm::vec3 normal = glm::vec3(0.0f);
+};
+
+/**
+ * @brief A collider placed in the world for IPhysicsWorld::QueryOverlaps.
+ */
+struct OverlapInput
+{
+    /** @brief The shape, ColliderShapeType::Box or ColliderShapeType::Sphere. */
+    ColliderShapeType shape = ColliderShapeType::Sphere;
+    /** @brief The center in world space. */
+    glm::vec3 center = glm::vec3(0.0f);
+    /** @brief Half size of a box along each axis. */
+    glm::vec3 half_extents = glm::vec3(0.5f);
+    /** @brief Radius of a sphere. */
+    float radius = 0.5f;
+};
+
+/**
+ * @brief The kinds of contact events.
+ */
+enum class ContactEventType : uint32_t
+{
+    Begin = 0,       /**< Two colliders started touching. */
+    Persist = 1,     /**< Two colliders are still touching after another step. Only reported when enabled. */
+    End = 2,         /**< Two colliders stopped touching, or one of them was destroyed. */
+    SensorBegin = 3, /**< A body entered a sensor. */
+    SensorEnd = 4    /**< A body left a sensor, or one of them was destroyed. */
+};
+
+/**
+ * @brief A contact event, written by the backend during IPhysicsWorld::Step and read in bulk afterwards.
+ * @details A plain record with a fixed layout, so batches can be copied across the native boundary as they are.
+ */
+struct ContactEvent
+{
+    /** @brief The kind of event. */
+    ContactEventType type = ContactEventType::Begin;
+    /** @brief The first body; the sensor for sensor events. */
+    BodyId body_a = kInvalidBodyId;
+    /** @brief The second body; the visiting body for sensor events. */
+    BodyId body_b = kInvalidBodyId;
+    /** @brief A point of the contact in world space, zero where the backend does not report one. */
+    glm::vec3 point = glm::vec3(0.0f);
+    /** @brief The contact normal pointing from body_a to body_b, zero where the backend does not report one. */
+    glm::vec3 normal = glm::vec3(0.0f);
+    /** @brief The speed at which the bodies approached along the normal, for Begin events where measured. */
+    float approach_speed = 0.0f;
+};
+
+/**
+ * @brief Settings for contact event reporting, see IPhysicsWorld::ConfigureContactEvents.
+ */
+struct ContactEventOptions
+{
+    /** @brief The number of events buffered between reads; 0 turns reporting off. */
+    uint32_t capacity = 0;
+    /** @brief Whether touching pairs report a Persist event every fixed step. */
+    bool report_persist = false;
+};
+
+} // namespace PAL
+} // namespace Piece
+
+#endif // PIECE_PAL_PAL_TYPES_H_
@@ -0,0 +1,201 @@
+/**
+ * @file physics_snapshot.h
+ * @brief Defines the buffer writer and reader physics backends use to implement IPhysicsWorld snapshots.
+ */
+#ifndef PIECE_PAL_PHYSICS_SNAPSHOT_H_
+#define PIECE_PAL_PHYSICS_SNAPSHOT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace Piece
+{
+namespace PAL
+{
+
+/**
+ * @brief Appends raw copies of trivially copyable data to a caller-provided buffer.
+ * @details The size is counted even when the buffer is missing or too small, so the same code path both measures
+ *          and writes a snapshot. Arrays are written as a 64-bit element count followed by the elements, which lets
+ *          structure-of-arrays state be saved with one memcpy per array.
+ */
+class PhysicsSnapshotWriter
+{
+  public:
+    /**
+     * @brief Creates a writer.
+     * @param buffer The destination, or nullptr to only measure.
+     * @param capacity The size of the destination in bytes.
+     */
+    PhysicsSnapshotWriter(void *buffer, size_t capacity) : buffer_(static_cast<uint8_t *>(buffer)), capacity_(capacity)
+    {
+    }
+
+    /**
+     * @brief Appends count elements.
+     * @param data The elements.
+     * @param count The number of elements.
+     */
+    template <typename T> void Write(const T *data, size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshots hold raw copies");
+        size_t bytes = sizeof(T) * count;
+        if (buffer_ && bytes > 0 && size_ + bytes <= capacity_)
+        {
+            std::memcpy(buffer_ + size_, data, bytes);
+        }
+        size_ += bytes;
+    }
+
+    /**
+     * @brief Appends one value.
+     * @param value The value.
+     */
+    template <typename T> void Write(const T &value)
+    {
+        Write(&value, 1);
+    }
+
+    /**
+     * @brief Appends the element count and the elements of an array.
+     * @param array The array.
+     */
+    template <typename T> void WriteArray(const std::vector<T> &array)
+    {
+        Write(static_cast<uint64_t>(array.size()));
+        Write(array.data(), array.size());
+    }
+
+    /**
+     * @brief Gets the number of bytes the snapshot needs so far.
+     * @return The size in bytes.
+     */
+    size_t GetSize() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Checks whether everything written so far fit into the buffer.
+     * @return True if the buffer holds a complete copy.
+     */
+    bool Fits() const
+    {
+        return buffer_ && size_ <= capacity_;
+    }
+
+  private:
+    uint8_t *buffer_;
+    size_t capacity_;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Reads data written by PhysicsSnapshotWriter back in the same order.
+ * @details Reading past the end of the buffer fails and every later read fails too, so callers can check
+ *          IsValid once after reading everything.
+ */
+class PhysicsSnapshotReader
+{
+  public:
+    /**
+     * @brief Creates a reader.
+     * @param buffer The snapshot.
+     * @param size The size of the snapshot in bytes.
+     */
+    PhysicsSnapshotReader(const void *buffer, size_t size)
+        : buffer_(static_cast<const uint8_t *>(buffer)), size_(buffer ? size : 0)
+    {
+    }
+
+    /**
+     * @brief Reads count elements.
+     * @param data Receives the elements.
+     * @param count The number of elements.
+     * @return False if the snapshot is too short.
+     */
+    template <typename T> bool Read(T *data, size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshots hold raw copies");
+        if (failed_ || count > (size_ - offset_) / sizeof(T))
+        {
+            failed_ = true;
+            return false;
+        }
+        size_t bytes = sizeof(T) * count;
+        if (bytes > 0)
+        {
+            std::memcpy(data, buffer_ + offset_, bytes);
+        }
+        offset_ += bytes;
+        return true;
+    }
+
+    /**
+     * @brief Reads one value.
+     * @param value Receives the value.
+     * @return False if the snapshot is too short.
+     */
+    template <typename T> bool Read(T &value)
+    {
+        return Read(&value, 1);
+    }
+
+    /**
+     * @brief Reads an array written by PhysicsSnapshotWriter::WriteArray, reusing the array's storage.
+     * @param array Receives the elements.
+     * @return False if the snapshot is too short.
+     */
+    template <typename T> bool ReadArray(std::vector<T> &array)
+    {
+        uint64_t count = 0;
+        if (!Read(count) || count > (size_ - offset_) / sizeof(T))
+        {
+            failed_ = true;
+            return false;
+        }
+        array.resize(static_cast<size_t>(count));
+        return Read(array.data(), array.size());
+    }
+
+    /**
+     * @brief Gets the number of bytes not read yet.
+     * @return The remaining size in bytes.
+     */
+    size_t GetRemaining() const
+    {
+        return size_ - offset_;
+    }
+
+    /**
+     * @brief Checks whether every read so far succeeded.
+     * @return True if no read ran past the end.
+     */
+    bool IsValid() const
+    {
+        return !failed_;
+    }
+
+    /**
+     * @brief Checks whether the whole snapshot was consumed.
+     * @return True if every read succeeded and no bytes are left.
+     */
+    bool IsComplete() const
+    {
+        return !failed_ && offset_ == size_;
+    }
+
+  private:
+    const uint8_t *buffer_;
+    size_t size_;
+    size_t offset_ = 0;
+    bool failed_ = false;
+};
+
+} // namespace PAL
+} // namespace Piece
+
+#endif // PIECE_PAL_PHYSICS_SNAPSHOT_H_
@@ -0,0 +1,81 @@
+/**
+ * @file physics_state_hash.h
+ * @brief Defines the hash functions physics backends use for IPhysicsWorld::GetStateHash.
+ */
+#ifndef PIECE_PAL_PHYSICS_STATE_HASH_H_
+#define PIECE_PAL_PHYSICS_STATE_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Piece
+{
+namespace PAL
+{
+
+/**
+ * @brief Scrambles all bits of a 64-bit value (the SplitMix64 finalizer).
+ * @param value The value.
+ * @return The mixed value.
+ */
+inline uint64_t MixStateHash(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBull;
+    value ^= value >> 31;
+    return value;
+}
+
+/**
+ * @brief Feeds raw bytes into a hash. Floats are hashed by their bit patterns, so any bit of divergence shows.
+ * @param hash The hash so far.
+ * @param data The bytes.
+ * @param size The number of bytes.
+ * @return The updated hash.
+ */
+inline uint64_t HashStateBytes(uint64_t hash, const void *data, size_t size)
+{
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t offset = 0; offset < size; offset += sizeof(uint32_t))
+    {
+        uint32_t word = 0;
+        std::memcpy(&word, bytes + offset, size - offset < sizeof(uint32_t) ? size - offset : sizeof(uint32_t));
+        hash = (hash ^ word) * 0x100000001B3ull;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+/**
+ * @brief Hashes the state of one body from values without padding bytes, such as ids, floats and vectors.
+ * @details Per-body hashes are summed into a step hash, which makes the step hash independent of the order in
+ *          which bodies are visited and lets ranges of bodies be hashed in parallel.
+ * @param values The body's state.
+ * @return The body hash.
+ */
+template <typename... Values> uint64_t HashBodyState(const Values &...values)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    ((hash = HashStateBytes(hash, &values, sizeof(Values))), ...);
+    return MixStateHash(hash);
+}
+
+/**
+ * @brief Chains the bodies of one fixed step onto the hash of the previous steps.
+ * @param previous The hash after the previous step.
+ * @param body_hash_sum The sum of HashBodyState over the bodies simulated in this step.
+ * @param body_count The number of bodies simulated in this step.
+ * @return The hash after this step.
+ */
+inline uint64_t ChainStepHash(uint64_t previous, uint64_t body_hash_sum, uint32_t body_count)
+{
+    return MixStateHash(previous ^ MixStateHash(body_hash_sum + body_count));
+}
+
+} // namespace PAL
+} // namespace Piece
+
+#endif // PIECE_PAL_PHYSICS_STATE_HASH_H_
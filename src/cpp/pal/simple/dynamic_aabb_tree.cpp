@@ -0,0 +1,270 @@
+#include "dynamic_aabb_tree.h"
+
+#include <algorithm>
+
+namespace Piece {
+    namespace PAL {
+        // Fast movers get their fat AABB stretched this many steps ahead along their displacement.
+        constexpr float kDisplacementMultiplier = 4.0f;
+
+        DynamicAabbTree::DynamicAabbTree(float margin) : margin_(margin) {}
+
+        int32_t DynamicAabbTree::CreateProxy(const Aabb &aabb, uint32_t user_data) {
+            int32_t proxy = AllocateNode();
+            nodes_[proxy].aabb = Fatten(aabb);
+            nodes_[proxy].user_data = user_data;
+            nodes_[proxy].height = 0;
+            InsertLeaf(proxy);
+            ++proxy_count_;
+            return proxy;
+        }
+
+        void DynamicAabbTree::DestroyProxy(int32_t proxy) {
+            RemoveLeaf(proxy);
+            FreeNode(proxy);
+            --proxy_count_;
+        }
+
+        bool DynamicAabbTree::MoveProxy(int32_t proxy, const Aabb &aabb, const glm::vec3 &displacement) {
+            Aabb fat = Fatten(aabb);
+            glm::vec3 stretch = kDisplacementMultiplier * displacement;
+            fat.min += glm::min(stretch, glm::vec3(0.0f));
+            fat.max += glm::max(stretch, glm::vec3(0.0f));
+
+            // Keep the leaf while it still bounds the object and has not grown much larger than it needs to,
+            // otherwise a body that stopped after moving fast would keep an oversized leaf forever.
+            const Aabb &current = nodes_[proxy].aabb;
+            if (current.Contains(aabb)) {
+                Aabb huge = fat;
+                glm::vec3 slack(4.0f * margin_);
+                huge.min -= slack;
+                huge.max += slack;
+                if (huge.Contains(current)) {
+                    return false;
+                }
+            }
+
+            RemoveLeaf(proxy);
+            nodes_[proxy].aabb = fat;
+            InsertLeaf(proxy);
+            return true;
+        }
+
+        void DynamicAabbTree::SaveSnapshot(PhysicsSnapshotWriter &writer) const {
+            writer.WriteArray(nodes_);
+            writer.Write(root_);
+            writer.Write(free_list_);
+            writer.Write(proxy_count_);
+            writer.Write(margin_);
+        }
+
+        bool DynamicAabbTree::RestoreSnapshot(PhysicsSnapshotReader &reader) {
+            reader.ReadArray(nodes_);
+            reader.Read(root_);
+            reader.Read(free_list_);
+            reader.Read(proxy_count_);
+            reader.Read(margin_);
+            return reader.IsValid();
+        }
+
+        int32_t DynamicAabbTree::AllocateNode() {
+            if (free_list_ == kNullNode) {
+                nodes_.emplace_back();
+                return static_cast<int32_t>(nodes_.size() - 1);
+            }
+            int32_t node = free_list_;
+            free_list_ = nodes_[node].parent;
+            nodes_[node] = Node();
+            return node;
+        }
+
+        void DynamicAabbTree::FreeNode(int32_t node) {
+            nodes_[node].parent = free_list_;
+            nodes_[node].height = -1;
+            free_list_ = node;
+        }
+
+        void DynamicAabbTree::InsertLeaf(int32_t leaf) {
+            if (root_ == kNullNode) {
+                root_ = leaf;
+                nodes_[root_].parent = kNullNode;
+                return;
+            }
+
+            // Descend towards the sibling that minimizes the surface area added to the tree.
+            const Aabb leaf_aabb = nodes_[leaf].aabb;
+            int32_t index = root_;
+            while (!nodes_[index].IsLeaf()) {
+                const Node &node = nodes_[index];
+                float area = node.aabb.GetArea();
+                float combined_area = Union(node.aabb, leaf_aabb).GetArea();
+                // Cost of making a new parent for this node and the leaf.
+                float cost = 2.0f * combined_area;
+                // Minimum cost of pushing the leaf further down, paid by every ancestor growing.
+                float inheritance_cost = 2.0f * (combined_area - area);
+
+                auto descend_cost = [&](int32_t child) {
+                    const Node &child_node = nodes_[child];
+                    float union_area = Union(leaf_aabb, child_node.aabb).GetArea();
+                    return child_node.IsLeaf() ? union_area + inheritance_cost
+                                               : union_area - child_node.aabb.GetArea() + inheritance_cost;
+                };
+                float cost1 = descend_cost(node.child1);
+                float cost2 = descend_cost(node.child2);
+                if (cost < cost1 && cost < cost2) {
+                    break;
+                }
+                index = cost1 < cost2 ? node.child1 : node.child2;
+            }
+
+            int32_t sibling = index;
+            int32_t old_parent = nodes_[sibling].parent;
+            int32_t new_parent = AllocateNode();
+            nodes_[new_parent].parent = old_parent;
+            nodes_[new_parent].aabb = Union(leaf_aabb, nodes_[sibling].aabb);
+            nodes_[new_parent].height = nodes_[sibling].height + 1;
+            nodes_[new_parent].child1 = sibling;
+            nodes_[new_parent].child2 = leaf;
+            nodes_[sibling].parent = new_parent;
+            nodes_[leaf].parent = new_parent;
+
+            if (old_parent == kNullNode) {
+                root_ = new_parent;
+            } else if (nodes_[old_parent].child1 == sibling) {
+                nodes_[old_parent].child1 = new_parent;
+            } else {
+                nodes_[old_parent].child2 = new_parent;
+            }
+
+            RefitAncestors(new_parent);
+        }
+
+        void DynamicAabbTree::RemoveLeaf(int32_t leaf) {
+            if (leaf == root_) {
+                root_ = kNullNode;
+                return;
+            }
+
+            int32_t parent = nodes_[leaf].parent;
+            int32_t grand_parent = nodes_[parent].parent;
+            int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+            if (grand_parent == kNullNode) {
+                root_ = sibling;
+                nodes_[sibling].parent = kNullNode;
+                FreeNode(parent);
+                return;
+            }
+
+            if (nodes_[grand_parent].child1 == parent) {
+                nodes_[grand_parent].child1 = sibling;
+            } else {
+                nodes_[grand_parent].child2 = sibling;
+            }
+            nodes_[sibling].parent = grand_parent;
+            FreeNode(parent);
+            RefitAncestors(grand_parent);
+        }
+
+        void DynamicAabbTree::RefitAncestors(int32_t index) {
+            while (index != kNullNode) {
+                index = Balance(index);
+                Node &node = nodes_[index];
+                const Node &child1 = nodes_[node.child1];
+                const Node &child2 = nodes_[node.child2];
+                node.height = 1 + std::max(child1.height, child2.height);
+                node.aabb = Union(child1.aabb, child2.aabb);
+                index = node.parent;
+            }
+        }
+
+        int32_t DynamicAabbTree::Balance(int32_t index_a) {
+            Node *a = &nodes_[index_a];
+            if (a->IsLeaf() || a->height < 2) {
+                return index_a;
+            }
+
+            int32_t index_b = a->child1;
+            int32_t index_c = a->child2;
+            Node *b = &nodes_[index_b];
+            Node *c = &nodes_[index_c];
+            int32_t balance = c->height - b->height;
+
+            // Replaces a with its child as the child of a's parent.
+            auto replace_in_parent = [&](Node *child, int32_t index_child) {
+                child->parent = a->parent;
+                a->parent = index_child;
+                if (child->parent == kNullNode) {
+                    root_ = index_child;
+                } else if (nodes_[child->parent].child1 == index_a) {
+                    nodes_[child->parent].child1 = index_child;
+                } else {
+                    nodes_[child->parent].child2 = index_child;
+                }
+            };
+
+            if (balance > 1) {
+                // Rotate c up; its taller child stays with it, the shorter one moves to a.
+                int32_t index_f = c->child1;
+                int32_t index_g = c->child2;
+                Node *f = &nodes_[index_f];
+                Node *g = &nodes_[index_g];
+                c->child1 = index_a;
+                replace_in_parent(c, index_c);
+                if (f->height > g->height) {
+                    c->child2 = index_f;
+                    a->child2 = index_g;
+                    g->parent = index_a;
+                    a->aabb = Union(b->aabb, g->aabb);
+                    c->aabb = Union(a->aabb, f->aabb);
+                    a->height = 1 + std::max(b->height, g->height);
+                    c->height = 1 + std::max(a->height, f->height);
+                } else {
+                    c->child2 = index_g;
+                    a->child2 = index_f;
+                    f->parent = index_a;
+                    a->aabb = Union(b->aabb, f->aabb);
+                    c->aabb = Union(a->aabb, g->aabb);
+                    a->height = 1 + std::max(b->height, f->height);
+                    c->height = 1 + std::max(a->height, g->height);
+                }
+                return index_c;
+            }
+
+            if (balance < -1) {
+                // Rotate b up, mirroring the case above.
+                int32_t index_d = b->child1;
+                int32_t index_e = b->child2;
+                Node *d = &nodes_[index_d];
+                Node *e = &nodes_[index_e];
+                b->child1 = index_a;
+                replace_in_parent(b, index_b);
+                if (d->height > e->height) {
+                    b->child2 = index_d;
+                    a->child1 = index_e;
+                    e->parent = index_a;
+                    a->aabb = Union(c->aabb, e->aabb);
+                    b->aabb = Union(a->aabb, d->aabb);
+                    a->height = 1 + std::max(c->height, e->height);
+                    b->height = 1 + std::max(a->height, d->height);
+                } else {
+                    b->child2 = index_e;
+                    a->child1 = index_d;
+                    d->parent = index_a;
+                    a->aabb = Union(c->aabb, d->aabb);
+                    b->aabb = Union(a->aabb, e->aabb);
+                    a->height = 1 + std::max(c->height, d->height);
+                    b->height = 1 + std::max(a->height, e->height);
+                }
+                return index_b;
+            }
+
+            return index_a;
+        }
+
+        Aabb DynamicAabbTree::Fatten(const Aabb &aabb) const {
+            glm::vec3 margin(margin_);
+            return {aabb.min - margin, aabb.max + margin};
+        }
+    }
+}
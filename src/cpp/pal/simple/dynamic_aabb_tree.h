@@ -0,0 +1,247 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <pal/physics_snapshot.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIECE_PAL_SIMPLE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace Piece {
+    namespace PAL {
+        // Axis-aligned bounding box.
+        struct Aabb {
+            glm::vec3 min = glm::vec3(0.0f);
+            glm::vec3 max = glm::vec3(0.0f);
+
+            bool Contains(const Aabb &other) const {
+                return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+                       other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+            }
+
+            bool Overlaps(const Aabb &other) const {
+                return min.x <= other.max.x && other.min.x <= max.x && min.y <= other.max.y &&
+                       other.min.y <= max.y && min.z <= other.max.z && other.min.z <= max.z;
+            }
+
+            // Surface area, the cost metric of the tree.
+            float GetArea() const {
+                glm::vec3 extent = max - min;
+                return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+            }
+        };
+
+        static_assert(sizeof(Aabb) == 6 * sizeof(float), "RaySlabTester loads Aabb as packed floats");
+
+        inline Aabb Union(const Aabb &a, const Aabb &b) {
+            return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+        }
+
+        // Precomputed ray for repeated slab tests against AABBs grown by a fixed extent.
+        // The SSE path tests all three slabs at once; both paths use the same min/max semantics so they agree.
+        class RaySlabTester {
+        public:
+            RaySlabTester(const glm::vec3 &origin, const glm::vec3 &direction, const glm::vec3 &extent)
+                : origin_(origin), extent_(extent) {
+                // Division by zero yields infinities, which the slab test handles for rays parallel to a slab.
+                inverse_direction_ = glm::vec3(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+#ifdef PIECE_PAL_SIMPLE_SSE
+                origin4_ = _mm_set_ps(0.0f, origin.z, origin.y, origin.x);
+                inverse4_ = _mm_set_ps(0.0f, inverse_direction_.z, inverse_direction_.y, inverse_direction_.x);
+                extent4_ = _mm_set_ps(0.0f, extent.z, extent.y, extent.x);
+#endif
+            }
+
+            // Returns true if the ray enters aabb before max_distance; t_enter receives the entry distance,
+            // negative when the origin is inside.
+            bool Intersect(const Aabb &aabb, float max_distance, float &t_enter) const {
+#ifdef PIECE_PAL_SIMPLE_SSE
+                // Loads stay within the 24 bytes of the box: min.xyz + max.x, and min.z + max.xyz rotated.
+                __m128 box_min = _mm_loadu_ps(&aabb.min.x);
+                __m128 tail = _mm_loadu_ps(&aabb.min.z);
+                __m128 box_max = _mm_shuffle_ps(tail, tail, _MM_SHUFFLE(0, 3, 2, 1));
+                box_min = _mm_sub_ps(box_min, extent4_);
+                box_max = _mm_add_ps(box_max, extent4_);
+                __m128 t1 = _mm_mul_ps(_mm_sub_ps(box_min, origin4_), inverse4_);
+                __m128 t2 = _mm_mul_ps(_mm_sub_ps(box_max, origin4_), inverse4_);
+                __m128 xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+                // The unused fourth lane becomes [-inf, max_distance] so it never decides the result.
+                __m128 t_near = _mm_or_ps(_mm_and_ps(xyz, _mm_min_ps(t1, t2)),
+                                          _mm_andnot_ps(xyz, _mm_set1_ps(-INFINITY)));
+                __m128 t_far = _mm_or_ps(_mm_and_ps(xyz, _mm_max_ps(t1, t2)),
+                                         _mm_andnot_ps(xyz, _mm_set1_ps(max_distance)));
+                t_near = _mm_max_ps(t_near, _mm_shuffle_ps(t_near, t_near, _MM_SHUFFLE(1, 0, 3, 2)));
+                t_near = _mm_max_ps(t_near, _mm_shuffle_ps(t_near, t_near, _MM_SHUFFLE(2, 3, 0, 1)));
+                t_far = _mm_min_ps(t_far, _mm_shuffle_ps(t_far, t_far, _MM_SHUFFLE(1, 0, 3, 2)));
+                t_far = _mm_min_ps(t_far, _mm_shuffle_ps(t_far, t_far, _MM_SHUFFLE(2, 3, 0, 1)));
+                t_enter = _mm_cvtss_f32(t_near);
+                float t_exit = _mm_cvtss_f32(t_far);
+#else
+                float t_exit = max_distance;
+                t_enter = -INFINITY;
+                for (int axis = 0; axis < 3; ++axis) {
+                    float t1 = (aabb.min[axis] - extent_[axis] - origin_[axis]) * inverse_direction_[axis];
+                    float t2 = (aabb.max[axis] + extent_[axis] - origin_[axis]) * inverse_direction_[axis];
+                    float t_near = t1 < t2 ? t1 : t2;
+                    float t_far = t1 > t2 ? t1 : t2;
+                    t_enter = t_enter > t_near ? t_enter : t_near;
+                    t_exit = t_exit < t_far ? t_exit : t_far;
+                }
+#endif
+                return t_enter <= t_exit && t_exit >= 0.0f;
+            }
+
+        private:
+            glm::vec3 origin_;
+            glm::vec3 extent_;
+            glm::vec3 inverse_direction_;
+#ifdef PIECE_PAL_SIMPLE_SSE
+            __m128 origin4_;
+            __m128 inverse4_;
+            __m128 extent4_;
+#endif
+        };
+
+        // Bounding volume hierarchy over fat AABBs, after Box2D's b2DynamicTree.
+        // Each leaf stores its object's AABB enlarged by a margin, so objects moving a little do not touch the
+        // tree at all. Leaves that leave their fat AABB are reinserted; the ancestors on the way up are refit and
+        // rebalanced with AVL-style rotations, which keeps the height logarithmic under incremental updates.
+        class DynamicAabbTree {
+        public:
+            static constexpr int32_t kNullNode = -1;
+            // Deepest traversal stack the query functions support; balanced trees stay far below it.
+            static constexpr int32_t kMaxStackSize = 256;
+
+            explicit DynamicAabbTree(float margin = 0.1f);
+
+            // Creates a leaf for a tight AABB and returns its proxy id.
+            int32_t CreateProxy(const Aabb &aabb, uint32_t user_data);
+            void DestroyProxy(int32_t proxy);
+            // Updates a proxy for its new tight AABB. The displacement of the last step extends the fat AABB in the
+            // direction of motion. Returns true if the leaf had to be reinserted.
+            bool MoveProxy(int32_t proxy, const Aabb &aabb, const glm::vec3 &displacement);
+
+            const Aabb &GetFatAabb(int32_t proxy) const { return nodes_[proxy].aabb; }
+            uint32_t GetUserData(int32_t proxy) const { return nodes_[proxy].user_data; }
+            uint32_t GetProxyCount() const { return proxy_count_; }
+            int32_t GetHeight() const { return root_ == kNullNode ? 0 : nodes_[root_].height; }
+            float GetMargin() const { return margin_; }
+
+            // Copies the whole tree, so a restored tree matches the saved one node for node.
+            void SaveSnapshot(PhysicsSnapshotWriter &writer) const;
+            bool RestoreSnapshot(PhysicsSnapshotReader &reader);
+
+            // Calls callback(proxy) for every leaf whose fat AABB overlaps aabb. Stops when callback returns false.
+            template <typename Callback>
+            void Query(const Aabb &aabb, Callback &&callback) const {
+                if (root_ == kNullNode) {
+                    return;
+                }
+                int32_t stack[kMaxStackSize];
+                int32_t count = 0;
+                stack[count++] = root_;
+                while (count > 0) {
+                    const Node &node = nodes_[stack[--count]];
+                    if (!node.aabb.Overlaps(aabb)) {
+                        continue;
+                    }
+                    if (node.IsLeaf()) {
+                        if (!callback(static_cast<int32_t>(&node - nodes_.data()))) {
+                            return;
+                        }
+                    } else if (count + 2 <= kMaxStackSize) {
+                        stack[count++] = node.child1;
+                        stack[count++] = node.child2;
+                    }
+                }
+            }
+
+            // Casts a ray against the fat AABBs grown by extent, nearest subtrees first. callback(proxy, max_distance)
+            // returns the new max_distance: the hit distance to clip the ray, max_distance to continue, or a negative
+            // value to stop.
+            template <typename Callback>
+            void RayCast(const glm::vec3 &origin, const glm::vec3 &direction, float max_distance,
+                         const glm::vec3 &extent, Callback &&callback) const {
+                if (root_ == kNullNode) {
+                    return;
+                }
+                RaySlabTester tester(origin, direction, extent);
+                struct Entry {
+                    int32_t node;
+                    float t_enter;
+                };
+                Entry stack[kMaxStackSize];
+                int32_t count = 0;
+                float t_enter;
+                if (tester.Intersect(nodes_[root_].aabb, max_distance, t_enter)) {
+                    stack[count++] = {root_, t_enter};
+                }
+                while (count > 0) {
+                    Entry entry = stack[--count];
+                    if (entry.t_enter > max_distance) {
+                        continue; // The ray was clipped since this node was pushed.
+                    }
+                    const Node &node = nodes_[entry.node];
+                    if (node.IsLeaf()) {
+                        max_distance = callback(entry.node, max_distance);
+                        if (max_distance < 0.0f) {
+                            return;
+                        }
+                        continue;
+                    }
+                    float t1, t2;
+                    bool hit1 = tester.Intersect(nodes_[node.child1].aabb, max_distance, t1);
+                    bool hit2 = tester.Intersect(nodes_[node.child2].aabb, max_distance, t2);
+                    if (count + 2 > kMaxStackSize) {
+                        continue;
+                    }
+                    // Push the farther child first so the nearer one is visited first and clips the ray early.
+                    if (hit1 && hit2) {
+                        bool first_nearer = t1 <= t2;
+                        stack[count++] = first_nearer ? Entry{node.child2, t2} : Entry{node.child1, t1};
+                        stack[count++] = first_nearer ? Entry{node.child1, t1} : Entry{node.child2, t2};
+                    } else if (hit1) {
+                        stack[count++] = {node.child1, t1};
+                    } else if (hit2) {
+                        stack[count++] = {node.child2, t2};
+                    }
+                }
+            }
+
+        private:
+            struct Node {
+                Aabb aabb;
+                // Parent for nodes in the tree, next free node for nodes in the free list.
+                int32_t parent = kNullNode;
+                int32_t child1 = kNullNode;
+                int32_t child2 = kNullNode;
+                // Leaves are 0, free nodes -1.
+                int32_t height = -1;
+                uint32_t user_data = 0;
+
+                bool IsLeaf() const { return child1 == kNullNode; }
+            };
+
+            int32_t AllocateNode();
+            void FreeNode(int32_t node);
+            void InsertLeaf(int32_t leaf);
+            void RemoveLeaf(int32_t leaf);
+            // Walks from index to the root, rebalancing and refitting every node.
+            void RefitAncestors(int32_t index);
+            // Rotates the subtree at index if its children heights differ by more than one. Returns the new root.
+            int32_t Balance(int32_t index);
+            Aabb Fatten(const Aabb &aabb) const;
+
+            std::vector<Node> nodes_;
+            int32_t root_ = kNullNode;
+            int32_t free_list_ = kNullNode;
+            uint32_t proxy_count_ = 0;
+            float margin_;
+        };
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#ifdef _WIN32
+#ifdef PAL_SIMPLE_BUILD_DLL
+#define PAL_SIMPLE_API __declspec(dllexport)
+#else
+#define PAL_SIMPLE_API __declspec(dllimport)
+#endif
+#else // Non-Windows platforms
+#ifdef PAL_SIMPLE_BUILD_DLL
+#define PAL_SIMPLE_API __attribute__((visibility("default")))
+#else
+#define PAL_SIMPLE_API
+#endif
+#endif
@@ -0,0 +1,200 @@
+#include "simple_body_store.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Piece {
+    namespace PAL {
+        constexpr float kPi = 3.14159265358979f;
+
+        BodyId SimpleBodyStore::Add(const RigidBodyCreationInfo &info) {
+            BodyId id;
+            if (!free_ids.empty()) {
+                id = free_ids.back();
+                free_ids.pop_back();
+            } else {
+                id = static_cast<BodyId>(indices.size());
+                indices.push_back(kInvalidIndex);
+            }
+            uint32_t index = GetSize();
+            indices[id] = index;
+
+            glm::vec3 extents = info.shape == ColliderShapeType::Sphere ? glm::vec3(info.radius) : info.half_extents;
+            float volume = 1.0f;
+            if (info.shape == ColliderShapeType::Box) {
+                volume = 8.0f * extents.x * extents.y * extents.z;
+            } else if (info.shape == ColliderShapeType::Sphere) {
+                volume = 4.0f / 3.0f * kPi * info.radius * info.radius * info.radius;
+            }
+            float mass = info.density * volume;
+
+            ids.push_back(id);
+            positions.push_back(info.position);
+            rotations.push_back(info.rotation);
+            linear_velocities.push_back(info.body_type == BodyType::Static ? glm::vec3(0.0f) : info.linear_velocity);
+            angular_velocities.push_back(glm::vec3(0.0f));
+            forces.push_back(glm::vec3(0.0f));
+            half_extents.push_back(extents);
+            inverse_masses.push_back(info.body_type == BodyType::Dynamic && mass > 0.0f ? 1.0f / mass : 0.0f);
+            frictions.push_back(info.friction);
+            restitutions.push_back(info.restitution);
+            types.push_back(info.body_type);
+            shapes.push_back(info.shape);
+            proxies.push_back(info.shape == ColliderShapeType::None ? DynamicAabbTree::kNullNode
+                                                                    : broadphase.CreateProxy(ComputeAabb(index), id));
+            sleep_times.push_back(0.0f);
+            sleep_thresholds.push_back(info.sleep_threshold);
+            sleep_enabled.push_back(info.enable_sleep ? 1 : 0);
+            islands.push_back(kNoIsland);
+            sensors.push_back(info.is_sensor ? 1 : 0);
+
+            if (info.body_type != BodyType::Static) {
+                Swap(index, awake_count++);
+                if (!info.is_awake) {
+                    Sleep(&id, 1);
+                }
+            }
+            return id;
+        }
+
+        void SimpleBodyStore::Remove(BodyId id) {
+            uint32_t index = Find(id);
+            if (index == kInvalidIndex) {
+                return;
+            }
+            // Bodies resting on this one must not stay asleep in mid-air.
+            Wake(index);
+            index = Find(id);
+            if (proxies[index] != DynamicAabbTree::kNullNode) {
+                broadphase.Query(broadphase.GetFatAabb(proxies[index]), [this](int32_t proxy) {
+                    Wake(Find(broadphase.GetUserData(proxy)));
+                    return true;
+                });
+            }
+            index = Find(id);
+            if (IsAwake(index)) {
+                Swap(index, --awake_count);
+                index = awake_count;
+            }
+            if (proxies[index] != DynamicAabbTree::kNullNode) {
+                broadphase.DestroyProxy(proxies[index]);
+            }
+
+            ForEachArray([index](auto &array) {
+                array[index] = array.back();
+                array.pop_back();
+            });
+
+            if (index < GetSize()) {
+                indices[ids[index]] = index;
+            }
+            indices[id] = kInvalidIndex;
+            free_ids.push_back(id);
+        }
+
+        Aabb SimpleBodyStore::ComputeAabb(uint32_t index) const {
+            return {positions[index] - half_extents[index], positions[index] + half_extents[index]};
+        }
+
+        void SimpleBodyStore::Wake(uint32_t index) {
+            if (IsAwake(index) || islands[index] == kNoIsland) {
+                return;
+            }
+            uint32_t island = islands[index];
+            for (BodyId id : island_bodies[island]) {
+                uint32_t body = Find(id);
+                woken.push_back({id, positions[body], rotations[body]});
+                islands[body] = kNoIsland;
+                sleep_times[body] = 0.0f;
+                Swap(body, awake_count++);
+            }
+            island_bodies[island].clear();
+            free_islands.push_back(island);
+        }
+
+        void SimpleBodyStore::Sleep(const BodyId *sleep_ids, uint32_t count) {
+            uint32_t island;
+            if (!free_islands.empty()) {
+                island = free_islands.back();
+                free_islands.pop_back();
+            } else {
+                island = static_cast<uint32_t>(island_bodies.size());
+                island_bodies.emplace_back();
+            }
+            island_bodies[island].assign(sleep_ids, sleep_ids + count);
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t index = Find(sleep_ids[i]);
+                Swap(index, --awake_count);
+                index = awake_count;
+                linear_velocities[index] = glm::vec3(0.0f);
+                angular_velocities[index] = glm::vec3(0.0f);
+                forces[index] = glm::vec3(0.0f);
+                islands[index] = island;
+            }
+        }
+
+        void SimpleBodyStore::WakeAll() {
+            for (const std::vector<BodyId> &bodies : island_bodies) {
+                if (!bodies.empty()) {
+                    Wake(Find(bodies.front()));
+                }
+            }
+        }
+
+        void SimpleBodyStore::Swap(uint32_t a, uint32_t b) {
+            if (a == b) {
+                return;
+            }
+            ForEachArray([a, b](auto &array) { std::swap(array[a], array[b]); });
+            indices[ids[a]] = a;
+            indices[ids[b]] = b;
+        }
+
+        void SimpleBodyStore::SaveSnapshot(PhysicsSnapshotWriter &writer) const {
+            ForEachArray([&writer](const auto &array) { writer.WriteArray(array); });
+            writer.WriteArray(indices);
+            writer.WriteArray(free_ids);
+            writer.Write(awake_count);
+            writer.Write(static_cast<uint64_t>(island_bodies.size()));
+            for (const std::vector<BodyId> &bodies : island_bodies) {
+                writer.WriteArray(bodies);
+            }
+            writer.WriteArray(free_islands);
+            broadphase.SaveSnapshot(writer);
+        }
+
+        bool SimpleBodyStore::RestoreSnapshot(PhysicsSnapshotReader &reader) {
+            ForEachArray([&reader](auto &array) { reader.ReadArray(array); });
+            reader.ReadArray(indices);
+            reader.ReadArray(free_ids);
+            reader.Read(awake_count);
+            uint64_t island_count = 0;
+            // Every island array takes at least its 8-byte count, which bounds a corrupt island count.
+            if (!reader.Read(island_count) || island_count > reader.GetRemaining() / sizeof(uint64_t)) {
+                return false;
+            }
+            island_bodies.resize(static_cast<size_t>(island_count));
+            for (std::vector<BodyId> &bodies : island_bodies) {
+                reader.ReadArray(bodies);
+            }
+            reader.ReadArray(free_islands);
+            woken.clear();
+            if (!broadphase.RestoreSnapshot(reader)) {
+                return false;
+            }
+            // All arrays must describe the same bodies, and the sparse table must point back at them.
+            bool consistent = awake_count <= GetSize();
+            ForEachArray([&](const auto &array) { consistent = consistent && array.size() == ids.size(); });
+            for (uint32_t i = 0; consistent && i < GetSize(); ++i) {
+                consistent = Find(ids[i]) == i;
+            }
+            return consistent;
+        }
+
+        void SimpleBodyStore::UpdateProxy(uint32_t index, const glm::vec3 &displacement) {
+            if (proxies[index] != DynamicAabbTree::kNullNode) {
+                broadphase.MoveProxy(proxies[index], ComputeAabb(index), displacement);
+            }
+        }
+    }
+}
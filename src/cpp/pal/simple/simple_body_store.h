@@ -0,0 +1,126 @@
+#pragma once
+
+#include <pal/pal_types.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "dynamic_aabb_tree.h"
+
+namespace Piece {
+    namespace PAL {
+        // Rigid body state of the simple backend as a structure of arrays.
+        // The arrays are dense: body i of a step lives at index i of every array, and destroying a body moves the
+        // last body into its slot. Stable BodyIds map to dense indices through a sparse table.
+        // Awake bodies are kept in front: [0, awake_count) holds the bodies the solver simulates, the rest are
+        // static or asleep and cost nothing per step. Waking and sleeping swap bodies across that boundary.
+        struct SimpleBodyStore {
+            static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+            static constexpr uint32_t kNoIsland = 0xFFFFFFFFu;
+
+            // Transform of a body at some point in time, used to tell whether it moved since.
+            struct BodyTransform {
+                BodyId id;
+                glm::vec3 position;
+                glm::quat rotation;
+            };
+
+            std::vector<BodyId> ids;
+            std::vector<glm::vec3> positions;
+            std::vector<glm::quat> rotations;
+            std::vector<glm::vec3> linear_velocities;
+            std::vector<glm::vec3> angular_velocities;
+            // Forces accumulated since the last step.
+            std::vector<glm::vec3> forces;
+            // Collider half size; spheres store their radius on every axis.
+            std::vector<glm::vec3> half_extents;
+            // 0 for static and kinematic bodies.
+            std::vector<float> inverse_masses;
+            std::vector<float> frictions;
+            std::vector<float> restitutions;
+            std::vector<BodyType> types;
+            std::vector<ColliderShapeType> shapes;
+            // Broadphase leaf, or DynamicAabbTree::kNullNode for bodies without a collider.
+            std::vector<int32_t> proxies;
+            // Time the body has been resting below its sleep threshold.
+            std::vector<float> sleep_times;
+            std::vector<float> sleep_thresholds;
+            std::vector<uint8_t> sleep_enabled;
+            // Sleeping island of the body, kNoIsland while awake and for static bodies.
+            std::vector<uint32_t> islands;
+            // Sensors report overlaps but take no part in contact response, islands or waking.
+            std::vector<uint8_t> sensors;
+
+            uint32_t awake_count = 0;
+            // Bodies of each sleeping island by island id; empty for free ids.
+            std::vector<std::vector<BodyId>> island_bodies;
+            std::vector<uint32_t> free_islands;
+            // Bodies woken since the world last cleared the list, with their transform at that time.
+            std::vector<BodyTransform> woken;
+
+            // Dense index by BodyId, kInvalidIndex for unused ids.
+            std::vector<uint32_t> indices;
+            std::vector<BodyId> free_ids;
+
+            DynamicAabbTree broadphase;
+
+            uint32_t GetSize() const { return static_cast<uint32_t>(ids.size()); }
+            uint32_t Find(BodyId id) const { return id < indices.size() ? indices[id] : kInvalidIndex; }
+
+            BodyId Add(const RigidBodyCreationInfo &info);
+            void Remove(BodyId id);
+            // Tight world-space AABB of the collider at index. Colliders are axis-aligned; rotation is ignored.
+            Aabb ComputeAabb(uint32_t index) const;
+            // Refreshes the broadphase leaf of the body at index after it moved by displacement.
+            void UpdateProxy(uint32_t index, const glm::vec3 &displacement);
+
+            bool IsAwake(uint32_t index) const { return index < awake_count; }
+            // Wakes the sleeping island of the body at index. Only moves bodies at or after awake_count, so the
+            // indices of awake bodies stay valid.
+            void Wake(uint32_t index);
+            // Puts the given awake bodies to sleep as one island, zeroing their velocities.
+            void Sleep(const BodyId *sleep_ids, uint32_t count);
+            void WakeAll();
+            // Exchanges two bodies in every array.
+            void Swap(uint32_t a, uint32_t b);
+
+            // Saves everything but the woken list, which only matters within a step.
+            void SaveSnapshot(PhysicsSnapshotWriter &writer) const;
+            // Replaces the contents of this store with a saved one, reusing its storage.
+            bool RestoreSnapshot(PhysicsSnapshotReader &reader);
+
+            // Calls function(array) for every per-body array.
+            template <typename Function>
+            void ForEachArray(Function &&function) {
+                VisitArrays(*this, function);
+            }
+            template <typename Function>
+            void ForEachArray(Function &&function) const {
+                VisitArrays(*this, function);
+            }
+
+        private:
+            template <typename Store, typename Function>
+            static void VisitArrays(Store &store, Function &function) {
+                function(store.ids);
+                function(store.positions);
+                function(store.rotations);
+                function(store.linear_velocities);
+                function(store.angular_velocities);
+                function(store.forces);
+                function(store.half_extents);
+                function(store.inverse_masses);
+                function(store.frictions);
+                function(store.restitutions);
+                function(store.types);
+                function(store.shapes);
+                function(store.proxies);
+                function(store.sleep_times);
+                function(store.sleep_thresholds);
+                function(store.sleep_enabled);
+                function(store.islands);
+                function(store.sensors);
+            }
+        };
+    }
+}
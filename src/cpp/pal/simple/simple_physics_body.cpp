@@ -0,0 +1,68 @@
+#include "simple_physics_body.h"
+
+#include <utility>
+
+namespace Piece {
+    namespace PAL {
+        SimpleBody::SimpleBody(std::shared_ptr<SimpleBodyStore> store, BodyId id) : store_(std::move(store)), id_(id) {}
+
+        SimpleBody::~SimpleBody() { store_->Remove(id_); }
+
+        void SimpleBody::SetPosition(const glm::vec3 &position) {
+            uint32_t index = GetIndex();
+            store_->positions[index] = position;
+            store_->UpdateProxy(index, glm::vec3(0.0f));
+        }
+
+        glm::vec3 SimpleBody::GetPosition() const { return store_->positions[GetIndex()]; }
+
+        void SimpleBody::SetRotation(const glm::quat &rotation) { store_->rotations[GetIndex()] = rotation; }
+
+        glm::quat SimpleBody::GetRotation() const { return store_->rotations[GetIndex()]; }
+
+        void SimpleBody::ApplyForce(const glm::vec3 &force) { store_->forces[WakeAndGetIndex()] += force; }
+
+        void SimpleBody::ApplyImpulse(const glm::vec3 &impulse) {
+            uint32_t index = WakeAndGetIndex();
+            store_->linear_velocities[index] += impulse * store_->inverse_masses[index];
+        }
+
+        void SimpleBody::SetLinearVelocity(const glm::vec3 &velocity) {
+            uint32_t index = velocity != glm::vec3(0.0f) ? WakeAndGetIndex() : GetIndex();
+            if (store_->types[index] != BodyType::Static) {
+                store_->linear_velocities[index] = velocity;
+            }
+        }
+
+        glm::vec3 SimpleBody::GetLinearVelocity() const { return store_->linear_velocities[GetIndex()]; }
+
+        void SimpleBody::SetAngularVelocity(const glm::vec3 &velocity) {
+            uint32_t index = velocity != glm::vec3(0.0f) ? WakeAndGetIndex() : GetIndex();
+            if (store_->types[index] != BodyType::Static) {
+                store_->angular_velocities[index] = velocity;
+            }
+        }
+
+        glm::vec3 SimpleBody::GetAngularVelocity() const { return store_->angular_velocities[GetIndex()]; }
+
+        void SimpleBody::SetAwake(bool awake) {
+            uint32_t index = GetIndex();
+            if (awake) {
+                store_->Wake(index);
+            } else if (store_->IsAwake(index)) {
+                store_->Sleep(&id_, 1);
+            }
+        }
+
+        bool SimpleBody::IsAwake() const { return store_->IsAwake(GetIndex()); }
+
+        void SimpleBody::SetSleepThreshold(float threshold) { store_->sleep_thresholds[GetIndex()] = threshold; }
+
+        float SimpleBody::GetSleepThreshold() const { return store_->sleep_thresholds[GetIndex()]; }
+
+        uint32_t SimpleBody::WakeAndGetIndex() {
+            store_->Wake(GetIndex());
+            return GetIndex();
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <pal/iphysics_body.h>
+
+#include <memory>
+
+#include "simple_body_store.h"
+
+namespace Piece {
+    namespace PAL {
+        // Handle to a body in a SimpleBodyStore. Shares ownership of the store, so bodies may outlive their world;
+        // destroying the handle removes the body.
+        class SimpleBody : public IPhysicsBody {
+        public:
+            SimpleBody(std::shared_ptr<SimpleBodyStore> store, BodyId id);
+            ~SimpleBody() override;
+
+            SimpleBody(const SimpleBody &) = delete;
+            SimpleBody &operator=(const SimpleBody &) = delete;
+
+            // IPhysicsBody interface
+            BodyId GetId() const override { return id_; }
+            void SetPosition(const glm::vec3 &position) override;
+            glm::vec3 GetPosition() const override;
+            void SetRotation(const glm::quat &rotation) override;
+            glm::quat GetRotation() const override;
+            void ApplyForce(const glm::vec3 &force) override;
+            void ApplyImpulse(const glm::vec3 &impulse) override;
+            void SetLinearVelocity(const glm::vec3 &velocity) override;
+            glm::vec3 GetLinearVelocity() const override;
+            void SetAngularVelocity(const glm::vec3 &velocity) override;
+            glm::vec3 GetAngularVelocity() const override;
+            void SetAwake(bool awake) override;
+            bool IsAwake() const override;
+            void SetSleepThreshold(float threshold) override;
+            float GetSleepThreshold() const override;
+
+        private:
+            uint32_t GetIndex() const { return store_->Find(id_); }
+            // Wakes the body's island and returns the body's index afterwards.
+            uint32_t WakeAndGetIndex();
+
+            std::shared_ptr<SimpleBodyStore> store_;
+            BodyId id_;
+        };
+    }
+}
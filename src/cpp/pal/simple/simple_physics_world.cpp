@@ -0,0 +1,815 @@
+#include "simple_physics_world.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+#include <pal/physics_state_hash.h>
+
+#include "simple_physics_body.h"
+
+namespace Piece {
+    namespace PAL {
+        // Penetration left uncorrected so resting contacts stay touching instead of jittering.
+        constexpr float kLinearSlop = 0.005f;
+        // Fraction of the remaining penetration removed per sub-step.
+        constexpr float kPositionCorrection = 0.4f;
+        // Approach speed below which contacts do not bounce.
+        constexpr float kRestitutionThreshold = 1.0f;
+        // Time an island must rest before it falls asleep, as in Box2D.
+        constexpr float kTimeToSleep = 0.5f;
+        // Identifies snapshots of this backend and their layout.
+        constexpr uint32_t kSnapshotFormat = 0x31504D53; // "SMP1"
+        // Queries per scheduler sub-range; small enough to balance, large enough to amortize the dispatch.
+        constexpr uint32_t kQueryBatchSize = 64;
+        // Bodies per sub-range for the broadphase pass and the integration loops.
+        constexpr uint32_t kPairBatchSize = 64;
+        constexpr uint32_t kIntegrateBatchSize = 256;
+
+        namespace {
+            // Contact between two axis-aligned colliders. normal points from a to b; depth is positive when they
+            // overlap.
+            bool Collide(const SimpleBodyStore &store, uint32_t a, uint32_t b, glm::vec3 &normal, float &depth) {
+                const glm::vec3 &pa = store.positions[a];
+                const glm::vec3 &pb = store.positions[b];
+                const glm::vec3 &ha = store.half_extents[a];
+                const glm::vec3 &hb = store.half_extents[b];
+                bool sphere_a = store.shapes[a] == ColliderShapeType::Sphere;
+                bool sphere_b = store.shapes[b] == ColliderShapeType::Sphere;
+
+                if (sphere_a && sphere_b) {
+                    glm::vec3 delta = pb - pa;
+                    float distance = glm::length(delta);
+                    depth = ha.x + hb.x - distance;
+                    normal = distance > 1e-6f ? delta / distance : glm::vec3(0.0f, 1.0f, 0.0f);
+                    return depth > 0.0f;
+                }
+
+                if (sphere_a || sphere_b) {
+                    // Sphere against box; solved from the sphere's side and flipped if the sphere is b.
+                    const glm::vec3 &center = sphere_a ? pa : pb;
+                    const glm::vec3 &box_center = sphere_a ? pb : pa;
+                    const glm::vec3 &box_extents = sphere_a ? hb : ha;
+                    float radius = sphere_a ? ha.x : hb.x;
+
+                    glm::vec3 local = center - box_center;
+                    glm::vec3 closest = glm::clamp(local, -box_extents, box_extents);
+                    glm::vec3 delta = closest - local;
+                    float distance = glm::length(delta);
+                    if (distance > 1e-6f) {
+                        normal = delta / distance;
+                        depth = radius - distance;
+                    } else {
+                        // Center inside the box: push out through the nearest face.
+                        glm::vec3 face_distance = box_extents - glm::abs(local);
+                        int axis = face_distance.x < face_distance.y ? (face_distance.x < face_distance.z ? 0 : 2)
+                                                                     : (face_distance.y < face_distance.z ? 1 : 2);
+                        normal = glm::vec3(0.0f);
+                        normal[axis] = local[axis] < 0.0f ? 1.0f : -1.0f;
+                        depth = radius + face_distance[axis];
+                    }
+                    if (!sphere_a) {
+                        normal = -normal;
+                    }
+                    return depth > 0.0f;
+                }
+
+                // Box against box: separate along the axis of least overlap.
+                glm::vec3 delta = pb - pa;
+                glm::vec3 overlap = ha + hb - glm::abs(delta);
+                if (overlap.x <= 0.0f || overlap.y <= 0.0f || overlap.z <= 0.0f) {
+                    return false;
+                }
+                int axis = overlap.x < overlap.y ? (overlap.x < overlap.z ? 0 : 2) : (overlap.y < overlap.z ? 1 : 2);
+                normal = glm::vec3(0.0f);
+                normal[axis] = delta[axis] < 0.0f ? -1.0f : 1.0f;
+                depth = overlap[axis];
+                return true;
+            }
+
+            // Ray against the box center +- extent. Boxes containing the origin are not hit.
+            bool RayBox(const glm::vec3 &origin, const glm::vec3 &direction, float max_distance,
+                        const glm::vec3 &center, const glm::vec3 &extent, float &distance, glm::vec3 &normal) {
+                float t_enter = -INFINITY;
+                float t_exit = max_distance;
+                int enter_axis = -1;
+                for (int axis = 0; axis < 3; ++axis) {
+                    float box_min = center[axis] - extent[axis];
+                    float box_max = center[axis] + extent[axis];
+                    if (std::fabs(direction[axis]) < 1e-12f) {
+                        if (origin[axis] < box_min || origin[axis] > box_max) {
+                            return false;
+                        }
+                        continue;
+                    }
+                    float inverse = 1.0f / direction[axis];
+                    float t1 = (box_min - origin[axis]) * inverse;
+                    float t2 = (box_max - origin[axis]) * inverse;
+                    if (t1 > t2) {
+                        std::swap(t1, t2);
+                    }
+                    if (t1 > t_enter) {
+                        t_enter = t1;
+                        enter_axis = axis;
+                    }
+                    t_exit = std::min(t_exit, t2);
+                    if (t_enter > t_exit) {
+                        return false;
+                    }
+                }
+                if (enter_axis < 0 || t_enter < 0.0f) {
+                    return false;
+                }
+                distance = t_enter;
+                normal = glm::vec3(0.0f);
+                normal[enter_axis] = direction[enter_axis] > 0.0f ? -1.0f : 1.0f;
+                return true;
+            }
+
+            // Ray against a sphere. Spheres containing the origin are not hit.
+            bool RaySphere(const glm::vec3 &origin, const glm::vec3 &direction, float max_distance,
+                           const glm::vec3 &center, float radius, float &distance, glm::vec3 &normal) {
+                glm::vec3 offset = origin - center;
+                float b = glm::dot(offset, direction);
+                float c = glm::dot(offset, offset) - radius * radius;
+                if (c <= 0.0f || b > 0.0f) {
+                    return false;
+                }
+                float discriminant = b * b - c;
+                if (discriminant < 0.0f) {
+                    return false;
+                }
+                float t = -b - std::sqrt(discriminant);
+                if (t > max_distance) {
+                    return false;
+                }
+                distance = t;
+                normal = glm::normalize(origin + direction * t - center);
+                return true;
+            }
+
+            float DistanceSquaredToBox(const glm::vec3 &point, const glm::vec3 &center, const glm::vec3 &extent) {
+                glm::vec3 local = point - center;
+                glm::vec3 outside = local - glm::clamp(local, -extent, extent);
+                return glm::dot(outside, outside);
+            }
+        }
+
+        SimplePhysicsWorld::SimplePhysicsWorld(const Core::NativePhysicsOptions &options)
+            : store_(std::make_shared<SimpleBodyStore>()),
+              fixed_delta_time_(options.fixed_delta_time > 0.0f ? options.fixed_delta_time : 1.0f / 60.0f),
+              max_steps_(std::max(options.max_physics_steps, 1u)),
+              sub_step_count_(std::max(options.sub_step_count, 1u)) {}
+
+        void SimplePhysicsWorld::SetTaskScheduler(IPhysicsTaskScheduler *scheduler) {
+            if (initialized_) {
+                std::cerr << "SimplePhysicsWorld: SetTaskScheduler must be called before Init, ignoring." << std::endl;
+                return;
+            }
+            scheduler_ = scheduler;
+        }
+
+        void SimplePhysicsWorld::Init() {
+            uint32_t workers = scheduler_ ? std::max(scheduler_->GetWorkerCount(), 1u) : 1u;
+            worker_pairs_.resize(workers);
+            worker_wakes_.resize(workers);
+            initialized_ = true;
+        }
+
+        void SimplePhysicsWorld::Step(float delta_time) {
+            if (!initialized_) {
+                return;
+            }
+            SimpleBodyStore &store = *store_;
+            step_start_.clear();
+            for (uint32_t i = 0; i < store.awake_count; ++i) {
+                step_start_.push_back({store.ids[i], store.positions[i], store.rotations[i]});
+            }
+            store.woken.clear();
+
+            accumulator_ += delta_time;
+            uint32_t steps = 0;
+            while (accumulator_ >= fixed_delta_time_ && steps < max_steps_) {
+                StepFixed(fixed_delta_time_);
+                accumulator_ -= fixed_delta_time_;
+                ++steps;
+            }
+            // When the step budget runs out, drop the backlog instead of letting it grow every frame.
+            accumulator_ = std::min(accumulator_, fixed_delta_time_);
+
+            moved_bodies_.clear();
+            auto collect_moved = [&](const SimpleBodyStore::BodyTransform &start) {
+                uint32_t index = store.Find(start.id);
+                if (index != SimpleBodyStore::kInvalidIndex &&
+                    (store.positions[index] != start.position || store.rotations[index] != start.rotation)) {
+                    moved_bodies_.push_back(start.id);
+                }
+            };
+            std::for_each(step_start_.begin(), step_start_.end(), collect_moved);
+            if (!store.woken.empty()) {
+                // A body that fell asleep and was woken again within this Step is listed twice.
+                std::for_each(store.woken.begin(), store.woken.end(), collect_moved);
+                std::sort(moved_bodies_.begin(), moved_bodies_.end());
+                moved_bodies_.erase(std::unique(moved_bodies_.begin(), moved_bodies_.end()), moved_bodies_.end());
+            }
+        }
+
+        std::unique_ptr<IPhysicsBody> SimplePhysicsWorld::CreatePhysicsBody(const RigidBodyCreationInfo &info) {
+            if (!initialized_) {
+                std::cerr << "SimplePhysicsWorld: CreatePhysicsBody called before Init." << std::endl;
+                return nullptr;
+            }
+            return std::make_unique<SimpleBody>(store_, store_->Add(info));
+        }
+
+        uint32_t SimplePhysicsWorld::GetBodyCount() const { return store_->GetSize(); }
+
+        uint32_t SimplePhysicsWorld::GetAwakeBodyCount() const { return store_->awake_count; }
+
+        void SimplePhysicsWorld::SetSleepingEnabled(bool enabled) {
+            sleeping_enabled_ = enabled;
+            if (!enabled) {
+                store_->WakeAll();
+            }
+        }
+
+        void SimplePhysicsWorld::SetDeterministic(bool enabled) { deterministic_ = enabled; }
+
+        uint64_t SimplePhysicsWorld::GetStateHash() const { return state_hash_; }
+
+        uint32_t SimplePhysicsWorld::ReadBodyStates(const BodyStateArrays &states, uint32_t capacity, bool moved_only) {
+            if (!states.ids) {
+                return 0;
+            }
+            const SimpleBodyStore &store = *store_;
+            if (!moved_only) {
+                // The store is already laid out as arrays, so a full read is a handful of bulk copies.
+                uint32_t count = std::min(capacity, store.GetSize());
+                std::copy_n(store.ids.begin(), count, states.ids);
+                if (states.positions) {
+                    std::copy_n(store.positions.begin(), count, states.positions);
+                }
+                if (states.rotations) {
+                    std::copy_n(store.rotations.begin(), count, states.rotations);
+                }
+                if (states.linear_velocities) {
+                    std::copy_n(store.linear_velocities.begin(), count, states.linear_velocities);
+                }
+                if (states.angular_velocities) {
+                    std::copy_n(store.angular_velocities.begin(), count, states.angular_velocities);
+                }
+                return count;
+            }
+
+            uint32_t written = 0;
+            for (size_t i = 0; i < moved_bodies_.size() && written < capacity; ++i) {
+                uint32_t index = store.Find(moved_bodies_[i]);
+                if (index == SimpleBodyStore::kInvalidIndex) {
+                    continue;
+                }
+                states.ids[written] = moved_bodies_[i];
+                if (states.positions) {
+                    states.positions[written] = store.positions[index];
+                }
+                if (states.rotations) {
+                    states.rotations[written] = store.rotations[index];
+                }
+                if (states.linear_velocities) {
+                    states.linear_velocities[written] = store.linear_velocities[index];
+                }
+                if (states.angular_velocities) {
+                    states.angular_velocities[written] = store.angular_velocities[index];
+                }
+                ++written;
+            }
+            return written;
+        }
+
+        void SimplePhysicsWorld::WriteBodyStates(const BodyStateArrays &states, uint32_t count) {
+            if (!states.ids) {
+                return;
+            }
+            SimpleBodyStore &store = *store_;
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t index = store.Find(states.ids[i]);
+                if (index == SimpleBodyStore::kInvalidIndex) {
+                    continue;
+                }
+                if ((states.linear_velocities && states.linear_velocities[i] != glm::vec3(0.0f)) ||
+                    (states.angular_velocities && states.angular_velocities[i] != glm::vec3(0.0f))) {
+                    store.Wake(index);
+                    index = store.Find(states.ids[i]);
+                }
+                if (states.positions) {
+                    store.positions[index] = states.positions[i];
+                    store.UpdateProxy(index, glm::vec3(0.0f));
+                }
+                if (states.rotations) {
+                    store.rotations[index] = states.rotations[i];
+                }
+                if (store.types[index] == BodyType::Static) {
+                    continue;
+                }
+                if (states.linear_velocities) {
+                    store.linear_velocities[index] = states.linear_velocities[i];
+                }
+                if (states.angular_velocities) {
+                    store.angular_velocities[index] = states.angular_velocities[i];
+                }
+            }
+        }
+
+        void SimplePhysicsWorld::ApplyImpulses(const BodyId *ids, const glm::vec3 *impulses, uint32_t count) {
+            SimpleBodyStore &store = *store_;
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t index = store.Find(ids[i]);
+                if (index == SimpleBodyStore::kInvalidIndex || store.types[index] == BodyType::Static) {
+                    continue;
+                }
+                store.Wake(index);
+                index = store.Find(ids[i]);
+                store.linear_velocities[index] += impulses[i] * store.inverse_masses[index];
+            }
+        }
+
+        void SimplePhysicsWorld::CastRays(const RayCastInput *rays, uint32_t count, RayCastHit *hits) {
+            auto cast = [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    hits[i] = Cast(rays[i].origin, rays[i].direction, rays[i].max_distance, ColliderShapeType::None,
+                                   glm::vec3(0.0f));
+                }
+            };
+            RunParallel(scheduler_, count, kQueryBatchSize, cast);
+        }
+
+        void SimplePhysicsWorld::CastShapes(const ShapeCastInput *casts, uint32_t count, RayCastHit *hits) {
+            auto cast = [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    const ShapeCastInput &input = casts[i];
+                    glm::vec3 extent = input.shape == ColliderShapeType::Sphere ? glm::vec3(input.radius)
+                                                                                : input.half_extents;
+                    hits[i] = Cast(input.origin, input.direction, input.max_distance, input.shape, extent);
+                }
+            };
+            RunParallel(scheduler_, count, kQueryBatchSize, cast);
+        }
+
+        void SimplePhysicsWorld::QueryOverlaps(const OverlapInput *queries, uint32_t count, BodyId *results,
+                                               uint32_t max_results_per_query, uint32_t *result_counts) {
+            auto query = [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    result_counts[i] = Overlap(queries[i], results + static_cast<size_t>(i) * max_results_per_query,
+                                               max_results_per_query);
+                }
+            };
+            RunParallel(scheduler_, count, kQueryBatchSize, query);
+        }
+
+        void SimplePhysicsWorld::ConfigureContactEvents(const ContactEventOptions &options) {
+            contact_events_.SetCapacity(options.capacity);
+            report_persist_ = options.report_persist;
+            contacts_.clear();
+        }
+
+        uint32_t SimplePhysicsWorld::ReadContactEvents(ContactEvent *events, uint32_t capacity) {
+            return contact_events_.Read(events, capacity);
+        }
+
+        uint64_t SimplePhysicsWorld::GetDroppedContactEventCount() const { return contact_events_.GetDroppedCount(); }
+
+        size_t SimplePhysicsWorld::SaveSnapshot(void *buffer, size_t capacity) {
+            // The store already is a set of flat arrays, so the snapshot is one copy per array plus the tree nodes.
+            PhysicsSnapshotWriter writer(buffer, capacity);
+            writer.Write(kSnapshotFormat);
+            writer.Write(gravity_);
+            writer.Write(accumulator_);
+            writer.Write(sleeping_enabled_);
+            writer.Write(state_hash_);
+            store_->SaveSnapshot(writer);
+            writer.WriteArray(contacts_);
+            return writer.GetSize();
+        }
+
+        bool SimplePhysicsWorld::RestoreSnapshot(const void *snapshot, size_t size) {
+            PhysicsSnapshotReader reader(snapshot, size);
+            uint32_t format = 0;
+            glm::vec3 gravity;
+            float accumulator;
+            bool sleeping_enabled;
+            uint64_t state_hash = 0;
+            reader.Read(format);
+            reader.Read(gravity);
+            reader.Read(accumulator);
+            reader.Read(sleeping_enabled);
+            reader.Read(state_hash);
+            bool valid = format == kSnapshotFormat && restore_store_.RestoreSnapshot(reader);
+            if (!valid || !reader.ReadArray(current_contacts_) || !reader.IsComplete()) {
+                std::cerr << "SimplePhysicsWorld: RestoreSnapshot got an invalid snapshot." << std::endl;
+                return false;
+            }
+            // Body handles refer to bodies by id, so the snapshot must hold exactly the bodies that exist now.
+            const SimpleBodyStore &store = *store_;
+            bool same_bodies = restore_store_.GetSize() == store.GetSize();
+            for (uint32_t i = 0; same_bodies && i < restore_store_.GetSize(); ++i) {
+                same_bodies = store.Find(restore_store_.ids[i]) != SimpleBodyStore::kInvalidIndex;
+            }
+            if (!same_bodies) {
+                std::cerr << "SimplePhysicsWorld: RestoreSnapshot bodies do not match the world's bodies." << std::endl;
+                return false;
+            }
+
+            std::swap(*store_, restore_store_);
+            std::swap(contacts_, current_contacts_);
+            gravity_ = gravity;
+            accumulator_ = accumulator;
+            sleeping_enabled_ = sleeping_enabled;
+            state_hash_ = state_hash;
+            pairs_.clear();
+            moved_bodies_.assign(store_->ids.begin(), store_->ids.end());
+            return true;
+        }
+
+        RayCastHit SimplePhysicsWorld::Cast(const glm::vec3 &origin, const glm::vec3 &direction, float max_distance,
+                                            ColliderShapeType shape, const glm::vec3 &extent) const {
+            // The tree is traversed with its boxes grown by the cast extent, which turns the sweep into a ray cast
+            // against Minkowski sums. That sum is exact for boxes and sphere pairs; a box meeting a sphere is
+            // treated as meeting the sphere's bounding box.
+            const SimpleBodyStore &store = *store_;
+            RayCastHit hit;
+            store.broadphase.RayCast(origin, direction, max_distance, extent, [&](int32_t proxy, float max) {
+                uint32_t index = store.Find(store.broadphase.GetUserData(proxy));
+                float distance;
+                glm::vec3 normal;
+                bool round = store.shapes[index] == ColliderShapeType::Sphere && shape != ColliderShapeType::Box;
+                bool hit_body = round ? RaySphere(origin, direction, max, store.positions[index],
+                                                  store.half_extents[index].x + extent.x, distance, normal)
+                                      : RayBox(origin, direction, max, store.positions[index],
+                                               store.half_extents[index] + extent, distance, normal);
+                if (!hit_body) {
+                    return max;
+                }
+                hit.body = store.ids[index];
+                hit.distance = distance;
+                hit.point = origin + direction * distance;
+                hit.normal = normal;
+                return distance;
+            });
+            return hit;
+        }
+
+        uint32_t SimplePhysicsWorld::Overlap(const OverlapInput &query, BodyId *results, uint32_t max_results) const {
+            if (max_results == 0) {
+                return 0;
+            }
+            const SimpleBodyStore &store = *store_;
+            bool query_sphere = query.shape == ColliderShapeType::Sphere;
+            glm::vec3 extent = query_sphere ? glm::vec3(query.radius) : query.half_extents;
+            Aabb bounds = {query.center - extent, query.center + extent};
+
+            uint32_t count = 0;
+            store.broadphase.Query(bounds, [&](int32_t proxy) {
+                uint32_t index = store.Find(store.broadphase.GetUserData(proxy));
+                const glm::vec3 &center = store.positions[index];
+                const glm::vec3 &body_extent = store.half_extents[index];
+                bool body_sphere = store.shapes[index] == ColliderShapeType::Sphere;
+                bool overlaps;
+                if (query_sphere && body_sphere) {
+                    float radius = query.radius + body_extent.x;
+                    glm::vec3 offset = center - query.center;
+                    overlaps = glm::dot(offset, offset) <= radius * radius;
+                } else if (query_sphere) {
+                    overlaps = DistanceSquaredToBox(query.center, center, body_extent) <= query.radius * query.radius;
+                } else if (body_sphere) {
+                    overlaps = DistanceSquaredToBox(center, query.center, extent) <= body_extent.x * body_extent.x;
+                } else {
+                    overlaps = bounds.Overlaps(store.ComputeAabb(index));
+                }
+                if (overlaps) {
+                    results[count++] = store.ids[index];
+                }
+                return count < max_results;
+            });
+            return count;
+        }
+
+        void SimplePhysicsWorld::StepFixed(float delta_time) {
+            SimpleBodyStore &store = *store_;
+            FindPairs();
+            // Only awake bodies are simulated; FindPairs may have woken some.
+            uint32_t count = store.awake_count;
+            fixed_step_positions_.assign(store.positions.begin(), store.positions.begin() + count);
+
+            float h = delta_time / static_cast<float>(sub_step_count_);
+            // Each body is integrated on its own, so the split into sub-ranges cannot change the result.
+            auto integrate_velocities = [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    if (store.types[i] == BodyType::Dynamic) {
+                        store.linear_velocities[i] += (gravity_ + store.forces[i] * store.inverse_masses[i]) * h;
+                    }
+                }
+            };
+            auto integrate_positions = [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    store.positions[i] += store.linear_velocities[i] * h;
+                    const glm::vec3 &w = store.angular_velocities[i];
+                    if (w.x != 0.0f || w.y != 0.0f || w.z != 0.0f) {
+                        glm::quat &q = store.rotations[i];
+                        q = glm::normalize(q + glm::quat(0.0f, w.x, w.y, w.z) * q * (0.5f * h));
+                    }
+                }
+            };
+            for (uint32_t sub_step = 0; sub_step < sub_step_count_; ++sub_step) {
+                RunParallel(scheduler_, count, kIntegrateBatchSize, integrate_velocities);
+                SolveContacts();
+                RunParallel(scheduler_, count, kIntegrateBatchSize, integrate_positions);
+            }
+
+            // Body hashes are summed, so the step hash does not depend on where each body sits in the store.
+            uint64_t body_hash_sum = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                store.forces[i] = glm::vec3(0.0f);
+                store.UpdateProxy(i, store.linear_velocities[i] * delta_time);
+                body_hash_sum += HashBodyState(store.ids[i], store.positions[i], store.rotations[i],
+                                               store.linear_velocities[i], store.angular_velocities[i]);
+            }
+            state_hash_ = ChainStepHash(state_hash_, body_hash_sum, count);
+
+            if (contact_events_.IsEnabled()) {
+                ReportContacts();
+            }
+
+            if (sleeping_enabled_) {
+                UpdateSleep(delta_time);
+            }
+        }
+
+        void SimplePhysicsWorld::FindPairs() {
+            SimpleBodyStore &store = *store_;
+            pairs_.clear();
+            // The awake bodies query the tree in parallel, read-only. Sleeping bodies they touch are woken after
+            // the pass; waking appends their islands to the awake range, so the pass repeats over the woken bodies
+            // until nothing new wakes. Waking only moves bodies at or after awake_count, which keeps the indices of
+            // the range being queried stable, but pairs still hold ids until all passes are done.
+            for (uint32_t begin = 0; begin < store.awake_count;) {
+                uint32_t end = store.awake_count;
+                auto query = [&](uint32_t range_begin, uint32_t range_end, uint32_t worker) {
+                    std::vector<BodyPair> &pairs = worker_pairs_[worker];
+                    std::vector<BodyId> &wakes = worker_wakes_[worker];
+                    for (uint32_t a = begin + range_begin; a < begin + range_end; ++a) {
+                        if (store.proxies[a] == DynamicAabbTree::kNullNode) {
+                            continue;
+                        }
+                        bool dynamic_a = store.types[a] == BodyType::Dynamic;
+                        store.broadphase.Query(store.broadphase.GetFatAabb(store.proxies[a]), [&](int32_t proxy) {
+                            BodyId id_b = store.broadphase.GetUserData(proxy);
+                            uint32_t b = store.Find(id_b);
+                            // Bodies of earlier passes already found their pairs with this one.
+                            if (b == a || b < begin) {
+                                return true;
+                            }
+                            glm::vec3 normal;
+                            float depth;
+                            if (b >= end && store.types[b] != BodyType::Static && !store.sensors[a] &&
+                                !store.sensors[b] && Collide(store, a, b, normal, depth)) {
+                                wakes.push_back(id_b);
+                            }
+                            // Pairs of awake dynamic bodies are found from both sides; keep the one from the lower
+                            // index. A sleeping b woken by this pass skips a in the next pass.
+                            if (dynamic_a && (store.types[b] != BodyType::Dynamic || b >= end || a < b)) {
+                                pairs.push_back({store.ids[a], id_b, false, glm::vec3(0.0f), 0.0f});
+                            }
+                            return true;
+                        });
+                    }
+                };
+                RunParallelPerWorker(scheduler_, end - begin, kPairBatchSize, query);
+
+                wake_ids_.clear();
+                for (size_t worker = 0; worker < worker_pairs_.size(); ++worker) {
+                    pairs_.insert(pairs_.end(), worker_pairs_[worker].begin(), worker_pairs_[worker].end());
+                    wake_ids_.insert(wake_ids_.end(), worker_wakes_[worker].begin(), worker_wakes_[worker].end());
+                    worker_pairs_[worker].clear();
+                    worker_wakes_[worker].clear();
+                }
+                // Which worker got which sub-range varies from run to run. The wake order decides where the woken
+                // islands land in the store, so deterministic mode wakes in id order.
+                if (deterministic_) {
+                    std::sort(wake_ids_.begin(), wake_ids_.end());
+                }
+                for (BodyId id : wake_ids_) {
+                    store.Wake(store.Find(id));
+                }
+                begin = end;
+            }
+            // The solver applies pairs one after another, so their order changes the result as well.
+            if (deterministic_) {
+                std::sort(pairs_.begin(), pairs_.end(), [](const BodyPair &x, const BodyPair &y) {
+                    return x.a != y.a ? x.a < y.a : x.b < y.b;
+                });
+            }
+            for (BodyPair &pair : pairs_) {
+                pair.a = store.Find(pair.a);
+                pair.b = store.Find(pair.b);
+            }
+        }
+
+        void SimplePhysicsWorld::SolveContacts() {
+            SimpleBodyStore &store = *store_;
+            for (BodyPair &pair : pairs_) {
+                glm::vec3 normal;
+                float depth;
+                if (!Collide(store, pair.a, pair.b, normal, depth)) {
+                    continue;
+                }
+                pair.touching = true;
+                pair.normal = normal;
+                if (store.sensors[pair.a] || store.sensors[pair.b]) {
+                    continue;
+                }
+                float inverse_mass_a = store.inverse_masses[pair.a];
+                float inverse_mass_b = store.IsAwake(pair.b) ? store.inverse_masses[pair.b] : 0.0f;
+                float inverse_mass_sum = inverse_mass_a + inverse_mass_b;
+                if (inverse_mass_sum <= 0.0f) {
+                    continue;
+                }
+
+                glm::vec3 &velocity_a = store.linear_velocities[pair.a];
+                glm::vec3 &velocity_b = store.linear_velocities[pair.b];
+                float normal_speed = glm::dot(velocity_b - velocity_a, normal);
+                pair.approach_speed = std::max(pair.approach_speed, -normal_speed);
+                if (normal_speed < 0.0f) {
+                    float restitution = normal_speed < -kRestitutionThreshold
+                                            ? std::max(store.restitutions[pair.a], store.restitutions[pair.b])
+                                            : 0.0f;
+                    float normal_impulse = -(1.0f + restitution) * normal_speed / inverse_mass_sum;
+                    velocity_a -= normal * (normal_impulse * inverse_mass_a);
+                    velocity_b += normal * (normal_impulse * inverse_mass_b);
+
+                    // Coulomb friction against the remaining tangential velocity.
+                    glm::vec3 relative = velocity_b - velocity_a;
+                    glm::vec3 tangent_velocity = relative - normal * glm::dot(relative, normal);
+                    float tangent_speed = glm::length(tangent_velocity);
+                    if (tangent_speed > 1e-6f) {
+                        float friction = std::sqrt(store.frictions[pair.a] * store.frictions[pair.b]);
+                        float tangent_impulse = std::min(tangent_speed / inverse_mass_sum, friction * normal_impulse);
+                        glm::vec3 tangent = tangent_velocity / tangent_speed;
+                        velocity_a += tangent * (tangent_impulse * inverse_mass_a);
+                        velocity_b -= tangent * (tangent_impulse * inverse_mass_b);
+                    }
+                }
+
+                float correction = std::max(depth - kLinearSlop, 0.0f) * kPositionCorrection / inverse_mass_sum;
+                store.positions[pair.a] -= normal * (correction * inverse_mass_a);
+                store.positions[pair.b] += normal * (correction * inverse_mass_b);
+            }
+        }
+
+        void SimplePhysicsWorld::UpdateSleep(float delta_time) {
+            SimpleBodyStore &store = *store_;
+            uint32_t count = store.awake_count;
+            for (uint32_t i = 0; i < count; ++i) {
+                // Fastest point of the collider, as Box2D estimates it. The linear part is measured from the actual
+                // displacement: bodies held up by positional correction keep a small velocity while resting.
+                const glm::vec3 &extent = store.half_extents[i];
+                float speed = glm::length(store.positions[i] - fixed_step_positions_[i]) / delta_time +
+                              std::max(extent.x, std::max(extent.y, extent.z)) * glm::length(store.angular_velocities[i]);
+                if (!store.sleep_enabled[i] || speed > store.sleep_thresholds[i]) {
+                    store.sleep_times[i] = 0.0f;
+                } else {
+                    store.sleep_times[i] += delta_time;
+                }
+            }
+
+            island_parents_.resize(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                island_parents_[i] = i;
+            }
+            auto find_root = [this](uint32_t i) {
+                while (island_parents_[i] != i) {
+                    island_parents_[i] = island_parents_[island_parents_[i]];
+                    i = island_parents_[i];
+                }
+                return i;
+            };
+            for (const BodyPair &pair : pairs_) {
+                if (!pair.touching || !store.IsAwake(pair.b) || store.sensors[pair.a] || store.sensors[pair.b]) {
+                    continue; // Static and sleeping bodies do not join islands; they act as ground.
+                }
+                if (store.types[pair.b] == BodyType::Dynamic) {
+                    island_parents_[find_root(pair.a)] = find_root(pair.b);
+                } else {
+                    // A moving kinematic body keeps the bodies it touches awake.
+                    store.sleep_times[pair.a] = std::min(store.sleep_times[pair.a], store.sleep_times[pair.b]);
+                }
+            }
+
+            island_rest_times_.assign(count, INFINITY);
+            for (uint32_t i = 0; i < count; ++i) {
+                float &rest = island_rest_times_[find_root(i)];
+                rest = std::min(rest, store.sleep_times[i]);
+            }
+            sleep_candidates_.clear();
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t root = find_root(i);
+                if (island_rest_times_[root] >= kTimeToSleep) {
+                    sleep_candidates_.push_back({root, store.ids[i]});
+                }
+            }
+            std::sort(sleep_candidates_.begin(), sleep_candidates_.end());
+            for (size_t begin = 0; begin < sleep_candidates_.size();) {
+                size_t end = begin;
+                sleep_island_.clear();
+                while (end < sleep_candidates_.size() && sleep_candidates_[end].first == sleep_candidates_[begin].first) {
+                    sleep_island_.push_back(sleep_candidates_[end++].second);
+                }
+                store.Sleep(sleep_island_.data(), static_cast<uint32_t>(sleep_island_.size()));
+                begin = end;
+            }
+        }
+
+        void SimplePhysicsWorld::ReportContacts() {
+            const SimpleBodyStore &store = *store_;
+            current_contacts_.clear();
+            for (const BodyPair &pair : pairs_) {
+                if (!pair.touching) {
+                    continue;
+                }
+                TrackedContact contact;
+                const glm::vec3 &extent = store.half_extents[pair.a];
+                float reach = store.shapes[pair.a] == ColliderShapeType::Sphere
+                                  ? extent.x
+                                  : glm::dot(extent, glm::abs(pair.normal));
+                contact.point = store.positions[pair.a] + pair.normal * reach;
+                contact.normal = pair.normal;
+                contact.approach_speed = pair.approach_speed;
+                BodyId low = store.ids[pair.a];
+                BodyId high = store.ids[pair.b];
+                contact.sensor = store.sensors[pair.a] ? 1 : store.sensors[pair.b] ? 2 : 0;
+                if (high < low) {
+                    std::swap(low, high);
+                    contact.normal = -contact.normal;
+                    contact.sensor = contact.sensor == 0 ? 0 : 3 - contact.sensor;
+                }
+                contact.key = static_cast<uint64_t>(low) << 32 | high;
+                current_contacts_.push_back(contact);
+            }
+            auto by_key = [](const TrackedContact &x, const TrackedContact &y) { return x.key < y.key; };
+            std::sort(current_contacts_.begin(), current_contacts_.end(), by_key);
+
+            // Walk both sorted lists together. Pairs of two sleeping or static bodies are not found anymore but
+            // still touch, so they carry over silently.
+            size_t current_count = current_contacts_.size();
+            size_t i = 0;
+            size_t j = 0;
+            while (i < contacts_.size() || j < current_count) {
+                if (j == current_count || (i < contacts_.size() && contacts_[i].key < current_contacts_[j].key)) {
+                    const TrackedContact &ended = contacts_[i++];
+                    uint32_t low = store.Find(static_cast<BodyId>(ended.key >> 32));
+                    uint32_t high = store.Find(static_cast<BodyId>(ended.key));
+                    if (low != SimpleBodyStore::kInvalidIndex && high != SimpleBodyStore::kInvalidIndex &&
+                        !store.IsAwake(low) && !store.IsAwake(high)) {
+                        current_contacts_.push_back(ended);
+                    } else {
+                        PushContactEvent(ContactEventType::End, ended);
+                    }
+                } else if (i == contacts_.size() || current_contacts_[j].key < contacts_[i].key) {
+                    PushContactEvent(ContactEventType::Begin, current_contacts_[j++]);
+                } else {
+                    if (report_persist_) {
+                        PushContactEvent(ContactEventType::Persist, current_contacts_[j]);
+                    }
+                    ++i;
+                    ++j;
+                }
+            }
+            if (current_contacts_.size() > current_count) {
+                std::sort(current_contacts_.begin(), current_contacts_.end(), by_key);
+            }
+            std::swap(contacts_, current_contacts_);
+        }
+
+        void SimplePhysicsWorld::PushContactEvent(ContactEventType type, const TrackedContact &contact) {
+            ContactEvent event;
+            event.type = type;
+            event.body_a = static_cast<BodyId>(contact.key >> 32);
+            event.body_b = static_cast<BodyId>(contact.key);
+            event.point = contact.point;
+            event.normal = contact.normal;
+            event.approach_speed = type == ContactEventType::Begin ? contact.approach_speed : 0.0f;
+            if (contact.sensor != 0) {
+                if (type == ContactEventType::Persist) {
+                    return;
+                }
+                event.type = type == ContactEventType::Begin ? ContactEventType::SensorBegin
+                                                             : ContactEventType::SensorEnd;
+                if (contact.sensor == 2) {
+                    std::swap(event.body_a, event.body_b);
+                    event.normal = -event.normal;
+                }
+                event.approach_speed = 0.0f;
+            }
+            contact_events_.Push(event);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <pal/contact_event_buffer.h>
+#include <pal/iphysics_task_scheduler.h>
+#include <pal/iphysics_world.h>
+#include <piece_core/native_interop_types.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "simple_body_store.h"
+
+namespace Piece {
+    namespace PAL {
+        // Lightweight physics world for games that need overlap tests and simple dynamics rather than a full engine.
+        // Colliders are axis-aligned boxes and spheres found through a dynamic AABB tree; contacts are resolved
+        // with one impulse pass per sub-step plus positional correction. Rotations are integrated from the angular
+        // velocity but do not affect collision. Touching bodies form islands that fall asleep together once they
+        // rest, and sleeping bodies are left out of every per-step loop until an awake body touches them.
+        class SimplePhysicsWorld : public IPhysicsWorld {
+        public:
+            explicit SimplePhysicsWorld(const Core::NativePhysicsOptions &options);
+
+            SimplePhysicsWorld(const SimplePhysicsWorld &) = delete;
+            SimplePhysicsWorld &operator=(const SimplePhysicsWorld &) = delete;
+
+            // IPhysicsWorld interface
+            void SetTaskScheduler(IPhysicsTaskScheduler *scheduler) override;
+            void Init() override;
+            void Step(float delta_time) override;
+            std::unique_ptr<IPhysicsBody> CreatePhysicsBody(const RigidBodyCreationInfo &info) override;
+            uint32_t GetBodyCount() const override;
+            uint32_t GetAwakeBodyCount() const override;
+            void SetSleepingEnabled(bool enabled) override;
+            void SetDeterministic(bool enabled) override;
+            uint64_t GetStateHash() const override;
+            uint32_t ReadBodyStates(const BodyStateArrays &states, uint32_t capacity, bool moved_only) override;
+            void WriteBodyStates(const BodyStateArrays &states, uint32_t count) override;
+            void ApplyImpulses(const BodyId *ids, const glm::vec3 *impulses, uint32_t count) override;
+            void CastRays(const RayCastInput *rays, uint32_t count, RayCastHit *hits) override;
+            void CastShapes(const ShapeCastInput *casts, uint32_t count, RayCastHit *hits) override;
+            void QueryOverlaps(const OverlapInput *queries, uint32_t count, BodyId *results,
+                               uint32_t max_results_per_query, uint32_t *result_counts) override;
+            void ConfigureContactEvents(const ContactEventOptions &options) override;
+            uint32_t ReadContactEvents(ContactEvent *events, uint32_t capacity) override;
+            uint64_t GetDroppedContactEventCount() const override;
+            size_t SaveSnapshot(void *buffer, size_t capacity) override;
+            bool RestoreSnapshot(const void *snapshot, size_t size) override;
+
+            void SetGravity(const glm::vec3 &gravity) { gravity_ = gravity; }
+            const glm::vec3 &GetGravity() const { return gravity_; }
+            const DynamicAabbTree &GetBroadphase() const { return store_->broadphase; }
+            // Number of body pairs whose fat AABBs overlapped in the last fixed step.
+            uint32_t GetPairCount() const { return static_cast<uint32_t>(pairs_.size()); }
+
+        private:
+            // Dense indices of two bodies whose fat AABBs overlap. a is always dynamic and awake; a sleeping b is
+            // treated as static until the pair touches and wakes it in the next FindPairs.
+            struct BodyPair {
+                uint32_t a;
+                uint32_t b;
+                // Whether the colliders touched in any sub-step; touching pairs join islands.
+                bool touching;
+                // Normal from a to b in the last sub-step they touched, and the fastest approach along it.
+                glm::vec3 normal;
+                float approach_speed;
+            };
+
+            // A touching pair remembered across steps to report contact events, keyed by its lower id in the high
+            // bits so sorting orders pairs by body.
+            struct TrackedContact {
+                uint64_t key;
+                glm::vec3 point;
+                // Points from the lower id to the higher one.
+                glm::vec3 normal;
+                float approach_speed;
+                // 0 for a contact, 1 if the lower id is the sensor, 2 if the higher one is.
+                uint8_t sensor;
+            };
+
+            void StepFixed(float delta_time);
+            void FindPairs();
+            void SolveContacts();
+            // Compares the touching pairs of this step with the last one's and records the contact events.
+            void ReportContacts();
+            void PushContactEvent(ContactEventType type, const TrackedContact &contact);
+            // Advances the rest timers and puts islands whose bodies have all rested long enough to sleep.
+            void UpdateSleep(float delta_time);
+            // Closest hit of a shape with the given half extent swept from origin; ColliderShapeType::None casts a
+            // ray. Read-only, so batches run it concurrently.
+            RayCastHit Cast(const glm::vec3 &origin, const glm::vec3 &direction, float max_distance,
+                            ColliderShapeType shape, const glm::vec3 &extent) const;
+            uint32_t Overlap(const OverlapInput &query, BodyId *results, uint32_t max_results) const;
+
+            std::shared_ptr<SimpleBodyStore> store_;
+            // Snapshots are restored into this store first and swapped in once validated; the swapped-out store
+            // keeps its storage for the next restore.
+            SimpleBodyStore restore_store_;
+            IPhysicsTaskScheduler *scheduler_ = nullptr;
+            bool initialized_ = false;
+            glm::vec3 gravity_ = glm::vec3(0.0f, -9.81f, 0.0f);
+            float fixed_delta_time_;
+            uint32_t max_steps_;
+            uint32_t sub_step_count_;
+            float accumulator_ = 0.0f;
+            bool sleeping_enabled_ = true;
+            bool deterministic_ = false;
+            uint64_t state_hash_ = 0;
+
+            std::vector<BodyPair> pairs_;
+            // Per-worker output of the parallel broadphase pass: pairs found and sleeping bodies to wake.
+            std::vector<std::vector<BodyPair>> worker_pairs_;
+            std::vector<std::vector<BodyId>> worker_wakes_;
+            std::vector<BodyId> wake_ids_;
+            ContactEventBuffer contact_events_;
+            bool report_persist_ = false;
+            // Touching pairs of the last step sorted by key, and scratch for the current step's.
+            std::vector<TrackedContact> contacts_;
+            std::vector<TrackedContact> current_contacts_;
+            // Bodies whose transform changed during the last Step.
+            std::vector<BodyId> moved_bodies_;
+            // Transforms of the awake bodies at the start of Step, compared against afterwards to find the moved
+            // bodies. Bodies woken during Step are compared against SimpleBodyStore::woken instead.
+            std::vector<SimpleBodyStore::BodyTransform> step_start_;
+            // Positions of the awake bodies at the start of the current fixed step.
+            std::vector<glm::vec3> fixed_step_positions_;
+            // Scratch for UpdateSleep: union-find parents and island rest times by dense index, and the bodies
+            // ready to sleep keyed by island root.
+            std::vector<uint32_t> island_parents_;
+            std::vector<float> island_rest_times_;
+            std::vector<std::pair<uint32_t, BodyId>> sleep_candidates_;
+            std::vector<BodyId> sleep_island_;
+        };
+    }
+}
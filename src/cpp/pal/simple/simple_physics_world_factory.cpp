@@ -0,0 +1,18 @@
+#include "simple_physics_world_factory.h"
+
+#include "simple_physics_world.h"
+
+namespace Piece {
+    namespace Core {
+        std::unique_ptr<PAL::IPhysicsWorld> SimplePhysicsWorldFactory::CreatePhysicsWorld(const NativePhysicsOptions *options) {
+            NativePhysicsOptions defaults = {1.0f / 60.0f, 4, 4};
+            return std::make_unique<PAL::SimplePhysicsWorld>(options ? *options : defaults);
+        }
+    }
+}
+
+extern "C" {
+    PAL_SIMPLE_API Piece::Core::IPhysicsWorldFactory* CreateSimplePhysicsWorldFactory() {
+        return new Piece::Core::SimplePhysicsWorldFactory();
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <piece_core/interfaces/iphysics_world_factory.h>
+#include <pal/iphysics_world.h>
+#include "pal_simple_exports.h"
+
+namespace Piece {
+    namespace Core {
+        class SimplePhysicsWorldFactory : public IPhysicsWorldFactory {
+        public:
+            std::unique_ptr<PAL::IPhysicsWorld> CreatePhysicsWorld(const NativePhysicsOptions *options) override;
+        };
+    }
+}
+
+extern "C" {
+    PAL_SIMPLE_API Piece::Core::IPhysicsWorldFactory* CreateSimplePhysicsWorldFactory();
+}
@@ -0,0 +1,41 @@
+/**
+ * @file command_ring.cpp
+ * @brief Implements the CommandRing class.
+ */
+#include "command_ring.h"
+
+#include <algorithm>
+
+namespace Piece
+{
+namespace Core
+{
+
+CommandRing::CommandRing(uint32_t capacity)
+{
+    uint32_t slots = 1;
+    while (slots < std::min(capacity, 1u << 31))
+    {
+        slots <<= 1;
+    }
+    commands_ = std::make_unique<NativeCommand[]>(slots);
+    native_.commands = commands_.get();
+    native_.capacity = slots;
+    native_.write_index = reinterpret_cast<uint64_t *>(&write_index_);
+    native_.read_index = reinterpret_cast<uint64_t *>(&read_index_);
+}
+
+bool CommandRing::Push(const NativeCommand &command)
+{
+    uint64_t write = write_index_.load(std::memory_order_relaxed);
+    if (write - read_index_.load(std::memory_order_acquire) >= native_.capacity)
+    {
+        return false;
+    }
+    native_.commands[write & (native_.capacity - 1)] = command;
+    write_index_.store(write + 1, std::memory_order_release);
+    return true;
+}
+
+} // namespace Core
+} // namespace Piece
@@ -0,0 +1,122 @@
+/**
+ * @file command_ring.h
+ * @brief Defines the CommandRing class, a single-producer single-consumer ring of command records that managed code
+ *        writes into without calling into native code.
+ */
+#ifndef PIECE_CORE_COMMAND_RING_H_
+#define PIECE_CORE_COMMAND_RING_H_
+
+#include <piece_core/native_interop_types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief The commands of NativeCommand::type.
+ */
+enum class CommandType : uint32_t
+{
+    Spawn = 0,        /**< Activates an entity slot with a transform. */
+    Destroy = 1,      /**< Deactivates an entity slot. */
+    SetTransform = 2, /**< Sets an active entity's position, rotation and scale. */
+    ApplyImpulse = 3  /**< Applies a linear impulse to a physics body. */
+};
+
+/**
+ * @brief A bounded, lock-free queue of command records from one producer thread to one consumer thread.
+ * @details The slots and indices live in native memory and are described to managed code by a NativeCommandRing, so
+ *          the producer enqueues by writing a record and publishing the write index, with no transition into native
+ *          code. The consumer takes everything published so far in one pass. The indices sit on their own cache
+ *          lines so the two sides do not share one.
+ */
+class PIECE_CORE_API CommandRing
+{
+  public:
+    /**
+     * @brief Allocates the slots.
+     * @param capacity The requested number of slots, rounded up to a power of two.
+     */
+    explicit CommandRing(uint32_t capacity);
+
+    CommandRing(const CommandRing &) = delete;
+    CommandRing &operator=(const CommandRing &) = delete;
+
+    /**
+     * @brief Gets the control block handed to managed code.
+     * @return The slot and index pointers.
+     */
+    NativeCommandRing *GetNative()
+    {
+        return &native_;
+    }
+
+    /**
+     * @brief Gets the number of slots.
+     * @return The capacity, a power of two.
+     */
+    uint32_t GetCapacity() const
+    {
+        return native_.capacity;
+    }
+
+    /**
+     * @brief Enqueues a command as the managed producer does, for native producers. Producer thread only.
+     * @param command The command.
+     * @return False if the ring is full.
+     */
+    bool Push(const NativeCommand &command);
+
+    /**
+     * @brief Passes every command published so far to a function in order, then frees their slots.
+     *        Consumer thread only.
+     * @details The write index comes from managed code. If it is more than the capacity ahead of the read index, or
+     *          behind it, the slots no longer hold one command each: nothing is passed and the read index jumps to the
+     *          write index so the ring works again.
+     * @tparam Function Called as function(const NativeCommand &).
+     * @param function The function.
+     * @return The number of commands consumed.
+     */
+    template <typename Function> uint32_t Drain(Function &&function)
+    {
+        uint64_t read = read_index_.load(std::memory_order_relaxed);
+        uint64_t write = write_index_.load(std::memory_order_acquire);
+        if (write - read > native_.capacity)
+        {
+            read_index_.store(write, std::memory_order_release);
+            return 0;
+        }
+        uint32_t mask = native_.capacity - 1;
+        for (uint64_t i = read; i != write; ++i)
+        {
+            function(native_.commands[i & mask]);
+        }
+        read_index_.store(write, std::memory_order_release);
+        return static_cast<uint32_t>(write - read);
+    }
+
+  private:
+    static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) && std::atomic<uint64_t>::is_always_lock_free,
+                  "Managed code accesses the indices as plain 64-bit integers.");
+
+    /** @brief The command slots. */
+    std::unique_ptr<NativeCommand[]> commands_;
+    /** @brief The control block pointing at the slots and indices. */
+    NativeCommandRing native_ = {};
+    /** @brief The count of commands written, advanced by the producer. */
+    alignas(64) std::atomic<uint64_t> write_index_{0};
+    /** @brief The count of commands consumed, advanced by the consumer. */
+    alignas(64) std::atomic<uint64_t> read_index_{0};
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_COMMAND_RING_H_
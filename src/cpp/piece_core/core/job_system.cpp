@@ -0,0 +1,156 @@
+/**
+ * @file job_system.cpp
+ * @brief Implements the JobSystem worker thread pool.
+ */
+#include "job_system.h"
+
+#include <algorithm>
+
+namespace Piece
+{
+namespace Core
+{
+
+namespace
+{
+/** @brief The index of the current thread within its job system, 0 outside of workers. */
+thread_local uint32_t t_worker_index = 0;
+} // namespace
+
+JobSystem::JobSystem(uint32_t worker_count)
+{
+    if (worker_count == 0)
+    {
+        uint32_t hardware_threads = std::thread::hardware_concurrency();
+        worker_count = hardware_threads > 1 ? hardware_threads - 1 : 1;
+    }
+    workers_.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        workers_.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (std::thread &worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void JobSystem::Submit(Job job, JobCounter *counter)
+{
+    if (counter)
+    {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back({std::move(job), counter});
+    }
+    work_available_.notify_one();
+    // Workers blocked in a nested Wait sleep on job_finished_ and may pick up the new job as well.
+    job_finished_.notify_all();
+}
+
+void JobSystem::Wait(JobCounter &counter)
+{
+    bool is_worker = t_worker_index != 0;
+    while (counter.pending.load(std::memory_order_acquire) != 0)
+    {
+        if (is_worker && TryRunOne())
+        {
+            continue;
+        }
+        // Nothing this thread may help with: the remaining jobs are queued for or running on the workers.
+        std::unique_lock<std::mutex> lock(mutex_);
+        job_finished_.wait(lock, [&] {
+            return counter.pending.load(std::memory_order_acquire) == 0 || (is_worker && !queue_.empty());
+        });
+    }
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t batch_size, const std::function<void(uint32_t, uint32_t)> &fn)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    batch_size = std::max(batch_size, 1u);
+    if (count <= batch_size)
+    {
+        fn(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (uint32_t begin = batch_size; begin < count; begin += batch_size)
+    {
+        uint32_t end = std::min(begin + batch_size, count);
+        Submit([&fn, begin, end] { fn(begin, end); }, &counter);
+    }
+    fn(0, batch_size);
+    Wait(counter);
+}
+
+uint32_t JobSystem::GetCurrentWorkerIndex()
+{
+    return t_worker_index;
+}
+
+void JobSystem::WorkerLoop(uint32_t worker_index)
+{
+    t_worker_index = worker_index;
+    for (;;)
+    {
+        QueuedJob queued;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_available_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty())
+            {
+                return;
+            }
+            queued = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        Run(queued);
+    }
+}
+
+bool JobSystem::TryRunOne()
+{
+    QueuedJob queued;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty())
+        {
+            return false;
+        }
+        queued = std::move(queue_.front());
+        queue_.pop_front();
+    }
+    Run(queued);
+    return true;
+}
+
+void JobSystem::Run(QueuedJob &queued)
+{
+    queued.job();
+    if (queued.counter)
+    {
+        // Decrement under the lock so a waiter cannot miss the wake-up between its check and its wait.
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued.counter->pending.fetch_sub(1, std::memory_order_release);
+        job_finished_.notify_all();
+    }
+}
+
+} // namespace Core
+} // namespace Piece
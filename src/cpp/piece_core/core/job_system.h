@@ -0,0 +1,146 @@
+/**
+ * @file job_system.h
+ * @brief Defines the JobSystem class, a fixed-size worker thread pool for short CPU-bound tasks.
+ */
+#ifndef PIECE_CORE_JOB_SYSTEM_H_
+#define PIECE_CORE_JOB_SYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief Tracks the completion of a group of jobs.
+ * @details Incremented when a job is submitted with the counter and decremented when it finishes. A counter must
+ *          outlive every job submitted with it.
+ */
+struct JobCounter
+{
+    /** @brief The number of unfinished jobs. */
+    std::atomic<uint32_t> pending{0};
+};
+
+/**
+ * @brief A pool of worker threads executing jobs from a shared FIFO queue.
+ * @details Worker threads that wait on a counter run queued jobs while they wait instead of blocking, so jobs may
+ *          submit and wait on other jobs without deadlocking the pool. Other threads block in Wait and never run
+ *          queued jobs, which keeps worker indices unique among the threads executing jobs.
+ */
+class PIECE_CORE_API JobSystem
+{
+  public:
+    /**
+     * @brief A unit of work.
+     */
+    using Job = std::function<void()>;
+
+    /**
+     * @brief Starts the worker threads.
+     * @param worker_count The number of workers. 0 uses one less than the number of hardware threads, at least one.
+     */
+    explicit JobSystem(uint32_t worker_count = 0);
+
+    /**
+     * @brief Runs the remaining queued jobs and joins the worker threads.
+     */
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /**
+     * @brief Queues a job.
+     * @param job The job to run.
+     * @param counter Optional counter tracking the job.
+     */
+    void Submit(Job job, JobCounter *counter = nullptr);
+
+    /**
+     * @brief Waits until every job tracked by a counter has finished. Workers run queued jobs meanwhile.
+     * @param counter The counter to wait on.
+     */
+    void Wait(JobCounter &counter);
+
+    /**
+     * @brief Splits a range into batches, runs them on the workers and the calling thread, and waits for all of them.
+     * @param count The number of items.
+     * @param batch_size The maximum number of items per batch.
+     * @param fn A callable taking (uint32_t begin, uint32_t end) for each batch.
+     */
+    void ParallelFor(uint32_t count, uint32_t batch_size, const std::function<void(uint32_t, uint32_t)> &fn);
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return The worker count.
+     */
+    uint32_t GetWorkerCount() const
+    {
+        return static_cast<uint32_t>(workers_.size());
+    }
+
+    /**
+     * @brief Gets the index of the calling thread within its job system.
+     * @return 1 to GetWorkerCount() on worker threads, 0 on any other thread.
+     */
+    static uint32_t GetCurrentWorkerIndex();
+
+  private:
+    /**
+     * @brief A queued job and the counter tracking it.
+     */
+    struct QueuedJob
+    {
+        /** @brief The job to run. */
+        Job job;
+        /** @brief The counter to decrement once the job finishes, or nullptr. */
+        JobCounter *counter;
+    };
+
+    /**
+     * @brief The loop run by each worker thread.
+     * @param worker_index The index of the worker, starting at 1.
+     */
+    void WorkerLoop(uint32_t worker_index);
+
+    /**
+     * @brief Pops and runs one queued job if there is one.
+     * @return True if a job was run.
+     */
+    bool TryRunOne();
+
+    /**
+     * @brief Runs a job and signals its counter.
+     * @param queued The job to run.
+     */
+    void Run(QueuedJob &queued);
+
+    /** @brief The worker threads. */
+    std::vector<std::thread> workers_;
+    /** @brief Jobs waiting for a thread. */
+    std::deque<QueuedJob> queue_;
+    /** @brief Guards queue_ and stopping_. */
+    std::mutex mutex_;
+    /** @brief Signaled when a job is queued or the pool stops. */
+    std::condition_variable work_available_;
+    /** @brief Signaled when a counted job finishes or a job is queued, for threads blocked in Wait. */
+    std::condition_variable job_finished_;
+    /** @brief Set when the pool is being destroyed. */
+    bool stopping_ = false;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_JOB_SYSTEM_H_
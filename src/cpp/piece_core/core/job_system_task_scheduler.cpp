@@ -0,0 +1,140 @@
+/**
+ * @file job_system_task_scheduler.cpp
+ * @brief Implements the JobSystemTaskScheduler class.
+ */
+#include "job_system_task_scheduler.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace Piece
+{
+namespace Core
+{
+
+namespace
+{
+/** @brief The number of chunks per worker a task is cut into, for load balancing. */
+constexpr int kChunksPerWorker = 4;
+} // namespace
+
+JobSystemTaskScheduler::JobSystemTaskScheduler(JobSystem &job_system)
+    : job_system_(job_system), worker_count_(std::min(job_system.GetWorkerCount() + 1, kMaxWorkerCount)),
+      held_indices_(std::make_shared<std::atomic<uint64_t>>(0))
+{
+}
+
+uint32_t JobSystemTaskScheduler::GetWorkerCount() const
+{
+    return worker_count_;
+}
+
+void *JobSystemTaskScheduler::EnqueueTask(TaskFunction task, int item_count, int min_range, void *task_context)
+{
+    if (item_count <= 0)
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Task> record;
+    for (const std::shared_ptr<Task> &candidate : task_pool_)
+    {
+        if (candidate.use_count() == 1 &&
+            std::find(active_tasks_.begin(), active_tasks_.end(), candidate.get()) == active_tasks_.end())
+        {
+            record = candidate;
+            break;
+        }
+    }
+    if (!record)
+    {
+        record = std::make_shared<Task>();
+        task_pool_.push_back(record);
+    }
+
+    int max_chunks = static_cast<int>(GetWorkerCount()) * kChunksPerWorker;
+    record->function = task;
+    record->context = task_context;
+    record->item_count = item_count;
+    record->chunk_size = std::max({min_range, 1, (item_count + max_chunks - 1) / max_chunks});
+    record->chunk_count = (item_count + record->chunk_size - 1) / record->chunk_size;
+    record->next_chunk.store(0, std::memory_order_relaxed);
+    record->finished_chunks.store(0, std::memory_order_relaxed);
+    active_tasks_.push_back(record.get());
+
+    uint32_t runners = std::min<uint32_t>(static_cast<uint32_t>(record->chunk_count), worker_count_ - 1);
+    for (uint32_t i = 0; i < runners; ++i)
+    {
+        job_system_.Submit([record, held_indices = held_indices_, worker_count = worker_count_] {
+            RunChunks(*record, *held_indices, worker_count);
+        });
+    }
+    return record.get();
+}
+
+void JobSystemTaskScheduler::FinishTask(void *task_handle)
+{
+    Task *task = static_cast<Task *>(task_handle);
+    while (task->finished_chunks.load(std::memory_order_acquire) != task->chunk_count)
+    {
+        bool ran = false;
+        for (Task *active : active_tasks_)
+        {
+            if (RunChunk(*active, 0))
+            {
+                ran = true;
+                break;
+            }
+        }
+        if (!ran)
+        {
+            std::this_thread::yield();
+        }
+    }
+    active_tasks_.erase(std::find(active_tasks_.begin(), active_tasks_.end(), task));
+}
+
+void JobSystemTaskScheduler::RunChunks(Task &task, std::atomic<uint64_t> &held_indices, uint32_t worker_count)
+{
+    // Index 0 belongs to the stepping thread. If every other index is held, the threads holding them and FinishTask
+    // run the remaining chunks.
+    uint64_t free_indices = (worker_count < 64 ? (uint64_t{1} << worker_count) - 1 : ~uint64_t{0}) & ~uint64_t{1};
+    uint64_t held = held_indices.load(std::memory_order_relaxed);
+    uint64_t bit = 0;
+    do
+    {
+        uint64_t available = free_indices & ~held;
+        if (available == 0)
+        {
+            return;
+        }
+        bit = available & (~available + 1);
+    } while (!held_indices.compare_exchange_weak(held, held | bit, std::memory_order_acquire));
+
+    uint32_t worker_index = 0;
+    while ((uint64_t{1} << worker_index) != bit)
+    {
+        ++worker_index;
+    }
+    while (RunChunk(task, worker_index))
+    {
+    }
+    held_indices.fetch_and(~bit, std::memory_order_release);
+}
+
+bool JobSystemTaskScheduler::RunChunk(Task &task, uint32_t worker_index)
+{
+    int chunk = task.next_chunk.fetch_add(1, std::memory_order_relaxed);
+    if (chunk >= task.chunk_count)
+    {
+        return false;
+    }
+    int begin = chunk * task.chunk_size;
+    int end = std::min(begin + task.chunk_size, task.item_count);
+    task.function(begin, end, worker_index, task.context);
+    task.finished_chunks.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+} // namespace Core
+} // namespace Piece
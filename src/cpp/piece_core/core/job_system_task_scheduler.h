@@ -0,0 +1,120 @@
+/**
+ * @file job_system_task_scheduler.h
+ * @brief Defines the JobSystemTaskScheduler class, which runs physics backend tasks on the engine's JobSystem.
+ */
+#ifndef PIECE_CORE_JOB_SYSTEM_TASK_SCHEDULER_H_
+#define PIECE_CORE_JOB_SYSTEM_TASK_SCHEDULER_H_
+
+#include <pal/iphysics_task_scheduler.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "job_system.h"
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief Adapts the JobSystem to PAL::IPhysicsTaskScheduler.
+ * @details A task is cut into chunks that workers claim atomically. While FinishTask waits it claims outstanding
+ *          chunks of any active task itself with worker index 0, so tasks that expect one thread per worker, like
+ *          Box2D's solver stages, make progress even when every worker is taken. Job system workers do not pass
+ *          their own index: a runner first claims a free index from 1 to GetWorkerCount() - 1 and gives it back when
+ *          it is done, so the indices stay below the capped worker count however many workers the job system has.
+ *          EnqueueTask and FinishTask must be called from a single thread at a time, normally the one stepping the
+ *          world.
+ */
+class PIECE_CORE_API JobSystemTaskScheduler : public PAL::IPhysicsTaskScheduler
+{
+  public:
+    /** @brief The most worker indices handed out, including the stepping thread; Box2D's limit as well. */
+    static constexpr uint32_t kMaxWorkerCount = 64;
+
+    /**
+     * @brief Constructs the scheduler.
+     * @param job_system The job system running the tasks. Must outlive the scheduler.
+     */
+    explicit JobSystemTaskScheduler(JobSystem &job_system);
+
+    /**
+     * @brief Gets the number of worker indices: the job system workers plus the stepping thread, at most
+     *        kMaxWorkerCount.
+     * @return The worker count.
+     */
+    uint32_t GetWorkerCount() const override;
+
+    /**
+     * @brief Splits a task into chunks and queues runners for it on the job system.
+     * @param task The task body.
+     * @param item_count The number of items.
+     * @param min_range The smallest chunk size.
+     * @param task_context Opaque data passed to the task body.
+     * @return The task handle, or nullptr if there was nothing to run.
+     */
+    void *EnqueueTask(TaskFunction task, int item_count, int min_range, void *task_context) override;
+
+    /**
+     * @brief Helps running chunks until the task has finished, then recycles it.
+     * @param task_handle The handle returned by EnqueueTask.
+     */
+    void FinishTask(void *task_handle) override;
+
+  private:
+    /**
+     * @brief A task in flight. Runner jobs keep it alive through shared ownership.
+     */
+    struct Task
+    {
+        /** @brief The task body. */
+        TaskFunction function = nullptr;
+        /** @brief Opaque data passed to the task body. */
+        void *context = nullptr;
+        /** @brief The number of items. */
+        int item_count = 0;
+        /** @brief The number of items per chunk. */
+        int chunk_size = 0;
+        /** @brief The number of chunks. */
+        int chunk_count = 0;
+        /** @brief The next chunk to claim. */
+        std::atomic<int> next_chunk{0};
+        /** @brief The number of chunks that have finished running. */
+        std::atomic<int> finished_chunks{0};
+    };
+
+    /**
+     * @brief Claims and runs one chunk of a task.
+     * @param task The task.
+     * @param worker_index The worker index passed to the task body.
+     * @return False if every chunk had already been claimed.
+     */
+    static bool RunChunk(Task &task, uint32_t worker_index);
+
+    /**
+     * @brief Claims and runs chunks of a task on a job system worker under a worker index of its own.
+     * @param task The task.
+     * @param held_indices The mask of worker indices in use.
+     * @param worker_count The number of worker indices.
+     */
+    static void RunChunks(Task &task, std::atomic<uint64_t> &held_indices, uint32_t worker_count);
+
+    /** @brief The job system running the tasks. */
+    JobSystem &job_system_;
+    /** @brief The number of worker indices. */
+    uint32_t worker_count_;
+    /** @brief Bit i is set while a runner uses worker index i. Shared with runner jobs that may outlive this. */
+    std::shared_ptr<std::atomic<uint64_t>> held_indices_;
+    /** @brief Every task allocated so far. A task is reusable once no runner holds it anymore. */
+    std::vector<std::shared_ptr<Task>> task_pool_;
+    /** @brief Tasks enqueued and not finished yet. */
+    std::vector<Task *> active_tasks_;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_JOB_SYSTEM_TASK_SCHEDULER_H_
@@ -0,0 +1,121 @@
+/**
+ * @file latency_tracker.cpp
+ * @brief Implements the LatencyTracker class.
+ */
+#include "latency_tracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Piece
+{
+namespace Core
+{
+
+namespace
+{
+
+/**
+ * @brief Picks a percentile from sorted samples by the nearest-rank method.
+ * @param sorted The samples in ascending order; not empty.
+ * @param percentile The percentile, from 0 to 100.
+ * @return The percentile in milliseconds.
+ */
+float NearestRank(const std::vector<int64_t> &sorted, float percentile)
+{
+    size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0f * static_cast<float>(sorted.size())));
+    size_t index = std::min(std::max(rank, size_t{1}), sorted.size()) - 1;
+    return static_cast<float>(sorted[index]) / 1.0e6f;
+}
+
+} // namespace
+
+LatencyTracker::LatencyTracker(uint32_t capacity) : capacity_(std::max(capacity, 1u))
+{
+    samples_.reserve(capacity_);
+}
+
+void LatencyTracker::AddInput(const WAL::IWindow &window)
+{
+    uint32_t count = window.ReadInputEvents(nullptr, 0);
+    if (count == 0)
+    {
+        return;
+    }
+    poll_events_.resize(count);
+    window.ReadInputEvents(poll_events_.data(), count);
+    // An event cannot arrive after the poll that delivered it. Replayed events can carry later stamps when the replay
+    // runs faster than the recording; they count from the poll instead.
+    int64_t polled_ns = WAL::InputEventQueue::Now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const WAL::InputEvent &event : poll_events_)
+    {
+        // Without frames being rendered nothing would ever take the events, so their number is bounded.
+        if (pending_.size() >= capacity_)
+        {
+            break;
+        }
+        pending_.push_back(std::min(event.timestamp_ns, polled_ns));
+    }
+}
+
+void LatencyTracker::BeginFrame()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    frame_inputs_.swap(pending_);
+    pending_.clear();
+}
+
+void LatencyTracker::EndFrame(int64_t present_ns)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int64_t timestamp_ns : frame_inputs_)
+    {
+        int64_t latency_ns = std::max<int64_t>(present_ns - timestamp_ns, 0);
+        if (samples_.size() < capacity_)
+        {
+            samples_.push_back(latency_ns);
+        }
+        else
+        {
+            samples_[next_sample_] = latency_ns;
+        }
+        next_sample_ = (next_sample_ + 1) % capacity_;
+        ++sample_count_;
+    }
+    frame_inputs_.clear();
+}
+
+LatencyStats LatencyTracker::GetStats() const
+{
+    std::vector<int64_t> sorted;
+    LatencyStats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sorted = samples_;
+        stats.sample_count = sample_count_;
+    }
+    if (sorted.empty())
+    {
+        return stats;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    stats.p50_ms = NearestRank(sorted, 50.0f);
+    stats.p90_ms = NearestRank(sorted, 90.0f);
+    stats.p99_ms = NearestRank(sorted, 99.0f);
+    stats.max_ms = static_cast<float>(sorted.back()) / 1.0e6f;
+    return stats;
+}
+
+void LatencyTracker::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.clear();
+    frame_inputs_.clear();
+    samples_.clear();
+    next_sample_ = 0;
+    sample_count_ = 0;
+}
+
+} // namespace Core
+} // namespace Piece
@@ -0,0 +1,114 @@
+/**
+ * @file latency_tracker.h
+ * @brief Defines the LatencyTracker class, which measures the time from input events to the present of the frame
+ *        that consumed them.
+ */
+#ifndef PIECE_CORE_LATENCY_TRACKER_H_
+#define PIECE_CORE_LATENCY_TRACKER_H_
+
+#include <wal/iwindow.h>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief Percentiles of the recent input-to-present latencies.
+ */
+struct LatencyStats
+{
+    /** @brief The number of latencies measured since the last reset, including those no longer kept. */
+    uint64_t sample_count = 0;
+    /** @brief The median latency of the kept samples, in milliseconds. */
+    float p50_ms = 0.0f;
+    /** @brief The 90th percentile, in milliseconds. */
+    float p90_ms = 0.0f;
+    /** @brief The 99th percentile, in milliseconds. */
+    float p99_ms = 0.0f;
+    /** @brief The largest kept latency, in milliseconds. */
+    float max_ms = 0.0f;
+};
+
+/**
+ * @brief Measures how long input events take to reach the screen.
+ * @details Every event a window polled is stamped with the time the backend received it. AddInput hands the events of
+ *          one poll over; the next frame that starts rendering takes all events handed over so far with BeginFrame,
+ *          and EndFrame, called once the frame's SwapBuffers returned, turns each of them into one latency sample.
+ *          With a render thread, events polled while a frame is already being rendered go to the frame after it, as
+ *          that is the first one that can show them.
+ *
+ *          The most recent samples are kept in a fixed-size ring, so percentiles describe the last few seconds of a
+ *          session. AddInput and the stats are called on the update thread, BeginFrame and EndFrame on the rendering
+ *          thread.
+ */
+class PIECE_CORE_API LatencyTracker
+{
+  public:
+    /** @brief The number of samples kept by default. */
+    static constexpr uint32_t kDefaultCapacity = 4096;
+
+    /**
+     * @brief Constructs a LatencyTracker instance.
+     * @param capacity The number of most recent samples kept; also bounds the events waiting for a frame.
+     */
+    explicit LatencyTracker(uint32_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief Hands over the events a window polled, to be consumed by the next frame that starts rendering.
+     *        Call right after the window's PollEvents.
+     * @param window The window.
+     */
+    void AddInput(const WAL::IWindow &window);
+
+    /**
+     * @brief Tags the frame starting to render with every event handed over since the previous frame started.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Records the latency of every event the frame consumed.
+     * @param present_ns The time the frame's SwapBuffers returned, in the clock of WAL::InputEventQueue::Now.
+     */
+    void EndFrame(int64_t present_ns);
+
+    /**
+     * @brief Computes the percentiles of the kept samples.
+     * @return The stats; all zero before the first sample.
+     */
+    LatencyStats GetStats() const;
+
+    /**
+     * @brief Drops every sample and every event not presented yet.
+     */
+    void Reset();
+
+  private:
+    /** @brief Guards the waiting events and the samples between the update and rendering threads. */
+    mutable std::mutex mutex_;
+    /** @brief The timestamps of events handed over and not yet taken by a frame. */
+    std::vector<int64_t> pending_;
+    /** @brief The timestamps of the events consumed by the frame being rendered. */
+    std::vector<int64_t> frame_inputs_;
+    /** @brief The events of the last poll; update thread only, kept to not allocate every frame. */
+    std::vector<WAL::InputEvent> poll_events_;
+    /** @brief The ring of the most recent latencies, in nanoseconds. */
+    std::vector<int64_t> samples_;
+    /** @brief The ring slot written next. */
+    uint32_t next_sample_ = 0;
+    /** @brief The number of samples recorded since the last reset. */
+    uint64_t sample_count_ = 0;
+    /** @brief The number of samples kept. */
+    uint32_t capacity_;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_LATENCY_TRACKER_H_
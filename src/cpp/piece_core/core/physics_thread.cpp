@@ -0,0 +1,133 @@
+/**
+ * @file physics_thread.cpp
+ * @brief Implements the PhysicsThread class.
+ */
+#include "physics_thread.h"
+
+#include <algorithm>
+
+namespace Piece
+{
+namespace Core
+{
+
+PhysicsThread::PhysicsThread(PAL::IPhysicsWorld &world, float fixed_delta_time, uint32_t max_steps)
+    : world_(world), fixed_delta_time_(fixed_delta_time),
+      step_duration_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<float>(fixed_delta_time))),
+      max_steps_(std::max(max_steps, 1u))
+{
+    thread_ = std::thread(&PhysicsThread::Run, this);
+}
+
+PhysicsThread::~PhysicsThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+}
+
+uint32_t PhysicsThread::ReadInterpolatedStates(PAL::BodyId *ids, glm::vec3 *positions, glm::quat *rotations,
+                                               uint32_t capacity, std::chrono::steady_clock::time_point now)
+{
+    frames_.Update();
+    const PhysicsFrame &frame = frames_.GetReadBuffer();
+    if (!ids || frame.step_count == 0)
+    {
+        return 0;
+    }
+
+    // Rendering lags one step behind: at frame.time it shows the state before the step, one step later the state
+    // after it. Past that the newest state is held until the next frame arrives.
+    float alpha = std::chrono::duration<float>(now - frame.time).count() / fixed_delta_time_;
+    alpha = std::min(std::max(alpha, 0.0f), 1.0f);
+    uint32_t count = std::min(capacity, static_cast<uint32_t>(frame.ids.size()));
+    std::copy_n(frame.ids.begin(), count, ids);
+    if (positions)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            positions[i] = glm::mix(frame.previous_positions[i], frame.positions[i], alpha);
+        }
+    }
+    if (rotations)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            rotations[i] = glm::slerp(frame.previous_rotations[i], frame.rotations[i], alpha);
+        }
+    }
+    return count;
+}
+
+void PhysicsThread::Run()
+{
+    auto next_step = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> wait_lock(wait_mutex_);
+    while (!stopping_)
+    {
+        wait_lock.unlock();
+        {
+            std::lock_guard<std::mutex> world_lock(world_mutex_);
+            world_.Step(fixed_delta_time_);
+            PublishFrame(next_step);
+        }
+        next_step += step_duration_;
+        // After a stall, catch up on at most max_steps_ steps and drop the rest rather than falling behind for good.
+        auto now = std::chrono::steady_clock::now();
+        if (now - next_step > step_duration_ * max_steps_)
+        {
+            next_step = now;
+        }
+        wait_lock.lock();
+        wake_.wait_until(wait_lock, next_step, [this] { return stopping_; });
+    }
+}
+
+void PhysicsThread::PublishFrame(std::chrono::steady_clock::time_point time)
+{
+    PhysicsFrame &frame = frames_.GetWriteBuffer();
+    uint32_t capacity = world_.GetBodyCount();
+    frame.ids.resize(capacity);
+    frame.positions.resize(capacity);
+    frame.rotations.resize(capacity);
+    PAL::BodyStateArrays states;
+    states.ids = frame.ids.data();
+    states.positions = frame.positions.data();
+    states.rotations = frame.rotations.data();
+    uint32_t count = world_.ReadBodyStates(states, capacity, false);
+    frame.ids.resize(count);
+    frame.positions.resize(count);
+    frame.rotations.resize(count);
+    frame.previous_positions.resize(count);
+    frame.previous_rotations.resize(count);
+
+    uint64_t step = step_count_.load(std::memory_order_relaxed) + 1;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        PAL::BodyId id = frame.ids[i];
+        if (id >= last_steps_.size())
+        {
+            last_positions_.resize(id + 1);
+            last_rotations_.resize(id + 1);
+            last_steps_.resize(id + 1, 0);
+        }
+        // Bodies created since the previous step have no earlier transform and start at rest.
+        bool known = last_steps_[id] + 1 == step;
+        frame.previous_positions[i] = known ? last_positions_[id] : frame.positions[i];
+        frame.previous_rotations[i] = known ? last_rotations_[id] : frame.rotations[i];
+        last_positions_[id] = frame.positions[i];
+        last_rotations_[id] = frame.rotations[i];
+        last_steps_[id] = step;
+    }
+    frame.time = time;
+    frame.step_count = step;
+    frames_.Publish();
+    step_count_.store(step, std::memory_order_relaxed);
+}
+
+} // namespace Core
+} // namespace Piece
@@ -0,0 +1,152 @@
+/**
+ * @file physics_thread.h
+ * @brief Defines the PhysicsThread class, which steps a physics world on a dedicated thread at a fixed rate.
+ */
+#ifndef PIECE_CORE_PHYSICS_THREAD_H_
+#define PIECE_CORE_PHYSICS_THREAD_H_
+
+#include <pal/iphysics_world.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "piece_core_exports.h"
+#include "triple_buffer.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief The body transforms of one fixed physics step, as published by PhysicsThread.
+ * @details Each body carries its transform before and after the step, so a reader can interpolate without keeping
+ *          older frames, which it may never have seen.
+ */
+struct PhysicsFrame
+{
+    /** @brief The body ids. Element i of every other array belongs to ids[i]. */
+    std::vector<PAL::BodyId> ids;
+    /** @brief Positions before the step. */
+    std::vector<glm::vec3> previous_positions;
+    /** @brief Rotations before the step. */
+    std::vector<glm::quat> previous_rotations;
+    /** @brief Positions after the step. */
+    std::vector<glm::vec3> positions;
+    /** @brief Rotations after the step. */
+    std::vector<glm::quat> rotations;
+    /** @brief The scheduled time of the step, which the positions after it belong to. */
+    std::chrono::steady_clock::time_point time;
+    /** @brief The number of steps taken so far, 0 for a frame that was never published. */
+    uint64_t step_count = 0;
+};
+
+/**
+ * @brief Steps a physics world on its own thread at its own fixed rate, decoupled from the frame rate.
+ * @details After every step the thread copies the body transforms into a TripleBuffer, so the render side always
+ *          finds a complete frame without waiting for a step to finish. Rendering runs one step behind the
+ *          simulation and interpolates within the newest frame, which keeps motion smooth when steps and frames
+ *          do not line up or a step takes longer than usual. Everything else that touches the world while the
+ *          thread runs, including body handles, must hold the lock returned by LockWorld.
+ */
+class PIECE_CORE_API PhysicsThread
+{
+  public:
+    /**
+     * @brief Starts the thread.
+     * @param world The world to step. Must outlive the thread.
+     * @param fixed_delta_time The time simulated per step, in seconds; also the real time between steps.
+     * @param max_steps The number of steps the thread catches up on after a stall before it drops the backlog.
+     */
+    PhysicsThread(PAL::IPhysicsWorld &world, float fixed_delta_time, uint32_t max_steps);
+
+    /**
+     * @brief Finishes the step in progress and joins the thread.
+     */
+    ~PhysicsThread();
+
+    PhysicsThread(const PhysicsThread &) = delete;
+    PhysicsThread &operator=(const PhysicsThread &) = delete;
+
+    /**
+     * @brief Blocks the thread from stepping while the returned lock is held.
+     * @return A lock on the world.
+     */
+    std::unique_lock<std::mutex> LockWorld()
+    {
+        return std::unique_lock<std::mutex>(world_mutex_);
+    }
+
+    /**
+     * @brief Gets the number of steps taken so far.
+     * @return The step count.
+     */
+    uint64_t GetStepCount() const
+    {
+        return step_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copies the body transforms of the newest frame, interpolated for rendering at the given time.
+     *        Must be called from one thread at a time, normally the render thread.
+     * @param ids Receives the body ids.
+     * @param positions Receives the positions, or nullptr to skip them.
+     * @param rotations Receives the rotations, or nullptr to skip them.
+     * @param capacity The number of bodies the arrays hold.
+     * @param now The time to interpolate for.
+     * @return The number of bodies written, 0 before the first step.
+     */
+    uint32_t ReadInterpolatedStates(PAL::BodyId *ids, glm::vec3 *positions, glm::quat *rotations, uint32_t capacity,
+                                    std::chrono::steady_clock::time_point now);
+
+  private:
+    /**
+     * @brief The loop of the physics thread.
+     */
+    void Run();
+
+    /**
+     * @brief Copies the body transforms after a step into the write frame and publishes it.
+     * @param time The scheduled time of the step.
+     */
+    void PublishFrame(std::chrono::steady_clock::time_point time);
+
+    /** @brief The stepped world. */
+    PAL::IPhysicsWorld &world_;
+    /** @brief The time simulated per step, in seconds. */
+    float fixed_delta_time_;
+    /** @brief The real time between steps. */
+    std::chrono::steady_clock::duration step_duration_;
+    /** @brief The number of steps to catch up on after a stall. */
+    uint32_t max_steps_;
+    /** @brief Held by the thread while it steps and by LockWorld callers. */
+    std::mutex world_mutex_;
+    /** @brief Guards stopping_ for the wait between steps. */
+    std::mutex wait_mutex_;
+    /** @brief Wakes the thread early when it has to stop. */
+    std::condition_variable wake_;
+    /** @brief Set to ask the thread to exit. */
+    bool stopping_ = false;
+    /** @brief The number of steps taken so far. */
+    std::atomic<uint64_t> step_count_{0};
+    /** @brief The frames handed from the physics thread to the reader. */
+    TripleBuffer<PhysicsFrame> frames_;
+    /** @brief Positions after the last step by body id, the previous positions of the next frame. */
+    std::vector<glm::vec3> last_positions_;
+    /** @brief Rotations after the last step by body id. */
+    std::vector<glm::quat> last_rotations_;
+    /** @brief The step each entry of last_positions_ was written in, to skip bodies created since. */
+    std::vector<uint64_t> last_steps_;
+    /** @brief The thread. Declared last so it starts after every other member is constructed. */
+    std::thread thread_;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_PHYSICS_THREAD_H_
@@ -0,0 +1,73 @@
+/**
+ * @file render_thread.cpp
+ * @brief Implements the RenderThread class.
+ */
+#include "render_thread.h"
+
+#include <utility>
+
+namespace Piece
+{
+namespace Core
+{
+
+RenderThread::RenderThread(WAL::IWindow &window, std::function<void()> render_frame)
+    : window_(window), render_frame_(std::move(render_frame))
+{
+    window_.SetNotificationCallback(
+        [this](WAL::WindowNotification notification) { OnWindowNotification(notification); });
+    thread_ = std::thread(&RenderThread::Run, this);
+}
+
+RenderThread::~RenderThread()
+{
+    window_.SetNotificationCallback(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+}
+
+void RenderThread::SubmitFrame()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frame_pending_ = true;
+    }
+    wake_.notify_one();
+}
+
+void RenderThread::OnWindowNotification(WAL::WindowNotification notification)
+{
+    // Close requests are read through IWindow::ShouldClose by the event thread; only resizes need a new frame.
+    if (notification == WAL::WindowNotification::Resized)
+    {
+        SubmitFrame();
+    }
+}
+
+void RenderThread::Run()
+{
+    window_.SetContextCurrent(true);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        wake_.wait(lock, [this] { return stopping_ || frame_pending_; });
+        if (stopping_)
+        {
+            break;
+        }
+        frame_pending_ = false;
+        lock.unlock();
+        render_frame_();
+        frame_count_.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    lock.unlock();
+    window_.SetContextCurrent(false);
+}
+
+} // namespace Core
+} // namespace Piece
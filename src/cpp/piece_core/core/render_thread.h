@@ -0,0 +1,99 @@
+/**
+ * @file render_thread.h
+ * @brief Defines the RenderThread class, which owns a window's graphics context and renders on a dedicated thread.
+ */
+#ifndef PIECE_CORE_RENDER_THREAD_H_
+#define PIECE_CORE_RENDER_THREAD_H_
+
+#include <wal/iwindow.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief Renders and presents frames on a dedicated thread that owns the window's graphics context.
+ * @details The window's event pump stays on the thread that created it. While the OS holds that thread in a modal
+ *          loop, such as a window drag or resize, the render thread keeps presenting and re-renders as soon as the
+ *          window reports a new size, instead of the whole loop stalling until the user lets go. The event thread
+ *          hands over frames with SubmitFrame, which never waits for rendering: submissions made while a frame is
+ *          being rendered collapse into one.
+ */
+class PIECE_CORE_API RenderThread
+{
+  public:
+    /**
+     * @brief Starts the thread, which binds the window's context. Release the context on the calling thread first.
+     *        Call on the window's event thread; the thread registers for the window's notifications.
+     * @param window The window. Must outlive the thread.
+     * @param render_frame Renders and presents one frame; called on the render thread with the context current.
+     */
+    RenderThread(WAL::IWindow &window, std::function<void()> render_frame);
+
+    /**
+     * @brief Finishes the frame in progress, releases the context on the render thread and joins it.
+     *        Call on the window's event thread; the context can then be bound there again.
+     */
+    ~RenderThread();
+
+    RenderThread(const RenderThread &) = delete;
+    RenderThread &operator=(const RenderThread &) = delete;
+
+    /**
+     * @brief Asks for a new frame to be rendered. Never waits for the render thread.
+     */
+    void SubmitFrame();
+
+    /**
+     * @brief Gets the number of frames rendered so far.
+     * @return The frame count.
+     */
+    uint64_t GetFrameCount() const
+    {
+        return frame_count_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    /**
+     * @brief The loop of the render thread.
+     */
+    void Run();
+
+    /**
+     * @brief Wakes the thread to render a frame at the new size after a resize.
+     * @param notification The window change.
+     */
+    void OnWindowNotification(WAL::WindowNotification notification);
+
+    /** @brief The window presented to. */
+    WAL::IWindow &window_;
+    /** @brief Renders and presents one frame. */
+    std::function<void()> render_frame_;
+    /** @brief Guards the wake conditions. */
+    std::mutex mutex_;
+    /** @brief Wakes the thread for a submitted frame, a resize or to stop. */
+    std::condition_variable wake_;
+    /** @brief Set to ask the thread to exit. */
+    bool stopping_ = false;
+    /** @brief Set when a frame was submitted or the window resized since the last frame started. */
+    bool frame_pending_ = false;
+    /** @brief The number of frames rendered so far. */
+    std::atomic<uint64_t> frame_count_{0};
+    /** @brief The thread. Declared last so it starts after every other member is constructed. */
+    std::thread thread_;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_RENDER_THREAD_H_
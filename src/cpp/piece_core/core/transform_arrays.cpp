@@ -0,0 +1,95 @@
+/**
+ * @file transform_arrays.cpp
+ * @brief Implements the TransformArrays class.
+ */
+#include "transform_arrays.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace Piece
+{
+namespace Core
+{
+
+namespace
+{
+
+/**
+ * @brief Rounds a byte count up to the array alignment.
+ * @param size The byte count.
+ * @return The rounded byte count.
+ */
+size_t AlignUp(size_t size)
+{
+    return (size + TransformArrays::kAlignment - 1) & ~(TransformArrays::kAlignment - 1);
+}
+
+} // namespace
+
+TransformArrays::TransformArrays(uint32_t capacity)
+{
+    size_t vector3_bytes = AlignUp(sizeof(float) * 3 * capacity);
+    size_t rotation_bytes = AlignUp(sizeof(float) * 4 * capacity);
+    size_t flag_bytes = AlignUp(sizeof(uint32_t) * capacity);
+    size_t total = std::max<size_t>(vector3_bytes * 2 + rotation_bytes + flag_bytes, kAlignment);
+    storage_ = ::operator new(total, std::align_val_t(kAlignment));
+    std::memset(storage_, 0, total);
+
+    char *bytes = static_cast<char *>(storage_);
+    native_.positions = reinterpret_cast<float *>(bytes);
+    native_.rotations = reinterpret_cast<float *>(bytes + vector3_bytes);
+    native_.scales = reinterpret_cast<float *>(bytes + vector3_bytes + rotation_bytes);
+    native_.flags = reinterpret_cast<uint32_t *>(bytes + vector3_bytes * 2 + rotation_bytes);
+    native_.capacity = capacity;
+    for (uint32_t i = 0; i < capacity; ++i)
+    {
+        native_.rotations[i * 4 + 3] = 1.0f;
+        native_.scales[i * 3 + 0] = 1.0f;
+        native_.scales[i * 3 + 1] = 1.0f;
+        native_.scales[i * 3 + 2] = 1.0f;
+    }
+}
+
+TransformArrays::~TransformArrays()
+{
+    ::operator delete(storage_, std::align_val_t(kAlignment));
+}
+
+const std::vector<uint32_t> &TransformArrays::TakeManagedChanges()
+{
+    managed_changes_.clear();
+    if (native_.managed_version == taken_managed_version_)
+    {
+        return managed_changes_;
+    }
+    taken_managed_version_ = native_.managed_version;
+    for (uint32_t i = 0; i < native_.capacity; ++i)
+    {
+        if (native_.flags[i] & kTransformManagedDirty)
+        {
+            native_.flags[i] &= ~static_cast<uint32_t>(kTransformManagedDirty);
+            managed_changes_.push_back(i);
+        }
+    }
+    return managed_changes_;
+}
+
+void TransformArrays::MarkNativeChange(uint32_t index)
+{
+    native_.flags[index] |= kTransformNativeDirty;
+    native_changes_pending_ = true;
+}
+
+void TransformArrays::PublishNativeChanges()
+{
+    if (native_changes_pending_)
+    {
+        ++native_.native_version;
+        native_changes_pending_ = false;
+    }
+}
+
+} // namespace Core
+} // namespace Piece
@@ -0,0 +1,163 @@
+/**
+ * @file transform_arrays.h
+ * @brief Defines the TransformArrays class, native-owned structure-of-arrays entity transforms shared with managed
+ *        code without copies.
+ */
+#ifndef PIECE_CORE_TRANSFORM_ARRAYS_H_
+#define PIECE_CORE_TRANSFORM_ARRAYS_H_
+
+#include <piece_core/native_interop_types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief The bits of an entity's flags word. Bits from kTransformUserFlagsShift up are free for gameplay code.
+ */
+enum TransformFlags : uint32_t
+{
+    kTransformActive = 1u << 0,       /**< The slot holds an entity. */
+    kTransformManagedDirty = 1u << 1, /**< Managed code wrote the transform since native code last took changes. */
+    kTransformNativeDirty = 1u << 2,  /**< Native code wrote the transform since managed code last took changes. */
+    kTransformUserFlagsShift = 16     /**< The first bit free for gameplay code. */
+};
+
+/**
+ * @brief Entity positions, rotations, scales and flags in native memory that managed code reads and writes in place.
+ * @details The four arrays live in one allocation, each starting on a cache line, and never move until the object is
+ *          destroyed. New slots are inactive and hold the identity transform.
+ *
+ *          Neither side copies to find what the other changed: see NativeTransformArrays for the version and dirty-bit
+ *          protocol. TakeManagedChanges is the native reading half, MarkNativeChange and PublishNativeChanges the
+ *          writing half. Both sides touch the arrays only on the thread driving the engine: managed code between
+ *          updates, native code during them.
+ */
+class PIECE_CORE_API TransformArrays
+{
+  public:
+    /** @brief The alignment of each array, one cache line. */
+    static constexpr size_t kAlignment = 64;
+
+    /**
+     * @brief Allocates the arrays with every slot inactive and set to the identity transform.
+     * @param capacity The number of entity slots.
+     */
+    explicit TransformArrays(uint32_t capacity);
+
+    /**
+     * @brief Frees the arrays; spans managed code holds over them become invalid.
+     */
+    ~TransformArrays();
+
+    TransformArrays(const TransformArrays &) = delete;
+    TransformArrays &operator=(const TransformArrays &) = delete;
+
+    /**
+     * @brief Gets the control block handed to managed code.
+     * @return The array pointers, capacity and versions.
+     */
+    NativeTransformArrays *GetNative()
+    {
+        return &native_;
+    }
+
+    /**
+     * @brief Gets the number of entity slots.
+     * @return The capacity.
+     */
+    uint32_t GetCapacity() const
+    {
+        return native_.capacity;
+    }
+
+    /**
+     * @brief Gets the positions, three floats per entity.
+     * @return The position array.
+     */
+    float *GetPositions()
+    {
+        return native_.positions;
+    }
+
+    /**
+     * @brief Gets the rotation quaternions, four floats (x, y, z, w) per entity.
+     * @return The rotation array.
+     */
+    float *GetRotations()
+    {
+        return native_.rotations;
+    }
+
+    /**
+     * @brief Gets the scales, three floats per entity.
+     * @return The scale array.
+     */
+    float *GetScales()
+    {
+        return native_.scales;
+    }
+
+    /**
+     * @brief Gets the flags, one TransformFlags word per entity.
+     * @return The flags array.
+     */
+    uint32_t *GetFlags()
+    {
+        return native_.flags;
+    }
+
+    /**
+     * @brief Takes the entities managed code changed since the last call and clears their managed dirty bits.
+     *        Called once per frame by the native system that applies managed writes, such as a physics body sync;
+     *        until one exists nothing calls it and the bits stay set. The flags are only scanned if the managed
+     *        version moved.
+     * @return The indices of the changed entities, in ascending order, valid until the next call.
+     */
+    const std::vector<uint32_t> &TakeManagedChanges();
+
+    /**
+     * @brief Gets the entities the last TakeManagedChanges returned, for native systems later in the frame.
+     * @return The indices of the changed entities, in ascending order.
+     */
+    const std::vector<uint32_t> &GetManagedChanges() const
+    {
+        return managed_changes_;
+    }
+
+    /**
+     * @brief Flags an entity native code wrote to, for managed code to pick up.
+     * @param index The entity slot, less than GetCapacity.
+     */
+    void MarkNativeChange(uint32_t index);
+
+    /**
+     * @brief Bumps the native version if entities were marked since the last call, so managed code scans the flags.
+     *        Call once at the end of each native frame.
+     */
+    void PublishNativeChanges();
+
+  private:
+    /** @brief The control block with the array pointers and versions, read and written by managed code. */
+    NativeTransformArrays native_ = {};
+    /** @brief The allocation holding all four arrays. */
+    void *storage_ = nullptr;
+    /** @brief The managed version the changes were last taken at. */
+    uint64_t taken_managed_version_ = 0;
+    /** @brief The entities managed code changed, as of the last TakeManagedChanges. */
+    std::vector<uint32_t> managed_changes_;
+    /** @brief Set when an entity was marked since the native version was last bumped. */
+    bool native_changes_pending_ = false;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_TRANSFORM_ARRAYS_H_
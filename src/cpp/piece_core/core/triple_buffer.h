@@ -0,0 +1,90 @@
+/**
+ * @file triple_buffer.h
+ * @brief Defines the TripleBuffer class, a lock-free single-producer single-consumer exchange of the latest value.
+ */
+#ifndef PIECE_CORE_TRIPLE_BUFFER_H_
+#define PIECE_CORE_TRIPLE_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief Passes the most recent version of a value from one producer thread to one consumer thread without locks.
+ * @details The producer fills the write buffer and publishes it; the consumer picks up the newest published buffer
+ *          and reads it for as long as it likes. Neither side ever waits: the third buffer sits in between and the
+ *          two sides only exchange its index. Versions the consumer does not pick up in time are overwritten, and
+ *          buffers are reused rather than cleared, so large values keep their storage.
+ * @tparam T The value type.
+ */
+template <typename T> class TripleBuffer
+{
+  public:
+    /**
+     * @brief Gets the buffer the producer writes the next version into.
+     * @return The write buffer. Producer thread only.
+     */
+    T &GetWriteBuffer()
+    {
+        return buffers_[write_index_];
+    }
+
+    /**
+     * @brief Publishes the write buffer as the newest version and takes over the in-between buffer for writing.
+     *        Producer thread only.
+     */
+    void Publish()
+    {
+        uint8_t previous = middle_.exchange(static_cast<uint8_t>(write_index_ | kFreshBit), std::memory_order_acq_rel);
+        write_index_ = previous & kIndexMask;
+    }
+
+    /**
+     * @brief Switches the read buffer to the newest published version, if there is one the consumer has not seen.
+     *        Consumer thread only.
+     * @return True if the read buffer changed.
+     */
+    bool Update()
+    {
+        if ((middle_.load(std::memory_order_relaxed) & kFreshBit) == 0)
+        {
+            return false;
+        }
+        uint8_t previous = middle_.exchange(read_index_, std::memory_order_acq_rel);
+        read_index_ = previous & kIndexMask;
+        return true;
+    }
+
+    /**
+     * @brief Gets the version the consumer picked up last.
+     * @return The read buffer, default-constructed until the first Update that returned true. Consumer thread only.
+     */
+    const T &GetReadBuffer() const
+    {
+        return buffers_[read_index_];
+    }
+
+  private:
+    /** @brief Marks the in-between buffer as published and not picked up yet. */
+    static constexpr uint8_t kFreshBit = 4;
+    /** @brief Extracts the buffer index from the in-between state. */
+    static constexpr uint8_t kIndexMask = 3;
+
+    /** @brief The three buffers. */
+    T buffers_[3] = {};
+    /** @brief The producer's buffer, on its own cache line so the two sides do not share one. */
+    alignas(64) uint8_t write_index_ = 0;
+    /** @brief The index of the in-between buffer, plus kFreshBit while it holds an unseen version. */
+    alignas(64) std::atomic<uint8_t> middle_{1};
+    /** @brief The consumer's buffer. */
+    alignas(64) uint8_t read_index_ = 2;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_TRIPLE_BUFFER_H_
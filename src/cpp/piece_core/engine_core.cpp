@@ -6,11 +6,15 @@
 
 #include <pal/iphysics_world.h>
 #include <ral/igraphics_device.h>
+#include <ral/interfaces/irender_target.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 #include <wal/iwindow.h>
 
+#include <algorithm>
+#include <cstddef>
+
 #include "core/service_locator.h"
 #include "logging_api.h"
 #include "native_exports.h"
@@ -45,7 +49,7 @@ void InitializeLogger()
 /**
  * @brief Constructs the EngineCore, initializing all major systems.
  */
-EngineCore::EngineCore()
+EngineCore::EngineCore() : job_system_(std::make_unique<JobSystem>())
 {
     IWindowFactory *windowFactory = ServiceLocator::Get().GetWindowFactory();
     IGraphicsDeviceFactory *graphicsFactory = ServiceLocator::Get().GetGraphicsDeviceFactory();
@@ -87,45 +91,541 @@ EngineCore::EngineCore()
     }
     spdlog::info("IGraphicsDevice created.");
 
-    Piece::Core::NativePhysicsOptions defaultPhysicsOptions = {1.0f / 60.0f, 4};
-    physics_world_ = physicsFactory->CreatePhysicsWorld(&defaultPhysicsOptions);
+    resource_manager_ = std::make_unique<ResourceManager>(*job_system_, *graphics_device_);
+    spdlog::info("ResourceManager created with {} job workers.", job_system_->GetWorkerCount());
+
+    physics_world_ = physicsFactory->CreatePhysicsWorld(&physics_options_);
     if (!physics_world_)
     {
         spdlog::error("Failed to create IPhysicsWorld instance.");
         return;
     }
+    physics_task_scheduler_ = std::make_unique<JobSystemTaskScheduler>(*job_system_);
+    physics_world_->SetTaskScheduler(physics_task_scheduler_.get());
+    physics_world_->Init();
     spdlog::info("IPhysicsWorld created.");
     spdlog::info("EngineCore: Initialized successfully.");
 }
 
 /**
- * @brief Destroys the EngineCore.
+ * @brief Destroys the EngineCore, first stopping the render thread so the context is current on this thread while the
+ *        resource manager and graphics device free their GPU objects.
  */
 EngineCore::~EngineCore()
 {
+    SetRenderThreadEnabled(false);
     spdlog::info("EngineCore: Destroyed.");
 }
 
 /**
- * @brief Updates the physics world.
- * @param deltaTime The time since the last update.
+ * @brief Executes the queued commands, polls the window events, records or replays them, hands them to the latency
+ *        tracker, updates the physics world and publishes the native transform changes.
+ * @param deltaTime The time since the last update; replaced by the recorded one during a replay.
  */
 void EngineCore::Update(float deltaTime)
 {
-    if (physics_world_)
+    if (command_ring_)
+    {
+        ExecuteCommands();
+    }
+    if (window_)
+    {
+        window_->PollEvents();
+        if (replay_window_)
+        {
+            deltaTime = replay_window_->GetFrameDeltaTime();
+        }
+        if (input_recording_)
+        {
+            input_recording_->RecordFrame(deltaTime, *window_);
+        }
+        input_latency_.AddInput(*window_);
+    }
+    frame_delta_time_ = deltaTime;
+    if (physics_world_ && !physics_thread_)
     {
         physics_world_->Step(deltaTime);
     }
+    if (transform_arrays_)
+    {
+        transform_arrays_->PublishNativeChanges();
+    }
+}
+
+/**
+ * @brief Starts or stops the physics thread.
+ * @param enabled True to step physics on its own thread.
+ */
+void EngineCore::SetPhysicsThreadEnabled(bool enabled)
+{
+    if (!physics_world_ || enabled == (physics_thread_ != nullptr))
+    {
+        return;
+    }
+    if (enabled)
+    {
+        physics_thread_ = std::make_unique<PhysicsThread>(*physics_world_, physics_options_.fixed_delta_time,
+                                                          physics_options_.max_physics_steps);
+        spdlog::info("Physics thread started at {} steps per second.", 1.0f / physics_options_.fixed_delta_time);
+    }
+    else
+    {
+        physics_thread_.reset();
+        spdlog::info("Physics thread stopped.");
+    }
 }
 
 /**
- * @brief Renders a frame.
+ * @brief Renders a frame, or hands it to the render thread.
  */
 void EngineCore::Render()
 {
-    if (window_ && graphics_device_)
+    if (render_thread_)
+    {
+        render_thread_->SubmitFrame();
+    }
+    else if (window_ && graphics_device_)
+    {
+        RenderFrame();
+    }
+}
+
+/**
+ * @brief Starts or stops the render thread, moving the window's graphics context along.
+ * @param enabled True to render on the render thread.
+ */
+void EngineCore::SetRenderThreadEnabled(bool enabled)
+{
+    if (!window_ || !graphics_device_ || enabled == (render_thread_ != nullptr))
+    {
+        return;
+    }
+    if (enabled)
+    {
+        window_->SetContextCurrent(false);
+        render_thread_ = std::make_unique<RenderThread>(*window_, [this] { RenderFrame(); });
+        spdlog::info("Render thread started.");
+    }
+    else
+    {
+        render_thread_.reset();
+        window_->SetContextCurrent(true);
+        spdlog::info("Render thread stopped.");
+    }
+}
+
+/**
+ * @brief Allocates new transform arrays in place of the current ones.
+ * @param capacity The number of entity slots.
+ * @return The control block, or nullptr if the arrays were freed.
+ */
+NativeTransformArrays *EngineCore::CreateTransformArrays(uint32_t capacity)
+{
+    transform_arrays_.reset();
+    if (capacity == 0)
+    {
+        return nullptr;
+    }
+    transform_arrays_ = std::make_unique<TransformArrays>(capacity);
+    spdlog::info("Transform arrays created for {} entities.", capacity);
+    return transform_arrays_->GetNative();
+}
+
+/**
+ * @brief Allocates a new command ring in place of the current one.
+ * @param capacity The number of command slots.
+ * @return The control block, or nullptr if the ring was freed.
+ */
+NativeCommandRing *EngineCore::CreateCommandRing(uint32_t capacity)
+{
+    command_ring_.reset();
+    if (capacity == 0)
+    {
+        return nullptr;
+    }
+    command_ring_ = std::make_unique<CommandRing>(capacity);
+    spdlog::info("Command ring created with {} slots.", command_ring_->GetCapacity());
+    return command_ring_->GetNative();
+}
+
+/**
+ * @brief Sorts the queued commands into batches and executes them.
+ */
+void EngineCore::ExecuteCommands()
+{
+    transform_commands_.clear();
+    impulse_bodies_.clear();
+    impulses_.clear();
+    uint32_t unknown = 0;
+    uint32_t drained = command_ring_->Drain([this, &unknown](const NativeCommand &command) {
+        switch (static_cast<CommandType>(command.type))
+        {
+        case CommandType::Spawn:
+        case CommandType::Destroy:
+        case CommandType::SetTransform:
+            transform_commands_.push_back(command);
+            break;
+        case CommandType::ApplyImpulse:
+            impulse_bodies_.push_back(command.target);
+            impulses_.emplace_back(command.values[0], command.values[1], command.values[2]);
+            break;
+        default:
+            ++unknown;
+            break;
+        }
+    });
+    if (drained == 0)
+    {
+        return;
+    }
+    if (unknown != 0)
+    {
+        spdlog::warn("Command ring: dropped {} commands of unsupported types.", unknown);
+    }
+
+    // Sorted by entity, the writes sweep the arrays front to back; the stable sort keeps each entity's commands in
+    // the order they were enqueued.
+    auto by_entity = [](const NativeCommand &a, const NativeCommand &b) { return a.entity < b.entity; };
+    std::stable_sort(transform_commands_.begin(), transform_commands_.end(), by_entity);
+
+    // Each entity ends up as its last command left it, so a destroy followed by a spawn in one batch reuses the slot.
+    if (transform_arrays_ && !transform_commands_.empty())
+    {
+        TransformArrays &arrays = *transform_arrays_;
+        uint32_t *flags = arrays.GetFlags();
+        for (const NativeCommand &command : transform_commands_)
+        {
+            uint32_t entity = command.entity;
+            if (entity >= arrays.GetCapacity())
+            {
+                continue;
+            }
+            CommandType type = static_cast<CommandType>(command.type);
+            if (type == CommandType::Destroy)
+            {
+                flags[entity] = kTransformManagedDirty;
+                continue;
+            }
+            if (type == CommandType::SetTransform && (flags[entity] & kTransformActive) == 0)
+            {
+                continue;
+            }
+            std::copy_n(command.values, 3, arrays.GetPositions() + entity * 3);
+            std::copy_n(command.values + 3, 4, arrays.GetRotations() + entity * 4);
+            std::copy_n(command.values + 7, 3, arrays.GetScales() + entity * 3);
+            flags[entity] |= kTransformActive | kTransformManagedDirty;
+        }
+        // The changes reach native systems like direct writes from managed code do.
+        ++arrays.GetNative()->managed_version;
+    }
+
+    if (!impulse_bodies_.empty() && physics_world_)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld();
+        physics_world_->ApplyImpulses(impulse_bodies_.data(), impulses_.data(),
+                                      static_cast<uint32_t>(impulse_bodies_.size()));
+    }
+}
+
+/**
+ * @brief Starts a new input recording from the window's current input state.
+ * @return True if recording started.
+ */
+bool EngineCore::StartInputRecording()
+{
+    if (!window_)
+    {
+        return false;
+    }
+    input_recording_ = std::make_unique<WAL::InputRecording>();
+    input_recording_->Start(window_->GetInputState());
+    spdlog::info("Input recording started.");
+    return true;
+}
+
+/**
+ * @brief Stops the input recording and saves it.
+ * @param path The file path, or nullptr to discard the recording.
+ * @return True if the recording was written.
+ */
+bool EngineCore::StopInputRecording(const char *path)
+{
+    if (!input_recording_)
+    {
+        return false;
+    }
+    std::unique_ptr<WAL::InputRecording> recording = std::move(input_recording_);
+    if (!path)
+    {
+        spdlog::info("Input recording discarded.");
+        return false;
+    }
+    if (!recording->Save(path))
+    {
+        spdlog::error("Failed to write the input recording to '{}'.", path);
+        return false;
+    }
+    spdlog::info("Input recording of {} frames written to '{}'.", recording->GetFrameCount(), path);
+    return true;
+}
+
+/**
+ * @brief Loads a recording and wraps the window in a replay of it, or restarts the running replay with it.
+ * @param path The recording file.
+ * @return True if the replay started.
+ */
+bool EngineCore::StartInputReplay(const char *path)
+{
+    WAL::InputRecording recording;
+    if (!window_ || !path || !recording.Load(path))
+    {
+        spdlog::error("Failed to load the input recording '{}'.", path ? path : "");
+        return false;
+    }
+    spdlog::info("Replaying {} recorded frames from '{}'.", recording.GetFrameCount(), path);
+    if (replay_window_)
+    {
+        replay_window_->SetRecording(std::move(recording));
+        return true;
+    }
+    // The render thread holds on to the window it was started with, so it is restarted on the wrapper. The graphics
+    // device keeps using the wrapped window, which stays alive inside it.
+    bool render_threaded = render_thread_ != nullptr;
+    SetRenderThreadEnabled(false);
+    auto replay_window = std::make_unique<WAL::ReplayWindow>(std::move(window_), std::move(recording));
+    replay_window_ = replay_window.get();
+    window_ = std::move(replay_window);
+    SetRenderThreadEnabled(render_threaded);
+    return true;
+}
+
+/**
+ * @brief Uploads pending resources, draws the offscreen viewports, the extra windows and the main window, and
+ *        presents the windows. The frame consumes the input polled since the previous frame started.
+ */
+void EngineCore::RenderFrame()
+{
+    input_latency_.BeginFrame();
+    resource_manager_->Update();
+    {
+        std::lock_guard<std::mutex> lock(viewports_mutex_);
+        for (RAL::RenderTargetHandle render_target : retired_render_targets_)
+        {
+            graphics_device_->DestroyRenderTarget(render_target);
+        }
+        retired_render_targets_.clear();
+        if (!viewports_.empty())
+        {
+            // Framebuffer objects are not shared between contexts, so every render target is drawn with the main
+            // window's context current.
+            for (Viewport &viewport : viewports_)
+            {
+                if (viewport.window)
+                {
+                    continue;
+                }
+                RAL::RenderTargetDesc desc;
+                desc.width = static_cast<uint32_t>(viewport.requested_size.first);
+                desc.height = static_cast<uint32_t>(viewport.requested_size.second);
+                RAL::IRenderTarget *target = graphics_device_->GetRenderTarget(viewport.render_target);
+                if (!target)
+                {
+                    viewport.render_target = graphics_device_->CreateRenderTarget(desc);
+                }
+                else if (target->GetDesc().width != desc.width || target->GetDesc().height != desc.height)
+                {
+                    target->Resize(desc.width, desc.height);
+                }
+                graphics_device_->SetRenderTarget(viewport.render_target);
+                DrawView(viewport.requested_size, viewport.framebuffer_size);
+            }
+            graphics_device_->SetRenderTarget({});
+
+            // Extra windows present without waiting for vsync, so only the main window paces the frame.
+            bool drew_window = false;
+            for (Viewport &viewport : viewports_)
+            {
+                if (viewport.window)
+                {
+                    viewport.window->SetContextCurrent(true);
+                    DrawView(viewport.window->GetFramebufferSize(), viewport.framebuffer_size);
+                    viewport.window->SwapBuffers();
+                    drew_window = true;
+                }
+            }
+            if (drew_window)
+            {
+                window_->SetContextCurrent(true);
+            }
+        }
+    }
+    DrawView(window_->GetFramebufferSize(), framebuffer_size_);
+    window_->SwapBuffers();
+    input_latency_.EndFrame(WAL::InputEventQueue::Now());
+}
+
+/**
+ * @brief Follows size changes with the render context's viewport and draws one view.
+ * @param size The size drawn to.
+ * @param last_size The size last drawn at.
+ */
+void EngineCore::DrawView(std::pair<int, int> size, std::pair<int, int> &last_size)
+{
+    if (size != last_size)
+    {
+        last_size = size;
+        if (RAL::IRenderContext *context = graphics_device_->GetImmediateContext())
+        {
+            context->SetViewport(0.0f, 0.0f, static_cast<float>(size.first), static_cast<float>(size.second));
+        }
+    }
+    graphics_device_->BeginFrame();
+    graphics_device_->EndFrame();
+}
+
+/**
+ * @brief Creates a window or offscreen viewport sharing the graphics device.
+ * @param width The width in pixels.
+ * @param height The height in pixels.
+ * @param title The window title.
+ * @param offscreen True for an offscreen render target.
+ * @return The viewport id, or 0 on failure.
+ */
+uint32_t EngineCore::CreateViewport(int width, int height, const char *title, bool offscreen)
+{
+    if (!window_ || !graphics_device_ || width <= 0 || height <= 0)
+    {
+        return 0;
+    }
+    Viewport viewport;
+    if (offscreen)
+    {
+        // The render target itself is created by the next frame, on the thread that owns the graphics context.
+        viewport.requested_size = {width, height};
+    }
+    else
+    {
+        IWindowFactory *windowFactory = ServiceLocator::Get().GetWindowFactory();
+        Piece::Core::NativeWindowOptions windowOptions = {width, height, 0, title ? title : "Piece Engine Viewport"};
+        viewport.window = windowFactory ? windowFactory->CreateWindow(&windowOptions) : nullptr;
+        if (!viewport.window)
+        {
+            spdlog::error("Failed to create viewport window.");
+            return 0;
+        }
+        WAL::PresentOptions presentOptions;
+        presentOptions.mode = WAL::PresentMode::Uncapped;
+        viewport.window->SetPresentOptions(presentOptions);
+        // The new window's context became current here; hand the thread back to the main window or the render
+        // thread.
+        viewport.window->SetContextCurrent(false);
+        if (!render_thread_)
+        {
+            window_->SetContextCurrent(true);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(viewports_mutex_);
+    viewport.id = next_viewport_id_++;
+    viewports_.push_back(std::move(viewport));
+    spdlog::info("Viewport {} created ({}x{}, {}).", viewports_.back().id, width, height,
+                 offscreen ? "offscreen" : "window");
+    return viewports_.back().id;
+}
+
+/**
+ * @brief Destroys a viewport.
+ * @param id The viewport id.
+ */
+void EngineCore::DestroyViewport(uint32_t id)
+{
+    std::unique_ptr<WAL::IWindow> window;
+    {
+        std::lock_guard<std::mutex> lock(viewports_mutex_);
+        auto it = std::find_if(viewports_.begin(), viewports_.end(),
+                               [id](const Viewport &viewport) { return viewport.id == id; });
+        if (it == viewports_.end())
+        {
+            return;
+        }
+        if (!it->render_target.IsNull())
+        {
+            retired_render_targets_.push_back(it->render_target);
+        }
+        window = std::move(it->window);
+        viewports_.erase(it);
+    }
+    // Closed outside the lock; the rendering thread no longer reaches it.
+    window.reset();
+}
+
+/**
+ * @brief Resizes an offscreen viewport; the next frame reallocates its render target.
+ * @param id The viewport id.
+ * @param width The new width in pixels.
+ * @param height The new height in pixels.
+ * @return True if the viewport was resized.
+ */
+bool EngineCore::ResizeViewport(uint32_t id, int width, int height)
+{
+    std::lock_guard<std::mutex> lock(viewports_mutex_);
+    Viewport *viewport = FindViewport(id);
+    if (!viewport || viewport->window || width <= 0 || height <= 0)
     {
+        return false;
     }
+    viewport->requested_size = {width, height};
+    return true;
+}
+
+/**
+ * @brief Gets the window of a viewport.
+ * @param id The viewport id.
+ * @return The window, or nullptr.
+ */
+WAL::IWindow *EngineCore::GetViewportWindow(uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(viewports_mutex_);
+    Viewport *viewport = FindViewport(id);
+    return viewport ? viewport->window.get() : nullptr;
+}
+
+/**
+ * @brief Gets the render target of an offscreen viewport.
+ * @param id The viewport id.
+ * @return The render target, or the null handle.
+ */
+RAL::RenderTargetHandle EngineCore::GetViewportRenderTarget(uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(viewports_mutex_);
+    Viewport *viewport = FindViewport(id);
+    return viewport ? viewport->render_target : RAL::RenderTargetHandle{};
+}
+
+/**
+ * @brief Gets the color attachment of an offscreen viewport, under the lock the rendering thread creates and resizes
+ *        render targets under.
+ * @param id The viewport id.
+ * @return The renderer ID, or 0.
+ */
+uint32_t EngineCore::GetViewportColorTexture(uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(viewports_mutex_);
+    Viewport *viewport = FindViewport(id);
+    RAL::IRenderTarget *target = viewport ? graphics_device_->GetRenderTarget(viewport->render_target) : nullptr;
+    return target ? target->GetColorRendererID() : 0;
+}
+
+/**
+ * @brief Finds a viewport by id.
+ * @param id The viewport id.
+ * @return The viewport, or nullptr.
+ */
+EngineCore::Viewport *EngineCore::FindViewport(uint32_t id)
+{
+    auto it = std::find_if(viewports_.begin(), viewports_.end(),
+                           [id](const Viewport &viewport) { return viewport.id == id; });
+    return it != viewports_.end() ? &*it : nullptr;
 }
 
 } // namespace Core
@@ -239,6 +739,496 @@ extern "C"
         }
     }
 
+    /**
+     * @brief Locks the physics world against the physics thread for the duration of an export.
+     * @param corePtr A pointer to the EngineCore instance, or nullptr.
+     * @return The lock, empty without an engine or physics thread.
+     */
+    static std::unique_lock<std::mutex> LockPhysicsWorld(Piece::Core::EngineCore *corePtr)
+    {
+        return corePtr ? corePtr->LockPhysicsWorld() : std::unique_lock<std::mutex>();
+    }
+
+    /**
+     * @brief C-style export to get the number of physics bodies.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @return The body count, or 0 without a physics world.
+     */
+    uint32_t Engine_GetBodyCount(Piece::Core::EngineCore *corePtr)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr;
+        return world ? world->GetBodyCount() : 0;
+    }
+
+    /**
+     * @brief C-style export to get the number of awake physics bodies.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @return The awake body count, or 0 without a physics world.
+     */
+    uint32_t Engine_GetAwakeBodyCount(Piece::Core::EngineCore *corePtr)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr;
+        return world ? world->GetAwakeBodyCount() : 0;
+    }
+
+    /**
+     * @brief Converts interop state arrays to the PAL view of the same memory.
+     * @param states The interop arrays.
+     * @return The PAL arrays.
+     */
+    static Piece::PAL::BodyStateArrays ToBodyStateArrays(const Piece::Core::NativeBodyStateArrays &states)
+    {
+        static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "glm::vec3 must be three packed floats");
+        static_assert(sizeof(glm::quat) == 4 * sizeof(float), "glm::quat must be four packed floats");
+        Piece::PAL::BodyStateArrays arrays;
+        arrays.ids = states.ids;
+        arrays.positions = reinterpret_cast<glm::vec3 *>(states.positions);
+        arrays.rotations = reinterpret_cast<glm::quat *>(states.rotations);
+        arrays.linear_velocities = reinterpret_cast<glm::vec3 *>(states.linear_velocities);
+        arrays.angular_velocities = reinterpret_cast<glm::vec3 *>(states.angular_velocities);
+        return arrays;
+    }
+
+    /**
+     * @brief C-style export to copy the state of many physics bodies into caller-provided arrays.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param states The destination arrays.
+     * @param capacity The number of bodies the arrays hold.
+     * @param movedOnly Non-zero to only write bodies moved during the last update.
+     * @return The number of bodies written.
+     */
+    uint32_t Engine_ReadBodyStates(Piece::Core::EngineCore *corePtr, const Piece::Core::NativeBodyStateArrays *states,
+                                   uint32_t capacity, uint32_t movedOnly)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr;
+        if (!world || !states)
+        {
+            return 0;
+        }
+        return world->ReadBodyStates(ToBodyStateArrays(*states), capacity, movedOnly != 0);
+    }
+
+    /**
+     * @brief C-style export to set the state of many physics bodies from caller-provided arrays.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param states The source arrays.
+     * @param count The number of bodies to update.
+     */
+    void Engine_WriteBodyStates(Piece::Core::EngineCore *corePtr, const Piece::Core::NativeBodyStateArrays *states,
+                                uint32_t count)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr;
+        if (world && states)
+        {
+            world->WriteBodyStates(ToBodyStateArrays(*states), count);
+        }
+    }
+
+    /**
+     * @brief C-style export to save the physics state into a buffer.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param buffer The destination, or nullptr to only get the size.
+     * @param capacity The size of buffer in bytes.
+     * @return The snapshot size in bytes, or 0 without a physics world.
+     */
+    uint64_t Engine_SavePhysicsSnapshot(Piece::Core::EngineCore *corePtr, void *buffer, uint64_t capacity)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr;
+        return world ? world->SaveSnapshot(buffer, static_cast<size_t>(capacity)) : 0;
+    }
+
+    /**
+     * @brief C-style export to restore a physics state saved by Engine_SavePhysicsSnapshot.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param snapshot The snapshot.
+     * @param size The size of the snapshot in bytes.
+     * @return 1 on success, otherwise 0.
+     */
+    uint32_t Engine_RestorePhysicsSnapshot(Piece::Core::EngineCore *corePtr, const void *snapshot, uint64_t size)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr;
+        return world && world->RestoreSnapshot(snapshot, static_cast<size_t>(size)) ? 1u : 0u;
+    }
+
+    /**
+     * @brief C-style export to move physics stepping to its own thread or back into Engine_Update.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param enabled Non-zero to step physics on its own thread.
+     */
+    void Engine_SetPhysicsThreadEnabled(Piece::Core::EngineCore *corePtr, uint32_t enabled)
+    {
+        if (corePtr)
+        {
+            corePtr->SetPhysicsThreadEnabled(enabled != 0);
+        }
+    }
+
+    /**
+     * @brief C-style export to copy the body transforms published by the physics thread, interpolated for now.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param states The destination arrays. Only ids, positions and rotations are written.
+     * @param capacity The number of bodies the arrays hold.
+     * @return The number of bodies written, 0 without a physics thread.
+     */
+    uint32_t Engine_ReadInterpolatedBodyStates(Piece::Core::EngineCore *corePtr,
+                                               const Piece::Core::NativeBodyStateArrays *states, uint32_t capacity)
+    {
+        Piece::Core::PhysicsThread *thread = corePtr ? corePtr->GetPhysicsThread() : nullptr;
+        if (!thread || !states)
+        {
+            return 0;
+        }
+        Piece::PAL::BodyStateArrays arrays = ToBodyStateArrays(*states);
+        return thread->ReadInterpolatedStates(arrays.ids, arrays.positions, arrays.rotations, capacity,
+                                              std::chrono::steady_clock::now());
+    }
+
+    /**
+     * @brief C-style export to enable or disable deterministic physics stepping.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param enabled Non-zero to enable.
+     */
+    void Engine_SetPhysicsDeterministic(Piece::Core::EngineCore *corePtr, uint32_t enabled)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        if (Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr)
+        {
+            world->SetDeterministic(enabled != 0);
+        }
+    }
+
+    /**
+     * @brief C-style export to get the hash of the physics state.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @return The hash, or 0 without a physics world.
+     */
+    uint64_t Engine_GetPhysicsStateHash(Piece::Core::EngineCore *corePtr)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr;
+        return world ? world->GetStateHash() : 0;
+    }
+
+    static_assert(sizeof(Piece::Core::NativeInputEvent) == sizeof(Piece::WAL::InputEvent) &&
+                      offsetof(Piece::Core::NativeInputEvent, x) == offsetof(Piece::WAL::InputEvent, x),
+                  "NativeInputEvent must match the layout of WAL::InputEvent.");
+
+    /**
+     * @brief C-style export to copy the input events of the current frame.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param events The destination array, or nullptr to only get the count.
+     * @param capacity The number of events the array holds.
+     * @return The number of events in the frame.
+     */
+    uint32_t Engine_ReadInputEvents(Piece::Core::EngineCore *corePtr, Piece::Core::NativeInputEvent *events,
+                                    uint32_t capacity)
+    {
+        Piece::WAL::IWindow *window = corePtr ? corePtr->GetWindow() : nullptr;
+        return window ? window->ReadInputEvents(reinterpret_cast<Piece::WAL::InputEvent *>(events), capacity) : 0;
+    }
+
+    /**
+     * @brief C-style export to move rendering to its own thread or back into Engine_Render.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param enabled Non-zero to render on the render thread.
+     */
+    void Engine_SetRenderThreadEnabled(Piece::Core::EngineCore *corePtr, uint32_t enabled)
+    {
+        if (corePtr)
+        {
+            corePtr->SetRenderThreadEnabled(enabled != 0);
+        }
+    }
+
+    /**
+     * @brief C-style export to create a window or offscreen viewport.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param width The width in pixels.
+     * @param height The height in pixels.
+     * @param title The window title, or nullptr.
+     * @param offscreen Non-zero for an offscreen render target.
+     * @return The viewport id, or 0 on failure.
+     */
+    uint32_t Engine_CreateViewport(Piece::Core::EngineCore *corePtr, int32_t width, int32_t height, const char *title,
+                                   uint32_t offscreen)
+    {
+        return corePtr ? corePtr->CreateViewport(width, height, title, offscreen != 0) : 0;
+    }
+
+    /**
+     * @brief C-style export to destroy a viewport.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param viewportId The viewport id.
+     */
+    void Engine_DestroyViewport(Piece::Core::EngineCore *corePtr, uint32_t viewportId)
+    {
+        if (corePtr)
+        {
+            corePtr->DestroyViewport(viewportId);
+        }
+    }
+
+    /**
+     * @brief C-style export to resize an offscreen viewport.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param viewportId The viewport id.
+     * @param width The new width in pixels.
+     * @param height The new height in pixels.
+     * @return 1 if the viewport was resized, otherwise 0.
+     */
+    uint32_t Engine_ResizeViewport(Piece::Core::EngineCore *corePtr, uint32_t viewportId, int32_t width,
+                                   int32_t height)
+    {
+        return corePtr && corePtr->ResizeViewport(viewportId, width, height) ? 1u : 0u;
+    }
+
+    /**
+     * @brief C-style export to get the color attachment of an offscreen viewport.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param viewportId The viewport id.
+     * @return The renderer ID, or 0.
+     */
+    uint32_t Engine_GetViewportColorTexture(Piece::Core::EngineCore *corePtr, uint32_t viewportId)
+    {
+        return corePtr ? corePtr->GetViewportColorTexture(viewportId) : 0;
+    }
+
+    /**
+     * @brief C-style export to check if a window viewport should close.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param viewportId The viewport id.
+     * @return 1 if the window should close, otherwise 0.
+     */
+    uint32_t Engine_ViewportShouldClose(Piece::Core::EngineCore *corePtr, uint32_t viewportId)
+    {
+        Piece::WAL::IWindow *window = corePtr ? corePtr->GetViewportWindow(viewportId) : nullptr;
+        return window && window->ShouldClose() ? 1u : 0u;
+    }
+
+    /**
+     * @brief C-style export to copy the input events of a window viewport.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param viewportId The viewport id.
+     * @param events The destination array, or nullptr to only get the count.
+     * @param capacity The number of events the array holds.
+     * @return The number of events in the frame.
+     */
+    uint32_t Engine_ReadViewportInputEvents(Piece::Core::EngineCore *corePtr, uint32_t viewportId,
+                                            Piece::Core::NativeInputEvent *events, uint32_t capacity)
+    {
+        Piece::WAL::IWindow *window = corePtr ? corePtr->GetViewportWindow(viewportId) : nullptr;
+        return window ? window->ReadInputEvents(reinterpret_cast<Piece::WAL::InputEvent *>(events), capacity) : 0;
+    }
+
+    /**
+     * @brief C-style export to set the window's present mode and frame pacing.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param mode The WAL::PresentMode value.
+     * @param maxFrameRate The frame rate limit of the capped mode.
+     * @param lowLatency Non-zero to start frames just in time for the predicted present.
+     */
+    void Engine_SetPresentOptions(Piece::Core::EngineCore *corePtr, uint32_t mode, float maxFrameRate,
+                                  uint32_t lowLatency)
+    {
+        Piece::WAL::IWindow *window = corePtr ? corePtr->GetWindow() : nullptr;
+        if (window && mode <= static_cast<uint32_t>(Piece::WAL::PresentMode::Capped))
+        {
+            Piece::WAL::PresentOptions options;
+            options.mode = static_cast<Piece::WAL::PresentMode>(mode);
+            options.max_frame_rate = maxFrameRate;
+            options.low_latency = lowLatency != 0;
+            window->SetPresentOptions(options);
+        }
+    }
+
+    /**
+     * @brief C-style export to check if the main window should close.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @return 1 if the window should close.
+     */
+    uint32_t Engine_ShouldClose(Piece::Core::EngineCore *corePtr)
+    {
+        Piece::WAL::IWindow *window = corePtr ? corePtr->GetWindow() : nullptr;
+        return window && window->ShouldClose() ? 1u : 0u;
+    }
+
+    /**
+     * @brief C-style export to start recording input.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @return 1 if recording started.
+     */
+    uint32_t Engine_StartInputRecording(Piece::Core::EngineCore *corePtr)
+    {
+        return corePtr && corePtr->StartInputRecording() ? 1u : 0u;
+    }
+
+    /**
+     * @brief C-style export to stop recording input and save the recording.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param path The file path, or nullptr to discard the recording.
+     * @return 1 if the recording was written.
+     */
+    uint32_t Engine_StopInputRecording(Piece::Core::EngineCore *corePtr, const char *path)
+    {
+        return corePtr && corePtr->StopInputRecording(path) ? 1u : 0u;
+    }
+
+    /**
+     * @brief C-style export to replay an input recording.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param path The recording file.
+     * @return 1 if the replay started.
+     */
+    uint32_t Engine_StartInputReplay(Piece::Core::EngineCore *corePtr, const char *path)
+    {
+        return corePtr && corePtr->StartInputReplay(path) ? 1u : 0u;
+    }
+
+    /**
+     * @brief C-style export to get the delta time of the last update.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @return The delta time in seconds.
+     */
+    float Engine_GetFrameDeltaTime(Piece::Core::EngineCore *corePtr)
+    {
+        return corePtr ? corePtr->GetFrameDeltaTime() : 0.0f;
+    }
+
+    /**
+     * @brief C-style export to allocate the entity transform arrays shared with managed code.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param capacity The number of entity slots; 0 frees the arrays.
+     * @return The control block, or nullptr.
+     */
+    Piece::Core::NativeTransformArrays *Engine_CreateTransformArrays(Piece::Core::EngineCore *corePtr,
+                                                                     uint32_t capacity)
+    {
+        return corePtr ? corePtr->CreateTransformArrays(capacity) : nullptr;
+    }
+
+    /**
+     * @brief C-style export to get the entity transform arrays shared with managed code.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @return The control block, or nullptr if none were created.
+     */
+    Piece::Core::NativeTransformArrays *Engine_GetTransformArrays(Piece::Core::EngineCore *corePtr)
+    {
+        Piece::Core::TransformArrays *arrays = corePtr ? corePtr->GetTransformArrays() : nullptr;
+        return arrays ? arrays->GetNative() : nullptr;
+    }
+
+    /**
+     * @brief C-style export to allocate the command ring managed code enqueues commands into.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param capacity The number of command slots; 0 frees the ring.
+     * @return The control block, or nullptr.
+     */
+    Piece::Core::NativeCommandRing *Engine_CreateCommandRing(Piece::Core::EngineCore *corePtr, uint32_t capacity)
+    {
+        return corePtr ? corePtr->CreateCommandRing(capacity) : nullptr;
+    }
+
+    /**
+     * @brief C-style export to get the command ring managed code enqueues commands into.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @return The control block, or nullptr if none was created.
+     */
+    Piece::Core::NativeCommandRing *Engine_GetCommandRing(Piece::Core::EngineCore *corePtr)
+    {
+        Piece::Core::CommandRing *ring = corePtr ? corePtr->GetCommandRing() : nullptr;
+        return ring ? ring->GetNative() : nullptr;
+    }
+
+    /**
+     * @brief C-style export to get the input-to-present latency percentiles.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param stats The destination.
+     */
+    void Engine_GetInputLatencyStats(Piece::Core::EngineCore *corePtr, Piece::Core::NativeLatencyStats *stats)
+    {
+        if (!stats)
+        {
+            return;
+        }
+        Piece::Core::LatencyStats latency = corePtr ? corePtr->GetInputLatencyStats() : Piece::Core::LatencyStats();
+        stats->sample_count = latency.sample_count;
+        stats->p50_ms = latency.p50_ms;
+        stats->p90_ms = latency.p90_ms;
+        stats->p99_ms = latency.p99_ms;
+        stats->max_ms = latency.max_ms;
+    }
+
+    /**
+     * @brief C-style export to drop the input latency samples.
+     * @param corePtr A pointer to the EngineCore instance.
+     */
+    void Engine_ResetInputLatencyStats(Piece::Core::EngineCore *corePtr)
+    {
+        if (corePtr)
+        {
+            corePtr->ResetInputLatencyStats();
+        }
+    }
+
+    static_assert(sizeof(Piece::Core::NativeContactEvent) == sizeof(Piece::PAL::ContactEvent) &&
+                      offsetof(Piece::Core::NativeContactEvent, normal) == offsetof(Piece::PAL::ContactEvent, normal),
+                  "NativeContactEvent must match the layout of PAL::ContactEvent.");
+
+    /**
+     * @brief C-style export to turn contact event reporting on or off.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param capacity The number of events buffered between reads; 0 turns reporting off.
+     * @param reportPersist Non-zero to also report Persist events.
+     */
+    void Engine_ConfigureContactEvents(Piece::Core::EngineCore *corePtr, uint32_t capacity, uint32_t reportPersist)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        if (Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr)
+        {
+            Piece::PAL::ContactEventOptions options;
+            options.capacity = capacity;
+            options.report_persist = reportPersist != 0;
+            world->ConfigureContactEvents(options);
+        }
+    }
+
+    /**
+     * @brief C-style export to copy and remove the oldest buffered contact events.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @param events The destination array.
+     * @param capacity The number of events the array holds.
+     * @return The number of events written.
+     */
+    uint32_t Engine_ReadContactEvents(Piece::Core::EngineCore *corePtr, Piece::Core::NativeContactEvent *events,
+                                      uint32_t capacity)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr;
+        if (!world || !events)
+        {
+            return 0;
+        }
+        return world->ReadContactEvents(reinterpret_cast<Piece::PAL::ContactEvent *>(events), capacity);
+    }
+
+    /**
+     * @brief C-style export to get the number of contact events dropped because the buffer was full.
+     * @param corePtr A pointer to the EngineCore instance.
+     * @return The dropped event count.
+     */
+    uint64_t Engine_GetDroppedContactEventCount(Piece::Core::EngineCore *corePtr)
+    {
+        std::unique_lock<std::mutex> lock = LockPhysicsWorld(corePtr);
+        Piece::PAL::IPhysicsWorld *world = corePtr ? corePtr->GetPhysicsWorld() : nullptr;
+        return world ? world->GetDroppedContactEventCount() : 0;
+    }
+
     /**
      * @brief Static storage for the C# log callback.
      */
@@ -8,16 +8,30 @@
 
 #include <pal/iphysics_world.h>   // Assuming PAL interfaces are in WAL/RAL namespace or global
 #include <ral/igraphics_device.h> // Assuming RAL interfaces are in WAL/RAL namespace or global
+#include <wal/input_recording.h>
 #include <wal/iwindow.h>          // Assuming WAL interfaces are in WAL/RAL namespace or global
+#include <wal/replay_window.h>
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 // Forward declarations of factories and service locator.
 // These headers define the types within Piece::Core namespace already.
+#include "core/command_ring.h"
+#include "core/job_system.h"
+#include "core/job_system_task_scheduler.h"
+#include "core/latency_tracker.h"
+#include "core/physics_thread.h"
+#include "core/render_thread.h"
 #include "core/service_locator.h"
+#include "core/transform_arrays.h"
 #include "interfaces/igraphics_device_factory.h"
 #include "interfaces/iphysics_world_factory.h"
 #include "interfaces/iwindow_factory.h"
+#include "resources/resource_manager.h"
 
 #include "piece_core_exports.h" // Defines PIECE_CORE_API
 
@@ -55,6 +69,11 @@ class PIECE_CORE_API EngineCore
     /**
      * @brief Updates the engine's state.
      *        This method is called once per frame to update game logic, physics, and other dynamic systems.
+     *        It first polls the window events, which makes the frame's input available.
+     *        During an input replay, the recorded delta time replaces deltaTime.
+     *        The commands in the command ring are executed first, and the entity transforms native code changed
+     *        are published last. Managed transform changes stay flagged for the native systems that consume them.
+     *        Physics is only stepped here while the physics thread is disabled.
      * @param deltaTime The time elapsed since the last frame, in seconds.
      */
     void Update(float deltaTime);
@@ -62,10 +81,265 @@ class PIECE_CORE_API EngineCore
     /**
      * @brief Renders the current frame.
      *        This method is responsible for drawing all visual elements to the screen.
+     *        While the render thread runs, it only hands the frame over to it and returns at once.
      */
     void Render();
 
+    /**
+     * @brief Moves rendering and the window's graphics context to a dedicated thread, or back into Render.
+     *        The window's events are still pumped by Update on the calling thread. Call on that thread.
+     * @param enabled True to render on the render thread.
+     */
+    void SetRenderThreadEnabled(bool enabled);
+
+    /**
+     * @brief Creates an extra viewport rendered each frame with the main window's graphics device and resources.
+     *        Call on the thread that calls Update.
+     * @param width The width in pixels.
+     * @param height The height in pixels.
+     * @param title The window title; unused for offscreen viewports.
+     * @param offscreen True for an offscreen render target, false for a window.
+     * @return The viewport id, or 0 if the viewport could not be created.
+     */
+    uint32_t CreateViewport(int width, int height, const char *title, bool offscreen);
+
+    /**
+     * @brief Destroys a viewport and its window or render target.
+     * @param id The viewport id.
+     */
+    void DestroyViewport(uint32_t id);
+
+    /**
+     * @brief Resizes an offscreen viewport; window viewports follow their window instead.
+     * @param id The viewport id.
+     * @param width The new width in pixels.
+     * @param height The new height in pixels.
+     * @return True if the viewport is offscreen and was resized.
+     */
+    bool ResizeViewport(uint32_t id, int width, int height);
+
+    /**
+     * @brief Gets the window of a viewport.
+     * @param id The viewport id.
+     * @return The window, or nullptr for offscreen and unknown viewports.
+     */
+    WAL::IWindow *GetViewportWindow(uint32_t id);
+
+    /**
+     * @brief Gets the render target of an offscreen viewport.
+     * @param id The viewport id.
+     * @return The render target, or the null handle until it is first rendered and for window viewports.
+     */
+    RAL::RenderTargetHandle GetViewportRenderTarget(uint32_t id);
+
+    /**
+     * @brief Gets the renderer ID of an offscreen viewport's color attachment.
+     * @param id The viewport id.
+     * @return The renderer ID, or 0 until the viewport is first rendered and for window viewports.
+     */
+    uint32_t GetViewportColorTexture(uint32_t id);
+
+    /**
+     * @brief Starts recording the window's input events and the delta time of every following Update.
+     *        Restarts the recording if one is in progress.
+     * @return True if recording started; false without a window.
+     */
+    bool StartInputRecording();
+
+    /**
+     * @brief Stops recording and writes the recorded frames to a file.
+     * @param path The file path, or nullptr to discard the recording.
+     * @return True if the recording was written.
+     */
+    bool StopInputRecording(const char *path);
+
+    /**
+     * @brief Replays a recording in place of the window's live input, one recorded frame per Update, which also runs
+     *        with the recorded delta time. The window reports ShouldClose after the last frame.
+     * @param path The file written by StopInputRecording.
+     * @return True if the recording was loaded and the replay started.
+     */
+    bool StartInputReplay(const char *path);
+
+    /**
+     * @brief Gets the delta time the last Update ran with: the one passed in, or the recorded one during a replay.
+     * @return The delta time in seconds.
+     */
+    float GetFrameDeltaTime() const
+    {
+        return frame_delta_time_;
+    }
+
+    /**
+     * @brief Gets the percentiles of the time from the main window's input events to the present of the frame that
+     *        consumed them. Call on the thread that calls Update.
+     * @return The stats of the most recent samples.
+     */
+    LatencyStats GetInputLatencyStats() const
+    {
+        return input_latency_.GetStats();
+    }
+
+    /**
+     * @brief Drops the input latency samples, to measure a new phase of a session.
+     */
+    void ResetInputLatencyStats()
+    {
+        input_latency_.Reset();
+    }
+
+    /**
+     * @brief Replaces the entity transform arrays shared with managed code with new ones of every slot inactive.
+     *        Pointers into the previous arrays become invalid.
+     * @param capacity The number of entity slots; 0 frees the arrays.
+     * @return The control block of the new arrays, or nullptr for a capacity of 0.
+     */
+    NativeTransformArrays *CreateTransformArrays(uint32_t capacity);
+
+    /**
+     * @brief Gets the entity transform arrays shared with managed code.
+     * @return The arrays, or nullptr until CreateTransformArrays.
+     */
+    TransformArrays *GetTransformArrays()
+    {
+        return transform_arrays_.get();
+    }
+
+    /**
+     * @brief Replaces the command ring managed code enqueues commands into with a new, empty one. Commands still in
+     *        the previous ring are dropped and pointers into it become invalid.
+     * @param capacity The number of command slots, rounded up to a power of two; 0 frees the ring.
+     * @return The control block of the new ring, or nullptr for a capacity of 0.
+     */
+    NativeCommandRing *CreateCommandRing(uint32_t capacity);
+
+    /**
+     * @brief Gets the command ring managed code enqueues commands into.
+     * @return The ring, or nullptr until CreateCommandRing.
+     */
+    CommandRing *GetCommandRing()
+    {
+        return command_ring_.get();
+    }
+
+    /**
+     * @brief Gets the render thread.
+     * @return The render thread, or nullptr while frames are rendered in Render.
+     */
+    RenderThread *GetRenderThread()
+    {
+        return render_thread_.get();
+    }
+
+    /**
+     * @brief Gets the window.
+     * @return The window, or nullptr if it could not be created.
+     */
+    WAL::IWindow *GetWindow()
+    {
+        return window_.get();
+    }
+
+    /**
+     * @brief Gets the job system shared by the engine subsystems.
+     * @return The job system.
+     */
+    JobSystem &GetJobSystem()
+    {
+        return *job_system_;
+    }
+
+    /**
+     * @brief Gets the resource manager.
+     * @return The resource manager, or nullptr if the graphics device could not be created.
+     */
+    ResourceManager *GetResourceManager()
+    {
+        return resource_manager_.get();
+    }
+
+    /**
+     * @brief Gets the physics world.
+     * @return The physics world, or nullptr if it could not be created.
+     */
+    PAL::IPhysicsWorld *GetPhysicsWorld()
+    {
+        return physics_world_.get();
+    }
+
+    /**
+     * @brief Moves physics stepping to a dedicated thread running at the fixed physics rate, or back into Update.
+     * @param enabled True to step on the physics thread.
+     */
+    void SetPhysicsThreadEnabled(bool enabled);
+
+    /**
+     * @brief Gets the physics thread.
+     * @return The physics thread, or nullptr while physics is stepped in Update.
+     */
+    PhysicsThread *GetPhysicsThread()
+    {
+        return physics_thread_.get();
+    }
+
+    /**
+     * @brief Locks the physics world against the physics thread. Hold the lock while using the world or its bodies.
+     * @return A lock on the world, or an empty lock while there is no physics thread.
+     */
+    std::unique_lock<std::mutex> LockPhysicsWorld()
+    {
+        return physics_thread_ ? physics_thread_->LockWorld() : std::unique_lock<std::mutex>();
+    }
+
   private:
+    /**
+     * @brief Uploads pending resources, renders and presents one frame.
+     *        Runs on whichever thread the graphics context is current on.
+     */
+    void RenderFrame();
+
+    /**
+     * @brief Sets the viewport when the drawn-to size changed, then draws one view.
+     * @param size The size of the framebuffer or render target drawn to.
+     * @param last_size The size last drawn at, updated.
+     */
+    void DrawView(std::pair<int, int> size, std::pair<int, int> &last_size);
+
+    /**
+     * @brief An extra view rendered each frame besides the main window.
+     */
+    struct Viewport
+    {
+        /** @brief The id handed out by CreateViewport. */
+        uint32_t id = 0;
+        /** @brief The window, or nullptr for an offscreen viewport. */
+        std::unique_ptr<WAL::IWindow> window;
+        /** @brief The render target of an offscreen viewport, created on the rendering thread. */
+        RAL::RenderTargetHandle render_target;
+        /** @brief The size requested for an offscreen viewport. */
+        std::pair<int, int> requested_size = {0, 0};
+        /** @brief The size the viewport was last drawn at. */
+        std::pair<int, int> framebuffer_size = {0, 0};
+    };
+
+    /**
+     * @brief Drains the command ring in one pass, sorting the commands into batches by kind, and executes the batches:
+     *        transform commands, applied per entity in enqueue order, then impulses.
+     */
+    void ExecuteCommands();
+
+    /**
+     * @brief Finds a viewport. Caller holds viewports_mutex_.
+     * @param id The viewport id.
+     * @return The viewport, or nullptr if there is none with that id.
+     */
+    Viewport *FindViewport(uint32_t id);
+
+    /**
+     * @brief Unique pointer to the job system.
+     *        Declared first so it outlives every subsystem submitting jobs to it.
+     */
+    std::unique_ptr<JobSystem> job_system_;
     /**
      * @brief Unique pointer to the main window interface.
      *        Manages window-related operations, such as creation, input, and events.
@@ -76,11 +350,93 @@ class PIECE_CORE_API EngineCore
      *        Provides an abstraction for rendering functionalities.
      */
     std::unique_ptr<RAL::IGraphicsDevice> graphics_device_;
+    /**
+     * @brief Unique pointer to the scheduler running the physics world's parallel stages on the job system.
+     *        Declared before the physics world so it outlives it.
+     */
+    std::unique_ptr<JobSystemTaskScheduler> physics_task_scheduler_;
     /**
      * @brief Unique pointer to the physics world interface.
      *        Manages the physics simulation and interactions within the engine.
      */
     std::unique_ptr<PAL::IPhysicsWorld> physics_world_;
+    /**
+     * @brief The options the physics world was created with.
+     */
+    NativePhysicsOptions physics_options_ = {1.0f / 60.0f, 4, 4};
+    /**
+     * @brief Unique pointer to the thread stepping the physics world, if enabled.
+     *        Declared after the physics world so it stops before the world is destroyed.
+     */
+    std::unique_ptr<PhysicsThread> physics_thread_;
+    /**
+     * @brief Unique pointer to the resource manager.
+     *        Streams assets asynchronously; declared last so it is destroyed before the graphics device.
+     */
+    std::unique_ptr<ResourceManager> resource_manager_;
+    /**
+     * @brief The framebuffer size the viewport was last set for, only touched by the rendering thread.
+     */
+    std::pair<int, int> framebuffer_size_ = {0, 0};
+    /**
+     * @brief Guards the viewports between the calling thread and the render thread.
+     */
+    std::mutex viewports_mutex_;
+    /**
+     * @brief The extra viewports, in creation order.
+     *        Declared after the graphics device so their windows close before it is destroyed.
+     */
+    std::vector<Viewport> viewports_;
+    /**
+     * @brief Render targets of destroyed viewports, destroyed by the next frame on the rendering thread.
+     */
+    std::vector<RAL::RenderTargetHandle> retired_render_targets_;
+    /**
+     * @brief The id of the next viewport.
+     */
+    uint32_t next_viewport_id_ = 1;
+    /**
+     * @brief The input recording in progress, or nullptr.
+     */
+    std::unique_ptr<WAL::InputRecording> input_recording_;
+    /**
+     * @brief The replay wrapping the main window, or nullptr; owned through window_.
+     */
+    WAL::ReplayWindow *replay_window_ = nullptr;
+    /**
+     * @brief The delta time the last Update ran with.
+     */
+    float frame_delta_time_ = 0.0f;
+    /**
+     * @brief The entity transforms shared with managed code, or nullptr.
+     */
+    std::unique_ptr<TransformArrays> transform_arrays_;
+    /**
+     * @brief The ring managed code enqueues commands into, or nullptr.
+     */
+    std::unique_ptr<CommandRing> command_ring_;
+    /**
+     * @brief The spawn, destroy and set transform commands of the current batch.
+     */
+    std::vector<NativeCommand> transform_commands_;
+    /**
+     * @brief The bodies of the current batch's impulses.
+     */
+    std::vector<PAL::BodyId> impulse_bodies_;
+    /**
+     * @brief The impulses of the current batch, one per body.
+     */
+    std::vector<glm::vec3> impulses_;
+    /**
+     * @brief Measures the time from the main window's input events to the present of the frame consuming them.
+     *        Declared before the render thread, which reports presents to it.
+     */
+    LatencyTracker input_latency_;
+    /**
+     * @brief Unique pointer to the render thread, if enabled.
+     *        Declared last so it stops before the resource manager, graphics device and window are destroyed.
+     */
+    std::unique_ptr<RenderThread> render_thread_;
 };
 
 } // namespace Core
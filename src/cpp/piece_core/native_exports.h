@@ -51,6 +51,301 @@ extern "C"
      */
     PIECE_CORE_API void Engine_Render(Piece::Core::EngineCore *core_ptr);
 
+    /**
+     * @brief Gets the number of physics bodies.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @return The body count, an upper bound for the result of Engine_ReadBodyStates.
+     */
+    PIECE_CORE_API uint32_t Engine_GetBodyCount(Piece::Core::EngineCore *core_ptr);
+
+    /**
+     * @brief Gets the number of awake physics bodies, the bodies the simulation currently steps.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @return The awake body count.
+     */
+    PIECE_CORE_API uint32_t Engine_GetAwakeBodyCount(Piece::Core::EngineCore *core_ptr);
+
+    /**
+     * @brief Copies the state of many physics bodies into caller-provided arrays.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param states The destination arrays. ids must be set.
+     * @param capacity The number of bodies the arrays hold.
+     * @param moved_only Non-zero to only write bodies moved by the simulation during the last update.
+     * @return The number of bodies written.
+     */
+    PIECE_CORE_API uint32_t Engine_ReadBodyStates(Piece::Core::EngineCore *core_ptr,
+                                                  const Piece::Core::NativeBodyStateArrays *states, uint32_t capacity,
+                                                  uint32_t moved_only);
+
+    /**
+     * @brief Sets the state of many physics bodies from caller-provided arrays.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param states The source arrays. ids must be set; null arrays leave that attribute unchanged.
+     * @param count The number of bodies to update.
+     */
+    PIECE_CORE_API void Engine_WriteBodyStates(Piece::Core::EngineCore *core_ptr,
+                                               const Piece::Core::NativeBodyStateArrays *states, uint32_t count);
+
+    /**
+     * @brief Saves the complete physics state into a caller-provided buffer.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param buffer The destination, or nullptr to only get the size.
+     * @param capacity The size of buffer in bytes.
+     * @return The snapshot size in bytes; nothing usable was written if it exceeds capacity.
+     */
+    PIECE_CORE_API uint64_t Engine_SavePhysicsSnapshot(Piece::Core::EngineCore *core_ptr, void *buffer,
+                                                       uint64_t capacity);
+
+    /**
+     * @brief Restores a physics state saved by Engine_SavePhysicsSnapshot.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param snapshot The snapshot.
+     * @param size The size of the snapshot in bytes.
+     * @return 1 on success, 0 if the snapshot is invalid or its bodies differ from the world's.
+     */
+    PIECE_CORE_API uint32_t Engine_RestorePhysicsSnapshot(Piece::Core::EngineCore *core_ptr, const void *snapshot,
+                                                          uint64_t size);
+
+    /**
+     * @brief Moves physics stepping to a dedicated thread running at the fixed physics rate, or back into Engine_Update.
+     *        While the thread runs, the other physics exports wait for the step in progress.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param enabled Non-zero to step physics on its own thread.
+     */
+    PIECE_CORE_API void Engine_SetPhysicsThreadEnabled(Piece::Core::EngineCore *core_ptr, uint32_t enabled);
+
+    /**
+     * @brief Copies the newest body transforms published by the physics thread, interpolated for the current time.
+     *        Never waits for the physics thread. Call from one thread at a time.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param states The destination arrays. ids must be set; only positions and rotations are written besides.
+     * @param capacity The number of bodies the arrays hold.
+     * @return The number of bodies written, 0 while the physics thread is disabled or has not stepped yet.
+     */
+    PIECE_CORE_API uint32_t Engine_ReadInterpolatedBodyStates(Piece::Core::EngineCore *core_ptr,
+                                                              const Piece::Core::NativeBodyStateArrays *states,
+                                                              uint32_t capacity);
+
+    /**
+     * @brief Enables or disables deterministic physics stepping, which gives identical results for any worker count.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param enabled Non-zero to enable.
+     */
+    PIECE_CORE_API void Engine_SetPhysicsDeterministic(Piece::Core::EngineCore *core_ptr, uint32_t enabled);
+
+    /**
+     * @brief Gets the hash of the physics state, chained over every fixed step so far.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @return The hash; equal hashes on two machines mean their simulations have not diverged.
+     */
+    PIECE_CORE_API uint64_t Engine_GetPhysicsStateHash(Piece::Core::EngineCore *core_ptr);
+
+    /**
+     * @brief Copies the input events the window received during the current frame's Engine_Update, in arrival order.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param events The destination array, or nullptr to only get the count.
+     * @param capacity The number of events the array holds.
+     * @return The number of events in the frame; only the first capacity of them were copied if it is larger.
+     */
+    PIECE_CORE_API uint32_t Engine_ReadInputEvents(Piece::Core::EngineCore *core_ptr,
+                                                   Piece::Core::NativeInputEvent *events, uint32_t capacity);
+
+    /**
+     * @brief Moves rendering and the window's graphics context to a dedicated thread, or back into Engine_Render.
+     *        Window events are still pumped by Engine_Update, so OS window drags and resizes no longer stall
+     *        rendering. Call on the thread that calls Engine_Update.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param enabled Non-zero to render on the render thread.
+     */
+    PIECE_CORE_API void Engine_SetRenderThreadEnabled(Piece::Core::EngineCore *core_ptr, uint32_t enabled);
+
+    /**
+     * @brief Creates an extra viewport rendered by every Engine_Render with the same graphics device and resources.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param width The width in pixels.
+     * @param height The height in pixels.
+     * @param title The window title; ignored for offscreen viewports. May be nullptr.
+     * @param offscreen Non-zero for an offscreen render target, zero for a window.
+     * @return The viewport id, or 0 if the viewport could not be created.
+     */
+    PIECE_CORE_API uint32_t Engine_CreateViewport(Piece::Core::EngineCore *core_ptr, int32_t width, int32_t height,
+                                                  const char *title, uint32_t offscreen);
+
+    /**
+     * @brief Destroys a viewport created by Engine_CreateViewport.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param viewport_id The viewport id.
+     */
+    PIECE_CORE_API void Engine_DestroyViewport(Piece::Core::EngineCore *core_ptr, uint32_t viewport_id);
+
+    /**
+     * @brief Resizes an offscreen viewport. The next Engine_Render reallocates its render target.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param viewport_id The viewport id.
+     * @param width The new width in pixels.
+     * @param height The new height in pixels.
+     * @return 1 if the viewport was resized, 0 if it is unknown or a window.
+     */
+    PIECE_CORE_API uint32_t Engine_ResizeViewport(Piece::Core::EngineCore *core_ptr, uint32_t viewport_id,
+                                                  int32_t width, int32_t height);
+
+    /**
+     * @brief Gets the renderer ID of an offscreen viewport's color attachment, to show it in a UI panel.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param viewport_id The viewport id.
+     * @return The renderer ID, or 0 before the viewport was first rendered and for window viewports.
+     */
+    PIECE_CORE_API uint32_t Engine_GetViewportColorTexture(Piece::Core::EngineCore *core_ptr, uint32_t viewport_id);
+
+    /**
+     * @brief Checks if the user asked to close a window viewport.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param viewport_id The viewport id.
+     * @return 1 if the window should close, otherwise 0.
+     */
+    PIECE_CORE_API uint32_t Engine_ViewportShouldClose(Piece::Core::EngineCore *core_ptr, uint32_t viewport_id);
+
+    /**
+     * @brief Copies the input events a window viewport received during the current frame's Engine_Update.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param viewport_id The viewport id.
+     * @param events The destination array, or nullptr to only get the count.
+     * @param capacity The number of events the array holds.
+     * @return The number of events in the frame; 0 for offscreen and unknown viewports.
+     */
+    PIECE_CORE_API uint32_t Engine_ReadViewportInputEvents(Piece::Core::EngineCore *core_ptr, uint32_t viewport_id,
+                                                           Piece::Core::NativeInputEvent *events, uint32_t capacity);
+
+    /**
+     * @brief Sets how the window presents frames and paces their start.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param mode The present mode: 0 vsync, 1 adaptive vsync, 2 uncapped, 3 capped at max_frame_rate.
+     * @param max_frame_rate The frame rate limit of the capped mode, in frames per second.
+     * @param low_latency Non-zero to start each Engine_Update just in time for the predicted present, so input is
+     *        sampled as late as possible.
+     */
+    PIECE_CORE_API void Engine_SetPresentOptions(Piece::Core::EngineCore *core_ptr, uint32_t mode,
+                                                 float max_frame_rate, uint32_t low_latency);
+
+    /**
+     * @brief Checks if the main window should close, also once an input replay has played its last frame.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @return 1 if the window should close, otherwise 0.
+     */
+    PIECE_CORE_API uint32_t Engine_ShouldClose(Piece::Core::EngineCore *core_ptr);
+
+    /**
+     * @brief Starts recording the main window's input events and the delta time of every following Engine_Update.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @return 1 if recording started, otherwise 0.
+     */
+    PIECE_CORE_API uint32_t Engine_StartInputRecording(Piece::Core::EngineCore *core_ptr);
+
+    /**
+     * @brief Stops the input recording and writes it to a compact binary file.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param path The UTF-8 file path, or nullptr to discard the recording.
+     * @return 1 if the recording was written, otherwise 0.
+     */
+    PIECE_CORE_API uint32_t Engine_StopInputRecording(Piece::Core::EngineCore *core_ptr, const char *path);
+
+    /**
+     * @brief Replays a recording in place of the main window's live input. Each Engine_Update consumes one recorded
+     *        frame and runs with its recorded delta time; Engine_ShouldClose returns 1 after the last frame.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param path The UTF-8 path of a file written by Engine_StopInputRecording.
+     * @return 1 if the replay started, otherwise 0.
+     */
+    PIECE_CORE_API uint32_t Engine_StartInputReplay(Piece::Core::EngineCore *core_ptr, const char *path);
+
+    /**
+     * @brief Gets the delta time the last Engine_Update ran with, which is the recorded one during a replay.
+     *        Gameplay code advancing by it stays in step with the replayed session.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @return The delta time in seconds.
+     */
+    PIECE_CORE_API float Engine_GetFrameDeltaTime(Piece::Core::EngineCore *core_ptr);
+
+    /**
+     * @brief Allocates the entity transform arrays that managed code reads and writes in place, replacing any
+     *        previous ones. The arrays stay at the same address until they are replaced or the engine is destroyed.
+     *        See NativeTransformArrays for the change protocol; Engine_Update publishes native changes last, and
+     *        managed changes stay flagged until a native system consumes them.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param capacity The number of entity slots; 0 frees the arrays.
+     * @return The control block of the new arrays, or nullptr for a capacity of 0.
+     */
+    PIECE_CORE_API Piece::Core::NativeTransformArrays *Engine_CreateTransformArrays(Piece::Core::EngineCore *core_ptr,
+                                                                                    uint32_t capacity);
+
+    /**
+     * @brief Gets the entity transform arrays last created by Engine_CreateTransformArrays.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @return The control block, or nullptr if there are none.
+     */
+    PIECE_CORE_API Piece::Core::NativeTransformArrays *Engine_GetTransformArrays(Piece::Core::EngineCore *core_ptr);
+
+    /**
+     * @brief Allocates the single-producer, single-consumer ring managed code enqueues commands into without calling
+     *        into native code, replacing any previous ring. See NativeCommandRing for the protocol. Each
+     *        Engine_Update drains the ring in one pass and executes the commands in batches by kind: spawns, destroys
+     *        and set transforms update the transform arrays, in enqueue order for each entity, and impulses go to the
+     *        physics world in one call. Commands of other types are dropped with a warning.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param capacity The number of command slots, rounded up to a power of two; 0 frees the ring.
+     * @return The control block of the new ring, or nullptr for a capacity of 0.
+     */
+    PIECE_CORE_API Piece::Core::NativeCommandRing *Engine_CreateCommandRing(Piece::Core::EngineCore *core_ptr,
+                                                                            uint32_t capacity);
+
+    /**
+     * @brief Gets the command ring last created by Engine_CreateCommandRing.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @return The control block, or nullptr if there is none.
+     */
+    PIECE_CORE_API Piece::Core::NativeCommandRing *Engine_GetCommandRing(Piece::Core::EngineCore *core_ptr);
+
+    /**
+     * @brief Gets the percentiles of the time from the main window's input events to the return of the SwapBuffers
+     *        that presented the first frame rendered after they were polled. Covers the most recent 4096 events.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param stats The destination; all zero before the first measured event.
+     */
+    PIECE_CORE_API void Engine_GetInputLatencyStats(Piece::Core::EngineCore *core_ptr,
+                                                    Piece::Core::NativeLatencyStats *stats);
+
+    /**
+     * @brief Drops the input latency samples, to measure a new phase of a session.
+     * @param core_ptr A pointer to the EngineCore instance.
+     */
+    PIECE_CORE_API void Engine_ResetInputLatencyStats(Piece::Core::EngineCore *core_ptr);
+
+    /**
+     * @brief Turns contact event reporting on or off. Events collect in a fixed-size buffer between reads.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param capacity The number of events buffered between reads; 0 turns reporting off.
+     * @param report_persist Non-zero to also report a Persist event for every touching pair each fixed step.
+     */
+    PIECE_CORE_API void Engine_ConfigureContactEvents(Piece::Core::EngineCore *core_ptr, uint32_t capacity,
+                                                      uint32_t report_persist);
+
+    /**
+     * @brief Copies the oldest buffered contact events and removes them from the buffer.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @param events The destination array.
+     * @param capacity The number of events the array holds.
+     * @return The number of events written; call again while it equals capacity.
+     */
+    PIECE_CORE_API uint32_t Engine_ReadContactEvents(Piece::Core::EngineCore *core_ptr,
+                                                     Piece::Core::NativeContactEvent *events, uint32_t capacity);
+
+    /**
+     * @brief Gets the number of contact events dropped because the buffer was full.
+     * @param core_ptr A pointer to the EngineCore instance.
+     * @return The dropped event count since reporting was configured.
+     */
+    PIECE_CORE_API uint64_t Engine_GetDroppedContactEventCount(Piece::Core::EngineCore *core_ptr);
+
     /**
      * @brief Function pointer type for log callbacks.
      * @param level The log level.
@@ -52,6 +52,147 @@ struct NativePhysicsOptions
     float fixed_delta_time;
     /** @brief The maximum number of physics steps to perform per frame. */
     uint32_t max_physics_steps;
+    /** @brief The number of solver sub-steps per physics step. */
+    uint32_t sub_step_count;
+};
+
+/**
+ * @brief Caller-owned structure-of-arrays buffers for bulk body state transfers across the native boundary.
+ *        Element i of every array describes the body ids[i]. Any array except ids may be null to skip it.
+ */
+struct NativeBodyStateArrays
+{
+    /** @brief Body ids, one per body. */
+    uint32_t *ids;
+    /** @brief Positions, three floats (x, y, z) per body. */
+    float *positions;
+    /** @brief Rotation quaternions, four floats (x, y, z, w) per body. */
+    float *rotations;
+    /** @brief Linear velocities, three floats per body. */
+    float *linear_velocities;
+    /** @brief Angular velocities, three floats per body. */
+    float *angular_velocities;
+};
+
+/**
+ * @brief The control block of the entity transform arrays shared in place with managed code.
+ * @details The arrays are native-owned, cache-line aligned and stay put until they are recreated, so managed code
+ *          wraps them in spans once. Element i of every array describes entity slot i. Flags bits: 1 active,
+ *          2 written by managed code, 4 written by native code; bits 16 and up are free for gameplay code. After a
+ *          batch of writes, managed code sets bit 2 on each written entity and increments managed_version; native
+ *          code does the same with bit 4 and native_version. Each side scans the flags only when the other's version
+ *          moved, and clears the other's bit on the entities it consumed.
+ */
+struct NativeTransformArrays
+{
+    /** @brief Positions, three floats (x, y, z) per entity. */
+    float *positions;
+    /** @brief Rotation quaternions, four floats (x, y, z, w) per entity. */
+    float *rotations;
+    /** @brief Scales, three floats per entity. */
+    float *scales;
+    /** @brief Flags, one word per entity. */
+    uint32_t *flags;
+    /** @brief Incremented by managed code after each batch of writes. */
+    uint64_t managed_version;
+    /** @brief Incremented by native code after each update that wrote transforms. */
+    uint64_t native_version;
+    /** @brief The number of entity slots in each array. */
+    uint32_t capacity;
+};
+
+/**
+ * @brief A command record written by managed code into the command ring, 64 bytes.
+ */
+struct NativeCommand
+{
+    /** @brief The command: 0 spawn, 1 destroy, 2 set transform, 3 apply impulse. Other values are dropped. */
+    uint32_t type;
+    /** @brief The entity's transform slot, for every command but apply impulse. */
+    uint32_t entity;
+    /** @brief The body id for apply impulse, otherwise 0. */
+    uint32_t target;
+    /** @brief Reserved, 0. */
+    uint32_t flags;
+    /** @brief Spawn and set transform: position (3), rotation quaternion (4, x y z w) and scale (3). Apply impulse:
+     *         the impulse (3). */
+    float values[12];
+};
+
+/**
+ * @brief The control block of the single-producer, single-consumer command ring managed code writes commands into.
+ * @details The producer writes commands[write_index & (capacity - 1)] while write_index - read_index is less than
+ *          capacity, then stores write_index + 1 with release semantics. The consumer loads write_index with acquire
+ *          semantics and, after executing the commands, stores the new read_index with release semantics. The indices
+ *          only grow.
+ */
+struct NativeCommandRing
+{
+    /** @brief The command slots, capacity of them. */
+    NativeCommand *commands;
+    /** @brief The number of slots, a power of two. */
+    uint32_t capacity;
+    /** @brief The count of commands written so far; advanced by the producer. */
+    uint64_t *write_index;
+    /** @brief The count of commands executed so far; advanced by the consumer. */
+    uint64_t *read_index;
+};
+
+/**
+ * @brief An input event as copied across the native boundary, laid out like WAL::InputEvent.
+ */
+struct NativeInputEvent
+{
+    /** @brief When the event was received, in nanoseconds of the native steady clock. */
+    int64_t timestamp_ns;
+    /** @brief The kind of event: 0 key, 1 mouse button, 2 cursor move, 3 scroll, 4 text. */
+    uint32_t type;
+    /** @brief The key or mouse button code, or the Unicode code point of a text event. */
+    int32_t code;
+    /** @brief For keys and buttons: 0 release, 1 press, 2 repeat. */
+    uint32_t action;
+    /** @brief The held modifiers for keys and buttons: shift 1, control 2, alt 4, super 8. */
+    int32_t mods;
+    /** @brief The cursor x-coordinate, or the horizontal scroll offset. */
+    float x;
+    /** @brief The cursor y-coordinate, or the vertical scroll offset. */
+    float y;
+};
+
+/**
+ * @brief A contact event as copied across the native boundary, laid out like PAL::ContactEvent.
+ */
+struct NativeContactEvent
+{
+    /** @brief The kind of event: 0 begin, 1 persist, 2 end, 3 sensor begin, 4 sensor end. */
+    uint32_t type;
+    /** @brief The first body; the sensor for sensor events. */
+    uint32_t body_a;
+    /** @brief The second body; the visiting body for sensor events. */
+    uint32_t body_b;
+    /** @brief A contact point in world space, three floats. */
+    float point[3];
+    /** @brief The contact normal from body_a to body_b, three floats. */
+    float normal[3];
+    /** @brief The speed at which the bodies approached along the normal. */
+    float approach_speed;
+};
+
+/**
+ * @brief Percentiles of the recent input-to-present latencies.
+ */
+struct NativeLatencyStats
+{
+    /** @brief The number of latencies measured since the last reset. */
+    uint64_t sample_count;
+    /** @brief The median latency, in milliseconds. */
+    float p50_ms;
+    /** @brief The 90th percentile, in milliseconds. */
+    float p90_ms;
+    /** @brief The 99th percentile, in milliseconds. */
+    float p99_ms;
+    /** @brief The largest latency, in milliseconds. */
+    float max_ms;
 };
 
 } // namespace Core
@@ -0,0 +1,409 @@
+/**
+ * @file asset_pack.cpp
+ * @brief Implements the .pak writer and the memory-mapped reader.
+ */
+#include "asset_pack.h"
+
+#include <lz4.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Piece
+{
+namespace Core
+{
+
+namespace
+{
+/**
+ * @brief Rounds a value up to a power-of-two alignment.
+ * @param value The value to round.
+ * @param alignment The alignment.
+ * @return The aligned value.
+ */
+uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+} // namespace
+
+uint64_t HashAssetName(const std::string &name)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : name)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+AssetPackWriter::AssetPackWriter(uint32_t alignment) : alignment_(alignment)
+{
+    if (alignment_ == 0 || (alignment_ & (alignment_ - 1)) != 0)
+    {
+        spdlog::warn("AssetPackWriter: alignment {} is not a power of two, using 64.", alignment_);
+        alignment_ = 64;
+    }
+}
+
+bool AssetPackWriter::AddEntry(const std::string &name, AssetType type, const void *data, size_t size, bool compress)
+{
+    uint64_t hash = HashAssetName(name);
+    for (const PendingEntry &pending : entries_)
+    {
+        if (pending.entry.name_hash == hash)
+        {
+            spdlog::error("AssetPackWriter: duplicate asset name or hash collision for '{}'.", name);
+            return false;
+        }
+    }
+
+    PendingEntry pending = {};
+    pending.entry.name_hash = hash;
+    pending.entry.type = type;
+    pending.entry.size = size;
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+    if (compress && size > 0)
+    {
+        std::vector<uint8_t> scratch(static_cast<size_t>(LZ4_compressBound(static_cast<int>(kAssetPackBlockSize))));
+        for (size_t offset = 0; offset < size; offset += kAssetPackBlockSize)
+        {
+            int raw_size = static_cast<int>(std::min<size_t>(kAssetPackBlockSize, size - offset));
+            int compressed_size = LZ4_compress_default(reinterpret_cast<const char *>(bytes + offset),
+                                                       reinterpret_cast<char *>(scratch.data()), raw_size,
+                                                       static_cast<int>(scratch.size()));
+            if (compressed_size > 0 && compressed_size < raw_size)
+            {
+                pending.data.insert(pending.data.end(), scratch.begin(), scratch.begin() + compressed_size);
+                pending.blocks.push_back(static_cast<uint32_t>(compressed_size));
+            }
+            else
+            {
+                pending.data.insert(pending.data.end(), bytes + offset, bytes + offset + raw_size);
+                pending.blocks.push_back(static_cast<uint32_t>(raw_size) | kAssetPackBlockStored);
+            }
+        }
+
+        // Keep the entry zero-copy unless compression pays for the decode.
+        if (pending.data.size() >= size - size / 10)
+        {
+            pending.data.clear();
+            pending.blocks.clear();
+        }
+    }
+
+    if (pending.blocks.empty())
+    {
+        pending.data.assign(bytes, bytes + size);
+    }
+    else
+    {
+        pending.entry.flags |= kAssetPackEntryCompressed;
+        pending.entry.block_count = static_cast<uint32_t>(pending.blocks.size());
+    }
+    pending.entry.stored_size = pending.data.size();
+
+    entries_.push_back(std::move(pending));
+    return true;
+}
+
+bool AssetPackWriter::Write(const std::string &path) const
+{
+    std::vector<const PendingEntry *> sorted;
+    sorted.reserve(entries_.size());
+    uint32_t total_blocks = 0;
+    for (const PendingEntry &pending : entries_)
+    {
+        sorted.push_back(&pending);
+        total_blocks += pending.entry.block_count;
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const PendingEntry *a, const PendingEntry *b) {
+        return a->entry.name_hash < b->entry.name_hash;
+    });
+
+    AssetPackHeader header = {};
+    header.magic = kAssetPackMagic;
+    header.version = kAssetPackVersion;
+    header.entry_count = static_cast<uint32_t>(sorted.size());
+    header.alignment = alignment_;
+    header.block_size = kAssetPackBlockSize;
+    header.block_count = total_blocks;
+    header.toc_offset = AlignUp(sizeof(AssetPackHeader), alignment_);
+    header.block_table_offset = header.toc_offset + sorted.size() * sizeof(AssetPackEntry);
+
+    // Resolve entry offsets and the block table.
+    std::vector<AssetPackEntry> toc;
+    std::vector<uint32_t> block_table;
+    toc.reserve(sorted.size());
+    block_table.reserve(total_blocks);
+    uint64_t offset = AlignUp(header.block_table_offset + static_cast<uint64_t>(total_blocks) * sizeof(uint32_t),
+                              alignment_);
+    for (const PendingEntry *pending : sorted)
+    {
+        AssetPackEntry entry = pending->entry;
+        entry.offset = offset;
+        entry.first_block = static_cast<uint32_t>(block_table.size());
+        block_table.insert(block_table.end(), pending->blocks.begin(), pending->blocks.end());
+        toc.push_back(entry);
+        offset = AlignUp(offset + entry.stored_size, alignment_);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        spdlog::error("AssetPackWriter: cannot open '{}' for writing.", path);
+        return false;
+    }
+
+    auto pad_to = [&file](uint64_t target) {
+        static const char zeros[256] = {};
+        uint64_t position = static_cast<uint64_t>(file.tellp());
+        while (position < target)
+        {
+            uint64_t chunk = std::min<uint64_t>(sizeof(zeros), target - position);
+            file.write(zeros, static_cast<std::streamsize>(chunk));
+            position += chunk;
+        }
+    };
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    pad_to(header.toc_offset);
+    file.write(reinterpret_cast<const char *>(toc.data()),
+               static_cast<std::streamsize>(toc.size() * sizeof(AssetPackEntry)));
+    file.write(reinterpret_cast<const char *>(block_table.data()),
+               static_cast<std::streamsize>(block_table.size() * sizeof(uint32_t)));
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        pad_to(toc[i].offset);
+        file.write(reinterpret_cast<const char *>(sorted[i]->data.data()),
+                   static_cast<std::streamsize>(sorted[i]->data.size()));
+    }
+    pad_to(offset);
+
+    if (!file)
+    {
+        spdlog::error("AssetPackWriter: failed while writing '{}'.", path);
+        return false;
+    }
+    return true;
+}
+
+AssetPack::~AssetPack()
+{
+    Close();
+}
+
+bool AssetPack::Open(const std::string &path)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        spdlog::error("AssetPack: cannot open '{}'.", path);
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        spdlog::error("AssetPack: '{}' is empty or unreadable.", path);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+    {
+        spdlog::error("AssetPack: cannot map '{}'.", path);
+        return false;
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        spdlog::error("AssetPack: cannot map '{}'.", path);
+        return false;
+    }
+    mapping_handle_ = mapping;
+    base_ = static_cast<const uint8_t *>(view);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        spdlog::error("AssetPack: cannot open '{}'.", path);
+        return false;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+    {
+        close(fd);
+        spdlog::error("AssetPack: '{}' is empty or unreadable.", path);
+        return false;
+    }
+    void *view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        spdlog::error("AssetPack: cannot map '{}'.", path);
+        return false;
+    }
+    base_ = static_cast<const uint8_t *>(view);
+    size_ = static_cast<size_t>(file_stat.st_size);
+#endif
+
+    // Validate everything the accessors rely on so lookups can stay unchecked. Ranges are compared without adding
+    // untrusted offsets and sizes, which could wrap.
+    auto fits = [](uint64_t offset, uint64_t length, uint64_t limit) {
+        return length <= limit && offset <= limit - length;
+    };
+    header_ = reinterpret_cast<const AssetPackHeader *>(base_);
+    bool valid = size_ >= sizeof(AssetPackHeader) && header_->magic == kAssetPackMagic &&
+                 header_->version == kAssetPackVersion && header_->block_size == kAssetPackBlockSize &&
+                 fits(header_->block_table_offset, static_cast<uint64_t>(header_->block_count) * sizeof(uint32_t),
+                      size_) &&
+                 fits(header_->toc_offset, static_cast<uint64_t>(header_->entry_count) * sizeof(AssetPackEntry),
+                      header_->block_table_offset);
+    if (valid)
+    {
+        entries_ = reinterpret_cast<const AssetPackEntry *>(base_ + header_->toc_offset);
+        blocks_ = reinterpret_cast<const uint32_t *>(base_ + header_->block_table_offset);
+        for (uint32_t i = 0; i < header_->entry_count && valid; ++i)
+        {
+            const AssetPackEntry &entry = entries_[i];
+            bool compressed = (entry.flags & kAssetPackEntryCompressed) != 0;
+            valid = fits(entry.offset, entry.stored_size, size_) &&
+                    (i == 0 || entries_[i - 1].name_hash < entry.name_hash) &&
+                    (compressed ? fits(entry.first_block, entry.block_count, header_->block_count)
+                                : entry.size == entry.stored_size);
+        }
+    }
+    if (!valid)
+    {
+        spdlog::error("AssetPack: '{}' is not a valid pack file.", path);
+        Close();
+        return false;
+    }
+
+    spdlog::info("AssetPack: mapped '{}' ({} entries, {} bytes).", path, header_->entry_count, size_);
+    return true;
+}
+
+void AssetPack::Close()
+{
+    if (base_)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(base_);
+        CloseHandle(static_cast<HANDLE>(mapping_handle_));
+#else
+        munmap(const_cast<uint8_t *>(base_), size_);
+#endif
+    }
+    base_ = nullptr;
+    size_ = 0;
+    header_ = nullptr;
+    entries_ = nullptr;
+    blocks_ = nullptr;
+    mapping_handle_ = nullptr;
+}
+
+const AssetPackEntry *AssetPack::Find(const std::string &name) const
+{
+    return Find(HashAssetName(name));
+}
+
+const AssetPackEntry *AssetPack::Find(uint64_t name_hash) const
+{
+    if (!header_)
+    {
+        return nullptr;
+    }
+    const AssetPackEntry *end = entries_ + header_->entry_count;
+    const AssetPackEntry *it = std::lower_bound(
+        entries_, end, name_hash, [](const AssetPackEntry &entry, uint64_t hash) { return entry.name_hash < hash; });
+    return (it != end && it->name_hash == name_hash) ? it : nullptr;
+}
+
+const void *AssetPack::GetData(const AssetPackEntry &entry) const
+{
+    if (!base_ || (entry.flags & kAssetPackEntryCompressed))
+    {
+        return nullptr;
+    }
+    return base_ + entry.offset;
+}
+
+bool AssetPack::Read(const AssetPackEntry &entry, void *destination, size_t capacity) const
+{
+    if (!base_ || capacity < entry.size)
+    {
+        return false;
+    }
+    uint8_t *out = static_cast<uint8_t *>(destination);
+    const uint8_t *in = base_ + entry.offset;
+
+    if (!(entry.flags & kAssetPackEntryCompressed))
+    {
+        std::memcpy(out, in, static_cast<size_t>(entry.size));
+        return true;
+    }
+
+    uint64_t produced = 0;
+    uint64_t consumed = 0;
+    for (uint32_t b = 0; b < entry.block_count; ++b)
+    {
+        uint32_t block = blocks_[entry.first_block + b];
+        uint32_t stored_size = block & ~kAssetPackBlockStored;
+        int raw_size = static_cast<int>(std::min<uint64_t>(kAssetPackBlockSize, entry.size - produced));
+        if (consumed + stored_size > entry.stored_size)
+        {
+            spdlog::error("AssetPack: block table overruns entry {:#x}.", entry.name_hash);
+            return false;
+        }
+
+        if (block & kAssetPackBlockStored)
+        {
+            if (stored_size != static_cast<uint32_t>(raw_size))
+            {
+                return false;
+            }
+            std::memcpy(out + produced, in + consumed, stored_size);
+        }
+        else if (LZ4_decompress_safe(reinterpret_cast<const char *>(in + consumed),
+                                     reinterpret_cast<char *>(out + produced), static_cast<int>(stored_size),
+                                     raw_size) != raw_size)
+        {
+            spdlog::error("AssetPack: corrupt LZ4 block in entry {:#x}.", entry.name_hash);
+            return false;
+        }
+        produced += static_cast<uint64_t>(raw_size);
+        consumed += stored_size;
+    }
+    return produced == entry.size;
+}
+
+} // namespace Core
+} // namespace Piece
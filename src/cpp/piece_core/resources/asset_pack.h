@@ -0,0 +1,258 @@
+/**
+ * @file asset_pack.h
+ * @brief Defines the cooked .pak asset container: its on-disk layout, a writer used by the cooker and a
+ *        memory-mapped, zero-copy reader used at runtime.
+ */
+#ifndef PIECE_CORE_RESOURCES_ASSET_PACK_H_
+#define PIECE_CORE_RESOURCES_ASSET_PACK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief The kind of asset stored in a pack entry.
+ */
+enum class AssetType : uint32_t
+{
+    Raw = 0,     /**< Opaque bytes. */
+    Mesh = 1,    /**< A cooked mesh, see mesh_asset.h. */
+    Texture = 2, /**< Texture data. */
+    Shader = 3   /**< Shader source or bytecode. */
+};
+
+/** @brief The magic number at the start of every pack ("PPAK", little-endian). */
+constexpr uint32_t kAssetPackMagic = 0x4B415050u;
+/** @brief The current pack format version. */
+constexpr uint32_t kAssetPackVersion = 1;
+/** @brief The uncompressed size of a compression block. */
+constexpr uint32_t kAssetPackBlockSize = 64 * 1024;
+/** @brief Flag set in a block table entry when the block is stored uncompressed. */
+constexpr uint32_t kAssetPackBlockStored = 0x80000000u;
+
+/**
+ * @brief Entry flags.
+ */
+enum AssetPackEntryFlags : uint32_t
+{
+    /** @brief The entry is split into independently LZ4-compressed blocks. */
+    kAssetPackEntryCompressed = 1u << 0
+};
+
+/**
+ * @brief The fixed-size header at offset 0 of a pack file.
+ * @details All multi-byte values are little-endian. The table of contents follows the header, then the block table,
+ *          then the entry data, each aligned to the pack alignment.
+ */
+struct AssetPackHeader
+{
+    /** @brief kAssetPackMagic. */
+    uint32_t magic;
+    /** @brief kAssetPackVersion. */
+    uint32_t version;
+    /** @brief The number of entries in the table of contents. */
+    uint32_t entry_count;
+    /** @brief The alignment of the table of contents and of every entry's data. Power of two. */
+    uint32_t alignment;
+    /** @brief The uncompressed size of a compression block. */
+    uint32_t block_size;
+    /** @brief The number of entries in the block table. */
+    uint32_t block_count;
+    /** @brief File offset of the table of contents. */
+    uint64_t toc_offset;
+    /** @brief File offset of the block table. */
+    uint64_t block_table_offset;
+    /** @brief Reserved, zero. */
+    uint64_t reserved[3];
+};
+static_assert(sizeof(AssetPackHeader) == 64, "AssetPackHeader must stay 64 bytes");
+
+/**
+ * @brief One table of contents entry. Entries are sorted by name_hash.
+ */
+struct AssetPackEntry
+{
+    /** @brief HashAssetName of the asset path. */
+    uint64_t name_hash;
+    /** @brief File offset of the entry data, aligned to the pack alignment. */
+    uint64_t offset;
+    /** @brief Size of the entry data as stored in the file. */
+    uint64_t stored_size;
+    /** @brief Size of the entry data once decompressed. Equals stored_size for uncompressed entries. */
+    uint64_t size;
+    /** @brief The AssetType of the entry. */
+    AssetType type;
+    /** @brief AssetPackEntryFlags. */
+    uint32_t flags;
+    /** @brief Index of the first block table entry of a compressed entry. */
+    uint32_t first_block;
+    /** @brief The number of blocks of a compressed entry. */
+    uint32_t block_count;
+};
+static_assert(sizeof(AssetPackEntry) == 48, "AssetPackEntry must stay 48 bytes");
+
+/**
+ * @brief Hashes an asset path into the key used by the table of contents (64-bit FNV-1a).
+ * @param name The asset path.
+ * @return The hash.
+ */
+PIECE_CORE_API uint64_t HashAssetName(const std::string &name);
+
+/**
+ * @brief Builds a pack file from in-memory assets. Used by the offline cooker and by tests.
+ */
+class PIECE_CORE_API AssetPackWriter
+{
+  public:
+    /**
+     * @brief Constructs a writer.
+     * @param alignment The alignment of the table of contents and entry data. Must be a power of two.
+     */
+    explicit AssetPackWriter(uint32_t alignment = 64);
+
+    /**
+     * @brief Adds an asset to the pack.
+     * @param name The asset path used to look it up at runtime.
+     * @param type The kind of asset.
+     * @param data Pointer to the asset bytes.
+     * @param size The number of bytes.
+     * @param compress Compresses the asset in LZ4 blocks if that saves space. Uncompressed entries are zero-copy.
+     * @return False if an asset with the same name hash was already added.
+     */
+    bool AddEntry(const std::string &name, AssetType type, const void *data, size_t size, bool compress);
+
+    /**
+     * @brief Writes the pack to disk.
+     * @param path The destination file path.
+     * @return True on success, false otherwise.
+     */
+    bool Write(const std::string &path) const;
+
+  private:
+    /**
+     * @brief An asset waiting to be written.
+     */
+    struct PendingEntry
+    {
+        /** @brief The table of contents entry. Offsets are resolved by Write. */
+        AssetPackEntry entry;
+        /** @brief The stored bytes, compressed or not. */
+        std::vector<uint8_t> data;
+        /** @brief The block table entries of a compressed asset. */
+        std::vector<uint32_t> blocks;
+    };
+
+    /** @brief The alignment of the table of contents and entry data. */
+    uint32_t alignment_;
+    /** @brief The assets added so far. */
+    std::vector<PendingEntry> entries_;
+};
+
+/**
+ * @brief A read-only, memory-mapped pack file.
+ * @details Uncompressed entries are exposed as pointers into the mapping so their bytes can be handed straight to
+ *          the upload path. Compressed entries are decompressed block by block directly into caller-owned memory,
+ *          such as a staging buffer. The object is safe to read from multiple threads once opened.
+ */
+class PIECE_CORE_API AssetPack
+{
+  public:
+    /**
+     * @brief Constructs a closed pack.
+     */
+    AssetPack() = default;
+    /**
+     * @brief Unmaps the pack file.
+     */
+    ~AssetPack();
+
+    AssetPack(const AssetPack &) = delete;
+    AssetPack &operator=(const AssetPack &) = delete;
+
+    /**
+     * @brief Maps a pack file and validates its header and table of contents.
+     * @param path The pack file path.
+     * @return True on success, false otherwise.
+     */
+    bool Open(const std::string &path);
+
+    /**
+     * @brief Unmaps the pack file. Pointers previously returned by GetData become invalid.
+     */
+    void Close();
+
+    /**
+     * @brief Checks whether a pack is currently mapped.
+     * @return True if open.
+     */
+    bool IsOpen() const
+    {
+        return base_ != nullptr;
+    }
+
+    /**
+     * @brief Gets the number of entries in the pack.
+     * @return The entry count.
+     */
+    uint32_t GetEntryCount() const
+    {
+        return header_ ? header_->entry_count : 0;
+    }
+
+    /**
+     * @brief Looks an entry up by asset path.
+     * @param name The asset path.
+     * @return The entry, or nullptr if the pack does not contain it.
+     */
+    const AssetPackEntry *Find(const std::string &name) const;
+
+    /**
+     * @brief Looks an entry up by name hash.
+     * @param name_hash The HashAssetName of the asset path.
+     * @return The entry, or nullptr if the pack does not contain it.
+     */
+    const AssetPackEntry *Find(uint64_t name_hash) const;
+
+    /**
+     * @brief Gets the bytes of an uncompressed entry without copying them.
+     * @param entry An entry of this pack.
+     * @return A pointer into the mapping valid until Close, or nullptr if the entry is compressed.
+     */
+    const void *GetData(const AssetPackEntry &entry) const;
+
+    /**
+     * @brief Copies or decompresses an entry into caller-owned memory.
+     * @param entry An entry of this pack.
+     * @param destination Memory receiving entry.size bytes.
+     * @param capacity The size of the destination memory.
+     * @return True on success, false if the destination is too small or the data is corrupt.
+     */
+    bool Read(const AssetPackEntry &entry, void *destination, size_t capacity) const;
+
+  private:
+    /** @brief Start of the mapping. */
+    const uint8_t *base_ = nullptr;
+    /** @brief Size of the mapping. */
+    size_t size_ = 0;
+    /** @brief The pack header inside the mapping. */
+    const AssetPackHeader *header_ = nullptr;
+    /** @brief The table of contents inside the mapping. */
+    const AssetPackEntry *entries_ = nullptr;
+    /** @brief The block table inside the mapping. */
+    const uint32_t *blocks_ = nullptr;
+    /** @brief Platform handle of the mapping (a HANDLE on Windows, unused elsewhere). */
+    void *mapping_handle_ = nullptr;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_RESOURCES_ASSET_PACK_H_
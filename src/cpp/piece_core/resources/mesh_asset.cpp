@@ -0,0 +1,118 @@
+/**
+ * @file mesh_asset.cpp
+ * @brief Implements serialization, parsing and upload of cooked mesh blobs.
+ */
+#include "mesh_asset.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Piece
+{
+namespace Core
+{
+
+namespace
+{
+/** @brief Alignment of the vertex and index data inside a blob. */
+constexpr uint64_t kMeshAssetDataAlignment = 16;
+
+/**
+ * @brief Rounds a value up to kMeshAssetDataAlignment.
+ * @param value The value to round.
+ * @return The aligned value.
+ */
+uint64_t AlignData(uint64_t value)
+{
+    return (value + kMeshAssetDataAlignment - 1) & ~(kMeshAssetDataAlignment - 1);
+}
+} // namespace
+
+std::vector<uint8_t> SerializeMeshAsset(const OptimizedMesh &mesh)
+{
+    MeshAssetHeader header = {};
+    header.magic = kMeshAssetMagic;
+    header.version = kMeshAssetVersion;
+    header.layout = mesh.layout;
+    header.vertex_count = mesh.vertex_count;
+    header.index_count = mesh.index_count;
+    header.index_format = static_cast<uint32_t>(mesh.index_format);
+    if (mesh.lods.empty())
+    {
+        header.lod_count = 1;
+        header.lods[0] = {0, mesh.index_count, 0.0f};
+    }
+    else
+    {
+        header.lod_count = static_cast<uint32_t>(std::min<size_t>(mesh.lods.size(), kMaxMeshLods));
+        std::copy(mesh.lods.begin(), mesh.lods.begin() + header.lod_count, header.lods);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        header.bounds_min[i] = mesh.bounds_min[i];
+        header.bounds_max[i] = mesh.bounds_max[i];
+    }
+    header.vertex_data_offset = AlignData(sizeof(MeshAssetHeader));
+    header.index_data_offset = AlignData(header.vertex_data_offset + mesh.vertex_data.size());
+
+    std::vector<uint8_t> blob(static_cast<size_t>(header.index_data_offset + mesh.index_data.size()), 0);
+    std::memcpy(blob.data(), &header, sizeof(header));
+    std::memcpy(blob.data() + header.vertex_data_offset, mesh.vertex_data.data(), mesh.vertex_data.size());
+    std::memcpy(blob.data() + header.index_data_offset, mesh.index_data.data(), mesh.index_data.size());
+    return blob;
+}
+
+bool ParseMeshAsset(const void *data, size_t size, MeshAssetView &view)
+{
+    if (!data || size < sizeof(MeshAssetHeader))
+    {
+        return false;
+    }
+    const MeshAssetHeader *header = static_cast<const MeshAssetHeader *>(data);
+    if (header->magic != kMeshAssetMagic || header->version != kMeshAssetVersion ||
+        header->layout.attribute_count > RAL::kMaxVertexAttributes ||
+        header->index_format > static_cast<uint32_t>(RAL::IndexFormat::UInt32) || header->lod_count == 0 ||
+        header->lod_count > kMaxMeshLods)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->lod_count; ++i)
+    {
+        const MeshLod &lod = header->lods[i];
+        if (static_cast<uint64_t>(lod.index_offset) + lod.index_count > header->index_count)
+        {
+            return false;
+        }
+    }
+
+    // Products of two 32-bit values cannot overflow 64 bits. The ranges are compared without adding the untrusted
+    // offsets, which could wrap.
+    static_assert(sizeof(header->vertex_count) == 4 && sizeof(header->layout.stride) == 4 &&
+                      sizeof(header->index_count) == 4,
+                  "The data sizes are computed as 64-bit products of 32-bit fields.");
+    uint64_t vertex_bytes = static_cast<uint64_t>(header->vertex_count) * header->layout.stride;
+    uint64_t index_bytes = static_cast<uint64_t>(header->index_count) *
+                           RAL::GetIndexFormatSize(static_cast<RAL::IndexFormat>(header->index_format));
+    auto fits = [size](uint64_t offset, uint64_t length) { return length <= size && offset <= size - length; };
+    if (!fits(header->vertex_data_offset, vertex_bytes) || !fits(header->index_data_offset, index_bytes))
+    {
+        return false;
+    }
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    view.header = header;
+    view.vertex_data = bytes + header->vertex_data_offset;
+    view.index_data = bytes + header->index_data_offset;
+    return true;
+}
+
+void CreateMeshBuffers(RAL::IGraphicsDevice &device, const MeshAssetView &view, RAL::VertexBufferHandle &vertex_buffer,
+                       RAL::IndexBufferHandle &index_buffer)
+{
+    vertex_buffer = device.CreateVertexBuffer(view.vertex_data, view.header->vertex_count, view.header->layout);
+    index_buffer = device.CreateIndexBuffer(view.index_data, view.header->index_count,
+                                            static_cast<RAL::IndexFormat>(view.header->index_format));
+}
+
+} // namespace Core
+} // namespace Piece
@@ -0,0 +1,104 @@
+/**
+ * @file mesh_asset.h
+ * @brief Defines the cooked mesh blob stored in asset packs and helpers to serialize, parse and upload it.
+ */
+#ifndef PIECE_CORE_RESOURCES_MESH_ASSET_H_
+#define PIECE_CORE_RESOURCES_MESH_ASSET_H_
+
+#include <ral/igraphics_device.h>
+#include <ral/ral_types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mesh_lod.h"
+#include "mesh_optimizer.h"
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/** @brief The magic number at the start of a cooked mesh ("MESH", little-endian). */
+constexpr uint32_t kMeshAssetMagic = 0x4853454Du;
+/** @brief The current cooked mesh version. */
+constexpr uint32_t kMeshAssetVersion = 2;
+
+/**
+ * @brief The header of a cooked mesh blob.
+ * @details The vertex and index data follow the header at 16-byte aligned offsets relative to the start of the blob,
+ *          already in the layout expected by IGraphicsDevice, so a mapped blob can be uploaded without conversion.
+ */
+struct MeshAssetHeader
+{
+    /** @brief kMeshAssetMagic. */
+    uint32_t magic;
+    /** @brief kMeshAssetVersion. */
+    uint32_t version;
+    /** @brief The layout of one vertex. */
+    RAL::VertexLayout layout;
+    /** @brief The number of vertices. */
+    uint32_t vertex_count;
+    /** @brief The number of indices. */
+    uint32_t index_count;
+    /** @brief The RAL::IndexFormat of the indices. */
+    uint32_t index_format;
+    /** @brief The number of valid entries in lods. */
+    uint32_t lod_count;
+    /** @brief The levels of detail, finest first, as ranges of the index data. */
+    MeshLod lods[kMaxMeshLods];
+    /** @brief Minimum corner of the object-space bounding box. */
+    float bounds_min[3];
+    /** @brief Maximum corner of the object-space bounding box. */
+    float bounds_max[3];
+    /** @brief Offset of the vertex data from the start of the blob. */
+    uint64_t vertex_data_offset;
+    /** @brief Offset of the index data from the start of the blob. */
+    uint64_t index_data_offset;
+};
+
+/**
+ * @brief A non-owning view of a parsed cooked mesh. Pointers refer into the parsed blob.
+ */
+struct MeshAssetView
+{
+    /** @brief The blob header. */
+    const MeshAssetHeader *header = nullptr;
+    /** @brief The interleaved vertex data. */
+    const void *vertex_data = nullptr;
+    /** @brief The index data. */
+    const void *index_data = nullptr;
+};
+
+/**
+ * @brief Serializes an optimized mesh into a cooked mesh blob.
+ * @param mesh The optimized mesh.
+ * @return The blob bytes.
+ */
+PIECE_CORE_API std::vector<uint8_t> SerializeMeshAsset(const OptimizedMesh &mesh);
+
+/**
+ * @brief Validates a cooked mesh blob and exposes its contents without copying.
+ * @param data Pointer to the blob, e.g. from AssetPack::GetData.
+ * @param size The size of the blob.
+ * @param view Receives pointers into the blob.
+ * @return True if the blob is valid, false otherwise.
+ */
+PIECE_CORE_API bool ParseMeshAsset(const void *data, size_t size, MeshAssetView &view);
+
+/**
+ * @brief Creates the GPU buffers of a cooked mesh, uploading straight from the blob memory.
+ * @param device The graphics device.
+ * @param view A parsed cooked mesh.
+ * @param vertex_buffer Receives the vertex buffer handle.
+ * @param index_buffer Receives the index buffer handle.
+ */
+PIECE_CORE_API void CreateMeshBuffers(RAL::IGraphicsDevice &device, const MeshAssetView &view,
+                                      RAL::VertexBufferHandle &vertex_buffer, RAL::IndexBufferHandle &index_buffer);
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_RESOURCES_MESH_ASSET_H_
@@ -0,0 +1,446 @@
+/**
+ * @file mesh_lod.cpp
+ * @brief Implements quadric edge-collapse simplification and screen-space LOD selection.
+ */
+#include "mesh_lod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace Piece
+{
+namespace Core
+{
+
+namespace
+{
+/** @brief Weight of the plane constraints that keep open borders in place, relative to face area. */
+constexpr double kBorderWeight = 10.0;
+
+/**
+ * @brief How a vertex may move during simplification.
+ */
+enum class VertexKind : uint8_t
+{
+    Manifold, /**< Interior vertex, may collapse along any edge. */
+    Border,   /**< On an open border, may only collapse along border edges. */
+    Locked    /**< Seam or non-manifold vertex, never collapses. */
+};
+
+/**
+ * @brief A symmetric 4x4 error quadric and the total weight accumulated into it.
+ */
+struct Quadric
+{
+    double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+    double a11 = 0, a12 = 0, a13 = 0;
+    double a22 = 0, a23 = 0;
+    double a33 = 0;
+    double weight = 0;
+
+    /**
+     * @brief Adds the squared distance to a plane.
+     * @param a Plane normal x.
+     * @param b Plane normal y.
+     * @param c Plane normal z.
+     * @param d Plane offset.
+     * @param w The weight of the plane.
+     */
+    void AddPlane(double a, double b, double c, double d, double w)
+    {
+        a00 += w * a * a, a01 += w * a * b, a02 += w * a * c, a03 += w * a * d;
+        a11 += w * b * b, a12 += w * b * c, a13 += w * b * d;
+        a22 += w * c * c, a23 += w * c * d;
+        a33 += w * d * d;
+        weight += w;
+    }
+
+    /**
+     * @brief Accumulates another quadric.
+     * @param other The quadric to add.
+     */
+    void Add(const Quadric &other)
+    {
+        a00 += other.a00, a01 += other.a01, a02 += other.a02, a03 += other.a03;
+        a11 += other.a11, a12 += other.a12, a13 += other.a13;
+        a22 += other.a22, a23 += other.a23;
+        a33 += other.a33;
+        weight += other.weight;
+    }
+
+    /**
+     * @brief Evaluates the weighted squared distance of a point to the accumulated planes.
+     * @param p The point.
+     * @return The error, never negative.
+     */
+    double Evaluate(const glm::vec3 &p) const
+    {
+        double x = p.x, y = p.y, z = p.z;
+        double error = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                       2.0 * (a03 * x + a13 * y + a23 * z) + a33;
+        return std::max(error, 0.0);
+    }
+};
+
+/**
+ * @brief A candidate collapse of vertex from onto vertex to.
+ */
+struct Collapse
+{
+    uint32_t from;
+    uint32_t to;
+    /** @brief The mean squared distance introduced by the collapse. */
+    double cost;
+};
+
+/**
+ * @brief Builds a key for an undirected edge between two vertices.
+ * @param a First vertex.
+ * @param b Second vertex.
+ * @return The key.
+ */
+uint64_t EdgeKey(uint32_t a, uint32_t b)
+{
+    return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+}
+
+/**
+ * @brief Maps every vertex to the first vertex sharing its exact position.
+ * @param positions The vertex positions.
+ * @param vertex_count The number of vertices.
+ * @return The weld table.
+ */
+std::vector<uint32_t> WeldPositions(const glm::vec3 *positions, size_t vertex_count)
+{
+    struct PositionHash
+    {
+        size_t operator()(const glm::vec3 &p) const
+        {
+            uint32_t bits[3];
+            std::memcpy(bits, &p, sizeof(bits));
+            return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+        }
+    };
+    struct PositionEqual
+    {
+        bool operator()(const glm::vec3 &a, const glm::vec3 &b) const
+        {
+            return std::memcmp(&a, &b, sizeof(glm::vec3)) == 0;
+        }
+    };
+
+    std::unordered_map<glm::vec3, uint32_t, PositionHash, PositionEqual> first;
+    first.reserve(vertex_count);
+    std::vector<uint32_t> weld(vertex_count);
+    for (uint32_t v = 0; v < static_cast<uint32_t>(vertex_count); ++v)
+    {
+        weld[v] = first.emplace(positions[v], v).first->second;
+    }
+    return weld;
+}
+
+/**
+ * @brief Computes the unnormalized normal of a triangle.
+ * @param a First corner.
+ * @param b Second corner.
+ * @param c Third corner.
+ * @return The cross product of two edges.
+ */
+glm::vec3 TriangleNormal(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+{
+    return glm::cross(b - a, c - a);
+}
+} // namespace
+
+size_t SimplifyMesh(uint32_t *destination, const uint32_t *indices, size_t index_count, const glm::vec3 *positions,
+                    size_t vertex_count, size_t target_index_count, float target_error, float *result_error)
+{
+    if (destination != indices)
+    {
+        std::memmove(destination, indices, index_count * sizeof(uint32_t));
+    }
+    if (result_error)
+    {
+        *result_error = 0.0f;
+    }
+    if (index_count <= target_index_count || vertex_count == 0)
+    {
+        return index_count;
+    }
+
+    // Classify vertices on the welded mesh so seams count as shared edges rather than borders.
+    std::vector<uint32_t> weld = WeldPositions(positions, vertex_count);
+    std::vector<uint32_t> variants(vertex_count, 0);
+    for (uint32_t v = 0; v < static_cast<uint32_t>(vertex_count); ++v)
+    {
+        ++variants[weld[v]];
+    }
+    std::unordered_map<uint64_t, uint32_t> edge_uses;
+    auto count_edge_uses = [&] {
+        edge_uses.clear();
+        edge_uses.reserve(index_count);
+        for (size_t i = 0; i < index_count; i += 3)
+        {
+            for (int e = 0; e < 3; ++e)
+            {
+                ++edge_uses[EdgeKey(weld[destination[i + e]], weld[destination[i + (e + 1) % 3]])];
+            }
+        }
+    };
+    auto is_border_edge = [&](uint32_t a, uint32_t b) {
+        auto it = edge_uses.find(EdgeKey(weld[a], weld[b]));
+        return it != edge_uses.end() && it->second == 1;
+    };
+    count_edge_uses();
+
+    std::vector<VertexKind> kind(vertex_count, VertexKind::Manifold);
+    for (uint32_t v = 0; v < static_cast<uint32_t>(vertex_count); ++v)
+    {
+        if (variants[weld[v]] > 1)
+        {
+            kind[v] = VertexKind::Locked;
+        }
+    }
+    for (const auto &edge : edge_uses)
+    {
+        uint32_t a = static_cast<uint32_t>(edge.first >> 32);
+        uint32_t b = static_cast<uint32_t>(edge.first & 0xFFFFFFFFu);
+        VertexKind edge_kind = edge.second == 1 ? VertexKind::Border
+                               : edge.second > 2 ? VertexKind::Locked
+                                                 : VertexKind::Manifold;
+        kind[a] = std::max(kind[a], edge_kind);
+        kind[b] = std::max(kind[b], edge_kind);
+    }
+    for (uint32_t v = 0; v < static_cast<uint32_t>(vertex_count); ++v)
+    {
+        kind[v] = kind[weld[v]];
+    }
+
+    // Quadrics live on welded vertices: face planes weighted by area, plus perpendicular planes along borders.
+    std::vector<Quadric> quadrics(vertex_count);
+    for (size_t i = 0; i < index_count; i += 3)
+    {
+        uint32_t corner[3] = {weld[destination[i]], weld[destination[i + 1]], weld[destination[i + 2]]};
+        glm::vec3 normal = TriangleNormal(positions[corner[0]], positions[corner[1]], positions[corner[2]]);
+        float length = glm::length(normal);
+        if (length <= 0.0f)
+        {
+            continue;
+        }
+        normal /= length;
+        float offset = -glm::dot(normal, positions[corner[0]]);
+        for (uint32_t v : corner)
+        {
+            quadrics[v].AddPlane(normal.x, normal.y, normal.z, offset, 0.5 * length);
+        }
+
+        for (int e = 0; e < 3; ++e)
+        {
+            uint32_t a = corner[e];
+            uint32_t b = corner[(e + 1) % 3];
+            if (!is_border_edge(a, b))
+            {
+                continue;
+            }
+            glm::vec3 edge = positions[b] - positions[a];
+            glm::vec3 border_normal = glm::cross(edge, normal);
+            float border_length = glm::length(border_normal);
+            if (border_length <= 0.0f)
+            {
+                continue;
+            }
+            border_normal /= border_length;
+            float border_offset = -glm::dot(border_normal, positions[a]);
+            double weight = kBorderWeight * glm::dot(edge, edge);
+            quadrics[a].AddPlane(border_normal.x, border_normal.y, border_normal.z, border_offset, weight);
+            quadrics[b].AddPlane(border_normal.x, border_normal.y, border_normal.z, border_offset, weight);
+        }
+    }
+
+    double max_cost = static_cast<double>(target_error) * target_error;
+    double worst_applied = 0.0;
+    std::vector<uint32_t> triangle_offsets(vertex_count + 1);
+    std::vector<uint32_t> vertex_triangles;
+    std::vector<Collapse> collapses;
+    std::vector<uint32_t> remap(vertex_count);
+    std::vector<uint8_t> touched(vertex_count);
+
+    for (bool first_pass = true; index_count > target_index_count; first_pass = false)
+    {
+        // Collapses along borders create new border edges, so the counts are refreshed every pass.
+        if (!first_pass)
+        {
+            count_edge_uses();
+        }
+
+        // Vertex to triangle adjacency for the flip test.
+        std::fill(triangle_offsets.begin(), triangle_offsets.end(), 0);
+        for (size_t i = 0; i < index_count; ++i)
+        {
+            ++triangle_offsets[destination[i] + 1];
+        }
+        for (size_t v = 0; v < vertex_count; ++v)
+        {
+            triangle_offsets[v + 1] += triangle_offsets[v];
+        }
+        vertex_triangles.resize(index_count);
+        {
+            std::vector<uint32_t> cursor(triangle_offsets.begin(), triangle_offsets.end() - 1);
+            for (size_t i = 0; i < index_count; ++i)
+            {
+                vertex_triangles[cursor[destination[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        collapses.clear();
+        for (size_t i = 0; i < index_count; i += 3)
+        {
+            for (int e = 0; e < 3; ++e)
+            {
+                uint32_t from = destination[i + e];
+                uint32_t to = destination[i + (e + 1) % 3];
+                for (int direction = 0; direction < 2; ++direction, std::swap(from, to))
+                {
+                    if (kind[from] == VertexKind::Locked ||
+                        (kind[from] == VertexKind::Border && !is_border_edge(from, to)))
+                    {
+                        continue;
+                    }
+                    Quadric combined = quadrics[weld[from]];
+                    combined.Add(quadrics[weld[to]]);
+                    double cost = combined.Evaluate(positions[to]) / std::max(combined.weight, 1e-12);
+                    if (cost <= max_cost)
+                    {
+                        collapses.push_back({from, to, cost});
+                    }
+                }
+            }
+        }
+        if (collapses.empty())
+        {
+            break;
+        }
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse &a, const Collapse &b) { return a.cost < b.cost; });
+
+        // Apply an independent set of the cheapest collapses; each one removes about two triangles.
+        for (uint32_t v = 0; v < static_cast<uint32_t>(vertex_count); ++v)
+        {
+            remap[v] = v;
+        }
+        std::fill(touched.begin(), touched.end(), 0);
+        size_t triangles_needed = (index_count - target_index_count + 2) / 3;
+        size_t triangles_removed = 0;
+        for (const Collapse &collapse : collapses)
+        {
+            if (triangles_removed >= triangles_needed)
+            {
+                break;
+            }
+            if (touched[collapse.from] || touched[collapse.to])
+            {
+                continue;
+            }
+
+            const glm::vec3 &target = positions[collapse.to];
+            bool flips = false;
+            size_t removed = 0;
+            for (uint32_t t = triangle_offsets[collapse.from]; t < triangle_offsets[collapse.from + 1] && !flips; ++t)
+            {
+                const uint32_t *triangle = destination + vertex_triangles[t] * 3;
+                if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                {
+                    ++removed;
+                    continue;
+                }
+                glm::vec3 corners[3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    corners[c] = triangle[c] == collapse.from ? target : positions[triangle[c]];
+                }
+                glm::vec3 before = TriangleNormal(positions[triangle[0]], positions[triangle[1]], positions[triangle[2]]);
+                glm::vec3 after = TriangleNormal(corners[0], corners[1], corners[2]);
+                flips = glm::dot(before, after) <= 0.0f;
+            }
+            if (flips)
+            {
+                continue;
+            }
+
+            remap[collapse.from] = collapse.to;
+            quadrics[weld[collapse.to]].Add(quadrics[weld[collapse.from]]);
+            for (uint32_t t = triangle_offsets[collapse.from]; t < triangle_offsets[collapse.from + 1]; ++t)
+            {
+                const uint32_t *triangle = destination + vertex_triangles[t] * 3;
+                touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+            }
+            triangles_removed += removed;
+            worst_applied = std::max(worst_applied, collapse.cost);
+        }
+        if (triangles_removed == 0)
+        {
+            break;
+        }
+
+        size_t write = 0;
+        for (size_t i = 0; i < index_count; i += 3)
+        {
+            uint32_t a = remap[destination[i]];
+            uint32_t b = remap[destination[i + 1]];
+            uint32_t c = remap[destination[i + 2]];
+            if (weld[a] == weld[b] || weld[b] == weld[c] || weld[a] == weld[c])
+            {
+                continue;
+            }
+            destination[write++] = a;
+            destination[write++] = b;
+            destination[write++] = c;
+        }
+        index_count = write;
+    }
+
+    if (result_error)
+    {
+        *result_error = static_cast<float>(std::sqrt(worst_applied));
+    }
+    return index_count;
+}
+
+float ComputeLodProjectionScale(float vertical_fov, float viewport_height)
+{
+    return viewport_height / (2.0f * std::tan(vertical_fov * 0.5f));
+}
+
+uint32_t SelectLod(const MeshLod *lods, uint32_t lod_count, float distance, uint32_t current_lod,
+                   const LodSelectionParams &params)
+{
+    current_lod = std::min(current_lod, lod_count - 1);
+    float pixels_per_unit = params.projection_scale / std::max(distance, 1e-4f);
+
+    // Coarsest level within a budget; errors grow monotonically along the chain.
+    auto coarsest_within = [&](float budget) {
+        uint32_t lod = 0;
+        while (lod + 1 < lod_count && lods[lod + 1].error * pixels_per_unit <= budget)
+        {
+            ++lod;
+        }
+        return lod;
+    };
+
+    uint32_t desired = coarsest_within(params.pixel_error);
+    if (desired < current_lod)
+    {
+        return desired;
+    }
+    if (desired > current_lod)
+    {
+        return std::max(current_lod, coarsest_within(params.pixel_error * (1.0f - params.hysteresis)));
+    }
+    return current_lod;
+}
+
+} // namespace Core
+} // namespace Piece
@@ -0,0 +1,97 @@
+/**
+ * @file mesh_lod.h
+ * @brief Declares level-of-detail generation by quadric edge collapse and runtime LOD selection from the projected
+ *        screen-space error.
+ */
+#ifndef PIECE_CORE_RESOURCES_MESH_LOD_H_
+#define PIECE_CORE_RESOURCES_MESH_LOD_H_
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/** @brief The maximum number of levels of detail of a mesh, including the full-detail level. */
+constexpr uint32_t kMaxMeshLods = 8;
+
+/**
+ * @brief One level of detail: a range of the shared index buffer drawn with the shared vertex buffer.
+ */
+struct MeshLod
+{
+    /** @brief The first index of the level in the index buffer. */
+    uint32_t index_offset;
+    /** @brief The number of indices of the level. */
+    uint32_t index_count;
+    /** @brief The object-space geometric error of the level relative to the full-detail mesh. 0 for LOD 0. */
+    float error;
+};
+
+/**
+ * @brief Simplifies a triangle mesh by collapsing edges in order of increasing quadric error.
+ * @details Vertices are only ever collapsed onto other existing vertices, so the result indexes the same vertex
+ *          buffer as the input. Vertices with several attribute variants at the same position (UV or normal seams) and
+ *          non-manifold vertices stay in place; open borders only collapse along themselves.
+ * @param destination Receives the simplified indices. Must hold index_count entries; may alias indices.
+ * @param indices The triangle list indices.
+ * @param index_count The number of indices. Must be a multiple of 3.
+ * @param positions The vertex positions.
+ * @param vertex_count The number of vertices.
+ * @param target_index_count The number of indices to reduce to.
+ * @param target_error The maximum object-space distance a collapse may move the surface.
+ * @param result_error Optional, receives the largest error introduced.
+ * @return The number of indices written to destination.
+ */
+PIECE_CORE_API size_t SimplifyMesh(uint32_t *destination, const uint32_t *indices, size_t index_count,
+                                   const glm::vec3 *positions, size_t vertex_count, size_t target_index_count,
+                                   float target_error, float *result_error = nullptr);
+
+/**
+ * @brief Parameters controlling SelectLod.
+ */
+struct LodSelectionParams
+{
+    /** @brief Pixels per world unit at distance 1, see ComputeLodProjectionScale. */
+    float projection_scale = 1.0f;
+    /** @brief The largest screen-space error in pixels a level may show. */
+    float pixel_error = 1.0f;
+    /**
+     * @brief The fraction of pixel_error a coarser level must stay under before switching to it.
+     *        Objects hovering around a threshold distance then keep their level instead of popping every frame.
+     */
+    float hysteresis = 0.25f;
+};
+
+/**
+ * @brief Computes LodSelectionParams::projection_scale for a perspective projection.
+ * @param vertical_fov The vertical field of view in radians.
+ * @param viewport_height The viewport height in pixels.
+ * @return The number of pixels covered by one world unit at distance 1.
+ */
+PIECE_CORE_API float ComputeLodProjectionScale(float vertical_fov, float viewport_height);
+
+/**
+ * @brief Selects the coarsest level whose projected error stays within the pixel budget.
+ * @details Switching to a finer level happens as soon as the current one exceeds the budget; switching to a coarser
+ *          level requires its projected error to be below the budget reduced by the hysteresis fraction.
+ * @param lods The levels of the mesh, finest first.
+ * @param lod_count The number of levels. Must be at least 1.
+ * @param distance The distance from the camera to the object, divided by the object's scale.
+ * @param current_lod The level selected last frame.
+ * @param params The selection parameters.
+ * @return The level to render.
+ */
+PIECE_CORE_API uint32_t SelectLod(const MeshLod *lods, uint32_t lod_count, float distance, uint32_t current_lod,
+                                  const LodSelectionParams &params);
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_RESOURCES_MESH_LOD_H_
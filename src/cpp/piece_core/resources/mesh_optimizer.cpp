@@ -0,0 +1,676 @@
+/**
+ * @file mesh_optimizer.cpp
+ * @brief Implements the import-time mesh optimization pipeline.
+ */
+#include "mesh_optimizer.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Piece
+{
+namespace Core
+{
+
+namespace
+{
+/**
+ * @brief Simulates a FIFO post-transform cache using insertion timestamps.
+ * @details A vertex is cached if fewer than cache_size insertions happened since it was inserted.
+ */
+class FifoCacheSimulator
+{
+  public:
+    /**
+     * @brief Constructs a simulator for a given number of vertices.
+     * @param vertex_count The number of vertices.
+     * @param cache_size The size of the FIFO cache.
+     */
+    FifoCacheSimulator(size_t vertex_count, uint32_t cache_size)
+        : timestamps_(vertex_count, 0), cache_size_(cache_size), time_(cache_size + 1)
+    {
+    }
+
+    /**
+     * @brief Evicts every vertex from the cache.
+     */
+    void Reset()
+    {
+        time_ += cache_size_ + 1;
+    }
+
+    /**
+     * @brief Processes one triangle.
+     * @param triangle Pointer to three vertex indices.
+     * @return The number of cache misses caused by the triangle.
+     */
+    uint32_t Process(const uint32_t *triangle)
+    {
+        uint32_t misses = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            uint32_t v = triangle[k];
+            if (time_ - timestamps_[v] > cache_size_)
+            {
+                timestamps_[v] = time_++;
+                ++misses;
+            }
+        }
+        return misses;
+    }
+
+  private:
+    /** @brief Insertion time of each vertex. */
+    std::vector<uint32_t> timestamps_;
+    /** @brief The size of the FIFO cache. */
+    uint32_t cache_size_;
+    /** @brief The current insertion time. */
+    uint32_t time_;
+};
+
+/**
+ * @brief A contiguous range of triangles reordered as a unit by OptimizeOverdraw.
+ */
+struct TriangleCluster
+{
+    /** @brief The first triangle of the cluster. */
+    size_t first_triangle;
+    /** @brief The number of triangles in the cluster. */
+    size_t triangle_count;
+    /** @brief The overdraw sort key. Larger keys are drawn first. */
+    float sort_key;
+};
+} // namespace
+
+float AnalyzeVertexCache(const uint32_t *indices, size_t index_count, size_t vertex_count, uint32_t cache_size)
+{
+    size_t triangle_count = index_count / 3;
+    if (triangle_count == 0)
+    {
+        return 0.0f;
+    }
+
+    FifoCacheSimulator cache(vertex_count, cache_size);
+    size_t misses = 0;
+    for (size_t t = 0; t < triangle_count; ++t)
+    {
+        misses += cache.Process(&indices[t * 3]);
+    }
+    return static_cast<float>(misses) / static_cast<float>(triangle_count);
+}
+
+void OptimizeVertexCache(uint32_t *indices, size_t index_count, size_t vertex_count, uint32_t cache_size)
+{
+    size_t triangle_count = index_count / 3;
+    if (triangle_count == 0 || vertex_count == 0)
+    {
+        return;
+    }
+
+    // Vertex to triangle adjacency in CSR form; live counts the triangles of each vertex not emitted yet.
+    std::vector<uint32_t> live(vertex_count, 0);
+    for (size_t i = 0; i < triangle_count * 3; ++i)
+    {
+        ++live[indices[i]];
+    }
+    std::vector<uint32_t> offsets(vertex_count + 1, 0);
+    for (size_t v = 0; v < vertex_count; ++v)
+    {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+    std::vector<uint32_t> adjacency(triangle_count * 3);
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangle_count; ++t)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<uint32_t> cache_time(vertex_count, 0);
+    std::vector<uint8_t> emitted(triangle_count, 0);
+    std::vector<uint32_t> dead_end;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> output;
+    dead_end.reserve(triangle_count * 3);
+    output.reserve(triangle_count * 3);
+
+    uint32_t time = cache_size + 1;
+    size_t cursor = 0;
+    int64_t fanning = indices[0];
+
+    while (fanning >= 0)
+    {
+        // Emit every pending triangle around the fanning vertex.
+        candidates.clear();
+        uint32_t f = static_cast<uint32_t>(fanning);
+        for (uint32_t a = offsets[f]; a < offsets[f + 1]; ++a)
+        {
+            uint32_t t = adjacency[a];
+            if (emitted[t])
+            {
+                continue;
+            }
+            for (int k = 0; k < 3; ++k)
+            {
+                uint32_t v = indices[t * 3 + k];
+                output.push_back(v);
+                dead_end.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+                if (time - cache_time[v] > cache_size)
+                {
+                    cache_time[v] = time++;
+                }
+            }
+            emitted[t] = 1;
+        }
+
+        // Pick the candidate that will still be in the cache after its remaining triangles are emitted,
+        // preferring the oldest one.
+        int64_t best = -1;
+        int64_t best_priority = -1;
+        for (uint32_t v : candidates)
+        {
+            if (live[v] == 0)
+            {
+                continue;
+            }
+            int64_t priority = 0;
+            if (time - cache_time[v] + 2 * live[v] <= cache_size)
+            {
+                priority = time - cache_time[v];
+            }
+            if (priority > best_priority)
+            {
+                best_priority = priority;
+                best = v;
+            }
+        }
+
+        // Dead end: fall back to recently used vertices, then to the next unprocessed vertex in input order.
+        while (best < 0 && !dead_end.empty())
+        {
+            uint32_t v = dead_end.back();
+            dead_end.pop_back();
+            if (live[v] > 0)
+            {
+                best = v;
+            }
+        }
+        while (best < 0 && cursor < vertex_count)
+        {
+            if (live[cursor] > 0)
+            {
+                best = static_cast<int64_t>(cursor);
+            }
+            else
+            {
+                ++cursor;
+            }
+        }
+        fanning = best;
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+void OptimizeOverdraw(uint32_t *indices, size_t index_count, const glm::vec3 *positions, size_t vertex_count,
+                      uint32_t cache_size, float threshold)
+{
+    size_t triangle_count = index_count / 3;
+    if (triangle_count < 2)
+    {
+        return;
+    }
+
+    // Hard boundaries: a triangle missing all three vertices marks a restart of the cache-ordered strip.
+    std::vector<size_t> hard_starts;
+    {
+        FifoCacheSimulator cache(vertex_count, cache_size);
+        for (size_t t = 0; t < triangle_count; ++t)
+        {
+            if (cache.Process(&indices[t * 3]) == 3 || t == 0)
+            {
+                hard_starts.push_back(t);
+            }
+        }
+    }
+    hard_starts.push_back(triangle_count);
+
+    // Soft boundaries: split each hard cluster as soon as the cold-cache ACMR of the running sub-cluster is within
+    // threshold of the cluster ACMR, so reordering sub-clusters costs at most that much cache efficiency.
+    std::vector<TriangleCluster> clusters;
+    FifoCacheSimulator cache(vertex_count, cache_size);
+    for (size_t h = 0; h + 1 < hard_starts.size(); ++h)
+    {
+        size_t start = hard_starts[h];
+        size_t end = hard_starts[h + 1];
+
+        cache.Reset();
+        size_t cluster_misses = 0;
+        for (size_t t = start; t < end; ++t)
+        {
+            cluster_misses += cache.Process(&indices[t * 3]);
+        }
+        float cluster_threshold =
+            threshold * static_cast<float>(cluster_misses) / static_cast<float>(end - start);
+
+        cache.Reset();
+        size_t sub_start = start;
+        size_t sub_misses = 0;
+        for (size_t t = start; t < end; ++t)
+        {
+            sub_misses += cache.Process(&indices[t * 3]);
+            size_t sub_count = t + 1 - sub_start;
+            if (t + 1 == end ||
+                static_cast<float>(sub_misses) / static_cast<float>(sub_count) <= cluster_threshold)
+            {
+                clusters.push_back({sub_start, sub_count, 0.0f});
+                sub_start = t + 1;
+                sub_misses = 0;
+                cache.Reset();
+            }
+        }
+    }
+
+    // Sort key: how much the cluster faces away from the mesh centroid.
+    glm::vec3 mesh_centroid(0.0f);
+    for (size_t i = 0; i < triangle_count * 3; ++i)
+    {
+        mesh_centroid += positions[indices[i]];
+    }
+    mesh_centroid *= 1.0f / static_cast<float>(triangle_count * 3);
+
+    for (TriangleCluster &cluster : clusters)
+    {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area_sum = 0.0f;
+        for (size_t t = cluster.first_triangle; t < cluster.first_triangle + cluster.triangle_count; ++t)
+        {
+            const glm::vec3 &p0 = positions[indices[t * 3 + 0]];
+            const glm::vec3 &p1 = positions[indices[t * 3 + 1]];
+            const glm::vec3 &p2 = positions[indices[t * 3 + 2]];
+            glm::vec3 face = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(face);
+            centroid += (p0 + p1 + p2) * (area / 3.0f);
+            normal += face;
+            area_sum += area;
+        }
+        float normal_length = glm::length(normal);
+        if (area_sum > 0.0f && normal_length > 0.0f)
+        {
+            centroid *= 1.0f / area_sum;
+            cluster.sort_key = glm::dot(centroid - mesh_centroid, normal * (1.0f / normal_length));
+        }
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const TriangleCluster &a, const TriangleCluster &b) { return a.sort_key > b.sort_key; });
+
+    std::vector<uint32_t> output;
+    output.reserve(triangle_count * 3);
+    for (const TriangleCluster &cluster : clusters)
+    {
+        output.insert(output.end(), indices + cluster.first_triangle * 3,
+                      indices + (cluster.first_triangle + cluster.triangle_count) * 3);
+    }
+    std::copy(output.begin(), output.end(), indices);
+}
+
+size_t OptimizeVertexFetchRemap(uint32_t *remap, const uint32_t *indices, size_t index_count, size_t vertex_count)
+{
+    std::fill(remap, remap + vertex_count, std::numeric_limits<uint32_t>::max());
+
+    uint32_t next = 0;
+    for (size_t i = 0; i < index_count; ++i)
+    {
+        uint32_t v = indices[i];
+        if (remap[v] == std::numeric_limits<uint32_t>::max())
+        {
+            remap[v] = next++;
+        }
+    }
+    return next;
+}
+
+void OptimizeVertexFetch(MeshData &mesh)
+{
+    size_t vertex_count = mesh.positions.size();
+    std::vector<uint32_t> remap(vertex_count);
+    size_t unique_count = OptimizeVertexFetchRemap(remap.data(), mesh.indices.data(), mesh.indices.size(), vertex_count);
+
+    bool has_normals = mesh.normals.size() == vertex_count;
+    bool has_uvs = mesh.uvs.size() == vertex_count;
+
+    std::vector<glm::vec3> positions(unique_count);
+    std::vector<glm::vec3> normals(has_normals ? unique_count : 0);
+    std::vector<glm::vec2> uvs(has_uvs ? unique_count : 0);
+    for (size_t v = 0; v < vertex_count; ++v)
+    {
+        uint32_t target = remap[v];
+        if (target == std::numeric_limits<uint32_t>::max())
+        {
+            continue;
+        }
+        positions[target] = mesh.positions[v];
+        if (has_normals)
+        {
+            normals[target] = mesh.normals[v];
+        }
+        if (has_uvs)
+        {
+            uvs[target] = mesh.uvs[v];
+        }
+    }
+    for (uint32_t &index : mesh.indices)
+    {
+        index = remap[index];
+    }
+
+    mesh.positions = std::move(positions);
+    mesh.normals = std::move(normals);
+    mesh.uvs = std::move(uvs);
+}
+
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    uint32_t abs = bits & 0x7FFFFFFFu;
+
+    if (abs >= 0x7F800000u)
+    {
+        // Infinity stays infinity, NaN stays a quiet NaN.
+        return sign | 0x7C00u | (abs > 0x7F800000u ? 0x0200u : 0u);
+    }
+    if (abs >= 0x477FF000u)
+    {
+        // Rounds past the largest finite half (65504).
+        return sign | 0x7C00u;
+    }
+    if (abs < 0x38800000u)
+    {
+        // Half subnormal range; values below 2^-25 round to zero.
+        if (abs < 0x33000000u)
+        {
+            return sign;
+        }
+        uint32_t exponent = abs >> 23;
+        uint32_t mantissa = (abs & 0x007FFFFFu) | 0x00800000u;
+        uint32_t shift = 126 - exponent;
+        uint32_t half_mantissa = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half_mantissa & 1u)))
+        {
+            ++half_mantissa;
+        }
+        return sign | static_cast<uint16_t>(half_mantissa);
+    }
+
+    // Normal range: rebias the exponent and round the mantissa to nearest even. A carry correctly bumps the exponent.
+    uint32_t half = (abs - 0x38000000u) >> 13;
+    uint32_t remainder = abs & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+    {
+        ++half;
+    }
+    return sign | static_cast<uint16_t>(half);
+}
+
+float HalfToFloat(uint16_t value)
+{
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x03FFu;
+
+    if (exponent == 0)
+    {
+        float magnitude = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+        return sign ? -magnitude : magnitude;
+    }
+
+    uint32_t bits;
+    if (exponent == 31)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+void EncodeOctahedral(const glm::vec3 &normal, int16_t out[2])
+{
+    float l1 = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (l1 <= 0.0f)
+    {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+
+    float x = normal.x / l1;
+    float y = normal.y / l1;
+    if (normal.z < 0.0f)
+    {
+        float folded_x = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float folded_y = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = folded_x;
+        y = folded_y;
+    }
+    out[0] = static_cast<int16_t>(std::lround(std::min(std::max(x, -1.0f), 1.0f) * 32767.0f));
+    out[1] = static_cast<int16_t>(std::lround(std::min(std::max(y, -1.0f), 1.0f) * 32767.0f));
+}
+
+glm::vec3 DecodeOctahedral(const int16_t in[2])
+{
+    float x = std::max(static_cast<float>(in[0]) / 32767.0f, -1.0f);
+    float y = std::max(static_cast<float>(in[1]) / 32767.0f, -1.0f);
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    if (z < 0.0f)
+    {
+        float unfolded_x = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float unfolded_y = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = unfolded_x;
+        y = unfolded_y;
+    }
+    return glm::normalize(glm::vec3(x, y, z));
+}
+
+OptimizedMesh OptimizeMesh(const MeshData &mesh, const MeshOptimizerOptions &options)
+{
+    OptimizedMesh result;
+    if (mesh.positions.empty() || mesh.indices.size() < 3)
+    {
+        spdlog::warn("OptimizeMesh: mesh has no triangles, nothing to optimize.");
+        return result;
+    }
+
+    MeshData work = mesh;
+    work.indices.resize(work.indices.size() - work.indices.size() % 3);
+    // Every later stage indexes per-vertex arrays with the indices, so a triangle referencing a missing vertex is
+    // dropped here rather than read or written out of bounds.
+    size_t kept = 0;
+    for (size_t i = 0; i < work.indices.size(); i += 3)
+    {
+        if (work.indices[i] < work.positions.size() && work.indices[i + 1] < work.positions.size() &&
+            work.indices[i + 2] < work.positions.size())
+        {
+            std::copy_n(work.indices.begin() + i, 3, work.indices.begin() + kept);
+            kept += 3;
+        }
+    }
+    if (kept != work.indices.size())
+    {
+        spdlog::warn("OptimizeMesh: dropping {} triangles with out-of-range indices.",
+                     (work.indices.size() - kept) / 3);
+        work.indices.resize(kept);
+        if (kept == 0)
+        {
+            return result;
+        }
+    }
+    if (!work.normals.empty() && work.normals.size() != work.positions.size())
+    {
+        spdlog::warn("OptimizeMesh: normal count does not match position count, dropping normals.");
+        work.normals.clear();
+    }
+    if (!work.uvs.empty() && work.uvs.size() != work.positions.size())
+    {
+        spdlog::warn("OptimizeMesh: uv count does not match position count, dropping uvs.");
+        work.uvs.clear();
+    }
+
+    OptimizeVertexCache(work.indices.data(), work.indices.size(), work.positions.size(), options.vertex_cache_size);
+    if (options.overdraw_threshold > 1.0f)
+    {
+        OptimizeOverdraw(work.indices.data(), work.indices.size(), work.positions.data(), work.positions.size(),
+                         options.vertex_cache_size, options.overdraw_threshold);
+    }
+
+    // Each level is simplified from the previous one and appended to the shared index buffer.
+    result.lods.push_back({0, static_cast<uint32_t>(work.indices.size()), 0.0f});
+    uint32_t lod_count = std::min(std::max(options.lod_count, 1u), kMaxMeshLods);
+    if (lod_count > 1)
+    {
+        glm::vec3 low = work.positions[0];
+        glm::vec3 high = work.positions[0];
+        for (const glm::vec3 &position : work.positions)
+        {
+            low = glm::min(low, position);
+            high = glm::max(high, position);
+        }
+        float target_error = options.lod_target_error * glm::length(high - low);
+
+        std::vector<uint32_t> lod_indices;
+        for (uint32_t level = 1; level < lod_count; ++level)
+        {
+            const MeshLod &previous = result.lods.back();
+            size_t target = static_cast<size_t>(previous.index_count * options.lod_reduction) / 3 * 3;
+            lod_indices.resize(previous.index_count);
+            float error = 0.0f;
+            size_t count = SimplifyMesh(lod_indices.data(), work.indices.data() + previous.index_offset,
+                                        previous.index_count, work.positions.data(), work.positions.size(), target,
+                                        target_error, &error);
+            if (count == 0 || count > previous.index_count * 0.95f)
+            {
+                break; // The error budget is exhausted; further levels would look the same.
+            }
+            OptimizeVertexCache(lod_indices.data(), count, work.positions.size(), options.vertex_cache_size);
+            result.lods.push_back({static_cast<uint32_t>(work.indices.size()), static_cast<uint32_t>(count),
+                                   std::max(previous.error, error)});
+            work.indices.insert(work.indices.end(), lod_indices.begin(), lod_indices.begin() + count);
+        }
+    }
+    OptimizeVertexFetch(work);
+
+    bool has_normals = !work.normals.empty();
+    bool has_uvs = !work.uvs.empty();
+    result.layout.Append(RAL::VertexSemantic::Position,
+                         options.quantize_positions ? RAL::VertexFormat::Half4 : RAL::VertexFormat::Float3);
+    if (has_normals)
+    {
+        result.layout.Append(RAL::VertexSemantic::Normal,
+                             options.quantize_normals ? RAL::VertexFormat::Snorm16x2 : RAL::VertexFormat::Float3);
+    }
+    if (has_uvs)
+    {
+        result.layout.Append(RAL::VertexSemantic::TexCoord0,
+                             options.quantize_uvs ? RAL::VertexFormat::Half2 : RAL::VertexFormat::Float2);
+    }
+
+    result.vertex_count = static_cast<uint32_t>(work.positions.size());
+    result.vertex_data.resize(static_cast<size_t>(result.vertex_count) * result.layout.stride);
+    result.bounds_min = work.positions[0];
+    result.bounds_max = work.positions[0];
+
+    for (uint32_t v = 0; v < result.vertex_count; ++v)
+    {
+        uint8_t *vertex = result.vertex_data.data() + static_cast<size_t>(v) * result.layout.stride;
+        const glm::vec3 &position = work.positions[v];
+        result.bounds_min = glm::min(result.bounds_min, position);
+        result.bounds_max = glm::max(result.bounds_max, position);
+
+        uint32_t attribute = 0;
+        if (options.quantize_positions)
+        {
+            uint16_t packed[4] = {FloatToHalf(position.x), FloatToHalf(position.y), FloatToHalf(position.z),
+                                  FloatToHalf(1.0f)};
+            std::memcpy(vertex + result.layout.attributes[attribute].offset, packed, sizeof(packed));
+        }
+        else
+        {
+            float packed[3] = {position.x, position.y, position.z};
+            std::memcpy(vertex + result.layout.attributes[attribute].offset, packed, sizeof(packed));
+        }
+        ++attribute;
+
+        if (has_normals)
+        {
+            const glm::vec3 &normal = work.normals[v];
+            if (options.quantize_normals)
+            {
+                int16_t packed[2];
+                EncodeOctahedral(normal, packed);
+                std::memcpy(vertex + result.layout.attributes[attribute].offset, packed, sizeof(packed));
+            }
+            else
+            {
+                float packed[3] = {normal.x, normal.y, normal.z};
+                std::memcpy(vertex + result.layout.attributes[attribute].offset, packed, sizeof(packed));
+            }
+            ++attribute;
+        }
+
+        if (has_uvs)
+        {
+            const glm::vec2 &uv = work.uvs[v];
+            if (options.quantize_uvs)
+            {
+                uint16_t packed[2] = {FloatToHalf(uv.x), FloatToHalf(uv.y)};
+                std::memcpy(vertex + result.layout.attributes[attribute].offset, packed, sizeof(packed));
+            }
+            else
+            {
+                float packed[2] = {uv.x, uv.y};
+                std::memcpy(vertex + result.layout.attributes[attribute].offset, packed, sizeof(packed));
+            }
+        }
+    }
+
+    result.index_count = static_cast<uint32_t>(work.indices.size());
+    if (result.vertex_count <= std::numeric_limits<uint16_t>::max())
+    {
+        result.index_format = RAL::IndexFormat::UInt16;
+        result.index_data.resize(static_cast<size_t>(result.index_count) * sizeof(uint16_t));
+        uint16_t *out = reinterpret_cast<uint16_t *>(result.index_data.data());
+        for (uint32_t i = 0; i < result.index_count; ++i)
+        {
+            out[i] = static_cast<uint16_t>(work.indices[i]);
+        }
+    }
+    else
+    {
+        result.index_format = RAL::IndexFormat::UInt32;
+        result.index_data.resize(static_cast<size_t>(result.index_count) * sizeof(uint32_t));
+        std::memcpy(result.index_data.data(), work.indices.data(), result.index_data.size());
+    }
+
+    return result;
+}
+
+} // namespace Core
+} // namespace Piece
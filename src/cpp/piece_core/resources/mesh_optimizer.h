@@ -0,0 +1,185 @@
+/**
+ * @file mesh_optimizer.h
+ * @brief Declares the import-time mesh optimization pipeline: index reordering for the post-transform vertex cache
+ *        and overdraw, vertex reordering for fetch locality, and attribute quantization.
+ */
+#ifndef PIECE_CORE_RESOURCES_MESH_OPTIMIZER_H_
+#define PIECE_CORE_RESOURCES_MESH_OPTIMIZER_H_
+
+#include <ral/ral_types.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mesh_lod.h"
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/**
+ * @brief An uncompressed, indexed triangle mesh as produced by an importer.
+ * @details normals and uvs are optional; when present they must have one entry per position.
+ */
+struct MeshData
+{
+    /** @brief Vertex positions. */
+    std::vector<glm::vec3> positions;
+    /** @brief Vertex normals. Empty if the mesh has none. */
+    std::vector<glm::vec3> normals;
+    /** @brief First texture coordinate set. Empty if the mesh has none. */
+    std::vector<glm::vec2> uvs;
+    /** @brief Triangle list indices into the vertex arrays. */
+    std::vector<uint32_t> indices;
+};
+
+/**
+ * @brief Options controlling OptimizeMesh.
+ */
+struct MeshOptimizerOptions
+{
+    /** @brief The number of entries of the simulated FIFO post-transform cache. */
+    uint32_t vertex_cache_size = 16;
+    /**
+     * @brief The ACMR degradation allowed when reordering clusters for overdraw.
+     *        1.0 keeps the vertex cache order, larger values trade cache efficiency for less overdraw.
+     */
+    float overdraw_threshold = 1.05f;
+    /** @brief Stores positions as Half4 instead of Float3. */
+    bool quantize_positions = true;
+    /** @brief Stores normals as octahedral Snorm16x2 instead of Float3. */
+    bool quantize_normals = true;
+    /** @brief Stores texture coordinates as Half2 instead of Float2. */
+    bool quantize_uvs = true;
+    /** @brief The number of levels of detail to generate, including the full-detail level. Clamped to kMaxMeshLods. */
+    uint32_t lod_count = 1;
+    /** @brief The index count of each level relative to the previous one. */
+    float lod_reduction = 0.5f;
+    /** @brief The largest error a level may add, relative to the diagonal of the mesh bounds. */
+    float lod_target_error = 0.05f;
+};
+
+/**
+ * @brief A GPU-ready mesh: interleaved vertices matching a RAL::VertexLayout and a compact index buffer.
+ */
+struct OptimizedMesh
+{
+    /** @brief The layout of one vertex in vertex_data. */
+    RAL::VertexLayout layout = {};
+    /** @brief Interleaved vertex data, vertex_count * layout.stride bytes. */
+    std::vector<uint8_t> vertex_data;
+    /** @brief The number of vertices. */
+    uint32_t vertex_count = 0;
+    /** @brief The element type of index_data. UInt16 whenever the vertex count allows it. */
+    RAL::IndexFormat index_format = RAL::IndexFormat::UInt32;
+    /** @brief Index data, index_count * GetIndexFormatSize(index_format) bytes. */
+    std::vector<uint8_t> index_data;
+    /** @brief The number of indices of all levels of detail together. */
+    uint32_t index_count = 0;
+    /** @brief The levels of detail, finest first. Every level indexes the shared vertex data. */
+    std::vector<MeshLod> lods;
+    /** @brief Minimum corner of the object-space bounding box. */
+    glm::vec3 bounds_min = glm::vec3(0.0f);
+    /** @brief Maximum corner of the object-space bounding box. */
+    glm::vec3 bounds_max = glm::vec3(0.0f);
+};
+
+/**
+ * @brief Computes the average cache miss ratio (transformed vertices per triangle) of an index buffer.
+ * @param indices The triangle list indices.
+ * @param index_count The number of indices.
+ * @param vertex_count The number of vertices referenced by the indices.
+ * @param cache_size The size of the simulated FIFO cache.
+ * @return The ACMR. 0.5 is the lower bound for large regular meshes, 3.0 the worst case.
+ */
+PIECE_CORE_API float AnalyzeVertexCache(const uint32_t *indices, size_t index_count, size_t vertex_count,
+                                        uint32_t cache_size);
+
+/**
+ * @brief Reorders triangles in place to maximize post-transform vertex cache hits (Tipsify).
+ * @param indices The triangle list indices to reorder.
+ * @param index_count The number of indices. Must be a multiple of 3.
+ * @param vertex_count The number of vertices referenced by the indices.
+ * @param cache_size The size of the targeted FIFO cache.
+ */
+PIECE_CORE_API void OptimizeVertexCache(uint32_t *indices, size_t index_count, size_t vertex_count,
+                                        uint32_t cache_size);
+
+/**
+ * @brief Reorders triangle clusters in place so outward-facing clusters are drawn first, reducing overdraw.
+ * @details Expects indices already optimized with OptimizeVertexCache. The buffer is split into clusters that keep
+ *          the ACMR within threshold of the input, and clusters are sorted by how much they face away from the mesh
+ *          centroid.
+ * @param indices The triangle list indices to reorder.
+ * @param index_count The number of indices. Must be a multiple of 3.
+ * @param positions The vertex positions.
+ * @param vertex_count The number of vertices.
+ * @param cache_size The size of the simulated FIFO cache.
+ * @param threshold The allowed ACMR degradation, e.g. 1.05.
+ */
+PIECE_CORE_API void OptimizeOverdraw(uint32_t *indices, size_t index_count, const glm::vec3 *positions,
+                                     size_t vertex_count, uint32_t cache_size, float threshold);
+
+/**
+ * @brief Builds a vertex remap table that orders vertices by first use in the index buffer.
+ * @param remap Output table of vertex_count entries mapping old to new vertex indices. Unreferenced vertices map to
+ *        UINT32_MAX.
+ * @param indices The triangle list indices.
+ * @param index_count The number of indices.
+ * @param vertex_count The number of vertices.
+ * @return The number of referenced vertices.
+ */
+PIECE_CORE_API size_t OptimizeVertexFetchRemap(uint32_t *remap, const uint32_t *indices, size_t index_count,
+                                               size_t vertex_count);
+
+/**
+ * @brief Reorders the vertices of a mesh for fetch locality and drops unreferenced vertices.
+ * @param mesh The mesh to reorder in place.
+ */
+PIECE_CORE_API void OptimizeVertexFetch(MeshData &mesh);
+
+/**
+ * @brief Converts a 32-bit float to an IEEE 754 half-precision float, rounding to nearest even.
+ * @param value The value to convert.
+ * @return The half-precision bit pattern.
+ */
+PIECE_CORE_API uint16_t FloatToHalf(float value);
+
+/**
+ * @brief Converts an IEEE 754 half-precision float to a 32-bit float.
+ * @param value The half-precision bit pattern.
+ * @return The converted value.
+ */
+PIECE_CORE_API float HalfToFloat(uint16_t value);
+
+/**
+ * @brief Encodes a unit vector with the octahedral mapping into two signed normalized 16-bit values.
+ * @param normal The unit vector to encode.
+ * @param out The two encoded components.
+ */
+PIECE_CORE_API void EncodeOctahedral(const glm::vec3 &normal, int16_t out[2]);
+
+/**
+ * @brief Decodes an octahedral-encoded unit vector.
+ * @param in The two encoded components.
+ * @return The decoded unit vector.
+ */
+PIECE_CORE_API glm::vec3 DecodeOctahedral(const int16_t in[2]);
+
+/**
+ * @brief Runs the full import-time pipeline: LOD generation, vertex cache, overdraw, vertex fetch and quantization.
+ * @param mesh The source mesh. Must contain at least one triangle.
+ * @param options The pipeline options.
+ * @return The optimized, interleaved mesh ready for IGraphicsDevice::CreateVertexBuffer/CreateIndexBuffer.
+ */
+PIECE_CORE_API OptimizedMesh OptimizeMesh(const MeshData &mesh, const MeshOptimizerOptions &options = {});
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_RESOURCES_MESH_OPTIMIZER_H_
@@ -0,0 +1,334 @@
+/**
+ * @file resource_manager.cpp
+ * @brief Implements the asynchronous ResourceManager.
+ */
+#include "resource_manager.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace Piece
+{
+namespace Core
+{
+
+ResourceManager::ResourceManager(JobSystem &job_system, RAL::IGraphicsDevice &graphics_device)
+    : job_system_(job_system), graphics_device_(graphics_device), io_thread_(&ResourceManager::IoLoop, this)
+{
+}
+
+ResourceManager::~ResourceManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        io_queue_.clear();
+    }
+    io_available_.notify_all();
+    io_thread_.join();
+    job_system_.Wait(decode_jobs_);
+
+    meshes_.ForEach([this](MeshHandle, MeshEntry &entry) {
+        if (entry.state == ResourceState::Ready)
+        {
+            graphics_device_.DestroyVertexBuffer(entry.info.vertex_buffer);
+            graphics_device_.DestroyIndexBuffer(entry.info.index_buffer);
+        }
+    });
+}
+
+bool ResourceManager::MountPack(const std::string &path)
+{
+    auto pack = std::make_unique<AssetPack>();
+    if (!pack->Open(path))
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    packs_.push_back(std::move(pack));
+    spdlog::info("ResourceManager: Mounted '{}'.", path);
+    return true;
+}
+
+MeshHandle ResourceManager::LoadMesh(const std::string &path)
+{
+    uint64_t name_hash = HashAssetName(path);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = mesh_lookup_.find(name_hash);
+    if (it != mesh_lookup_.end())
+    {
+        ++meshes_.Get(it->second).ref_count;
+        return it->second;
+    }
+
+    MeshHandle handle = meshes_.Create();
+    MeshEntry &entry = meshes_.Get(handle);
+    entry.path = path;
+    entry.name_hash = name_hash;
+    entry.ref_count = 1;
+    mesh_lookup_.emplace(name_hash, handle);
+
+    io_queue_.push_back({handle, path, name_hash});
+    io_available_.notify_one();
+    return handle;
+}
+
+void ResourceManager::AddRef(MeshHandle handle)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (MeshEntry *entry = meshes_.TryGet(handle))
+    {
+        ++entry->ref_count;
+    }
+}
+
+void ResourceManager::Release(MeshHandle handle)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    MeshEntry *entry = meshes_.TryGet(handle);
+    if (!entry || entry->ref_count == 0)
+    {
+        spdlog::warn("ResourceManager: Release called on a stale or unreferenced mesh handle.");
+        return;
+    }
+    if (--entry->ref_count == 0)
+    {
+        entry->release_frame = frame_;
+        release_list_.push_back(handle);
+    }
+}
+
+ResourceState ResourceManager::GetState(MeshHandle handle) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const MeshEntry *entry = meshes_.TryGet(handle);
+    return entry ? entry->state : ResourceState::Failed;
+}
+
+bool ResourceManager::GetMesh(MeshHandle handle, MeshResourceInfo &info) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const MeshEntry *entry = meshes_.TryGet(handle);
+    if (!entry || entry->state != ResourceState::Ready)
+    {
+        return false;
+    }
+    info = entry->info;
+    return true;
+}
+
+void ResourceManager::Update()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++frame_;
+
+    size_t uploaded = 0;
+    while (!upload_queue_.empty() && (uploaded == 0 || uploaded < upload_budget_))
+    {
+        MeshHandle handle = upload_queue_.front();
+        upload_queue_.pop_front();
+        MeshEntry *entry = meshes_.TryGet(handle);
+        if (!entry || entry->state != ResourceState::Decoded)
+        {
+            continue;
+        }
+
+        // Slots are only destroyed on this thread, so the handle stays live while the lock is released for the
+        // upload. The entry pointer does not: LoadMesh may grow the pool.
+        std::vector<uint8_t> blob = std::move(entry->blob);
+        MeshAssetView view = entry->view;
+        entry->view = {};
+        lock.unlock();
+
+        MeshResourceInfo info;
+        CreateMeshBuffers(graphics_device_, view, info.vertex_buffer, info.index_buffer);
+        info.index_count = view.header->index_count;
+        info.lod_count = view.header->lod_count;
+        std::copy(view.header->lods, view.header->lods + view.header->lod_count, info.lods);
+        info.bounds_min = glm::vec3(view.header->bounds_min[0], view.header->bounds_min[1], view.header->bounds_min[2]);
+        info.bounds_max = glm::vec3(view.header->bounds_max[0], view.header->bounds_max[1], view.header->bounds_max[2]);
+        uploaded += static_cast<size_t>(view.header->vertex_count) * view.header->layout.stride +
+                    static_cast<size_t>(view.header->index_count) *
+                        RAL::GetIndexFormatSize(static_cast<RAL::IndexFormat>(view.header->index_format));
+        blob.clear();
+
+        lock.lock();
+        entry = &meshes_.Get(handle);
+        entry->info = info;
+        entry->state = ResourceState::Ready;
+    }
+
+    for (size_t i = 0; i < release_list_.size();)
+    {
+        MeshHandle handle = release_list_[i];
+        MeshEntry *entry = meshes_.TryGet(handle);
+        bool revived = !entry || entry->ref_count != 0;
+        bool expired = !revived && frame_ - entry->release_frame >= eviction_delay_;
+        if (expired)
+        {
+            EvictLocked(handle, *entry);
+        }
+        if (revived || expired)
+        {
+            release_list_[i] = release_list_.back();
+            release_list_.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void ResourceManager::SetUploadBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    upload_budget_ = bytes;
+}
+
+void ResourceManager::SetEvictionDelay(uint32_t frames)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    eviction_delay_ = frames;
+}
+
+uint32_t ResourceManager::GetResourceCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return meshes_.GetLiveCount();
+}
+
+void ResourceManager::IoLoop()
+{
+    for (;;)
+    {
+        IoRequest request;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            io_available_.wait(lock, [this] { return stopping_ || !io_queue_.empty(); });
+            if (stopping_)
+            {
+                return;
+            }
+            request = std::move(io_queue_.front());
+            io_queue_.pop_front();
+        }
+        ProcessIoRequest(request);
+    }
+}
+
+void ResourceManager::ProcessIoRequest(const IoRequest &request)
+{
+    const AssetPack *pack = nullptr;
+    const AssetPackEntry *pack_entry = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        MeshEntry *entry = meshes_.TryGet(request.handle);
+        if (!entry)
+        {
+            return; // Evicted before the I/O thread got to it.
+        }
+        entry->state = ResourceState::Loading;
+        for (auto it = packs_.rbegin(); it != packs_.rend() && !pack_entry; ++it)
+        {
+            pack_entry = (*it)->Find(request.name_hash);
+            pack = it->get();
+        }
+    }
+
+    MeshHandle handle = request.handle;
+    if (pack_entry)
+    {
+        if (pack_entry->type != AssetType::Mesh)
+        {
+            FailMesh(handle, "pack entry is not a mesh");
+            return;
+        }
+        if (const void *mapped = pack->GetData(*pack_entry))
+        {
+            size_t size = static_cast<size_t>(pack_entry->size);
+            job_system_.Submit([this, handle, mapped, size] { FinishDecode(handle, {}, mapped, size); }, &decode_jobs_);
+        }
+        else
+        {
+            job_system_.Submit(
+                [this, handle, pack, pack_entry] {
+                    std::vector<uint8_t> blob(static_cast<size_t>(pack_entry->size));
+                    if (!pack->Read(*pack_entry, blob.data(), blob.size()))
+                    {
+                        FailMesh(handle, "pack entry is corrupt");
+                        return;
+                    }
+                    FinishDecode(handle, std::move(blob), nullptr, 0);
+                },
+                &decode_jobs_);
+        }
+        return;
+    }
+
+    std::ifstream file(request.path, std::ios::binary);
+    if (!file)
+    {
+        FailMesh(handle, "asset not found");
+        return;
+    }
+    std::vector<uint8_t> blob((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    job_system_.Submit(
+        [this, handle, blob = std::move(blob)]() mutable { FinishDecode(handle, std::move(blob), nullptr, 0); },
+        &decode_jobs_);
+}
+
+void ResourceManager::FinishDecode(MeshHandle handle, std::vector<uint8_t> blob, const void *mapped_data,
+                                   size_t mapped_size)
+{
+    const void *data = mapped_data ? mapped_data : blob.data();
+    size_t size = mapped_data ? mapped_size : blob.size();
+    MeshAssetView view;
+    if (!ParseMeshAsset(data, size, view))
+    {
+        FailMesh(handle, "invalid mesh data");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    MeshEntry *entry = meshes_.TryGet(handle);
+    if (!entry)
+    {
+        return;
+    }
+    // Moving the vector keeps its buffer, so the view stays valid.
+    entry->blob = std::move(blob);
+    entry->view = view;
+    entry->state = ResourceState::Decoded;
+    upload_queue_.push_back(handle);
+}
+
+void ResourceManager::FailMesh(MeshHandle handle, const char *reason)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    MeshEntry *entry = meshes_.TryGet(handle);
+    if (!entry)
+    {
+        return;
+    }
+    spdlog::warn("ResourceManager: Failed to load mesh '{}': {}.", entry->path, reason);
+    entry->state = ResourceState::Failed;
+}
+
+void ResourceManager::EvictLocked(MeshHandle handle, MeshEntry &entry)
+{
+    if (entry.state == ResourceState::Ready)
+    {
+        graphics_device_.DestroyVertexBuffer(entry.info.vertex_buffer);
+        graphics_device_.DestroyIndexBuffer(entry.info.index_buffer);
+    }
+    mesh_lookup_.erase(entry.name_hash);
+    meshes_.Destroy(handle);
+}
+
+} // namespace Core
+} // namespace Piece
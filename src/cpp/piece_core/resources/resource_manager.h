@@ -0,0 +1,279 @@
+/**
+ * @file resource_manager.h
+ * @brief Defines the ResourceManager class, which streams cooked assets asynchronously and tracks their lifetime by
+ *        reference count.
+ */
+#ifndef PIECE_CORE_RESOURCES_RESOURCE_MANAGER_H_
+#define PIECE_CORE_RESOURCES_RESOURCE_MANAGER_H_
+
+#include <ral/igraphics_device.h>
+#include <ral/resource_handle.h>
+#include <ral/resource_pool.h>
+
+#include <glm/glm.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "asset_pack.h"
+#include "job_system.h"
+#include "mesh_asset.h"
+#include "piece_core_exports.h"
+
+namespace Piece
+{
+namespace Core
+{
+
+/** @brief Tag type for MeshHandle. */
+struct MeshResourceTag;
+/** @brief Handle to a mesh owned by the ResourceManager. */
+using MeshHandle = RAL::ResourceHandle<MeshResourceTag>;
+
+/**
+ * @brief The loading state of a managed resource.
+ */
+enum class ResourceState : uint8_t
+{
+    Queued = 0,  /**< Waiting for the I/O thread. */
+    Loading = 1, /**< Being read or decoded. */
+    Decoded = 2, /**< Decoded and waiting for its GPU upload. */
+    Ready = 3,   /**< Uploaded and usable for rendering. */
+    Failed = 4   /**< Could not be found, read or decoded. */
+};
+
+/**
+ * @brief The render-side view of a loaded mesh.
+ */
+struct MeshResourceInfo
+{
+    /** @brief The vertex buffer. */
+    RAL::VertexBufferHandle vertex_buffer;
+    /** @brief The index buffer. */
+    RAL::IndexBufferHandle index_buffer;
+    /** @brief The number of indices of all levels of detail together. */
+    uint32_t index_count = 0;
+    /** @brief The number of valid entries in lods. */
+    uint32_t lod_count = 0;
+    /** @brief The levels of detail, finest first, as ranges of index_buffer. Select one with SelectLod. */
+    MeshLod lods[kMaxMeshLods] = {};
+    /** @brief Minimum corner of the object-space bounding box. */
+    glm::vec3 bounds_min = glm::vec3(0.0f);
+    /** @brief Maximum corner of the object-space bounding box. */
+    glm::vec3 bounds_max = glm::vec3(0.0f);
+};
+
+/**
+ * @brief Loads cooked assets from mounted packs or loose files without blocking the caller.
+ * @details Load requests return a handle at once. A dedicated I/O thread reads loose files, JobSystem workers
+ *          decompress and validate the data, and Update, called once per frame on the thread that owns the graphics
+ *          device, uploads decoded assets within a per-frame byte budget. Requests for an asset that is already
+ *          known return the existing handle. When the last reference is released the asset is kept for a few frames,
+ *          so it can be revived cheaply and in-flight frames can finish with it, then evicted.
+ */
+class PIECE_CORE_API ResourceManager
+{
+  public:
+    /** @brief The default per-frame upload budget in bytes. */
+    static constexpr size_t kDefaultUploadBudget = 4 * 1024 * 1024;
+    /** @brief The default number of frames an unreferenced asset is kept before eviction. */
+    static constexpr uint32_t kDefaultEvictionDelay = 3;
+
+    /**
+     * @brief Constructs the manager and starts its I/O thread.
+     * @param job_system The job system running decode jobs. Must outlive the manager.
+     * @param graphics_device The device receiving uploads. Must outlive the manager.
+     */
+    ResourceManager(JobSystem &job_system, RAL::IGraphicsDevice &graphics_device);
+
+    /**
+     * @brief Stops the I/O thread, waits for in-flight decode jobs and destroys every GPU resource still owned.
+     */
+    ~ResourceManager();
+
+    ResourceManager(const ResourceManager &) = delete;
+    ResourceManager &operator=(const ResourceManager &) = delete;
+
+    /**
+     * @brief Maps a pack file and makes its entries loadable. Packs mounted later take precedence.
+     * @param path The pack file path.
+     * @return True on success, false otherwise.
+     */
+    bool MountPack(const std::string &path);
+
+    /**
+     * @brief Requests a cooked mesh and takes a reference to it.
+     * @param path The asset path, looked up in the mounted packs first and on disk otherwise.
+     * @return The mesh handle, valid immediately. Check GetState before using it.
+     */
+    MeshHandle LoadMesh(const std::string &path);
+
+    /**
+     * @brief Takes an additional reference to a mesh.
+     * @param handle The mesh handle.
+     */
+    void AddRef(MeshHandle handle);
+
+    /**
+     * @brief Releases a reference to a mesh. The mesh is evicted some frames after its last reference is released.
+     * @param handle The mesh handle.
+     */
+    void Release(MeshHandle handle);
+
+    /**
+     * @brief Gets the loading state of a mesh.
+     * @param handle The mesh handle.
+     * @return The state, or ResourceState::Failed if the handle is stale.
+     */
+    ResourceState GetState(MeshHandle handle) const;
+
+    /**
+     * @brief Gets the GPU buffers of a ready mesh.
+     * @param handle The mesh handle.
+     * @param info Receives the mesh buffers and bounds.
+     * @return True if the mesh is ready, false otherwise.
+     */
+    bool GetMesh(MeshHandle handle, MeshResourceInfo &info) const;
+
+    /**
+     * @brief Uploads decoded assets within the upload budget and evicts expired assets.
+     * @details Must be called once per frame on the thread that owns the graphics device. At least one pending upload
+     *          is processed per call so assets larger than the budget still make progress.
+     */
+    void Update();
+
+    /**
+     * @brief Sets the number of bytes uploaded per Update.
+     * @param bytes The budget.
+     */
+    void SetUploadBudget(size_t bytes);
+
+    /**
+     * @brief Sets the number of Update calls an unreferenced asset survives before eviction.
+     * @param frames The delay in frames.
+     */
+    void SetEvictionDelay(uint32_t frames);
+
+    /**
+     * @brief Gets the number of assets currently known to the manager, in any state.
+     * @return The asset count.
+     */
+    uint32_t GetResourceCount() const;
+
+  private:
+    /**
+     * @brief A managed mesh.
+     */
+    struct MeshEntry
+    {
+        /** @brief The asset path. */
+        std::string path;
+        /** @brief HashAssetName of the path. */
+        uint64_t name_hash = 0;
+        /** @brief The loading state. */
+        ResourceState state = ResourceState::Queued;
+        /** @brief The number of outstanding references. */
+        uint32_t ref_count = 0;
+        /** @brief The frame the last reference was released in. */
+        uint64_t release_frame = 0;
+        /** @brief Owned blob bytes for assets that were read or decompressed. Empty for zero-copy pack entries. */
+        std::vector<uint8_t> blob;
+        /** @brief The parsed blob, pointing into blob or into a pack mapping, until the upload. */
+        MeshAssetView view;
+        /** @brief The uploaded mesh. */
+        MeshResourceInfo info;
+    };
+
+    /**
+     * @brief A read request for the I/O thread.
+     */
+    struct IoRequest
+    {
+        /** @brief The requesting mesh. */
+        MeshHandle handle;
+        /** @brief The asset path. */
+        std::string path;
+        /** @brief HashAssetName of the path. */
+        uint64_t name_hash;
+    };
+
+    /**
+     * @brief The loop run by the I/O thread.
+     */
+    void IoLoop();
+
+    /**
+     * @brief Resolves a request against the packs or the file system and schedules its decode job.
+     * @param request The request to serve.
+     */
+    void ProcessIoRequest(const IoRequest &request);
+
+    /**
+     * @brief Validates a blob on a worker and hands it to the upload queue.
+     * @param handle The requesting mesh.
+     * @param blob Owned blob bytes, or empty when mapped_data is used.
+     * @param mapped_data Zero-copy blob bytes inside a pack mapping, or nullptr.
+     * @param mapped_size The size of mapped_data.
+     */
+    void FinishDecode(MeshHandle handle, std::vector<uint8_t> blob, const void *mapped_data, size_t mapped_size);
+
+    /**
+     * @brief Marks a mesh as failed.
+     * @param handle The mesh.
+     * @param reason A short description for the log.
+     */
+    void FailMesh(MeshHandle handle, const char *reason);
+
+    /**
+     * @brief Destroys the GPU buffers and the slot of a mesh. Caller holds mutex_.
+     * @param handle The mesh.
+     * @param entry The mesh entry.
+     */
+    void EvictLocked(MeshHandle handle, MeshEntry &entry);
+
+    /** @brief The job system running decode jobs. */
+    JobSystem &job_system_;
+    /** @brief The device receiving uploads. */
+    RAL::IGraphicsDevice &graphics_device_;
+    /** @brief Mounted packs in mount order, held by pointer so entries stay valid while the vector grows. */
+    std::vector<std::unique_ptr<AssetPack>> packs_;
+    /** @brief Managed meshes. */
+    RAL::ResourcePool<MeshEntry, MeshHandle> meshes_;
+    /** @brief Deduplication map from HashAssetName to handle. */
+    std::unordered_map<uint64_t, MeshHandle> mesh_lookup_;
+    /** @brief Decoded meshes waiting for upload, in completion order. */
+    std::deque<MeshHandle> upload_queue_;
+    /** @brief Meshes whose last reference was released, checked for eviction by Update. */
+    std::vector<MeshHandle> release_list_;
+    /** @brief Requests waiting for the I/O thread. */
+    std::deque<IoRequest> io_queue_;
+    /** @brief Tracks in-flight decode jobs. */
+    JobCounter decode_jobs_;
+    /** @brief Guards every member above except the references and decode_jobs_. */
+    mutable std::mutex mutex_;
+    /** @brief Signaled when a request is queued or the manager stops. */
+    std::condition_variable io_available_;
+    /** @brief Set when the manager is being destroyed. */
+    bool stopping_ = false;
+    /** @brief The per-frame upload budget in bytes. */
+    size_t upload_budget_ = kDefaultUploadBudget;
+    /** @brief The number of frames an unreferenced asset survives. */
+    uint32_t eviction_delay_ = kDefaultEvictionDelay;
+    /** @brief The number of Update calls so far. */
+    uint64_t frame_ = 0;
+    /** @brief The I/O thread. Declared last so it starts after every other member is initialized. */
+    std::thread io_thread_;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_CORE_RESOURCES_RESOURCE_MANAGER_H_
@@ -5,9 +5,9 @@
 #ifndef PIECE_RAL_IGRAPHICS_DEVICE_H_
 #define PIECE_RAL_IGRAPHICS_DEVICE_H_
 
-#include <memory>
-
 #include "irender_context.h"
+#include "ral_types.h"
+#include "resource_handle.h"
 
 namespace Piece
 {
@@ -18,11 +18,13 @@ class IVertexBuffer;
 class IIndexBuffer;
 class IShader;
 class IShaderProgram;
+class IRenderTarget;
 
 /**
  * @brief Interface for the graphics device.
  * @details This class provides a pure virtual interface for interacting with the graphics hardware,
- *          including frame management and creation of rendering resources.
+ *          including frame management and creation of rendering resources. Resources are owned by the device,
+ *          stored in contiguous per-type pools and referenced through generational handles.
  */
 class IGraphicsDevice
 {
@@ -52,25 +54,103 @@ class IGraphicsDevice
     virtual IRenderContext *GetImmediateContext() = 0;
 
     /**
-     * @brief Creates a new vertex buffer.
-     * @return A unique pointer to the created IVertexBuffer.
+     * @brief Creates a new vertex buffer and uploads its contents.
+     * @param data Pointer to vertex_count interleaved vertices matching the layout. May be null to allocate only.
+     * @param vertex_count The number of vertices.
+     * @param layout The layout of one vertex.
+     * @return A handle to the created vertex buffer.
+     */
+    virtual VertexBufferHandle CreateVertexBuffer(const void *data, uint32_t vertex_count,
+                                                  const VertexLayout &layout) = 0;
+    /**
+     * @brief Destroys a vertex buffer and invalidates its handle.
+     * @param handle The handle of the vertex buffer to destroy.
+     */
+    virtual void DestroyVertexBuffer(VertexBufferHandle handle) = 0;
+    /**
+     * @brief Resolves a vertex buffer handle.
+     * @param handle The handle to resolve.
+     * @return A pointer to the IVertexBuffer, or nullptr if the handle is stale or invalid.
+     */
+    virtual IVertexBuffer *GetVertexBuffer(VertexBufferHandle handle) = 0;
+
+    /**
+     * @brief Creates a new index buffer and uploads its contents.
+     * @param data Pointer to index_count indices of the given format. May be null to allocate only.
+     * @param index_count The number of indices.
+     * @param format The element type of the indices.
+     * @return A handle to the created index buffer.
      */
-    virtual std::unique_ptr<IVertexBuffer> CreateVertexBuffer() = 0;
+    virtual IndexBufferHandle CreateIndexBuffer(const void *data, uint32_t index_count, IndexFormat format) = 0;
     /**
-     * @brief Creates a new index buffer.
-     * @return A unique pointer to the created IIndexBuffer.
+     * @brief Destroys an index buffer and invalidates its handle.
+     * @param handle The handle of the index buffer to destroy.
      */
-    virtual std::unique_ptr<IIndexBuffer> CreateIndexBuffer() = 0;
+    virtual void DestroyIndexBuffer(IndexBufferHandle handle) = 0;
+    /**
+     * @brief Resolves an index buffer handle.
+     * @param handle The handle to resolve.
+     * @return A pointer to the IIndexBuffer, or nullptr if the handle is stale or invalid.
+     */
+    virtual IIndexBuffer *GetIndexBuffer(IndexBufferHandle handle) = 0;
+
     /**
      * @brief Creates a new shader.
-     * @return A unique pointer to the created IShader.
+     * @return A handle to the created shader.
      */
-    virtual std::unique_ptr<IShader> CreateShader() = 0;
+    virtual ShaderHandle CreateShader() = 0;
+    /**
+     * @brief Destroys a shader and invalidates its handle.
+     * @param handle The handle of the shader to destroy.
+     */
+    virtual void DestroyShader(ShaderHandle handle) = 0;
+    /**
+     * @brief Resolves a shader handle.
+     * @param handle The handle to resolve.
+     * @return A pointer to the IShader, or nullptr if the handle is stale or invalid.
+     */
+    virtual IShader *GetShader(ShaderHandle handle) = 0;
+
     /**
      * @brief Creates a new shader program.
-     * @return A unique pointer to the created IShaderProgram.
+     * @return A handle to the created shader program.
+     */
+    virtual ShaderProgramHandle CreateShaderProgram() = 0;
+    /**
+     * @brief Destroys a shader program and invalidates its handle.
+     * @param handle The handle of the shader program to destroy.
+     */
+    virtual void DestroyShaderProgram(ShaderProgramHandle handle) = 0;
+    /**
+     * @brief Resolves a shader program handle.
+     * @param handle The handle to resolve.
+     * @return A pointer to the IShaderProgram, or nullptr if the handle is stale or invalid.
+     */
+    virtual IShaderProgram *GetShaderProgram(ShaderProgramHandle handle) = 0;
+
+    /**
+     * @brief Creates an offscreen render target.
+     * @param desc The size and formats of the target.
+     * @return A handle to the created render target.
+     */
+    virtual RenderTargetHandle CreateRenderTarget(const RenderTargetDesc &desc) = 0;
+    /**
+     * @brief Destroys a render target and invalidates its handle.
+     * @param handle The handle of the render target to destroy.
+     */
+    virtual void DestroyRenderTarget(RenderTargetHandle handle) = 0;
+    /**
+     * @brief Resolves a render target handle.
+     * @param handle The handle to resolve.
+     * @return A pointer to the IRenderTarget, or nullptr if the handle is stale or invalid.
+     */
+    virtual IRenderTarget *GetRenderTarget(RenderTargetHandle handle) = 0;
+    /**
+     * @brief Directs the following drawing to a render target.
+     * @param handle A live render target, or the null handle for the framebuffer of the window current on the
+     *        calling thread. Resolve a handle that may be stale with GetRenderTarget first.
      */
-    virtual std::unique_ptr<IShaderProgram> CreateShaderProgram() = 0;
+    virtual void SetRenderTarget(RenderTargetHandle handle) = 0;
 };
 
 } // namespace RAL
@@ -7,6 +7,8 @@
 
 #include <cstdint>
 
+#include "ral_types.h"
+
 namespace Piece
 {
 namespace RAL
@@ -37,6 +39,11 @@ class IIndexBuffer
      * @return The number of indices.
      */
     virtual uint32_t GetCount() const = 0;
+    /**
+     * @brief Gets the element type of the indices stored in the buffer.
+     * @return The index format.
+     */
+    virtual IndexFormat GetFormat() const = 0;
 };
 
 } // namespace RAL
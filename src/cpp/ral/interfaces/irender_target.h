@@ -0,0 +1,51 @@
+/**
+ * @file irender_target.h
+ * @brief Defines the IRenderTarget interface, which provides an abstraction for an offscreen render target.
+ */
+#ifndef PIECE_RAL_INTERFACES_IRENDER_TARGET_H_
+#define PIECE_RAL_INTERFACES_IRENDER_TARGET_H_
+
+#include <cstdint>
+
+#include "ral_types.h"
+
+namespace Piece
+{
+namespace RAL
+{
+
+/**
+ * @brief Interface for an offscreen render target.
+ * @details A render target is drawn to like a window's framebuffer, and its color attachment can then be sampled,
+ *          for example to show an editor viewport inside a UI panel. It belongs to the same device as every other
+ *          resource, so all targets and windows share the device's buffers and shaders.
+ */
+class IRenderTarget
+{
+  public:
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~IRenderTarget() = default;
+    /**
+     * @brief Gets the description the target was created or last resized with.
+     * @return The description.
+     */
+    virtual const RenderTargetDesc &GetDesc() const = 0;
+    /**
+     * @brief Reallocates the attachments at a new size. Their contents are lost.
+     * @param width The new width in pixels.
+     * @param height The new height in pixels.
+     */
+    virtual void Resize(uint32_t width, uint32_t height) = 0;
+    /**
+     * @brief Gets the renderer ID of the color attachment, to sample the rendered image.
+     * @return The renderer ID.
+     */
+    virtual uint32_t GetColorRendererID() const = 0;
+};
+
+} // namespace RAL
+} // namespace Piece
+
+#endif // PIECE_RAL_INTERFACES_IRENDER_TARGET_H_
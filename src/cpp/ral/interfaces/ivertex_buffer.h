@@ -7,6 +7,8 @@
 
 #include <cstdint>
 
+#include "ral_types.h"
+
 namespace Piece
 {
 namespace RAL
@@ -37,6 +39,11 @@ class IVertexBuffer
      * @return The number of vertices.
      */
     virtual uint32_t GetCount() const = 0;
+    /**
+     * @brief Gets the layout of the vertices stored in the buffer.
+     * @return The vertex layout.
+     */
+    virtual const VertexLayout &GetLayout() const = 0;
 };
 
 } // namespace RAL
@@ -1,8 +1,4 @@
 #include "opengl_graphics_device.h"
-#include <ral/interfaces/ivertex_buffer.h>
-#include <ral/interfaces/iindex_buffer.h>
-#include <ral/interfaces/ishader.h>
-#include <ral/interfaces/ishader_program.h>
 
 namespace Piece {
     namespace RAL {
@@ -26,24 +22,78 @@ namespace Piece {
             return nullptr;
         }
 
-        std::unique_ptr<IVertexBuffer> OpenGLGraphicsDevice::CreateVertexBuffer() {
-            // Stub
-            return nullptr;
+        VertexBufferHandle OpenGLGraphicsDevice::CreateVertexBuffer(const void *data, uint32_t vertex_count,
+                                                                     const VertexLayout &layout) {
+            return vertex_buffers_.Create(data, vertex_count, layout);
         }
 
-        std::unique_ptr<IIndexBuffer> OpenGLGraphicsDevice::CreateIndexBuffer() {
-            // Stub
-            return nullptr;
+        void OpenGLGraphicsDevice::DestroyVertexBuffer(VertexBufferHandle handle) {
+            vertex_buffers_.Destroy(handle);
         }
 
-        std::unique_ptr<IShader> OpenGLGraphicsDevice::CreateShader() {
-            // Stub
-            return nullptr;
+        IVertexBuffer *OpenGLGraphicsDevice::GetVertexBuffer(VertexBufferHandle handle) {
+            return vertex_buffers_.TryGet(handle);
         }
 
-        std::unique_ptr<IShaderProgram> OpenGLGraphicsDevice::CreateShaderProgram() {
-            // Stub
-            return nullptr;
+        IndexBufferHandle OpenGLGraphicsDevice::CreateIndexBuffer(const void *data, uint32_t index_count,
+                                                                   IndexFormat format) {
+            return index_buffers_.Create(data, index_count, format);
+        }
+
+        void OpenGLGraphicsDevice::DestroyIndexBuffer(IndexBufferHandle handle) {
+            index_buffers_.Destroy(handle);
+        }
+
+        IIndexBuffer *OpenGLGraphicsDevice::GetIndexBuffer(IndexBufferHandle handle) {
+            return index_buffers_.TryGet(handle);
+        }
+
+        ShaderHandle OpenGLGraphicsDevice::CreateShader() {
+            return shaders_.Create();
+        }
+
+        void OpenGLGraphicsDevice::DestroyShader(ShaderHandle handle) {
+            shaders_.Destroy(handle);
+        }
+
+        IShader *OpenGLGraphicsDevice::GetShader(ShaderHandle handle) {
+            return shaders_.TryGet(handle);
+        }
+
+        ShaderProgramHandle OpenGLGraphicsDevice::CreateShaderProgram() {
+            return shader_programs_.Create();
+        }
+
+        void OpenGLGraphicsDevice::DestroyShaderProgram(ShaderProgramHandle handle) {
+            shader_programs_.Destroy(handle);
+        }
+
+        IShaderProgram *OpenGLGraphicsDevice::GetShaderProgram(ShaderProgramHandle handle) {
+            return shader_programs_.TryGet(handle);
+        }
+
+        RenderTargetHandle OpenGLGraphicsDevice::CreateRenderTarget(const RenderTargetDesc &desc) {
+            return render_targets_.Create(desc);
+        }
+
+        void OpenGLGraphicsDevice::DestroyRenderTarget(RenderTargetHandle handle) {
+            if (handle == current_render_target_) {
+                current_render_target_ = {};
+            }
+            render_targets_.Destroy(handle);
+        }
+
+        IRenderTarget *OpenGLGraphicsDevice::GetRenderTarget(RenderTargetHandle handle) {
+            return render_targets_.TryGet(handle);
+        }
+
+        void OpenGLGraphicsDevice::SetRenderTarget(RenderTargetHandle handle) {
+            // Futuramente: glBindFramebuffer(GL_FRAMEBUFFER, target ? target->GetRendererID() : 0)
+            // Binding a stale target is a use-after-free in the caller; Get asserts on it in debug builds.
+            if (!handle.IsNull()) {
+                render_targets_.Get(handle);
+            }
+            current_render_target_ = handle;
         }
     }
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <ral/igraphics_device.h>
+#include <ral/resource_pool.h>
+
+#include "opengl_resources.h"
 
 namespace Piece {
     namespace RAL {
@@ -14,10 +17,36 @@ namespace Piece {
             void BeginFrame() override;
             void EndFrame() override;
             IRenderContext *GetImmediateContext() override;
-            std::unique_ptr<IVertexBuffer> CreateVertexBuffer() override;
-            std::unique_ptr<IIndexBuffer> CreateIndexBuffer() override;
-            std::unique_ptr<IShader> CreateShader() override;
-            std::unique_ptr<IShaderProgram> CreateShaderProgram() override;
+
+            VertexBufferHandle CreateVertexBuffer(const void *data, uint32_t vertex_count, const VertexLayout &layout) override;
+            void DestroyVertexBuffer(VertexBufferHandle handle) override;
+            IVertexBuffer *GetVertexBuffer(VertexBufferHandle handle) override;
+
+            IndexBufferHandle CreateIndexBuffer(const void *data, uint32_t index_count, IndexFormat format) override;
+            void DestroyIndexBuffer(IndexBufferHandle handle) override;
+            IIndexBuffer *GetIndexBuffer(IndexBufferHandle handle) override;
+
+            ShaderHandle CreateShader() override;
+            void DestroyShader(ShaderHandle handle) override;
+            IShader *GetShader(ShaderHandle handle) override;
+
+            ShaderProgramHandle CreateShaderProgram() override;
+            void DestroyShaderProgram(ShaderProgramHandle handle) override;
+            IShaderProgram *GetShaderProgram(ShaderProgramHandle handle) override;
+
+            RenderTargetHandle CreateRenderTarget(const RenderTargetDesc &desc) override;
+            void DestroyRenderTarget(RenderTargetHandle handle) override;
+            IRenderTarget *GetRenderTarget(RenderTargetHandle handle) override;
+            void SetRenderTarget(RenderTargetHandle handle) override;
+
+        private:
+            ResourcePool<OpenGLVertexBuffer, VertexBufferHandle> vertex_buffers_;
+            ResourcePool<OpenGLIndexBuffer, IndexBufferHandle> index_buffers_;
+            ResourcePool<OpenGLShader, ShaderHandle> shaders_;
+            ResourcePool<OpenGLShaderProgram, ShaderProgramHandle> shader_programs_;
+            ResourcePool<OpenGLRenderTarget, RenderTargetHandle> render_targets_;
+            // Target of the following drawing; null for the current window's framebuffer.
+            RenderTargetHandle current_render_target_;
         };
     }
 }
@@ -0,0 +1,76 @@
+#include "opengl_resources.h"
+
+namespace Piece {
+    namespace RAL {
+        OpenGLVertexBuffer::OpenGLVertexBuffer(const void *data, uint32_t count, const VertexLayout &layout)
+            : count_(count), layout_(layout) {
+            // Futuramente: glGenBuffers + glBufferData(GL_ARRAY_BUFFER, count * layout.stride, data, ...)
+        }
+
+        void OpenGLVertexBuffer::Bind() const {
+            // Stub
+        }
+
+        void OpenGLVertexBuffer::Unbind() const {
+            // Stub
+        }
+
+        OpenGLIndexBuffer::OpenGLIndexBuffer(const void *data, uint32_t count, IndexFormat format)
+            : count_(count), format_(format) {
+            // Futuramente: glGenBuffers + glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * GetIndexFormatSize(format), data, ...)
+        }
+
+        void OpenGLIndexBuffer::Bind() const {
+            // Stub
+        }
+
+        void OpenGLIndexBuffer::Unbind() const {
+            // Stub
+        }
+
+        bool OpenGLShader::Compile(const std::string &source, ShaderType type) {
+            // Stub
+            type_ = type;
+            return false;
+        }
+
+        bool OpenGLShaderProgram::Link(IShader *vertexShader, IShader *fragmentShader) {
+            // Stub
+            return false;
+        }
+
+        void OpenGLShaderProgram::Bind() const {
+            // Stub
+        }
+
+        void OpenGLShaderProgram::Unbind() const {
+            // Stub
+        }
+
+        void OpenGLShaderProgram::SetUniform1i(const std::string &name, int value) {
+            // Stub
+        }
+
+        void OpenGLShaderProgram::SetUniform1f(const std::string &name, float value) {
+            // Stub
+        }
+
+        void OpenGLShaderProgram::SetUniformMat4f(const std::string &name, const glm::mat4 &matrix) {
+            // Stub
+        }
+
+        void OpenGLShaderProgram::SetUniformVec3f(const std::string &name, const glm::vec3 &vector) {
+            // Stub
+        }
+
+        OpenGLRenderTarget::OpenGLRenderTarget(const RenderTargetDesc &desc) : desc_(desc) {
+            // Futuramente: glGenFramebuffers + color texture (GL_RGBA8 / GL_RGBA16F) + GL_DEPTH24_STENCIL8 renderbuffer
+        }
+
+        void OpenGLRenderTarget::Resize(uint32_t width, uint32_t height) {
+            // Futuramente: glTexImage2D / glRenderbufferStorage at the new size
+            desc_.width = width;
+            desc_.height = height;
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <ral/interfaces/iindex_buffer.h>
+#include <ral/interfaces/irender_target.h>
+#include <ral/interfaces/ishader.h>
+#include <ral/interfaces/ishader_program.h>
+#include <ral/interfaces/ivertex_buffer.h>
+
+namespace Piece {
+    namespace RAL {
+        // Concrete OpenGL resources. They are stored by value in the device's resource pools,
+        // so they must stay default constructible and cheap to move.
+
+        class OpenGLVertexBuffer : public IVertexBuffer {
+        public:
+            OpenGLVertexBuffer() = default;
+            OpenGLVertexBuffer(const void *data, uint32_t count, const VertexLayout &layout);
+
+            // IVertexBuffer interface
+            void Bind() const override;
+            void Unbind() const override;
+            uint32_t GetCount() const override { return count_; }
+            const VertexLayout &GetLayout() const override { return layout_; }
+
+            uint32_t GetRendererID() const { return renderer_id_; }
+
+        private:
+            uint32_t renderer_id_ = 0;
+            uint32_t count_ = 0;
+            VertexLayout layout_ = {};
+        };
+
+        class OpenGLIndexBuffer : public IIndexBuffer {
+        public:
+            OpenGLIndexBuffer() = default;
+            OpenGLIndexBuffer(const void *data, uint32_t count, IndexFormat format);
+
+            // IIndexBuffer interface
+            void Bind() const override;
+            void Unbind() const override;
+            uint32_t GetCount() const override { return count_; }
+            IndexFormat GetFormat() const override { return format_; }
+
+            uint32_t GetRendererID() const { return renderer_id_; }
+
+        private:
+            uint32_t renderer_id_ = 0;
+            uint32_t count_ = 0;
+            IndexFormat format_ = IndexFormat::UInt32;
+        };
+
+        class OpenGLShader : public IShader {
+        public:
+            OpenGLShader() = default;
+
+            // IShader interface
+            bool Compile(const std::string &source, ShaderType type) override;
+            uint32_t GetRendererID() const override { return renderer_id_; }
+
+        private:
+            uint32_t renderer_id_ = 0;
+            ShaderType type_ = ShaderType::Unknown;
+        };
+
+        class OpenGLShaderProgram : public IShaderProgram {
+        public:
+            OpenGLShaderProgram() = default;
+
+            // IShaderProgram interface
+            bool Link(IShader *vertexShader, IShader *fragmentShader) override;
+            void Bind() const override;
+            void Unbind() const override;
+            uint32_t GetRendererID() const override { return renderer_id_; }
+            void SetUniform1i(const std::string &name, int value) override;
+            void SetUniform1f(const std::string &name, float value) override;
+            void SetUniformMat4f(const std::string &name, const glm::mat4 &matrix) override;
+            void SetUniformVec3f(const std::string &name, const glm::vec3 &vector) override;
+
+        private:
+            uint32_t renderer_id_ = 0;
+        };
+
+        // A framebuffer object with a color texture and an optional depth-stencil renderbuffer.
+        class OpenGLRenderTarget : public IRenderTarget {
+        public:
+            OpenGLRenderTarget() = default;
+            explicit OpenGLRenderTarget(const RenderTargetDesc &desc);
+
+            // IRenderTarget interface
+            const RenderTargetDesc &GetDesc() const override { return desc_; }
+            void Resize(uint32_t width, uint32_t height) override;
+            uint32_t GetColorRendererID() const override { return color_id_; }
+
+            uint32_t GetRendererID() const { return renderer_id_; }
+
+        private:
+            uint32_t renderer_id_ = 0;
+            uint32_t color_id_ = 0;
+            uint32_t depth_id_ = 0;
+            RenderTargetDesc desc_ = {};
+        };
+    }
+}
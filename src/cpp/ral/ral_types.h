@@ -0,0 +1,184 @@
+/**
+ * @file ral_types.h
+ * @brief Defines common RAL enums and structs, such as the vertex layout description and index formats.
+ */
+#ifndef PIECE_RAL_RAL_TYPES_H_
+#define PIECE_RAL_RAL_TYPES_H_
+
+#include <cstdint>
+
+namespace Piece
+{
+namespace RAL
+{
+
+/**
+ * @brief The maximum number of attributes a VertexLayout can describe.
+ */
+constexpr uint32_t kMaxVertexAttributes = 8;
+
+/**
+ * @brief Specifies what a vertex attribute represents.
+ */
+enum class VertexSemantic : uint8_t
+{
+    Position,  /**< Object-space position. */
+    Normal,    /**< Object-space normal. */
+    Tangent,   /**< Object-space tangent. */
+    TexCoord0, /**< First texture coordinate set. */
+    TexCoord1, /**< Second texture coordinate set. */
+    Color      /**< Vertex color. */
+};
+
+/**
+ * @brief Specifies the storage format of a vertex attribute.
+ */
+enum class VertexFormat : uint8_t
+{
+    Float2,    /**< Two 32-bit floats. */
+    Float3,    /**< Three 32-bit floats. */
+    Float4,    /**< Four 32-bit floats. */
+    Half2,     /**< Two 16-bit floats. */
+    Half4,     /**< Four 16-bit floats. */
+    Snorm16x2, /**< Two signed normalized 16-bit integers. */
+    Snorm16x4, /**< Four signed normalized 16-bit integers. */
+    Unorm8x4   /**< Four unsigned normalized 8-bit integers. */
+};
+
+/**
+ * @brief Specifies the element type of an index buffer.
+ */
+enum class IndexFormat : uint8_t
+{
+    UInt16, /**< 16-bit unsigned indices. */
+    UInt32  /**< 32-bit unsigned indices. */
+};
+
+/**
+ * @brief Gets the size in bytes of a vertex attribute format.
+ * @param format The attribute format.
+ * @return The size of one attribute value, in bytes.
+ */
+inline uint32_t GetVertexFormatSize(VertexFormat format)
+{
+    switch (format)
+    {
+    case VertexFormat::Float2:
+        return 8;
+    case VertexFormat::Float3:
+        return 12;
+    case VertexFormat::Float4:
+        return 16;
+    case VertexFormat::Half2:
+        return 4;
+    case VertexFormat::Half4:
+        return 8;
+    case VertexFormat::Snorm16x2:
+        return 4;
+    case VertexFormat::Snorm16x4:
+        return 8;
+    case VertexFormat::Unorm8x4:
+        return 4;
+    }
+    return 0;
+}
+
+/**
+ * @brief Gets the size in bytes of an index format.
+ * @param format The index format.
+ * @return The size of one index, in bytes.
+ */
+inline uint32_t GetIndexFormatSize(IndexFormat format)
+{
+    return format == IndexFormat::UInt16 ? 2 : 4;
+}
+
+/**
+ * @brief Describes a single attribute inside an interleaved vertex.
+ */
+struct VertexAttribute
+{
+    /** @brief What the attribute represents. */
+    VertexSemantic semantic;
+    /** @brief How the attribute is stored. */
+    VertexFormat format;
+    /** @brief Byte offset of the attribute from the start of the vertex. */
+    uint16_t offset;
+};
+
+/**
+ * @brief Describes the interleaved layout of the vertices in a vertex buffer.
+ * @details The struct is a fixed-size POD so it can be stored verbatim in cooked asset files.
+ */
+struct VertexLayout
+{
+    /** @brief The attributes of the layout. Only the first attribute_count entries are meaningful. */
+    VertexAttribute attributes[kMaxVertexAttributes];
+    /** @brief The number of attributes in use. */
+    uint32_t attribute_count;
+    /** @brief The size of one vertex, in bytes. */
+    uint32_t stride;
+
+    /**
+     * @brief Appends an attribute at the end of the vertex and grows the stride accordingly.
+     * @param semantic What the attribute represents.
+     * @param format How the attribute is stored.
+     * @return True if the attribute was added, false if the layout is full.
+     */
+    bool Append(VertexSemantic semantic, VertexFormat format)
+    {
+        if (attribute_count >= kMaxVertexAttributes)
+        {
+            return false;
+        }
+        attributes[attribute_count++] = {semantic, format, static_cast<uint16_t>(stride)};
+        stride += GetVertexFormatSize(format);
+        return true;
+    }
+
+    /**
+     * @brief Finds the attribute with a given semantic.
+     * @param semantic The semantic to look for.
+     * @return A pointer to the attribute, or nullptr if the layout does not contain it.
+     */
+    const VertexAttribute *Find(VertexSemantic semantic) const
+    {
+        for (uint32_t i = 0; i < attribute_count; ++i)
+        {
+            if (attributes[i].semantic == semantic)
+            {
+                return &attributes[i];
+            }
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * @brief Specifies the color format of a render target.
+ */
+enum class RenderTargetFormat : uint8_t
+{
+    RGBA8,  /**< Four unsigned normalized 8-bit channels. */
+    RGBA16F /**< Four 16-bit float channels, for HDR rendering. */
+};
+
+/**
+ * @brief Describes an offscreen render target.
+ */
+struct RenderTargetDesc
+{
+    /** @brief The width in pixels. */
+    uint32_t width = 0;
+    /** @brief The height in pixels. */
+    uint32_t height = 0;
+    /** @brief The format of the color attachment. */
+    RenderTargetFormat color_format = RenderTargetFormat::RGBA8;
+    /** @brief Whether the target has a depth-stencil attachment. */
+    bool has_depth = true;
+};
+
+} // namespace RAL
+} // namespace Piece
+
+#endif // PIECE_RAL_RAL_TYPES_H_
@@ -0,0 +1,74 @@
+/**
+ * @file resource_handle.h
+ * @brief Defines the generational ResourceHandle type used to reference RAL resources.
+ */
+#ifndef PIECE_RAL_RESOURCE_HANDLE_H_
+#define PIECE_RAL_RESOURCE_HANDLE_H_
+
+#include <cstdint>
+
+namespace Piece
+{
+namespace RAL
+{
+
+/**
+ * @brief A typed, generational reference to a resource owned by a graphics device.
+ * @details A handle is a slot index into a backend resource pool plus the generation of the slot at the time the
+ *          resource was created. Destroying the resource bumps the slot generation, so stale handles can be detected
+ *          instead of silently aliasing a newer resource. The struct is a plain 8-byte POD and can be passed across
+ *          the interop boundary by value. A zero generation denotes the null handle.
+ * @tparam Tag An empty tag type that makes handles of different resource kinds incompatible.
+ */
+template <typename Tag> struct ResourceHandle
+{
+    /** @brief The slot index inside the owning resource pool. */
+    uint32_t index = 0;
+    /** @brief The generation of the slot when this handle was issued. Zero means null. */
+    uint32_t generation = 0;
+
+    /**
+     * @brief Checks whether this handle has been issued by a pool.
+     * @return False for the default-constructed null handle, true otherwise.
+     */
+    bool IsNull() const
+    {
+        return generation == 0;
+    }
+
+    /**
+     * @brief Compares two handles for equality.
+     * @param other The handle to compare with.
+     * @return True if both the index and the generation match.
+     */
+    bool operator==(const ResourceHandle &other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+
+    /**
+     * @brief Compares two handles for inequality.
+     * @param other The handle to compare with.
+     * @return True if the index or the generation differ.
+     */
+    bool operator!=(const ResourceHandle &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/** @brief Handle to a vertex buffer created by an IGraphicsDevice. */
+using VertexBufferHandle = ResourceHandle<struct VertexBufferTag>;
+/** @brief Handle to an index buffer created by an IGraphicsDevice. */
+using IndexBufferHandle = ResourceHandle<struct IndexBufferTag>;
+/** @brief Handle to a shader created by an IGraphicsDevice. */
+using ShaderHandle = ResourceHandle<struct ShaderTag>;
+/** @brief Handle to a shader program created by an IGraphicsDevice. */
+using ShaderProgramHandle = ResourceHandle<struct ShaderProgramTag>;
+/** @brief Handle to an offscreen render target created by an IGraphicsDevice. */
+using RenderTargetHandle = ResourceHandle<struct RenderTargetTag>;
+
+} // namespace RAL
+} // namespace Piece
+
+#endif // PIECE_RAL_RESOURCE_HANDLE_H_
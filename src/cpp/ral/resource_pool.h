@@ -0,0 +1,194 @@
+/**
+ * @file resource_pool.h
+ * @brief Defines the ResourcePool class template, a contiguous generational store for backend resources.
+ */
+#ifndef PIECE_RAL_RESOURCE_POOL_H_
+#define PIECE_RAL_RESOURCE_POOL_H_
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "resource_handle.h"
+
+namespace Piece
+{
+namespace RAL
+{
+
+/**
+ * @brief A contiguous pool of resources addressed through generational handles.
+ * @details Resources are stored by value in a single array, so creating one does not allocate once the pool has
+ *          grown and iterating or resolving handles stays cache friendly. Each slot carries a generation counter:
+ *          an odd generation marks a live slot and an even one a free slot, so destroying a resource invalidates
+ *          every handle issued for it. Freed slots are recycled in LIFO order.
+ * @tparam T The stored resource type. Must be default constructible and move assignable.
+ * @tparam HandleT The ResourceHandle specialization used to address the pool.
+ */
+template <typename T, typename HandleT> class ResourcePool
+{
+  public:
+    /**
+     * @brief Constructs a resource in a free slot.
+     * @param args Arguments forwarded to the constructor of T.
+     * @return A handle to the new resource.
+     */
+    template <typename... Args> HandleT Create(Args &&...args)
+    {
+        uint32_t index;
+        if (!free_indices_.empty())
+        {
+            index = free_indices_.back();
+            free_indices_.pop_back();
+            items_[index] = T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            index = static_cast<uint32_t>(items_.size());
+            items_.emplace_back(std::forward<Args>(args)...);
+            generations_.push_back(0);
+        }
+        ++generations_[index];
+        ++live_count_;
+
+        HandleT handle;
+        handle.index = index;
+        handle.generation = generations_[index];
+        return handle;
+    }
+
+    /**
+     * @brief Destroys the resource referenced by a handle and recycles its slot.
+     * @param handle The handle of the resource to destroy.
+     * @return True if the handle was valid and the resource was destroyed, false otherwise.
+     */
+    bool Destroy(HandleT handle)
+    {
+        if (!IsValid(handle))
+        {
+            return false;
+        }
+        items_[handle.index] = T();
+        ++generations_[handle.index];
+        free_indices_.push_back(handle.index);
+        --live_count_;
+        return true;
+    }
+
+    /**
+     * @brief Checks whether a handle references a live resource of this pool.
+     * @param handle The handle to check.
+     * @return True if the handle is live, false if it is null, stale or out of range.
+     */
+    bool IsValid(HandleT handle) const
+    {
+        return handle.index < generations_.size() && (handle.generation & 1u) != 0 &&
+               generations_[handle.index] == handle.generation;
+    }
+
+    /**
+     * @brief Resolves a handle, validating it first.
+     * @param handle The handle to resolve.
+     * @return A pointer to the resource, or nullptr if the handle is not live.
+     */
+    T *TryGet(HandleT handle)
+    {
+        return IsValid(handle) ? &items_[handle.index] : nullptr;
+    }
+
+    /**
+     * @brief Resolves a handle, validating it first.
+     * @param handle The handle to resolve.
+     * @return A pointer to the resource, or nullptr if the handle is not live.
+     */
+    const T *TryGet(HandleT handle) const
+    {
+        return IsValid(handle) ? &items_[handle.index] : nullptr;
+    }
+
+    /**
+     * @brief Resolves a handle on the hot path.
+     * @details Debug builds assert that the handle is live to catch use-after-free; release builds only index
+     *          the array.
+     * @param handle The handle to resolve. Must be live.
+     * @return A reference to the resource.
+     */
+    T &Get(HandleT handle)
+    {
+        assert(IsValid(handle) && "Stale or invalid resource handle");
+        return items_[handle.index];
+    }
+
+    /**
+     * @brief Resolves a handle on the hot path.
+     * @param handle The handle to resolve. Must be live.
+     * @return A const reference to the resource.
+     */
+    const T &Get(HandleT handle) const
+    {
+        assert(IsValid(handle) && "Stale or invalid resource handle");
+        return items_[handle.index];
+    }
+
+    /**
+     * @brief Invokes a function for every live resource in slot order.
+     * @param fn A callable taking (HandleT, T &).
+     */
+    template <typename Fn> void ForEach(Fn &&fn)
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(items_.size()); ++i)
+        {
+            if ((generations_[i] & 1u) != 0)
+            {
+                HandleT handle;
+                handle.index = i;
+                handle.generation = generations_[i];
+                fn(handle, items_[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the number of live resources.
+     * @return The live resource count.
+     */
+    uint32_t GetLiveCount() const
+    {
+        return live_count_;
+    }
+
+    /**
+     * @brief Gets the number of slots allocated so far, live or free.
+     * @return The slot count.
+     */
+    uint32_t GetCapacity() const
+    {
+        return static_cast<uint32_t>(items_.size());
+    }
+
+    /**
+     * @brief Reserves storage for a number of slots up front.
+     * @param capacity The number of slots to reserve.
+     */
+    void Reserve(uint32_t capacity)
+    {
+        items_.reserve(capacity);
+        generations_.reserve(capacity);
+    }
+
+  private:
+    /** @brief Resource storage, one element per slot. */
+    std::vector<T> items_;
+    /** @brief Slot generations. Odd values mark live slots. */
+    std::vector<uint32_t> generations_;
+    /** @brief Indices of free slots available for reuse. */
+    std::vector<uint32_t> free_indices_;
+    /** @brief The number of live resources. */
+    uint32_t live_count_ = 0;
+};
+
+} // namespace RAL
+} // namespace Piece
+
+#endif // PIECE_RAL_RESOURCE_POOL_H_
@@ -0,0 +1,234 @@
+/**
+ * @file frame_pacer.h
+ * @brief Defines the present modes and the FramePacer class, which times frame starts for frame rate caps and
+ *        low-latency presentation.
+ */
+#ifndef PIECE_WAL_FRAME_PACER_H_
+#define PIECE_WAL_FRAME_PACER_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+namespace Piece
+{
+namespace WAL
+{
+
+/**
+ * @brief How frames are presented.
+ */
+enum class PresentMode : uint32_t
+{
+    VSync = 0,    /**< Present on vertical blank; no tearing, frame rate capped at the refresh rate. */
+    Adaptive = 1, /**< Like VSync, but late frames present immediately and may tear. Falls back to VSync. */
+    Uncapped = 2, /**< Present immediately, as fast as frames are produced. */
+    Capped = 3    /**< Present immediately, at most max_frame_rate times per second. */
+};
+
+/**
+ * @brief Presentation settings of a window.
+ */
+struct PresentOptions
+{
+    /** @brief The present mode. */
+    PresentMode mode = PresentMode::VSync;
+    /** @brief The frame rate limit of PresentMode::Capped, in frames per second. 0 or less disables the cap. */
+    float max_frame_rate = 0.0f;
+    /**
+     * @brief Whether to start each frame as late as possible: input is sampled and the frame simulated just in time
+     *        for the predicted present instead of right after the previous one. No effect with PresentMode::Uncapped.
+     */
+    bool low_latency = false;
+};
+
+/**
+ * @brief Decides when a window's frames start and waits for that moment precisely.
+ * @details The window asks for the start time before sampling input and reports the time around each present. With
+ *          a frame rate cap, frames start at a fixed interval. In low-latency mode, the pacer predicts the next
+ *          present from the last one and the present interval, and starts the frame the predicted work time before
+ *          it, so input is as fresh as possible when the frame is shown. The work time is the longest of the recent
+ *          frames, which errs towards presenting in time over shaving off the last bit of latency.
+ *
+ *          Waiting combines sleeping and spinning: it sleeps in short slices while the remaining time exceeds the
+ *          expected length of a slice plus its jitter, measured as it goes, and spins the rest. That keeps the
+ *          precision of a spin at a fraction of its CPU cost on any OS timer resolution.
+ */
+class FramePacer
+{
+  public:
+    /** @brief The clock frame times are measured with. */
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Applies presentation settings.
+     * @param options The settings.
+     * @param refresh_period The display's refresh period, the present interval of the vsync modes.
+     */
+    void Configure(const PresentOptions &options, Clock::duration refresh_period)
+    {
+        options_ = options;
+        switch (options.mode)
+        {
+        case PresentMode::VSync:
+        case PresentMode::Adaptive:
+            interval_ = refresh_period;
+            break;
+        case PresentMode::Capped:
+            interval_ = options.max_frame_rate > 0.0f
+                            ? std::chrono::duration_cast<Clock::duration>(
+                                  std::chrono::duration<double>(1.0 / options.max_frame_rate))
+                            : Clock::duration::zero();
+            break;
+        case PresentMode::Uncapped:
+        default:
+            interval_ = Clock::duration::zero();
+            break;
+        }
+        has_present_ = false;
+        next_start_ = Clock::time_point();
+    }
+
+    /**
+     * @brief Gets the time the next frame should start at, before its input is sampled.
+     * @param now The current time.
+     * @return The start time, or now if the frame should start right away.
+     */
+    Clock::time_point GetFrameStartTarget(Clock::time_point now) const
+    {
+        if (interval_ == Clock::duration::zero())
+        {
+            return now;
+        }
+        Clock::time_point target = now;
+        if (options_.low_latency && has_present_)
+        {
+            target = next_present_ - GetPredictedWorkTime();
+        }
+        else if (options_.mode == PresentMode::Capped)
+        {
+            target = next_start_;
+        }
+        return std::max(target, now);
+    }
+
+    /**
+     * @brief Records the start of a frame, right before its input is sampled.
+     * @param now The current time.
+     */
+    void BeginFrame(Clock::time_point now)
+    {
+        frame_start_ = now;
+        if (options_.mode == PresentMode::Capped && !options_.low_latency)
+        {
+            // Keep to the fixed schedule to avoid drift, but start over after a hitch instead of bursting frames.
+            next_start_ = now - next_start_ > interval_ ? now + interval_ : next_start_ + interval_;
+        }
+    }
+
+    /**
+     * @brief Records a present.
+     * @param present_begin The time the frame's work was done and the present was requested.
+     * @param present_end The time the present call returned.
+     */
+    void EndFrame(Clock::time_point present_begin, Clock::time_point present_end)
+    {
+        work_times_[work_index_] = present_begin - frame_start_;
+        work_index_ = (work_index_ + 1) % kWorkHistory;
+        if (options_.mode == PresentMode::Capped)
+        {
+            // Capped presents do not block, so the schedule is kept unless the frame ran late.
+            bool on_schedule = has_present_ && present_end - next_present_ < interval_;
+            next_present_ = (on_schedule ? next_present_ : present_end) + interval_;
+        }
+        else
+        {
+            // A blocking vsync present returns at the blank, so the next one is a refresh later.
+            next_present_ = present_end + interval_;
+        }
+        has_present_ = true;
+    }
+
+    /**
+     * @brief Gets the predicted time from frame start to present request.
+     * @return The longest recent frame plus a safety margin.
+     */
+    Clock::duration GetPredictedWorkTime() const
+    {
+        return *std::max_element(work_times_.begin(), work_times_.end()) + kSafetyMargin;
+    }
+
+    /**
+     * @brief Waits until a time by sleeping while that is safe and spinning the rest.
+     *        Only touches the sleep estimate, so it may run unlocked while another thread records a present.
+     * @param deadline The time to wait for.
+     */
+    void WaitUntil(Clock::time_point deadline)
+    {
+        Clock::time_point now = Clock::now();
+        while (deadline - now > std::chrono::duration<double>(sleep_estimate_))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            Clock::time_point woke = Clock::now();
+            UpdateSleepEstimate(std::chrono::duration<double>(woke - now).count());
+            now = woke;
+        }
+        while (Clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+  private:
+    /** @brief The number of recent frames the work time prediction covers. */
+    static constexpr uint32_t kWorkHistory = 16;
+    /** @brief Added to the predicted work time to absorb driver and scheduling noise. */
+    static constexpr Clock::duration kSafetyMargin = std::chrono::microseconds(1000);
+
+    /**
+     * @brief Updates the expected length of a 1 ms sleep with one measurement (Welford's algorithm).
+     * @param seconds The measured sleep, in seconds.
+     */
+    void UpdateSleepEstimate(double seconds)
+    {
+        // Capping the count keeps the estimate following changes in timer resolution and system load.
+        sleep_count_ = std::min(sleep_count_ + 1, 64u);
+        double delta = seconds - sleep_mean_;
+        sleep_mean_ += delta / sleep_count_;
+        sleep_m2_ = std::max(0.0, sleep_m2_ + delta * (seconds - sleep_mean_));
+        sleep_estimate_ = sleep_mean_ + std::sqrt(sleep_m2_ / std::max(sleep_count_ - 1, 1u));
+    }
+
+    /** @brief The presentation settings. */
+    PresentOptions options_;
+    /** @brief The time between presents, zero without a schedule. */
+    Clock::duration interval_ = Clock::duration::zero();
+    /** @brief The start of the current frame. */
+    Clock::time_point frame_start_;
+    /** @brief The scheduled start of the next frame, for the plain frame rate cap. */
+    Clock::time_point next_start_;
+    /** @brief The predicted time of the next present. */
+    Clock::time_point next_present_;
+    /** @brief Whether a present has been recorded since Configure. */
+    bool has_present_ = false;
+    /** @brief The work times of recent frames, a ring. */
+    std::array<Clock::duration, kWorkHistory> work_times_ = {};
+    /** @brief The ring position the next work time goes to. */
+    uint32_t work_index_ = 0;
+    /** @brief The mean of the measured 1 ms sleeps, in seconds. */
+    double sleep_mean_ = 0.002;
+    /** @brief The sum of squared deviations of the measured sleeps. */
+    double sleep_m2_ = 0.0;
+    /** @brief The number of sleeps in the estimate. */
+    uint32_t sleep_count_ = 1;
+    /** @brief A pessimistic length of a 1 ms sleep, in seconds; below that much time left, the wait spins. */
+    double sleep_estimate_ = 0.002;
+};
+
+} // namespace WAL
+} // namespace Piece
+
+#endif // PIECE_WAL_FRAME_PACER_H_
@@ -0,0 +1,109 @@
+/**
+ * @file glfw_platform.cpp
+ * @brief Implements the GlfwPlatform class.
+ */
+#include "glfw_platform.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "glfw_window.h"
+
+namespace Piece
+{
+namespace WAL
+{
+
+namespace
+{
+/** @brief Guards the reference count and the window list. */
+std::mutex g_platform_mutex;
+/** @brief The number of references on GLFW. */
+uint32_t g_reference_count = 0;
+/** @brief The live windows, oldest first. */
+std::vector<GlfwWindow *> g_windows;
+} // namespace
+
+/**
+ * @brief Initializes GLFW on the first reference.
+ * @return True if GLFW is initialized.
+ */
+bool GlfwPlatform::Acquire()
+{
+    std::lock_guard<std::mutex> lock(g_platform_mutex);
+    if (g_reference_count == 0 && !glfwInit())
+    {
+        return false;
+    }
+    ++g_reference_count;
+    return true;
+}
+
+/**
+ * @brief Terminates GLFW with the last reference.
+ */
+void GlfwPlatform::Release()
+{
+    std::lock_guard<std::mutex> lock(g_platform_mutex);
+    if (g_reference_count > 0 && --g_reference_count == 0)
+    {
+        glfwTerminate();
+    }
+}
+
+/**
+ * @brief Gets the number of references on GLFW.
+ * @return The reference count.
+ */
+uint32_t GlfwPlatform::GetReferenceCount()
+{
+    std::lock_guard<std::mutex> lock(g_platform_mutex);
+    return g_reference_count;
+}
+
+/**
+ * @brief Adds a window to the live windows.
+ * @param window The window.
+ */
+void GlfwPlatform::RegisterWindow(GlfwWindow *window)
+{
+    std::lock_guard<std::mutex> lock(g_platform_mutex);
+    g_windows.push_back(window);
+}
+
+/**
+ * @brief Removes a window from the live windows.
+ * @param window The window.
+ */
+void GlfwPlatform::UnregisterWindow(GlfwWindow *window)
+{
+    std::lock_guard<std::mutex> lock(g_platform_mutex);
+    g_windows.erase(std::remove(g_windows.begin(), g_windows.end(), window), g_windows.end());
+}
+
+/**
+ * @brief Gets the oldest live GLFW window. OpenGL shares objects between every context of a share group, so any
+ *        member will do.
+ * @return The GLFW window, or nullptr if there is none.
+ */
+GLFWwindow *GlfwPlatform::GetShareContext()
+{
+    std::lock_guard<std::mutex> lock(g_platform_mutex);
+    return g_windows.empty() ? nullptr : static_cast<GLFWwindow *>(g_windows.front()->GetNativeWindow());
+}
+
+/**
+ * @brief Clears the per-frame input of every live window.
+ */
+void GlfwPlatform::BeginInputFrames()
+{
+    std::lock_guard<std::mutex> lock(g_platform_mutex);
+    for (GlfwWindow *window : g_windows)
+    {
+        window->BeginInputFrame();
+    }
+}
+
+} // namespace WAL
+} // namespace Piece
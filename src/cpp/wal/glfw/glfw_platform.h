@@ -0,0 +1,70 @@
+/**
+ * @file glfw_platform.h
+ * @brief Defines the GlfwPlatform class, which reference-counts GLFW initialization and tracks the live windows.
+ */
+#ifndef PIECE_WAL_GLFW_PLATFORM_H_
+#define PIECE_WAL_GLFW_PLATFORM_H_
+
+#include <GLFW/glfw3.h>
+
+#include <cstdint>
+
+namespace Piece
+{
+namespace WAL
+{
+
+#include "wal_glfw_exports.h"
+
+class GlfwWindow;
+
+/**
+ * @brief Process-wide GLFW state shared by every GlfwWindow.
+ * @details GLFW is initialized by the first Acquire and terminated by the last Release, so windows can come and go
+ *          in any order without tearing down the library under the others. The live windows are registered so a new
+ *          window can share the OpenGL objects of the existing ones, and so one event poll starts the input frame of
+ *          every window before it dispatches their events. Call everything on the thread that created the windows.
+ */
+class WAL_GLFW_API GlfwPlatform
+{
+  public:
+    /**
+     * @brief Takes a reference on GLFW, initializing it on the first one.
+     * @return True if GLFW is initialized; false if initialization failed, in which case no reference is taken.
+     */
+    static bool Acquire();
+    /**
+     * @brief Drops a reference taken by Acquire, terminating GLFW with the last one.
+     */
+    static void Release();
+    /**
+     * @brief Gets the number of references on GLFW.
+     * @return The reference count.
+     */
+    static uint32_t GetReferenceCount();
+
+    /**
+     * @brief Registers a window once its GLFW window exists.
+     * @param window The window.
+     */
+    static void RegisterWindow(GlfwWindow *window);
+    /**
+     * @brief Unregisters a window before its GLFW window is destroyed.
+     * @param window The window.
+     */
+    static void UnregisterWindow(GlfwWindow *window);
+    /**
+     * @brief Gets a live GLFW window for a new window to share OpenGL objects with.
+     * @return The oldest live window, or nullptr if there is none.
+     */
+    static GLFWwindow *GetShareContext();
+    /**
+     * @brief Starts a new input frame on every registered window, ahead of the event poll that feeds them all.
+     */
+    static void BeginInputFrames();
+};
+
+} // namespace WAL
+} // namespace Piece
+
+#endif // PIECE_WAL_GLFW_PLATFORM_H_
@@ -4,7 +4,11 @@
  */
 #include "glfw_window.h"
 
+#include "glfw_platform.h"
+
+#include <chrono>
 #include <iostream>
+#include <utility>
 
 namespace Piece
 {
@@ -12,11 +16,12 @@ namespace WAL
 {
 
 /**
- * @brief Constructs a GlfwWindow instance and initializes GLFW.
+ * @brief Constructs a GlfwWindow instance and takes a reference on GLFW, initializing it for the first window.
  */
 GlfwWindow::GlfwWindow() : window_(nullptr)
 {
-    if (!glfwInit())
+    platform_acquired_ = GlfwPlatform::Acquire();
+    if (!platform_acquired_)
     {
         // It's better to use a proper logger here, but for now, this is fine.
         std::cerr << "Failed to initialize GLFW" << std::endl;
@@ -24,16 +29,21 @@ GlfwWindow::GlfwWindow() : window_(nullptr)
 }
 
 /**
- * @brief Destroys the GlfwWindow instance, destroys the window, and terminates GLFW.
+ * @brief Destroys the GlfwWindow instance and the window, and drops the GLFW reference; the last window terminates
+ *        GLFW.
  */
 GlfwWindow::~GlfwWindow()
 {
     if (window_)
     {
+        GlfwPlatform::UnregisterWindow(this);
         glfwDestroyWindow(window_);
         window_ = nullptr;
     }
-    glfwTerminate();
+    if (platform_acquired_)
+    {
+        GlfwPlatform::Release();
+    }
 }
 
 /**
@@ -50,50 +60,211 @@ bool GlfwWindow::Init(int width, int height, const std::string &title)
         std::cerr << "Window already initialized." << std::endl;
         return false;
     }
+    if (!platform_acquired_)
+    {
+        std::cerr << "GLFW is not initialized." << std::endl;
+        return false;
+    }
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    window_ = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+    // Every window joins one share group, so buffers, textures and shaders created by the graphics device are
+    // usable from all of them.
+    window_ = glfwCreateWindow(width, height, title.c_str(), nullptr, GlfwPlatform::GetShareContext());
     if (!window_)
     {
         std::cerr << "Failed to create GLFW window" << std::endl;
-        glfwTerminate();
         return false;
     }
+    GlfwPlatform::RegisterWindow(this);
 
     glfwMakeContextCurrent(window_);
-    glfwSwapInterval(1); // Enable V-Sync
+    ConfigureFramePacer();
+    ApplySwapInterval();
+
+    // Input is recorded as events arrive instead of queried from GLFW on every lookup.
+    glfwSetWindowUserPointer(window_, this);
+    glfwSetKeyCallback(window_, &GlfwWindow::OnKey);
+    glfwSetMouseButtonCallback(window_, &GlfwWindow::OnMouseButton);
+    glfwSetCursorPosCallback(window_, &GlfwWindow::OnCursorPosition);
+    glfwSetScrollCallback(window_, &GlfwWindow::OnScroll);
+    glfwSetCharCallback(window_, &GlfwWindow::OnText);
+    glfwSetFramebufferSizeCallback(window_, &GlfwWindow::OnFramebufferSize);
+    glfwSetWindowCloseCallback(window_, &GlfwWindow::OnClose);
+    double xpos, ypos;
+    glfwGetCursorPos(window_, &xpos, &ypos);
+    input_.ResetCursorPosition(static_cast<float>(xpos), static_cast<float>(ypos));
+    int framebuffer_width, framebuffer_height;
+    glfwGetFramebufferSize(window_, &framebuffer_width, &framebuffer_height);
+    StoreFramebufferSize(framebuffer_width, framebuffer_height);
 
     return true;
 }
 
 /**
- * @brief Polls for GLFW events.
+ * @brief Waits until the frame pacer's start time, starts a new input frame on every window and polls for GLFW
+ *        events, which update the input state and queue the input events through the callbacks.
  */
 void GlfwWindow::PollEvents()
 {
+    FramePacer::Clock::time_point start;
+    {
+        std::lock_guard<std::mutex> lock(present_mutex_);
+        start = frame_pacer_.GetFrameStartTarget(FramePacer::Clock::now());
+    }
+    // Waiting only touches the pacer's sleep estimate, which no other thread uses.
+    frame_pacer_.WaitUntil(start);
+    {
+        std::lock_guard<std::mutex> lock(present_mutex_);
+        frame_pacer_.BeginFrame(FramePacer::Clock::now());
+    }
+    // One poll dispatches the events of every window, so every window starts its input frame first.
+    GlfwPlatform::BeginInputFrames();
     glfwPollEvents();
 }
 
 /**
- * @brief Swaps the front and back buffers of the GLFW window.
+ * @brief Drops the previous frame's input edges, deltas and events.
+ */
+void GlfwWindow::BeginInputFrame()
+{
+    input_.BeginFrame();
+    input_events_.BeginFrame();
+}
+
+/**
+ * @brief Swaps the front and back buffers of the GLFW window, first applying a changed swap interval to the context,
+ *        which is current on the calling thread.
  */
 void GlfwWindow::SwapBuffers()
 {
     if (window_)
     {
+        if (swap_interval_dirty_.exchange(false))
+        {
+            ApplySwapInterval();
+        }
+        FramePacer::Clock::time_point present_begin = FramePacer::Clock::now();
         glfwSwapBuffers(window_);
+        FramePacer::Clock::time_point present_end = FramePacer::Clock::now();
+        std::lock_guard<std::mutex> lock(present_mutex_);
+        frame_pacer_.EndFrame(present_begin, present_end);
     }
 }
 
 /**
- * @brief Checks if the GLFW window should close.
+ * @brief Stores the presentation settings and reconfigures the frame pacer. The swap interval follows at the next
+ *        SwapBuffers, on whichever thread the context is current on.
+ * @param options The presentation settings.
+ */
+void GlfwWindow::SetPresentOptions(const PresentOptions &options)
+{
+    {
+        std::lock_guard<std::mutex> lock(present_mutex_);
+        present_options_ = options;
+    }
+    if (window_)
+    {
+        ConfigureFramePacer();
+        swap_interval_dirty_ = true;
+    }
+}
+
+/**
+ * @brief Configures the frame pacer with the present options and the refresh period of the primary monitor.
+ *        Monitors may only be queried on the thread that initialized GLFW, so this runs on the event thread.
+ */
+void GlfwWindow::ConfigureFramePacer()
+{
+    int refresh_rate = 60;
+    GLFWmonitor *monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode *mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    if (mode && mode->refreshRate > 0)
+    {
+        refresh_rate = mode->refreshRate;
+    }
+    std::lock_guard<std::mutex> lock(present_mutex_);
+    frame_pacer_.Configure(present_options_, std::chrono::duration_cast<FramePacer::Clock::duration>(
+                                                 std::chrono::duration<double>(1.0 / refresh_rate)));
+}
+
+/**
+ * @brief Sets the swap interval of the present mode on the context current on the calling thread.
+ */
+void GlfwWindow::ApplySwapInterval()
+{
+    PresentMode present_mode;
+    {
+        std::lock_guard<std::mutex> lock(present_mutex_);
+        present_mode = present_options_.mode;
+    }
+    int swap_interval = 1;
+    switch (present_mode)
+    {
+    case PresentMode::Adaptive:
+        // Negative intervals tear late frames instead of waiting a whole refresh, where the driver supports it.
+        if (glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+        {
+            swap_interval = -1;
+        }
+        break;
+    case PresentMode::Uncapped:
+    case PresentMode::Capped:
+        swap_interval = 0;
+        break;
+    case PresentMode::VSync:
+    default:
+        break;
+    }
+    glfwSwapInterval(swap_interval);
+}
+
+/**
+ * @brief Checks if the GLFW window should close. Safe to call from any thread.
  * @return True if the window should close, false otherwise.
  */
 bool GlfwWindow::ShouldClose() const
 {
-    return window_ ? glfwWindowShouldClose(window_) : true;
+    return window_ ? close_requested_.load() || glfwWindowShouldClose(window_) : true;
+}
+
+/**
+ * @brief Gets the framebuffer size last reported by GLFW. Safe to call from any thread.
+ * @return The width and height in pixels.
+ */
+std::pair<int, int> GlfwWindow::GetFramebufferSize() const
+{
+    uint64_t packed = framebuffer_size_.load();
+    return {static_cast<int>(static_cast<uint32_t>(packed >> 32)), static_cast<int>(static_cast<uint32_t>(packed))};
+}
+
+/**
+ * @brief Binds the window's OpenGL context to the calling thread, or releases the calling thread's context.
+ * @param current True to bind the context, false to release it.
+ */
+void GlfwWindow::SetContextCurrent(bool current)
+{
+    glfwMakeContextCurrent(current ? window_ : nullptr);
+}
+
+/**
+ * @brief Sets the function told about resizes and close requests.
+ * @param callback The function, or an empty function to stop notifications.
+ */
+void GlfwWindow::SetNotificationCallback(std::function<void(WindowNotification)> callback)
+{
+    notification_callback_ = std::move(callback);
+}
+
+/**
+ * @brief Publishes the framebuffer size, both halves in one atomic so readers never see a torn size.
+ * @param width The width in pixels.
+ * @param height The height in pixels.
+ */
+void GlfwWindow::StoreFramebufferSize(int width, int height)
+{
+    framebuffer_size_ = (uint64_t{static_cast<uint32_t>(width)} << 32) | static_cast<uint32_t>(height);
 }
 
 /**
@@ -112,11 +283,7 @@ void *GlfwWindow::GetNativeWindow() const
  */
 bool GlfwWindow::IsKeyPressed(KeyCode keycode) const
 {
-    if (window_)
-    {
-        return glfwGetKey(window_, static_cast<int>(keycode)) == GLFW_PRESS;
-    }
-    return false;
+    return input_.IsKeyDown(keycode);
 }
 
 /**
@@ -126,11 +293,7 @@ bool GlfwWindow::IsKeyPressed(KeyCode keycode) const
  */
 bool GlfwWindow::IsMouseButtonPressed(KeyCode button) const
 {
-    if (window_)
-    {
-        return glfwGetMouseButton(window_, static_cast<int>(button)) == GLFW_PRESS;
-    }
-    return false;
+    return input_.IsMouseButtonDown(button);
 }
 
 /**
@@ -139,13 +302,7 @@ bool GlfwWindow::IsMouseButtonPressed(KeyCode button) const
  */
 std::pair<float, float> GlfwWindow::GetMousePosition() const
 {
-    double xpos, ypos;
-    if (window_)
-    {
-        glfwGetCursorPos(window_, &xpos, &ypos);
-        return {static_cast<float>(xpos), static_cast<float>(ypos)};
-    }
-    return {0.0f, 0.0f};
+    return input_.GetCursorPosition();
 }
 
 /**
@@ -154,7 +311,7 @@ std::pair<float, float> GlfwWindow::GetMousePosition() const
  */
 float GlfwWindow::GetMouseX() const
 {
-    return GetMousePosition().first;
+    return input_.GetCursorPosition().first;
 }
 
 /**
@@ -163,7 +320,191 @@ float GlfwWindow::GetMouseX() const
  */
 float GlfwWindow::GetMouseY() const
 {
-    return GetMousePosition().second;
+    return input_.GetCursorPosition().second;
+}
+
+/**
+ * @brief Checks if a key went down during the last PollEvents.
+ * @param keycode The key to check.
+ * @return True if the key was pressed this frame.
+ */
+bool GlfwWindow::WasKeyPressedThisFrame(KeyCode keycode) const
+{
+    return input_.WasKeyPressed(keycode);
+}
+
+/**
+ * @brief Checks if a key went up during the last PollEvents.
+ * @param keycode The key to check.
+ * @return True if the key was released this frame.
+ */
+bool GlfwWindow::WasKeyReleasedThisFrame(KeyCode keycode) const
+{
+    return input_.WasKeyReleased(keycode);
+}
+
+/**
+ * @brief Checks if a mouse button went down during the last PollEvents.
+ * @param button The mouse button to check.
+ * @return True if the button was pressed this frame.
+ */
+bool GlfwWindow::WasMouseButtonPressedThisFrame(KeyCode button) const
+{
+    return input_.WasMouseButtonPressed(button);
+}
+
+/**
+ * @brief Checks if a mouse button went up during the last PollEvents.
+ * @param button The mouse button to check.
+ * @return True if the button was released this frame.
+ */
+bool GlfwWindow::WasMouseButtonReleasedThisFrame(KeyCode button) const
+{
+    return input_.WasMouseButtonReleased(button);
+}
+
+/**
+ * @brief Gets the input state filled by the GLFW callbacks.
+ * @return The input state.
+ */
+const InputState &GlfwWindow::GetInputState() const
+{
+    return input_;
+}
+
+/**
+ * @brief Copies the input events received during the last PollEvents.
+ * @param events The destination, or nullptr to only get the count.
+ * @param capacity The number of events the destination holds.
+ * @return The number of events in the frame.
+ */
+uint32_t GlfwWindow::ReadInputEvents(InputEvent *events, uint32_t capacity) const
+{
+    return input_events_.Copy(events, capacity);
+}
+
+/**
+ * @brief Records and queues a key event. Key repeats keep the key down without a new press.
+ * @param window The GLFW window.
+ * @param key The GLFW key, which matches KeyCode.
+ * @param scancode The platform scancode, unused.
+ * @param action GLFW_PRESS, GLFW_REPEAT or GLFW_RELEASE, which match InputAction.
+ * @param mods The modifier bits.
+ */
+void GlfwWindow::OnKey(GLFWwindow *window, int key, int scancode, int action, int mods)
+{
+    auto *self = static_cast<GlfwWindow *>(glfwGetWindowUserPointer(window));
+    self->input_.SetKey(static_cast<KeyCode>(key), action != GLFW_RELEASE);
+    InputEvent event;
+    event.timestamp_ns = InputEventQueue::Now();
+    event.type = InputEventType::Key;
+    event.code = key;
+    event.action = static_cast<InputAction>(action);
+    event.mods = mods;
+    self->input_events_.Push(event);
+}
+
+/**
+ * @brief Records and queues a mouse button event, stamped with the cursor position.
+ * @param window The GLFW window.
+ * @param button The GLFW mouse button, which matches KeyCode.
+ * @param action GLFW_PRESS or GLFW_RELEASE.
+ * @param mods The modifier bits.
+ */
+void GlfwWindow::OnMouseButton(GLFWwindow *window, int button, int action, int mods)
+{
+    auto *self = static_cast<GlfwWindow *>(glfwGetWindowUserPointer(window));
+    self->input_.SetMouseButton(static_cast<KeyCode>(button), action != GLFW_RELEASE);
+    InputEvent event;
+    event.timestamp_ns = InputEventQueue::Now();
+    event.type = InputEventType::MouseButton;
+    event.code = button;
+    event.action = static_cast<InputAction>(action);
+    event.mods = mods;
+    event.x = self->input_.GetCursorPosition().first;
+    event.y = self->input_.GetCursorPosition().second;
+    self->input_events_.Push(event);
+}
+
+/**
+ * @brief Records and queues the cursor position.
+ * @param window The GLFW window.
+ * @param x The x-coordinate in screen coordinates relative to the content area.
+ * @param y The y-coordinate.
+ */
+void GlfwWindow::OnCursorPosition(GLFWwindow *window, double x, double y)
+{
+    auto *self = static_cast<GlfwWindow *>(glfwGetWindowUserPointer(window));
+    self->input_.SetCursorPosition(static_cast<float>(x), static_cast<float>(y));
+    InputEvent event;
+    event.timestamp_ns = InputEventQueue::Now();
+    event.type = InputEventType::CursorMove;
+    event.x = static_cast<float>(x);
+    event.y = static_cast<float>(y);
+    self->input_events_.Push(event);
+}
+
+/**
+ * @brief Accumulates and queues scroll offsets.
+ * @param window The GLFW window.
+ * @param x_offset The horizontal offset.
+ * @param y_offset The vertical offset.
+ */
+void GlfwWindow::OnScroll(GLFWwindow *window, double x_offset, double y_offset)
+{
+    auto *self = static_cast<GlfwWindow *>(glfwGetWindowUserPointer(window));
+    self->input_.AddScroll(static_cast<float>(x_offset), static_cast<float>(y_offset));
+    InputEvent event;
+    event.timestamp_ns = InputEventQueue::Now();
+    event.type = InputEventType::Scroll;
+    event.x = static_cast<float>(x_offset);
+    event.y = static_cast<float>(y_offset);
+    self->input_events_.Push(event);
+}
+
+/**
+ * @brief Queues a typed character.
+ * @param window The GLFW window.
+ * @param codepoint The Unicode code point.
+ */
+void GlfwWindow::OnText(GLFWwindow *window, unsigned int codepoint)
+{
+    auto *self = static_cast<GlfwWindow *>(glfwGetWindowUserPointer(window));
+    InputEvent event;
+    event.timestamp_ns = InputEventQueue::Now();
+    event.type = InputEventType::Text;
+    event.code = static_cast<int32_t>(codepoint);
+    self->input_events_.Push(event);
+}
+
+/**
+ * @brief Publishes the new framebuffer size and notifies the callback.
+ * @param window The GLFW window.
+ * @param width The width in pixels.
+ * @param height The height in pixels.
+ */
+void GlfwWindow::OnFramebufferSize(GLFWwindow *window, int width, int height)
+{
+    auto *self = static_cast<GlfwWindow *>(glfwGetWindowUserPointer(window));
+    self->StoreFramebufferSize(width, height);
+    if (self->notification_callback_)
+    {
+        self->notification_callback_(WindowNotification::Resized);
+    }
+}
+
+/**
+ * @brief Records the close request and notifies the callback.
+ * @param window The GLFW window.
+ */
+void GlfwWindow::OnClose(GLFWwindow *window)
+{
+    auto *self = static_cast<GlfwWindow *>(glfwGetWindowUserPointer(window));
+    self->close_requested_ = true;
+    if (self->notification_callback_)
+    {
+        self->notification_callback_(WindowNotification::CloseRequested);
+    }
 }
 
 } // namespace WAL
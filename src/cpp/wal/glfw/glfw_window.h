@@ -8,6 +8,10 @@
 #include <GLFW/glfw3.h> 
 #include <wal/iwindow.h>
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+
 namespace Piece
 {
 namespace WAL
@@ -39,18 +43,38 @@ class WAL_GLFW_API GlfwWindow : public IWindow
      */
     virtual bool Init(int width, int height, const std::string &title) override;
     /**
-     * @brief Polls for GLFW events.
+     * @brief Waits until the frame should start, then polls for the GLFW events of every window.
      */
     virtual void PollEvents() override;
     /**
-     * @brief Swaps the front and back buffers of the GLFW window.
+     * @brief Swaps the front and back buffers of the GLFW window. Call on the thread the context is current on.
      */
     virtual void SwapBuffers() override;
+    /**
+     * @brief Sets the swap interval and frame pacing; applied at Init if the window does not exist yet.
+     * @param options The presentation settings.
+     */
+    virtual void SetPresentOptions(const PresentOptions &options) override;
     /**
      * @brief Checks if the GLFW window should close.
      * @return True if the window should close, false otherwise.
      */
     virtual bool ShouldClose() const override;
+    /**
+     * @brief Gets the framebuffer size, kept up to date by the GLFW callback. Safe to call from any thread.
+     * @return The width and height in pixels.
+     */
+    virtual std::pair<int, int> GetFramebufferSize() const override;
+    /**
+     * @brief Binds the OpenGL context to the calling thread, or releases it.
+     * @param current True to bind the context, false to release it.
+     */
+    virtual void SetContextCurrent(bool current) override;
+    /**
+     * @brief Sets the function told about resizes and close requests during PollEvents.
+     * @param callback The function, or an empty function to stop notifications.
+     */
+    virtual void SetNotificationCallback(std::function<void(WindowNotification)> callback) override;
     /**
      * @brief Gets the native GLFW window handle.
      * @return A void pointer to the native GLFWwindow.
@@ -85,10 +109,114 @@ class WAL_GLFW_API GlfwWindow : public IWindow
      * @return The y-coordinate of the mouse.
      */
     virtual float GetMouseY() const override;
+    /**
+     * @brief Checks if a key went down during the last PollEvents.
+     * @param keycode The key to check.
+     * @return True if the key was pressed this frame.
+     */
+    virtual bool WasKeyPressedThisFrame(KeyCode keycode) const override;
+    /**
+     * @brief Checks if a key went up during the last PollEvents.
+     * @param keycode The key to check.
+     * @return True if the key was released this frame.
+     */
+    virtual bool WasKeyReleasedThisFrame(KeyCode keycode) const override;
+    /**
+     * @brief Checks if a mouse button went down during the last PollEvents.
+     * @param button The mouse button to check.
+     * @return True if the button was pressed this frame.
+     */
+    virtual bool WasMouseButtonPressedThisFrame(KeyCode button) const override;
+    /**
+     * @brief Checks if a mouse button went up during the last PollEvents.
+     * @param button The mouse button to check.
+     * @return True if the button was released this frame.
+     */
+    virtual bool WasMouseButtonReleasedThisFrame(KeyCode button) const override;
+    /**
+     * @brief Gets the input state filled by the GLFW callbacks.
+     * @return The input state.
+     */
+    virtual const InputState &GetInputState() const override;
+    /**
+     * @brief Copies the input events received during the last PollEvents.
+     * @param events The destination, or nullptr to only get the count.
+     * @param capacity The number of events the destination holds.
+     * @return The number of events in the frame.
+     */
+    virtual uint32_t ReadInputEvents(InputEvent *events, uint32_t capacity) const override;
 
   private:
+    friend class GlfwPlatform;
+
+    /**
+     * @brief Starts a new input frame; called on every window before the shared event poll.
+     */
+    void BeginInputFrame();
+    /**
+     * @brief Configures the frame pacer from the present options and the monitor's refresh rate.
+     */
+    void ConfigureFramePacer();
+    /**
+     * @brief Sets the swap interval of the present mode on the calling thread's context.
+     */
+    void ApplySwapInterval();
+    /**
+     * @brief Publishes the framebuffer size to other threads.
+     */
+    void StoreFramebufferSize(int width, int height);
+
+    /**
+     * @brief GLFW key callback; records the key in the input state.
+     */
+    static void OnKey(GLFWwindow *window, int key, int scancode, int action, int mods);
+    /**
+     * @brief GLFW mouse button callback; records the button in the input state.
+     */
+    static void OnMouseButton(GLFWwindow *window, int button, int action, int mods);
+    /**
+     * @brief GLFW cursor position callback; records the position in the input state.
+     */
+    static void OnCursorPosition(GLFWwindow *window, double x, double y);
+    /**
+     * @brief GLFW scroll callback; accumulates the offsets in the input state.
+     */
+    static void OnScroll(GLFWwindow *window, double x_offset, double y_offset);
+    /**
+     * @brief GLFW character callback; queues the typed code point.
+     */
+    static void OnText(GLFWwindow *window, unsigned int codepoint);
+    /**
+     * @brief GLFW framebuffer size callback; publishes the size and notifies.
+     */
+    static void OnFramebufferSize(GLFWwindow *window, int width, int height);
+    /**
+     * @brief GLFW window close callback; records the request and notifies.
+     */
+    static void OnClose(GLFWwindow *window);
+
     /** @brief Pointer to the native GLFW window object. */
     GLFWwindow *window_;
+    /** @brief Whether the constructor took a reference on GLFW. */
+    bool platform_acquired_ = false;
+    /** @brief The input state of the current frame, filled by the callbacks during PollEvents. */
+    InputState input_;
+    /** @brief The input events of the current frame, queued by the callbacks during PollEvents. */
+    InputEventQueue input_events_;
+    /** @brief Guards the present options and the frame pacer between the event thread and the presenting thread. */
+    mutable std::mutex present_mutex_;
+    /** @brief The presentation settings. */
+    PresentOptions present_options_;
+    /** @brief Times frame starts for the frame rate cap and low latency. */
+    FramePacer frame_pacer_;
+    /** @brief Set when the present mode changed, so the next SwapBuffers updates the swap interval. */
+    std::atomic<bool> swap_interval_dirty_{false};
+    /** @brief The framebuffer width in the high and height in the low 32 bits, readable from any thread. */
+    std::atomic<uint64_t> framebuffer_size_{0};
+    /** @brief Set by the close callback, readable from any thread. */
+    std::atomic<bool> close_requested_{false};
+    /** @brief Told about resizes and close requests on the event thread. */
+    std::function<void(WindowNotification)> notification_callback_;
 };
 
 } // namespace WAL
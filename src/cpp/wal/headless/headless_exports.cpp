@@ -0,0 +1,33 @@
+/**
+ * @file headless_exports.cpp
+ * @brief Implements the C-style exported functions for the headless windowing implementation.
+ */
+#include <piece_core/native_exports.h>
+
+#include "headless_window_factory.h"
+#include "wal_headless_exports.h"
+
+extern "C"
+{
+
+    /**
+     * @brief Creates a new HeadlessWindowFactory.
+     * @param options The native window options, or nullptr for the defaults.
+     * @return A pointer to the newly created IWindowFactory.
+     */
+    WAL_HEADLESS_API Piece::Core::IWindowFactory *CreateHeadlessWindowFactory(
+        const Piece::Core::NativeWindowOptions *options)
+    {
+        return new Piece::Core::HeadlessWindowFactory(options);
+    }
+
+    /**
+     * @brief Destroys a HeadlessWindowFactory.
+     * @param factory A pointer to the factory to destroy.
+     */
+    WAL_HEADLESS_API void DestroyHeadlessWindowFactory(Piece::Core::IWindowFactory *factory)
+    {
+        delete factory;
+    }
+
+} // extern "C"
@@ -0,0 +1,520 @@
+/**
+ * @file headless_window.cpp
+ * @brief Implements the HeadlessWindow class.
+ */
+#include "headless_window.h"
+
+#include <EGL/eglext.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace Piece
+{
+namespace WAL
+{
+
+namespace
+{
+
+/** @brief GL_RGBA, for reading the framebuffer back without an OpenGL header. */
+constexpr unsigned int kGlRgba = 0x1908;
+/** @brief GL_UNSIGNED_BYTE. */
+constexpr unsigned int kGlUnsignedByte = 0x1401;
+
+/** @brief Guards the shared display and the context list. */
+std::mutex g_display_mutex;
+/** @brief The EGL display of all headless windows. */
+EGLDisplay g_display = EGL_NO_DISPLAY;
+/** @brief The number of windows using the display. */
+uint32_t g_display_references = 0;
+/** @brief The contexts of the initialized windows, oldest first; new contexts share objects with the oldest. */
+std::vector<EGLContext> g_contexts;
+
+/**
+ * @brief Checks a space-separated EGL extension string for an extension.
+ * @param extensions The extension string, or nullptr.
+ * @param name The extension name.
+ * @return True if the extension is listed.
+ */
+bool HasExtension(const char *extensions, const char *name)
+{
+    if (!extensions)
+    {
+        return false;
+    }
+    size_t length = std::strlen(name);
+    for (const char *found = std::strstr(extensions, name); found; found = std::strstr(found + length, name))
+    {
+        bool starts = found == extensions || found[-1] == ' ';
+        bool ends = found[length] == '\0' || found[length] == ' ';
+        if (starts && ends)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Opens and initializes an EGL display.
+ *        Mesa's surfaceless platform needs neither a display server nor a GPU device node, so it is preferred;
+ *        other drivers get the default display.
+ * @return The display, or EGL_NO_DISPLAY on failure.
+ */
+EGLDisplay OpenDisplay()
+{
+    EGLDisplay display = EGL_NO_DISPLAY;
+    if (HasExtension(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS), "EGL_MESA_platform_surfaceless"))
+    {
+        auto get_platform_display =
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (get_platform_display)
+        {
+            display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+    }
+    if (display == EGL_NO_DISPLAY)
+    {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    EGLint major = 0, minor = 0;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+    {
+        return EGL_NO_DISPLAY;
+    }
+    return display;
+}
+
+/**
+ * @brief Takes a reference on the shared display, opening it for the first window.
+ * @return The display, or EGL_NO_DISPLAY if it could not be opened.
+ */
+EGLDisplay AcquireDisplay()
+{
+    std::lock_guard<std::mutex> lock(g_display_mutex);
+    if (g_display_references == 0)
+    {
+        g_display = OpenDisplay();
+        if (g_display == EGL_NO_DISPLAY)
+        {
+            return EGL_NO_DISPLAY;
+        }
+    }
+    ++g_display_references;
+    return g_display;
+}
+
+/**
+ * @brief Drops a reference on the shared display, terminating it after the last window.
+ */
+void ReleaseDisplay()
+{
+    std::lock_guard<std::mutex> lock(g_display_mutex);
+    if (g_display_references > 0 && --g_display_references == 0)
+    {
+        eglTerminate(g_display);
+        g_display = EGL_NO_DISPLAY;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Constructs a HeadlessWindow instance. The display is opened by Init.
+ */
+HeadlessWindow::HeadlessWindow() = default;
+
+/**
+ * @brief Destroys the surface and context, releasing the context first if it is current on this thread, and drops
+ *        the display reference.
+ */
+HeadlessWindow::~HeadlessWindow()
+{
+    if (display_ == EGL_NO_DISPLAY)
+    {
+        return;
+    }
+    if (context_ != EGL_NO_CONTEXT)
+    {
+        if (eglGetCurrentContext() == context_)
+        {
+            eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+        {
+            std::lock_guard<std::mutex> lock(g_display_mutex);
+            g_contexts.erase(std::remove(g_contexts.begin(), g_contexts.end(), context_), g_contexts.end());
+        }
+        eglDestroyContext(display_, context_);
+    }
+    if (surface_ != EGL_NO_SURFACE)
+    {
+        eglDestroySurface(display_, surface_);
+    }
+    ReleaseDisplay();
+}
+
+/**
+ * @brief Opens the shared display, picks an RGBA8 config with depth, and creates a pbuffer of the requested size with
+ *        an OpenGL 3.3 core context, or a surfaceless context if the driver has no pbuffer configs.
+ * @param width The width of the framebuffer.
+ * @param height The height of the framebuffer.
+ * @param title Unused.
+ * @return True if initialization is successful, false otherwise.
+ */
+bool HeadlessWindow::Init(int width, int height, [[maybe_unused]] const std::string &title)
+{
+    if (display_ != EGL_NO_DISPLAY)
+    {
+        std::cerr << "Window already initialized." << std::endl;
+        return false;
+    }
+    EGLDisplay display = AcquireDisplay();
+    if (display == EGL_NO_DISPLAY)
+    {
+        std::cerr << "Failed to open an EGL display" << std::endl;
+        return false;
+    }
+    display_ = display;
+
+    // The bound API is per thread, so it is set wherever the context is made current.
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        std::cerr << "EGL display does not support desktop OpenGL" << std::endl;
+        return false;
+    }
+    EGLint config_attributes[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                                  EGL_RED_SIZE,     8,               EGL_GREEN_SIZE,      8,
+                                  EGL_BLUE_SIZE,    8,               EGL_ALPHA_SIZE,      8,
+                                  EGL_DEPTH_SIZE,   24,              EGL_NONE};
+    EGLConfig config = nullptr;
+    EGLint config_count = 0;
+    bool has_pbuffer = eglChooseConfig(display_, config_attributes, &config, 1, &config_count) && config_count > 0;
+    if (!has_pbuffer)
+    {
+        if (!HasExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"))
+        {
+            std::cerr << "EGL display has neither pbuffers nor surfaceless contexts" << std::endl;
+            return false;
+        }
+        // An empty surface type mask matches every config.
+        config_attributes[1] = 0;
+        if (!eglChooseConfig(display_, config_attributes, &config, 1, &config_count) || config_count == 0)
+        {
+            std::cerr << "No EGL config for OpenGL rendering" << std::endl;
+            return false;
+        }
+    }
+
+    EGLint context_attributes[] = {EGL_CONTEXT_MAJOR_VERSION,       3,
+                                   EGL_CONTEXT_MINOR_VERSION,       3,
+                                   EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                   EGL_NONE};
+    {
+        // Every headless window joins one share group, like the GLFW backend's windows.
+        std::lock_guard<std::mutex> lock(g_display_mutex);
+        EGLContext share_context = g_contexts.empty() ? EGL_NO_CONTEXT : g_contexts.front();
+        context_ = eglCreateContext(display_, config, share_context, context_attributes);
+        if (context_ == EGL_NO_CONTEXT)
+        {
+            std::cerr << "Failed to create an EGL context" << std::endl;
+            return false;
+        }
+        g_contexts.push_back(context_);
+    }
+    if (has_pbuffer)
+    {
+        EGLint surface_attributes[] = {EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE};
+        surface_ = eglCreatePbufferSurface(display_, config, surface_attributes);
+        if (surface_ == EGL_NO_SURFACE)
+        {
+            std::cerr << "Failed to create an EGL pbuffer" << std::endl;
+            return false;
+        }
+    }
+    width_ = width;
+    height_ = height;
+
+    SetContextCurrent(true);
+    finish_ = reinterpret_cast<FinishProc>(eglGetProcAddress("glFinish"));
+    read_pixels_ = reinterpret_cast<ReadPixelsProc>(eglGetProcAddress("glReadPixels"));
+    ConfigureFramePacer();
+    return true;
+}
+
+/**
+ * @brief Waits until the frame pacer's start time and starts a new input frame.
+ */
+void HeadlessWindow::PollEvents()
+{
+    FramePacer::Clock::time_point start;
+    {
+        std::lock_guard<std::mutex> lock(present_mutex_);
+        start = frame_pacer_.GetFrameStartTarget(FramePacer::Clock::now());
+    }
+    frame_pacer_.WaitUntil(start);
+    {
+        std::lock_guard<std::mutex> lock(present_mutex_);
+        frame_pacer_.BeginFrame(FramePacer::Clock::now());
+    }
+    input_.BeginFrame();
+}
+
+/**
+ * @brief Finishes the frame's rendering and records the present. A pbuffer has no front buffer to swap with, and
+ *        waiting for the rendering keeps a software rasterizer from queueing up frames the way a blocking present
+ *        would.
+ */
+void HeadlessWindow::SwapBuffers()
+{
+    if (context_ == EGL_NO_CONTEXT)
+    {
+        return;
+    }
+    FramePacer::Clock::time_point present_begin = FramePacer::Clock::now();
+    if (finish_)
+    {
+        finish_();
+    }
+    FramePacer::Clock::time_point present_end = FramePacer::Clock::now();
+    std::lock_guard<std::mutex> lock(present_mutex_);
+    frame_pacer_.EndFrame(present_begin, present_end);
+}
+
+/**
+ * @brief Stores the presentation settings and reconfigures the frame pacer.
+ * @param options The presentation settings.
+ */
+void HeadlessWindow::SetPresentOptions(const PresentOptions &options)
+{
+    {
+        std::lock_guard<std::mutex> lock(present_mutex_);
+        present_options_ = options;
+    }
+    ConfigureFramePacer();
+}
+
+/**
+ * @brief Configures the frame pacer. Presents never block, so the vsync modes become a cap at the simulated refresh
+ *        rate.
+ */
+void HeadlessWindow::ConfigureFramePacer()
+{
+    std::lock_guard<std::mutex> lock(present_mutex_);
+    PresentOptions options = present_options_;
+    if (options.mode == PresentMode::VSync || options.mode == PresentMode::Adaptive)
+    {
+        options.mode = PresentMode::Capped;
+        options.max_frame_rate = static_cast<float>(kRefreshRate);
+    }
+    frame_pacer_.Configure(options, std::chrono::duration_cast<FramePacer::Clock::duration>(
+                                        std::chrono::duration<double>(1.0 / kRefreshRate)));
+}
+
+/**
+ * @brief Checks if the window should close. Safe to call from any thread.
+ * @return True once RequestClose was called or if the window is not initialized.
+ */
+bool HeadlessWindow::ShouldClose() const
+{
+    return context_ == EGL_NO_CONTEXT || close_requested_.load();
+}
+
+/**
+ * @brief Gets the framebuffer size, fixed at Init. Safe to call from any thread.
+ * @return The width and height in pixels.
+ */
+std::pair<int, int> HeadlessWindow::GetFramebufferSize() const
+{
+    return {width_, height_};
+}
+
+/**
+ * @brief Binds the context and its surface to the calling thread, or releases the calling thread's context.
+ * @param current True to bind the context, false to release it.
+ */
+void HeadlessWindow::SetContextCurrent(bool current)
+{
+    if (display_ == EGL_NO_DISPLAY)
+    {
+        return;
+    }
+    if (current)
+    {
+        eglBindAPI(EGL_OPENGL_API);
+        eglMakeCurrent(display_, surface_, surface_, context_);
+    }
+    else
+    {
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+}
+
+/**
+ * @brief Sets the function told about close requests.
+ * @param callback The function, or an empty function to stop notifications.
+ */
+void HeadlessWindow::SetNotificationCallback(std::function<void(WindowNotification)> callback)
+{
+    notification_callback_ = std::move(callback);
+}
+
+/**
+ * @brief Gets the EGL context.
+ * @return The EGLContext, or nullptr before Init.
+ */
+void *HeadlessWindow::GetNativeWindow() const
+{
+    return static_cast<void *>(context_);
+}
+
+/**
+ * @brief Records a close request and notifies the callback.
+ */
+void HeadlessWindow::RequestClose()
+{
+    close_requested_ = true;
+    if (notification_callback_)
+    {
+        notification_callback_(WindowNotification::CloseRequested);
+    }
+}
+
+/**
+ * @brief Reads the framebuffer back as RGBA8.
+ * @param pixels The destination, bottom row first.
+ * @param size The size of the destination in bytes.
+ * @return True if the pixels were read.
+ */
+bool HeadlessWindow::ReadPixels(void *pixels, size_t size) const
+{
+    if (!read_pixels_ || !pixels || size < static_cast<size_t>(width_) * static_cast<size_t>(height_) * 4)
+    {
+        return false;
+    }
+    read_pixels_(0, 0, width_, height_, kGlRgba, kGlUnsignedByte, pixels);
+    return true;
+}
+
+/**
+ * @brief Checks if the window has a surfaceless context.
+ * @return True if there is no default framebuffer.
+ */
+bool HeadlessWindow::IsSurfaceless() const
+{
+    return context_ != EGL_NO_CONTEXT && surface_ == EGL_NO_SURFACE;
+}
+
+/**
+ * @brief Checks if a specific key is currently pressed.
+ * @param keycode The key to check.
+ * @return Whether the key is down in the window's input state, which no device input reaches.
+ */
+bool HeadlessWindow::IsKeyPressed(KeyCode keycode) const
+{
+    return input_.IsKeyDown(keycode);
+}
+
+/**
+ * @brief Checks if a specific mouse button is currently pressed.
+ * @param button The mouse button to check.
+ * @return Whether the button is down in the window's input state, which no device input reaches.
+ */
+bool HeadlessWindow::IsMouseButtonPressed(KeyCode button) const
+{
+    return input_.IsMouseButtonDown(button);
+}
+
+/**
+ * @brief Gets the current position of the mouse cursor.
+ * @return The cursor position of the window's input state, which no device input reaches.
+ */
+std::pair<float, float> HeadlessWindow::GetMousePosition() const
+{
+    return input_.GetCursorPosition();
+}
+
+/**
+ * @brief Gets the x-coordinate of the mouse cursor.
+ * @return The cursor x-coordinate of the window's input state.
+ */
+float HeadlessWindow::GetMouseX() const
+{
+    return input_.GetCursorPosition().first;
+}
+
+/**
+ * @brief Gets the y-coordinate of the mouse cursor.
+ * @return The cursor y-coordinate of the window's input state.
+ */
+float HeadlessWindow::GetMouseY() const
+{
+    return input_.GetCursorPosition().second;
+}
+
+/**
+ * @brief Checks if a key went down during the last PollEvents.
+ * @param keycode The key to check.
+ * @return Whether the window's input state recorded it, which no device input reaches.
+ */
+bool HeadlessWindow::WasKeyPressedThisFrame(KeyCode keycode) const
+{
+    return input_.WasKeyPressed(keycode);
+}
+
+/**
+ * @brief Checks if a key went up during the last PollEvents.
+ * @param keycode The key to check.
+ * @return Whether the window's input state recorded it, which no device input reaches.
+ */
+bool HeadlessWindow::WasKeyReleasedThisFrame(KeyCode keycode) const
+{
+    return input_.WasKeyReleased(keycode);
+}
+
+/**
+ * @brief Checks if a mouse button went down during the last PollEvents.
+ * @param button The mouse button to check.
+ * @return Whether the window's input state recorded it, which no device input reaches.
+ */
+bool HeadlessWindow::WasMouseButtonPressedThisFrame(KeyCode button) const
+{
+    return input_.WasMouseButtonPressed(button);
+}
+
+/**
+ * @brief Checks if a mouse button went up during the last PollEvents.
+ * @param button The mouse button to check.
+ * @return Whether the window's input state recorded it, which no device input reaches.
+ */
+bool HeadlessWindow::WasMouseButtonReleasedThisFrame(KeyCode button) const
+{
+    return input_.WasMouseButtonReleased(button);
+}
+
+/**
+ * @brief Gets the window's input state, which PollEvents advances by a frame but no device input reaches.
+ * @return The input state.
+ */
+const InputState &HeadlessWindow::GetInputState() const
+{
+    return input_;
+}
+
+/**
+ * @brief Copies the input events of the last PollEvents. A headless window receives none.
+ * @param events The destination, left untouched.
+ * @param capacity The number of events the destination holds.
+ * @return Zero, the number of events of the last PollEvents.
+ */
+uint32_t HeadlessWindow::ReadInputEvents([[maybe_unused]] InputEvent *events, [[maybe_unused]] uint32_t capacity) const
+{
+    return 0;
+}
+
+} // namespace WAL
+} // namespace Piece
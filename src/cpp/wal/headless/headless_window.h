@@ -0,0 +1,224 @@
+/**
+ * @file headless_window.h
+ * @brief Defines the HeadlessWindow class, an EGL-based implementation of the IWindow interface without a visible
+ *        window.
+ */
+#ifndef PIECE_WAL_HEADLESS_WINDOW_H_
+#define PIECE_WAL_HEADLESS_WINDOW_H_
+
+#include <EGL/egl.h>
+#include <wal/iwindow.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+namespace Piece
+{
+namespace WAL
+{
+
+#include "wal_headless_exports.h"
+
+/**
+ * @brief An IWindow that renders into an offscreen EGL surface, for machines without a display.
+ * @details Every window opens the same EGL display, preferring Mesa's surfaceless platform, which needs neither a
+ *          display server nor a GPU and falls back to the llvmpipe software rasterizer. The window's framebuffer is a
+ *          pbuffer of the requested size with an OpenGL 3.3 core context, like the GLFW backend's. Drivers without
+ *          pbuffer configs get a surfaceless context instead, which has no default framebuffer, so frames must then
+ *          be drawn into render targets.
+ *
+ *          Contexts of all headless windows share their objects. There is no input: the input queries report an idle
+ *          keyboard and mouse. SwapBuffers waits for the frame's rendering to finish, so frame times measure the
+ *          rendering, and the vsync present modes are paced at a simulated 60 Hz display.
+ */
+class WAL_HEADLESS_API HeadlessWindow : public IWindow
+{
+  public:
+    /** @brief The refresh rate the vsync present modes are paced at. */
+    static constexpr int kRefreshRate = 60;
+
+    /**
+     * @brief Constructs a HeadlessWindow instance.
+     */
+    HeadlessWindow();
+    /**
+     * @brief Destroys the HeadlessWindow instance, its surface and context, and closes the EGL display after the
+     *        last window.
+     */
+    virtual ~HeadlessWindow();
+
+    /**
+     * @brief Opens the EGL display and creates the surface and context, which become current on the calling thread.
+     * @param width The width of the framebuffer.
+     * @param height The height of the framebuffer.
+     * @param title Unused; kept for the interface.
+     * @return True if initialization was successful, false otherwise.
+     */
+    virtual bool Init(int width, int height, const std::string &title) override;
+    /**
+     * @brief Waits until the frame should start and starts a new, empty input frame.
+     */
+    virtual void PollEvents() override;
+    /**
+     * @brief Waits for the frame's rendering to finish. Call on the thread the context is current on.
+     */
+    virtual void SwapBuffers() override;
+    /**
+     * @brief Sets the frame pacing; the vsync modes are paced at kRefreshRate.
+     * @param options The presentation settings.
+     */
+    virtual void SetPresentOptions(const PresentOptions &options) override;
+    /**
+     * @brief Checks if the window should close.
+     * @return True once RequestClose was called or if the window is not initialized.
+     */
+    virtual bool ShouldClose() const override;
+    /**
+     * @brief Gets the framebuffer size. Safe to call from any thread.
+     * @return The width and height in pixels.
+     */
+    virtual std::pair<int, int> GetFramebufferSize() const override;
+    /**
+     * @brief Binds the EGL context to the calling thread, or releases it.
+     * @param current True to bind the context, false to release it.
+     */
+    virtual void SetContextCurrent(bool current) override;
+    /**
+     * @brief Sets the function told about close requests.
+     * @param callback The function, or an empty function to stop notifications.
+     */
+    virtual void SetNotificationCallback(std::function<void(WindowNotification)> callback) override;
+    /**
+     * @brief Gets the EGL context, the closest a headless window has to a native handle.
+     * @return The EGLContext.
+     */
+    virtual void *GetNativeWindow() const override;
+
+    // Input Methods
+    /**
+     * @brief Checks if a specific key is currently pressed.
+     * @param keycode The key to check.
+     * @return Whether the key is down in the window's input state, which no device input reaches.
+     */
+    virtual bool IsKeyPressed(KeyCode keycode) const override;
+    /**
+     * @brief Checks if a specific mouse button is currently pressed.
+     * @param button The mouse button to check.
+     * @return Whether the button is down in the window's input state, which no device input reaches.
+     */
+    virtual bool IsMouseButtonPressed(KeyCode button) const override;
+    /**
+     * @brief Gets the current position of the mouse cursor.
+     * @return The cursor position of the window's input state, which no device input reaches.
+     */
+    virtual std::pair<float, float> GetMousePosition() const override;
+    /**
+     * @brief Gets the x-coordinate of the mouse cursor.
+     * @return The cursor x-coordinate of the window's input state.
+     */
+    virtual float GetMouseX() const override;
+    /**
+     * @brief Gets the y-coordinate of the mouse cursor.
+     * @return The cursor y-coordinate of the window's input state.
+     */
+    virtual float GetMouseY() const override;
+    /**
+     * @brief Checks if a key went down during the last PollEvents.
+     * @param keycode The key to check.
+     * @return Whether the window's input state recorded it, which no device input reaches.
+     */
+    virtual bool WasKeyPressedThisFrame(KeyCode keycode) const override;
+    /**
+     * @brief Checks if a key went up during the last PollEvents.
+     * @param keycode The key to check.
+     * @return Whether the window's input state recorded it, which no device input reaches.
+     */
+    virtual bool WasKeyReleasedThisFrame(KeyCode keycode) const override;
+    /**
+     * @brief Checks if a mouse button went down during the last PollEvents.
+     * @param button The mouse button to check.
+     * @return Whether the window's input state recorded it, which no device input reaches.
+     */
+    virtual bool WasMouseButtonPressedThisFrame(KeyCode button) const override;
+    /**
+     * @brief Checks if a mouse button went up during the last PollEvents.
+     * @param button The mouse button to check.
+     * @return Whether the window's input state recorded it, which no device input reaches.
+     */
+    virtual bool WasMouseButtonReleasedThisFrame(KeyCode button) const override;
+    /**
+     * @brief Gets the window's input state, which PollEvents advances by a frame but no device input reaches.
+     * @return The input state.
+     */
+    virtual const InputState &GetInputState() const override;
+    /**
+     * @brief Copies the input events of the last PollEvents, of which there are none.
+     * @param events The destination, or nullptr to only get the count.
+     * @param capacity The number of events the destination holds.
+     * @return Zero, the number of events of the last PollEvents.
+     */
+    virtual uint32_t ReadInputEvents(InputEvent *events, uint32_t capacity) const override;
+
+    /**
+     * @brief Makes ShouldClose return true and notifies the callback, like a user closing a window.
+     */
+    void RequestClose();
+    /**
+     * @brief Reads the framebuffer back, for image comparisons. Call on the thread the context is current on, after
+     *        SwapBuffers to get a finished frame.
+     * @param pixels The destination for width * height RGBA8 pixels, bottom row first as OpenGL stores them.
+     * @param size The size of the destination in bytes.
+     * @return True if the pixels were read; false if the destination is too small or the window is not initialized.
+     */
+    bool ReadPixels(void *pixels, size_t size) const;
+    /**
+     * @brief Checks if the window fell back to a surfaceless context, which has no default framebuffer.
+     * @return True if frames must be drawn into render targets.
+     */
+    bool IsSurfaceless() const;
+
+  private:
+    /** @brief The glFinish signature, loaded through EGL so the backend needs no OpenGL loader. */
+    using FinishProc = void(EGLAPIENTRY *)();
+    /** @brief The glReadPixels signature. */
+    using ReadPixelsProc = void(EGLAPIENTRY *)(int, int, int, int, unsigned int, unsigned int, void *);
+
+    /**
+     * @brief Configures the frame pacer from the present options and the simulated refresh rate.
+     */
+    void ConfigureFramePacer();
+
+    /** @brief The EGL display shared by all headless windows. */
+    EGLDisplay display_ = EGL_NO_DISPLAY;
+    /** @brief The OpenGL context. */
+    EGLContext context_ = EGL_NO_CONTEXT;
+    /** @brief The pbuffer surface, or EGL_NO_SURFACE for a surfaceless context. */
+    EGLSurface surface_ = EGL_NO_SURFACE;
+    /** @brief The framebuffer width. */
+    int width_ = 0;
+    /** @brief The framebuffer height. */
+    int height_ = 0;
+    /** @brief glFinish, or nullptr if the driver does not expose it. */
+    FinishProc finish_ = nullptr;
+    /** @brief glReadPixels, or nullptr if the driver does not expose it. */
+    ReadPixelsProc read_pixels_ = nullptr;
+    /** @brief The input state, reset every frame and never fed. */
+    InputState input_;
+    /** @brief Guards the present options and the frame pacer between the event thread and the presenting thread. */
+    mutable std::mutex present_mutex_;
+    /** @brief The presentation settings. */
+    PresentOptions present_options_;
+    /** @brief Times frame starts for the frame rate cap, the simulated vsync and low latency. */
+    FramePacer frame_pacer_;
+    /** @brief Set by RequestClose, readable from any thread. */
+    std::atomic<bool> close_requested_{false};
+    /** @brief Told about close requests. */
+    std::function<void(WindowNotification)> notification_callback_;
+};
+
+} // namespace WAL
+} // namespace Piece
+
+#endif // PIECE_WAL_HEADLESS_WINDOW_H_
@@ -0,0 +1,53 @@
+/**
+ * @file headless_window_factory.h
+ * @brief Defines the HeadlessWindowFactory class, a factory for creating HeadlessWindow instances.
+ */
+#ifndef PIECE_WAL_HEADLESS_WINDOW_FACTORY_H_
+#define PIECE_WAL_HEADLESS_WINDOW_FACTORY_H_
+
+#include <piece_core/interfaces/iwindow_factory.h>
+#include <piece_core/native_exports.h> // For NativeWindowOptions
+
+#include "headless_window.h" // For HeadlessWindow concrete implementation
+
+namespace Piece
+{
+namespace Core
+{
+
+#include "wal_headless_exports.h"
+
+/**
+ * @brief A factory for creating HeadlessWindow instances.
+ * @details This class implements the IWindowFactory interface to provide a concrete
+ *          factory for creating headless windows.
+ */
+class WAL_HEADLESS_API HeadlessWindowFactory : public IWindowFactory
+{
+  public:
+    /**
+     * @brief Constructs a HeadlessWindowFactory instance.
+     * @param options The native window options to be used for window creation.
+     */
+    HeadlessWindowFactory(const Piece::Core::NativeWindowOptions *options);
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~HeadlessWindowFactory() = default;
+
+    /**
+     * @brief Creates a new HeadlessWindow instance.
+     * @param options Configuration options for the window.
+     * @return A unique_ptr to the newly created IWindow instance.
+     */
+    virtual std::unique_ptr<WAL::IWindow> CreateWindow(const Piece::Core::NativeWindowOptions *options) override;
+
+  private:
+    /** @brief Stores the native window options for later use. */
+    Piece::Core::NativeWindowOptions options_;
+};
+
+} // namespace Core
+} // namespace Piece
+
+#endif // PIECE_WAL_HEADLESS_WINDOW_FACTORY_H_
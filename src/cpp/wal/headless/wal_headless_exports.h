@@ -0,0 +1,38 @@
+/**
+ * @file wal_headless_exports.h
+ * @brief Defines macros for exporting and importing symbols from the WAL headless implementation library.
+ */
+#ifndef WAL_HEADLESS_EXPORTS_H_
+#define WAL_HEADLESS_EXPORTS_H_
+
+#ifdef _WIN32
+#ifdef WAL_HEADLESS_BUILD_DLL
+/**
+ * @def WAL_HEADLESS_API
+ * @brief Exports symbols from the DLL on Windows when building the DLL.
+ */
+#define WAL_HEADLESS_API __declspec(dllexport)
+#else
+/**
+ * @def WAL_HEADLESS_API
+ * @brief Imports symbols from the DLL on Windows when using the DLL.
+ */
+#define WAL_HEADLESS_API __declspec(dllimport)
+#endif
+#else // Non-Windows platforms
+#ifdef WAL_HEADLESS_BUILD_DLL
+/**
+ * @def WAL_HEADLESS_API
+ * @brief Sets default visibility for symbols on non-Windows platforms when building the shared library.
+ */
+#define WAL_HEADLESS_API __attribute__((visibility("default")))
+#else
+/**
+ * @def WAL_HEADLESS_API
+ * @brief Defined as empty on non-Windows platforms when using the shared library.
+ */
+#define WAL_HEADLESS_API
+#endif
+#endif
+
+#endif // WAL_HEADLESS_EXPORTS_H_
\ No newline at end of file
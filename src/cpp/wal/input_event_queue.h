@@ -0,0 +1,133 @@
+/**
+ * @file input_event_queue.h
+ * @brief Defines the InputEvent record and the InputEventQueue class collecting a frame's input events in order.
+ */
+#ifndef PIECE_WAL_INPUT_EVENT_QUEUE_H_
+#define PIECE_WAL_INPUT_EVENT_QUEUE_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace Piece
+{
+namespace WAL
+{
+
+/**
+ * @brief The kinds of input events.
+ */
+enum class InputEventType : uint32_t
+{
+    Key = 0,         /**< A key went down, repeated or went up. */
+    MouseButton = 1, /**< A mouse button went down or up. */
+    CursorMove = 2,  /**< The cursor moved; x and y hold the new position. */
+    Scroll = 3,      /**< The wheel or touchpad scrolled; x and y hold the offsets. */
+    Text = 4         /**< A character was typed; code holds its Unicode code point. */
+};
+
+/**
+ * @brief The actions of key and mouse button events. The values match GLFW's.
+ */
+enum class InputAction : uint32_t
+{
+    Release = 0, /**< The key or button went up. */
+    Press = 1,   /**< The key or button went down. */
+    Repeat = 2   /**< A held key repeated. */
+};
+
+/**
+ * @brief One input event, stamped with the time it was received.
+ * @details A plain record with a fixed layout, so a frame's events can be copied across the native boundary as one
+ *          array.
+ */
+struct InputEvent
+{
+    /** @brief When the event was received, in nanoseconds of std::chrono::steady_clock. */
+    int64_t timestamp_ns = 0;
+    /** @brief The kind of event. */
+    InputEventType type = InputEventType::Key;
+    /** @brief The KeyCode for key and mouse button events, the code point for text events, otherwise 0. */
+    int32_t code = 0;
+    /** @brief The InputAction for key and mouse button events, otherwise 0. */
+    InputAction action = InputAction::Release;
+    /** @brief The held modifiers for key and mouse button events, as GLFW modifier bits (shift 1, control 2, alt 4,
+     *         super 8, caps lock 16, num lock 32). */
+    int32_t mods = 0;
+    /** @brief The cursor x-coordinate, or the horizontal scroll offset. */
+    float x = 0.0f;
+    /** @brief The cursor y-coordinate, or the vertical scroll offset. */
+    float y = 0.0f;
+};
+
+/**
+ * @brief Collects the input events of one frame in the order they arrived.
+ * @details The window backend clears it at the start of IWindow::PollEvents and appends events as it receives them.
+ *          The storage is kept across frames, so a steady stream of events does not allocate.
+ */
+class InputEventQueue
+{
+  public:
+    /**
+     * @brief Gets the current time in the clock input events are stamped with.
+     * @return Nanoseconds of std::chrono::steady_clock.
+     */
+    static int64_t Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /**
+     * @brief Starts a new frame by dropping the previous frame's events.
+     */
+    void BeginFrame()
+    {
+        events_.clear();
+    }
+
+    /**
+     * @brief Appends an event.
+     * @param event The event.
+     */
+    void Push(const InputEvent &event)
+    {
+        events_.push_back(event);
+    }
+
+    /**
+     * @brief Copies the frame's events in arrival order.
+     * @param events The destination, or nullptr to only get the count.
+     * @param capacity The number of events the destination holds.
+     * @return The number of events in the frame; only the first capacity of them were copied if it is larger.
+     */
+    uint32_t Copy(InputEvent *events, uint32_t capacity) const
+    {
+        uint32_t count = static_cast<uint32_t>(events_.size());
+        if (events)
+        {
+            std::copy_n(events_.begin(), std::min(count, capacity), events);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Gets the frame's events.
+     * @return The events in arrival order.
+     */
+    const std::vector<InputEvent> &GetEvents() const
+    {
+        return events_;
+    }
+
+  private:
+    /** @brief The events of the current frame. */
+    std::vector<InputEvent> events_;
+};
+
+} // namespace WAL
+} // namespace Piece
+
+#endif // PIECE_WAL_INPUT_EVENT_QUEUE_H_
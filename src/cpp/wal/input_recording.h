@@ -0,0 +1,250 @@
+/**
+ * @file input_recording.h
+ * @brief Defines the InputRecording class, a per-frame record of a window's input events and frame delta times that
+ *        can be saved to and loaded from a compact binary file.
+ */
+#ifndef PIECE_WAL_INPUT_RECORDING_H_
+#define PIECE_WAL_INPUT_RECORDING_H_
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "iwindow.h"
+
+namespace Piece
+{
+namespace WAL
+{
+
+/**
+ * @brief One recorded frame.
+ */
+struct RecordedFrame
+{
+    /** @brief The delta time the frame was updated with, in seconds. */
+    float delta_time = 0.0f;
+    /** @brief The index of the frame's first event in the recording. */
+    uint32_t first_event = 0;
+    /** @brief The number of input events polled for the frame. */
+    uint32_t event_count = 0;
+};
+
+/**
+ * @brief The input events and delta times of a sequence of frames.
+ * @details Recorded by calling RecordFrame after each IWindow::PollEvents; replayed frame by frame by ReplayWindow.
+ *          Event timestamps are kept relative to Start, so a replay preserves the spacing of events within and across
+ *          frames.
+ *
+ *          The file holds a 24-byte header (magic "PIRC", version, frame count, event count and the cursor position
+ *          at Start), an 8-byte delta time and event count per frame, then the events as 32-byte InputEvent records.
+ *          Values are stored in the machine's byte order, which is little-endian on every supported platform. Keys
+ *          and buttons held down when the recording starts are not part of it.
+ */
+class InputRecording
+{
+  public:
+    /** @brief The format version written by Save and accepted by Load. */
+    static constexpr uint32_t kVersion = 1;
+
+    /**
+     * @brief Clears the recording and starts a new one at the current time.
+     * @param state The input state of the recorded window, for the starting cursor position.
+     */
+    void Start(const InputState &state)
+    {
+        frames_.clear();
+        events_.clear();
+        initial_cursor_ = state.GetCursorPosition();
+        start_timestamp_ns_ = InputEventQueue::Now();
+    }
+
+    /**
+     * @brief Appends a frame with the events the window polled for it.
+     * @param delta_time The delta time the frame is updated with, in seconds.
+     * @param window The window, right after its PollEvents.
+     */
+    void RecordFrame(float delta_time, const IWindow &window)
+    {
+        RecordedFrame frame;
+        frame.delta_time = delta_time;
+        frame.first_event = static_cast<uint32_t>(events_.size());
+        frame.event_count = window.ReadInputEvents(nullptr, 0);
+        events_.resize(events_.size() + frame.event_count);
+        window.ReadInputEvents(events_.data() + frame.first_event, frame.event_count);
+        for (uint32_t i = 0; i < frame.event_count; ++i)
+        {
+            events_[frame.first_event + i].timestamp_ns -= start_timestamp_ns_;
+        }
+        frames_.push_back(frame);
+    }
+
+    /**
+     * @brief Gets the number of recorded frames.
+     * @return The frame count.
+     */
+    uint32_t GetFrameCount() const
+    {
+        return static_cast<uint32_t>(frames_.size());
+    }
+
+    /**
+     * @brief Gets a recorded frame.
+     * @param index The frame index, less than GetFrameCount.
+     * @return The frame.
+     */
+    const RecordedFrame &GetFrame(uint32_t index) const
+    {
+        return frames_[index];
+    }
+
+    /**
+     * @brief Gets the events of a recorded frame.
+     * @param index The frame index, less than GetFrameCount.
+     * @return The frame's first event; timestamps are nanoseconds since Start.
+     */
+    const InputEvent *GetFrameEvents(uint32_t index) const
+    {
+        return events_.data() + frames_[index].first_event;
+    }
+
+    /**
+     * @brief Gets the cursor position when the recording started.
+     * @return The x and y window coordinates.
+     */
+    const std::pair<float, float> &GetInitialCursorPosition() const
+    {
+        return initial_cursor_;
+    }
+
+    /**
+     * @brief Writes the recording to a file.
+     * @param path The file path.
+     * @return True if the file was written.
+     */
+    bool Save(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+        Header header;
+        std::memcpy(header.magic, kMagic, sizeof(header.magic));
+        header.version = kVersion;
+        header.frame_count = GetFrameCount();
+        header.event_count = static_cast<uint32_t>(events_.size());
+        header.cursor_x = initial_cursor_.first;
+        header.cursor_y = initial_cursor_.second;
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (const RecordedFrame &frame : frames_)
+        {
+            FileFrame file_frame = {frame.delta_time, frame.event_count};
+            file.write(reinterpret_cast<const char *>(&file_frame), sizeof(file_frame));
+        }
+        file.write(reinterpret_cast<const char *>(events_.data()),
+                   static_cast<std::streamsize>(events_.size() * sizeof(InputEvent)));
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief Replaces the recording with one read from a file.
+     * @param path The file path.
+     * @return True if the file was read; false if it is missing, truncated or not a recording, leaving the
+     *         recording empty.
+     */
+    bool Load(const std::string &path)
+    {
+        frames_.clear();
+        events_.clear();
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        std::streamoff file_size = file ? static_cast<std::streamoff>(file.tellg()) : 0;
+        file.seekg(0);
+        Header header;
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0 || header.version != kVersion)
+        {
+            return false;
+        }
+        // Checked before allocating, so a corrupt count cannot ask for gigabytes.
+        uint64_t expected_size = sizeof(Header) + uint64_t{header.frame_count} * sizeof(FileFrame) +
+                                 uint64_t{header.event_count} * sizeof(InputEvent);
+        if (expected_size != static_cast<uint64_t>(file_size))
+        {
+            return false;
+        }
+        std::vector<FileFrame> file_frames(header.frame_count);
+        std::vector<InputEvent> events(header.event_count);
+        if (!file.read(reinterpret_cast<char *>(file_frames.data()),
+                       static_cast<std::streamsize>(file_frames.size() * sizeof(FileFrame))) ||
+            !file.read(reinterpret_cast<char *>(events.data()),
+                       static_cast<std::streamsize>(events.size() * sizeof(InputEvent))))
+        {
+            return false;
+        }
+        std::vector<RecordedFrame> frames(file_frames.size());
+        uint64_t first_event = 0;
+        for (size_t i = 0; i < file_frames.size(); ++i)
+        {
+            frames[i].delta_time = file_frames[i].delta_time;
+            frames[i].first_event = static_cast<uint32_t>(first_event);
+            frames[i].event_count = file_frames[i].event_count;
+            first_event += file_frames[i].event_count;
+        }
+        if (first_event != header.event_count)
+        {
+            return false;
+        }
+        frames_ = std::move(frames);
+        events_ = std::move(events);
+        initial_cursor_ = {header.cursor_x, header.cursor_y};
+        return true;
+    }
+
+  private:
+    static_assert(std::is_trivially_copyable<InputEvent>::value && sizeof(InputEvent) == 32,
+                  "InputEvent records are written to recordings as they are.");
+
+    /** @brief The first bytes of a recording file. */
+    static constexpr char kMagic[4] = {'P', 'I', 'R', 'C'};
+
+    /**
+     * @brief The file header.
+     */
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t frame_count;
+        uint32_t event_count;
+        float cursor_x;
+        float cursor_y;
+    };
+
+    /**
+     * @brief A frame as stored in the file; the first event follows from the counts before it.
+     */
+    struct FileFrame
+    {
+        float delta_time;
+        uint32_t event_count;
+    };
+
+    /** @brief The recorded frames. */
+    std::vector<RecordedFrame> frames_;
+    /** @brief The events of all frames, in order. */
+    std::vector<InputEvent> events_;
+    /** @brief The cursor position at Start. */
+    std::pair<float, float> initial_cursor_ = {0.0f, 0.0f};
+    /** @brief The time of Start, subtracted from recorded timestamps. */
+    int64_t start_timestamp_ns_ = 0;
+};
+
+} // namespace WAL
+} // namespace Piece
+
+#endif // PIECE_WAL_INPUT_RECORDING_H_
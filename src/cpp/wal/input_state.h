@@ -0,0 +1,291 @@
+/**
+ * @file input_state.h
+ * @brief Defines the InputState class, the per-frame keyboard and mouse state a window backend fills from events.
+ */
+#ifndef PIECE_WAL_INPUT_STATE_H_
+#define PIECE_WAL_INPUT_STATE_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "key_code.h"
+
+namespace Piece
+{
+namespace WAL
+{
+
+/**
+ * @brief A fixed-size set of input codes, one bit each.
+ * @details Lookups clamp the code into range instead of branching on it: codes outside the set, including
+ *          KeyCode::Unknown, all map to the last bit, which is never set.
+ * @tparam kCount The number of bits, a multiple of 64. The highest usable code is kCount - 2.
+ */
+template <size_t kCount> class InputBitSet
+{
+    static_assert(kCount % 64 == 0, "InputBitSet holds whole 64-bit words.");
+
+  public:
+    /**
+     * @brief Tests the bit of a code.
+     * @param code The key or button code.
+     * @return True if the bit is set; false for codes outside the set.
+     */
+    bool Test(int code) const
+    {
+        size_t index = ToIndex(code);
+        return ((words_[index >> 6] >> (index & 63)) & 1u) != 0;
+    }
+
+    /**
+     * @brief Sets or clears the bit of a code. Codes outside the set are ignored.
+     * @param code The key or button code.
+     * @param value The new value.
+     */
+    void Set(int code, bool value)
+    {
+        size_t index = ToIndex(code);
+        if (index == kCount - 1)
+        {
+            return;
+        }
+        uint64_t mask = uint64_t{1} << (index & 63);
+        words_[index >> 6] = value ? words_[index >> 6] | mask : words_[index >> 6] & ~mask;
+    }
+
+    /**
+     * @brief Clears every bit.
+     */
+    void Reset()
+    {
+        words_.fill(0);
+    }
+
+  private:
+    /**
+     * @brief Maps a code to its bit; negative and too large codes map to the unused last bit.
+     * @param code The code.
+     * @return The bit index.
+     */
+    static size_t ToIndex(int code)
+    {
+        return std::min(static_cast<size_t>(static_cast<unsigned int>(code)), kCount - 1);
+    }
+
+    /** @brief The bits, 64 per word. */
+    std::array<uint64_t, kCount / 64> words_ = {};
+};
+
+/**
+ * @brief The keyboard and mouse state of the current frame.
+ * @details The window backend feeds input events into it as they arrive during IWindow::PollEvents, after calling
+ *          BeginFrame. Queries then read bits instead of asking the platform, so they cost the same however many
+ *          bindings are polled per frame. Besides the held state it records which keys and buttons went down or up
+ *          during the frame's events, so a press and release within one frame is still seen.
+ */
+class InputState
+{
+  public:
+    /** @brief The number of key bits, enough for every KeyCode. */
+    static constexpr size_t kKeyCount = 512;
+    /** @brief The number of mouse button bits, enough for every mouse button KeyCode. */
+    static constexpr size_t kMouseButtonCount = 64;
+
+    /**
+     * @brief Starts a new frame: clears the pressed and released edges and the scroll and cursor deltas.
+     */
+    void BeginFrame()
+    {
+        keys_pressed_.Reset();
+        keys_released_.Reset();
+        buttons_pressed_.Reset();
+        buttons_released_.Reset();
+        frame_start_cursor_ = cursor_;
+        scroll_ = {0.0f, 0.0f};
+    }
+
+    /**
+     * @brief Records a key going down or up. Repeats of a held key are not new presses.
+     * @param key The key.
+     * @param down True if the key went down.
+     */
+    void SetKey(KeyCode key, bool down)
+    {
+        int code = static_cast<int>(key);
+        if (down && !keys_.Test(code))
+        {
+            keys_pressed_.Set(code, true);
+        }
+        else if (!down && keys_.Test(code))
+        {
+            keys_released_.Set(code, true);
+        }
+        keys_.Set(code, down);
+    }
+
+    /**
+     * @brief Records a mouse button going down or up.
+     * @param button The button.
+     * @param down True if the button went down.
+     */
+    void SetMouseButton(KeyCode button, bool down)
+    {
+        int code = static_cast<int>(button);
+        if (down && !buttons_.Test(code))
+        {
+            buttons_pressed_.Set(code, true);
+        }
+        else if (!down && buttons_.Test(code))
+        {
+            buttons_released_.Set(code, true);
+        }
+        buttons_.Set(code, down);
+    }
+
+    /**
+     * @brief Records the cursor position.
+     * @param x The x-coordinate in window coordinates.
+     * @param y The y-coordinate in window coordinates.
+     */
+    void SetCursorPosition(float x, float y)
+    {
+        cursor_ = {x, y};
+    }
+
+    /**
+     * @brief Moves the cursor without counting the move as motion, for the first position or a warp.
+     * @param x The x-coordinate in window coordinates.
+     * @param y The y-coordinate in window coordinates.
+     */
+    void ResetCursorPosition(float x, float y)
+    {
+        cursor_ = {x, y};
+        frame_start_cursor_ = cursor_;
+    }
+
+    /**
+     * @brief Accumulates scrolling.
+     * @param x_offset The horizontal scroll offset.
+     * @param y_offset The vertical scroll offset.
+     */
+    void AddScroll(float x_offset, float y_offset)
+    {
+        scroll_.first += x_offset;
+        scroll_.second += y_offset;
+    }
+
+    /**
+     * @brief Checks if a key is held down.
+     * @param key The key.
+     * @return True if the key is down.
+     */
+    bool IsKeyDown(KeyCode key) const
+    {
+        return keys_.Test(static_cast<int>(key));
+    }
+
+    /**
+     * @brief Checks if a key went down during this frame's events.
+     * @param key The key.
+     * @return True if the key was pressed this frame, even if it was released again.
+     */
+    bool WasKeyPressed(KeyCode key) const
+    {
+        return keys_pressed_.Test(static_cast<int>(key));
+    }
+
+    /**
+     * @brief Checks if a key went up during this frame's events.
+     * @param key The key.
+     * @return True if the key was released this frame.
+     */
+    bool WasKeyReleased(KeyCode key) const
+    {
+        return keys_released_.Test(static_cast<int>(key));
+    }
+
+    /**
+     * @brief Checks if a mouse button is held down.
+     * @param button The button.
+     * @return True if the button is down.
+     */
+    bool IsMouseButtonDown(KeyCode button) const
+    {
+        return buttons_.Test(static_cast<int>(button));
+    }
+
+    /**
+     * @brief Checks if a mouse button went down during this frame's events.
+     * @param button The button.
+     * @return True if the button was pressed this frame.
+     */
+    bool WasMouseButtonPressed(KeyCode button) const
+    {
+        return buttons_pressed_.Test(static_cast<int>(button));
+    }
+
+    /**
+     * @brief Checks if a mouse button went up during this frame's events.
+     * @param button The button.
+     * @return True if the button was released this frame.
+     */
+    bool WasMouseButtonReleased(KeyCode button) const
+    {
+        return buttons_released_.Test(static_cast<int>(button));
+    }
+
+    /**
+     * @brief Gets the cursor position.
+     * @return The x and y window coordinates.
+     */
+    const std::pair<float, float> &GetCursorPosition() const
+    {
+        return cursor_;
+    }
+
+    /**
+     * @brief Gets how far the cursor moved during this frame's events.
+     * @return The x and y movement.
+     */
+    std::pair<float, float> GetCursorDelta() const
+    {
+        return {cursor_.first - frame_start_cursor_.first, cursor_.second - frame_start_cursor_.second};
+    }
+
+    /**
+     * @brief Gets the scrolling of this frame's events.
+     * @return The summed x and y scroll offsets.
+     */
+    const std::pair<float, float> &GetScrollDelta() const
+    {
+        return scroll_;
+    }
+
+  private:
+    /** @brief Keys held down. */
+    InputBitSet<kKeyCount> keys_;
+    /** @brief Keys that went down this frame. */
+    InputBitSet<kKeyCount> keys_pressed_;
+    /** @brief Keys that went up this frame. */
+    InputBitSet<kKeyCount> keys_released_;
+    /** @brief Mouse buttons held down. */
+    InputBitSet<kMouseButtonCount> buttons_;
+    /** @brief Mouse buttons that went down this frame. */
+    InputBitSet<kMouseButtonCount> buttons_pressed_;
+    /** @brief Mouse buttons that went up this frame. */
+    InputBitSet<kMouseButtonCount> buttons_released_;
+    /** @brief The cursor position. */
+    std::pair<float, float> cursor_ = {0.0f, 0.0f};
+    /** @brief The cursor position at BeginFrame. */
+    std::pair<float, float> frame_start_cursor_ = {0.0f, 0.0f};
+    /** @brief The scrolling since BeginFrame. */
+    std::pair<float, float> scroll_ = {0.0f, 0.0f};
+};
+
+} // namespace WAL
+} // namespace Piece
+
+#endif // PIECE_WAL_INPUT_STATE_H_
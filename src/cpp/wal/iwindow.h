@@ -1,159 +1,32 @@
 /**
  * @file iwindow.h
- * @brief Defines the IWindow interface and KeyCode enum for windowing and input handling.
+ * @brief Defines the IWindow interface for windowing and input handling.
  */
 #ifndef PIECE_WAL_IWINDOW_H_
 #define PIECE_WAL_IWINDOW_H_
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <utility>
 
+#include "frame_pacer.h"
+#include "input_event_queue.h"
+#include "input_state.h"
+#include "key_code.h"
+
 namespace Piece
 {
 namespace WAL
 {
 
 /**
- * @brief Represents key and mouse button codes.
+ * @brief Window changes reported to the notification callback.
  */
-enum class KeyCode : int
+enum class WindowNotification : uint32_t
 {
-    Unknown = -1,
-
-    // Printable keys
-    kSpace = 32,
-    kApostrophe = 39, /* ' */
-    kComma = 44,      /* , */
-    kMinus = 45,      /* - */
-    kPeriod = 46,     /* . */
-    kSlash = 47,      /* / */
-    k0 = 48,
-    k1 = 49,
-    k2 = 50,
-    k3 = 51,
-    k4 = 52,
-    k5 = 53,
-    k6 = 54,
-    k7 = 55,
-    k8 = 56,
-    k9 = 57,
-    kSemicolon = 59, /* ; */
-    kEqual = 61,     /* = */
-    kA = 65,
-    kB = 66,
-    kC = 67,
-    kD = 68,
-    kE = 69,
-    kF = 70,
-    kG = 71,
-    kH = 72,
-    kI = 73,
-    kJ = 74,
-    kK = 75,
-    kL = 76,
-    kM = 77,
-    kN = 78,
-    kO = 79,
-    kP = 80,
-    kQ = 81,
-    kR = 82,
-    kS = 83,
-    kT = 84,
-    kU = 85,
-    kV = 86,
-    kW = 87,
-    kX = 88,
-    kY = 89,
-    kZ = 90,
-    kLeftBracket = 91,  /* [ */
-    kBackslash = 92,    /* \ */
-    kRightBracket = 93, /* ] */
-    kGraveAccent = 96,  /* ` */
-    kWorld1 = 161,      /* non-US #1 */
-    kWorld2 = 162,      /* non-US #2 */
-
-    // Function keys
-    kEscape = 256,
-    kEnter = 257,
-    kTab = 258,
-    kBackspace = 259,
-    kInsert = 260,
-    kDelete = 261,
-    kRight = 262,
-    kLeft = 263,
-    kDown = 264,
-    kUp = 265,
-    kPageUp = 266,
-    kPageDown = 267,
-    kHome = 268,
-    kEnd = 269,
-    kCapsLock = 280,
-    kScrollLock = 281,
-    kNumLock = 282,
-    kPrintScreen = 283,
-    kPause = 284,
-    kF1 = 290,
-    kF2 = 291,
-    kF3 = 292,
-    kF4 = 293,
-    kF5 = 294,
-    kF6 = 295,
-    kF7 = 296,
-    kF8 = 297,
-    kF9 = 298,
-    kF10 = 299,
-    kF11 = 300,
-    kF12 = 301,
-    kF13 = 302,
-    kF14 = 303,
-    kF15 = 304,
-    kF16 = 305,
-    kF17 = 306,
-    kF18 = 307,
-    kF19 = 308,
-    kF20 = 309,
-    kF21 = 310,
-    kF22 = 311,
-    kF23 = 312,
-    kF24 = 313,
-    kF25 = 314,
-    kKp0 = 320,
-    kKp1 = 321,
-    kKp2 = 322,
-    kKp3 = 323,
-    kKp4 = 324,
-    kKp5 = 325,
-    kKp6 = 326,
-    kKp7 = 327,
-    kKp8 = 328,
-    kKp9 = 329,
-    kKpDecimal = 330,
-    kKpDivide = 331,
-    kKpMultiply = 332,
-    kKpSubtract = 333,
-    kKpAdd = 334,
-    kKpEnter = 335,
-    kKpEqual = 336,
-    kLeftShift = 340,
-    kLeftControl = 341,
-    kLeftAlt = 342,
-    kLeftSuper = 343,
-    kRightShift = 344,
-    kRightControl = 345,
-    kRightAlt = 346,
-    kRightSuper = 347,
-    kMenu = 348,
-
-    // Mouse buttons
-    kMouse1 = 0,
-    kMouse2 = 1,
-    kMouse3 = 2,
-    kMouse4 = 3,
-    kMouse5 = 4,
-    kMouse6 = 5,
-    kMouse7 = 6,
-    kMouse8 = 7,
-    kLastMouseButton = kMouse8
+    Resized = 0,       /**< The framebuffer size changed; GetFramebufferSize returns the new size. */
+    CloseRequested = 1 /**< The user asked to close the window; ShouldClose now returns true. */
 };
 
 /**
@@ -179,6 +52,8 @@ class IWindow
 
     /**
      * @brief Polls for window events, such as input or close requests.
+     *        Starts a new input frame: the input queries reflect the events polled here until the next call.
+     *        Backends whose windows share one event queue poll and start the input frames of all of them.
      */
     virtual void PollEvents() = 0;
     /**
@@ -186,10 +61,38 @@ class IWindow
      */
     virtual void SwapBuffers() = 0;
     /**
-     * @brief Checks if the window should close.
+     * @brief Sets how frames are presented and paced.
+     *        With a frame rate cap or low latency, PollEvents waits until the frame should start before polling. Call
+     *        it on the event thread; a new swap interval takes effect at the next SwapBuffers on the context's thread.
+     * @param options The presentation settings.
+     */
+    virtual void SetPresentOptions(const PresentOptions &options) = 0;
+    /**
+     * @brief Checks if the window should close. Safe to call from any thread.
      * @return True if the window should close, false otherwise.
      */
     virtual bool ShouldClose() const = 0;
+    /**
+     * @brief Gets the size of the window's framebuffer in pixels. Safe to call from any thread.
+     * @return The width and height.
+     */
+    virtual std::pair<int, int> GetFramebufferSize() const = 0;
+    /**
+     * @brief Binds the window's graphics context to the calling thread, or releases it from the calling thread.
+     *        A context is current on at most one thread: release it before binding it on another. SwapBuffers must
+     *        be called on the thread the context is current on, while PollEvents stays on the thread that created
+     *        the window.
+     * @param current True to bind the context, false to release it.
+     */
+    virtual void SetContextCurrent(bool current) = 0;
+    /**
+     * @brief Sets the function told about resizes and close requests.
+     *        It is called during PollEvents on the event thread, also while the OS holds that thread in a modal loop
+     *        such as a window drag, so a render thread can react without waiting for the loop to end. Keep it short
+     *        and thread-safe. Set it from the event thread.
+     * @param callback The function, or an empty function to stop notifications.
+     */
+    virtual void SetNotificationCallback(std::function<void(WindowNotification)> callback) = 0;
     /**
      * @brief Gets a pointer to the native, underlying window handle.
      * @return A void pointer to the native window handle.
@@ -223,6 +126,43 @@ class IWindow
      * @return The y-coordinate of the mouse.
      */
     virtual float GetMouseY() const = 0;
+    /**
+     * @brief Checks if a key went down during the last PollEvents.
+     * @param keycode The key to check.
+     * @return True if the key was pressed this frame, even if it was released again.
+     */
+    virtual bool WasKeyPressedThisFrame(KeyCode keycode) const = 0;
+    /**
+     * @brief Checks if a key went up during the last PollEvents.
+     * @param keycode The key to check.
+     * @return True if the key was released this frame.
+     */
+    virtual bool WasKeyReleasedThisFrame(KeyCode keycode) const = 0;
+    /**
+     * @brief Checks if a mouse button went down during the last PollEvents.
+     * @param button The mouse button to check.
+     * @return True if the button was pressed this frame.
+     */
+    virtual bool WasMouseButtonPressedThisFrame(KeyCode button) const = 0;
+    /**
+     * @brief Checks if a mouse button went up during the last PollEvents.
+     * @param button The mouse button to check.
+     * @return True if the button was released this frame.
+     */
+    virtual bool WasMouseButtonReleasedThisFrame(KeyCode button) const = 0;
+    /**
+     * @brief Gets the whole input state of the current frame.
+     *        Code polling many bindings per frame can query it directly rather than through a virtual call each.
+     * @return The input state, valid for the lifetime of the window.
+     */
+    virtual const InputState &GetInputState() const = 0;
+    /**
+     * @brief Copies the input events received during the last PollEvents, in the order they arrived.
+     * @param events The destination, or nullptr to only get the count.
+     * @param capacity The number of events the destination holds.
+     * @return The number of events in the frame; only the first capacity of them were copied if it is larger.
+     */
+    virtual uint32_t ReadInputEvents(InputEvent *events, uint32_t capacity) const = 0;
 };
 
 } // namespace WAL
@@ -0,0 +1,273 @@
+/**
+ * @file replay_window.h
+ * @brief Defines the ReplayWindow class, an IWindow wrapper that replaces a window's input with a recording.
+ */
+#ifndef PIECE_WAL_REPLAY_WINDOW_H_
+#define PIECE_WAL_REPLAY_WINDOW_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "input_recording.h"
+#include "iwindow.h"
+
+namespace Piece
+{
+namespace WAL
+{
+
+/**
+ * @brief Feeds a recording back frame by frame in place of a window's input.
+ * @details Each PollEvents still polls the wrapped window, so it keeps pacing frames and stays responsive, but the
+ *          input queries and events then report the next recorded frame instead of the live input. The events are
+ *          restamped to keep their recorded spacing from the start of the replay. GetFrameDeltaTime gives the delta
+ *          time the frame was recorded with, so a session fed with it runs the same updates as the recorded one.
+ *          Once the last frame was polled, ShouldClose returns true, which ends a benchmark loop. Presentation,
+ *          contexts and notifications are the wrapped window's.
+ */
+class ReplayWindow : public IWindow
+{
+  public:
+    /**
+     * @brief Wraps a window.
+     * @param window The window rendered to and polled; owned by the wrapper.
+     * @param recording The recording to play.
+     */
+    ReplayWindow(std::unique_ptr<IWindow> window, InputRecording recording) : window_(std::move(window))
+    {
+        SetRecording(std::move(recording));
+    }
+
+    /**
+     * @brief Restarts the replay with another recording.
+     * @param recording The recording to play.
+     */
+    void SetRecording(InputRecording recording)
+    {
+        recording_ = std::move(recording);
+        next_frame_ = 0;
+        delta_time_ = 0.0f;
+        start_timestamp_ns_ = 0;
+        input_ = InputState();
+        input_events_.BeginFrame();
+        input_.ResetCursorPosition(recording_.GetInitialCursorPosition().first,
+                                   recording_.GetInitialCursorPosition().second);
+    }
+
+    /**
+     * @brief Gets the delta time of the frame the last PollEvents replayed.
+     * @return The recorded delta time in seconds, or 0 before the first frame and past the last.
+     */
+    float GetFrameDeltaTime() const
+    {
+        return delta_time_;
+    }
+
+    /**
+     * @brief Gets the number of frames replayed so far.
+     * @return The frame count.
+     */
+    uint32_t GetReplayedFrameCount() const
+    {
+        return next_frame_;
+    }
+
+    /**
+     * @brief Checks if every recorded frame was replayed.
+     * @return True once the last frame was polled.
+     */
+    bool IsFinished() const
+    {
+        return next_frame_ >= recording_.GetFrameCount();
+    }
+
+    /**
+     * @brief Gets the wrapped window.
+     * @return The window.
+     */
+    IWindow &GetWindow()
+    {
+        return *window_;
+    }
+
+    // IWindow interface: presentation, contexts and notifications go to the wrapped window.
+    bool Init(int width, int height, const std::string &title) override
+    {
+        return window_->Init(width, height, title);
+    }
+
+    /**
+     * @brief Polls the wrapped window, then replaces its input with the next recorded frame.
+     */
+    void PollEvents() override
+    {
+        window_->PollEvents();
+        input_.BeginFrame();
+        input_events_.BeginFrame();
+        if (IsFinished())
+        {
+            delta_time_ = 0.0f;
+            return;
+        }
+        if (next_frame_ == 0)
+        {
+            start_timestamp_ns_ = InputEventQueue::Now();
+        }
+        const RecordedFrame &frame = recording_.GetFrame(next_frame_);
+        const InputEvent *events = recording_.GetFrameEvents(next_frame_);
+        for (uint32_t i = 0; i < frame.event_count; ++i)
+        {
+            InputEvent event = events[i];
+            event.timestamp_ns += start_timestamp_ns_;
+            Apply(event);
+            input_events_.Push(event);
+        }
+        delta_time_ = frame.delta_time;
+        ++next_frame_;
+    }
+
+    void SwapBuffers() override
+    {
+        window_->SwapBuffers();
+    }
+
+    void SetPresentOptions(const PresentOptions &options) override
+    {
+        window_->SetPresentOptions(options);
+    }
+
+    /**
+     * @brief Checks if the wrapped window should close or the replay is over.
+     * @return True if the window should close or every recorded frame was polled.
+     */
+    bool ShouldClose() const override
+    {
+        return IsFinished() || window_->ShouldClose();
+    }
+
+    std::pair<int, int> GetFramebufferSize() const override
+    {
+        return window_->GetFramebufferSize();
+    }
+
+    void SetContextCurrent(bool current) override
+    {
+        window_->SetContextCurrent(current);
+    }
+
+    void SetNotificationCallback(std::function<void(WindowNotification)> callback) override
+    {
+        window_->SetNotificationCallback(std::move(callback));
+    }
+
+    void *GetNativeWindow() const override
+    {
+        return window_->GetNativeWindow();
+    }
+
+    // Input Methods, answered from the replayed frame.
+    bool IsKeyPressed(KeyCode keycode) const override
+    {
+        return input_.IsKeyDown(keycode);
+    }
+
+    bool IsMouseButtonPressed(KeyCode button) const override
+    {
+        return input_.IsMouseButtonDown(button);
+    }
+
+    std::pair<float, float> GetMousePosition() const override
+    {
+        return input_.GetCursorPosition();
+    }
+
+    float GetMouseX() const override
+    {
+        return input_.GetCursorPosition().first;
+    }
+
+    float GetMouseY() const override
+    {
+        return input_.GetCursorPosition().second;
+    }
+
+    bool WasKeyPressedThisFrame(KeyCode keycode) const override
+    {
+        return input_.WasKeyPressed(keycode);
+    }
+
+    bool WasKeyReleasedThisFrame(KeyCode keycode) const override
+    {
+        return input_.WasKeyReleased(keycode);
+    }
+
+    bool WasMouseButtonPressedThisFrame(KeyCode button) const override
+    {
+        return input_.WasMouseButtonPressed(button);
+    }
+
+    bool WasMouseButtonReleasedThisFrame(KeyCode button) const override
+    {
+        return input_.WasMouseButtonReleased(button);
+    }
+
+    const InputState &GetInputState() const override
+    {
+        return input_;
+    }
+
+    uint32_t ReadInputEvents(InputEvent *events, uint32_t capacity) const override
+    {
+        return input_events_.Copy(events, capacity);
+    }
+
+  private:
+    /**
+     * @brief Updates the input state with a recorded event, as the window backend did when it arrived.
+     * @param event The event.
+     */
+    void Apply(const InputEvent &event)
+    {
+        switch (event.type)
+        {
+        case InputEventType::Key:
+            input_.SetKey(static_cast<KeyCode>(event.code), event.action != InputAction::Release);
+            break;
+        case InputEventType::MouseButton:
+            input_.SetMouseButton(static_cast<KeyCode>(event.code), event.action != InputAction::Release);
+            break;
+        case InputEventType::CursorMove:
+            input_.SetCursorPosition(event.x, event.y);
+            break;
+        case InputEventType::Scroll:
+            input_.AddScroll(event.x, event.y);
+            break;
+        case InputEventType::Text:
+        default:
+            break;
+        }
+    }
+
+    /** @brief The wrapped window. */
+    std::unique_ptr<IWindow> window_;
+    /** @brief The recording being played. */
+    InputRecording recording_;
+    /** @brief The index of the next frame to replay. */
+    uint32_t next_frame_ = 0;
+    /** @brief The delta time of the frame last replayed. */
+    float delta_time_ = 0.0f;
+    /** @brief The time the first frame was replayed, added to the recorded timestamps. */
+    int64_t start_timestamp_ns_ = 0;
+    /** @brief The input state rebuilt from the recorded events. */
+    InputState input_;
+    /** @brief The recorded events of the current frame. */
+    InputEventQueue input_events_;
+};
+
+} // namespace WAL
+} // namespace Piece
+
+#endif // PIECE_WAL_REPLAY_WINDOW_H_
@@ -0,0 +1,85 @@
+using System.Numerics;
+
+namespace Piece.Core;
+
+/// <summary>
+/// Enqueues commands for the native core by writing them into native memory; the next <see cref="Engine.Update"/>
+/// executes everything enqueued before it in one pass. Enqueue from one thread at a time.
+/// </summary>
+public sealed unsafe class CommandRing
+{
+    private readonly NativeCalls.NativeCommandRing* _native;
+
+    internal CommandRing(IntPtr native)
+    {
+        _native = (NativeCalls.NativeCommandRing*)native;
+    }
+
+    public int Capacity => (int)_native->Capacity;
+
+    // Commands enqueued and not executed yet.
+    public int Count => (int)(Volatile.Read(ref *_native->WriteIndex) - Volatile.Read(ref *_native->ReadIndex));
+
+    // Returns false if the ring is full until the next update; size it for a frame's worth of commands.
+    public bool TryEnqueue(in NativeCalls.NativeCommand command)
+    {
+        ulong write = *_native->WriteIndex;
+        if (write - Volatile.Read(ref *_native->ReadIndex) >= _native->Capacity)
+        {
+            return false;
+        }
+        _native->Commands[write & (_native->Capacity - 1)] = command;
+        // Release: native code sees the record once it sees the new index.
+        Volatile.Write(ref *_native->WriteIndex, write + 1);
+        return true;
+    }
+
+    public bool TrySpawn(int entity, Vector3 position, Quaternion rotation, Vector3 scale)
+    {
+        return TryEnqueue(MakeTransformCommand(NativeCalls.CommandType.Spawn, entity, position, rotation, scale));
+    }
+
+    public bool TryDestroy(int entity)
+    {
+        NativeCalls.NativeCommand command = default;
+        command.Type = NativeCalls.CommandType.Destroy;
+        command.Entity = (uint)entity;
+        return TryEnqueue(command);
+    }
+
+    public bool TrySetTransform(int entity, Vector3 position, Quaternion rotation, Vector3 scale)
+    {
+        var command = MakeTransformCommand(NativeCalls.CommandType.SetTransform, entity, position, rotation, scale);
+        return TryEnqueue(command);
+    }
+
+    public bool TryApplyImpulse(uint bodyId, Vector3 impulse)
+    {
+        NativeCalls.NativeCommand command = default;
+        command.Type = NativeCalls.CommandType.ApplyImpulse;
+        command.Target = bodyId;
+        command.Values[0] = impulse.X;
+        command.Values[1] = impulse.Y;
+        command.Values[2] = impulse.Z;
+        return TryEnqueue(command);
+    }
+
+    private static NativeCalls.NativeCommand MakeTransformCommand(NativeCalls.CommandType type, int entity,
+                                                                  Vector3 position, Quaternion rotation, Vector3 scale)
+    {
+        NativeCalls.NativeCommand command = default;
+        command.Type = type;
+        command.Entity = (uint)entity;
+        command.Values[0] = position.X;
+        command.Values[1] = position.Y;
+        command.Values[2] = position.Z;
+        command.Values[3] = rotation.X;
+        command.Values[4] = rotation.Y;
+        command.Values[5] = rotation.Z;
+        command.Values[6] = rotation.W;
+        command.Values[7] = scale.X;
+        command.Values[8] = scale.Y;
+        command.Values[9] = scale.Z;
+        return command;
+    }
+}
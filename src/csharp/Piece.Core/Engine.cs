@@ -60,6 +60,369 @@ public class Engine : IDisposable
         }
     }
 
+    public int GetBodyCount()
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero ? (int)NativeCalls.Engine_GetBodyCount(_nativeEngineCorePtr) : 0;
+    }
+
+    // Bodies the physics world currently simulates; resting bodies sleep and are not counted.
+    public int GetAwakeBodyCount()
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero ? (int)NativeCalls.Engine_GetAwakeBodyCount(_nativeEngineCorePtr) : 0;
+    }
+
+    // Copies body states into the given arrays in one native call. Spans may be empty to skip an attribute;
+    // positions and velocities take 3 floats per body, rotations 4.
+    public unsafe int ReadBodyStates(Span<uint> ids, Span<float> positions, Span<float> rotations,
+                                     Span<float> linearVelocities, Span<float> angularVelocities, bool movedOnly)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return 0;
+        }
+        int capacity = GetStateCapacity(ids.Length, positions.Length, rotations.Length, linearVelocities.Length, angularVelocities.Length);
+        fixed (uint* idsPtr = ids)
+        fixed (float* positionsPtr = positions, rotationsPtr = rotations)
+        fixed (float* linearPtr = linearVelocities, angularPtr = angularVelocities)
+        {
+            var states = new NativeCalls.NativeBodyStateArrays
+            {
+                Ids = (IntPtr)idsPtr,
+                Positions = (IntPtr)positionsPtr,
+                Rotations = (IntPtr)rotationsPtr,
+                LinearVelocities = (IntPtr)linearPtr,
+                AngularVelocities = (IntPtr)angularPtr,
+            };
+            return (int)NativeCalls.Engine_ReadBodyStates(_nativeEngineCorePtr, states, (uint)capacity, movedOnly ? 1u : 0u);
+        }
+    }
+
+    // Sets body states from the given arrays in one native call. Empty spans leave that attribute unchanged.
+    public unsafe void WriteBodyStates(ReadOnlySpan<uint> ids, ReadOnlySpan<float> positions, ReadOnlySpan<float> rotations,
+                                       ReadOnlySpan<float> linearVelocities, ReadOnlySpan<float> angularVelocities)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return;
+        }
+        int count = GetStateCapacity(ids.Length, positions.Length, rotations.Length, linearVelocities.Length, angularVelocities.Length);
+        fixed (uint* idsPtr = ids)
+        fixed (float* positionsPtr = positions, rotationsPtr = rotations)
+        fixed (float* linearPtr = linearVelocities, angularPtr = angularVelocities)
+        {
+            var states = new NativeCalls.NativeBodyStateArrays
+            {
+                Ids = (IntPtr)idsPtr,
+                Positions = (IntPtr)positionsPtr,
+                Rotations = (IntPtr)rotationsPtr,
+                LinearVelocities = (IntPtr)linearPtr,
+                AngularVelocities = (IntPtr)angularPtr,
+            };
+            NativeCalls.Engine_WriteBodyStates(_nativeEngineCorePtr, states, (uint)count);
+        }
+    }
+
+    // Saves the whole physics state into the buffer and returns the snapshot size. If the size exceeds the buffer,
+    // nothing usable was written; call with an empty span to only get the size.
+    public unsafe long SavePhysicsSnapshot(Span<byte> buffer)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return 0;
+        }
+        fixed (byte* bufferPtr = buffer)
+        {
+            return (long)NativeCalls.Engine_SavePhysicsSnapshot(_nativeEngineCorePtr, (IntPtr)bufferPtr, (ulong)buffer.Length);
+        }
+    }
+
+    // Restores a state saved by SavePhysicsSnapshot. Fails if bodies were created or destroyed since.
+    public unsafe bool RestorePhysicsSnapshot(ReadOnlySpan<byte> snapshot)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return false;
+        }
+        fixed (byte* snapshotPtr = snapshot)
+        {
+            return NativeCalls.Engine_RestorePhysicsSnapshot(_nativeEngineCorePtr, (IntPtr)snapshotPtr, (ulong)snapshot.Length) != 0;
+        }
+    }
+
+    // Steps physics on its own thread at the fixed physics rate instead of in Update.
+    public void SetPhysicsThreadEnabled(bool enabled)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr != IntPtr.Zero)
+        {
+            NativeCalls.Engine_SetPhysicsThreadEnabled(_nativeEngineCorePtr, enabled ? 1u : 0u);
+        }
+    }
+
+    // Copies the transforms last published by the physics thread, interpolated for rendering now, without waiting
+    // for the step in progress. Positions take 3 floats per body, rotations 4; empty spans are skipped.
+    public unsafe int ReadInterpolatedBodyStates(Span<uint> ids, Span<float> positions, Span<float> rotations)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return 0;
+        }
+        int capacity = GetStateCapacity(ids.Length, positions.Length, rotations.Length, 0, 0);
+        fixed (uint* idsPtr = ids)
+        fixed (float* positionsPtr = positions, rotationsPtr = rotations)
+        {
+            var states = new NativeCalls.NativeBodyStateArrays
+            {
+                Ids = (IntPtr)idsPtr,
+                Positions = (IntPtr)positionsPtr,
+                Rotations = (IntPtr)rotationsPtr,
+            };
+            return (int)NativeCalls.Engine_ReadInterpolatedBodyStates(_nativeEngineCorePtr, states, (uint)capacity);
+        }
+    }
+
+    // Makes physics steps give identical results for any number of worker threads, for lockstep and replays.
+    public void SetPhysicsDeterministic(bool enabled)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr != IntPtr.Zero)
+        {
+            NativeCalls.Engine_SetPhysicsDeterministic(_nativeEngineCorePtr, enabled ? 1u : 0u);
+        }
+    }
+
+    // Hash of the physics state chained over every fixed step; compare it across peers to detect desyncs.
+    public ulong GetPhysicsStateHash()
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero ? NativeCalls.Engine_GetPhysicsStateHash(_nativeEngineCorePtr) : 0;
+    }
+
+    // Copies the input events polled by the last Update in arrival order and returns how many the frame had. If that
+    // exceeds the span, only the first events were copied; call with an empty span to only get the count.
+    public unsafe int ReadInputEvents(Span<NativeCalls.NativeInputEvent> events)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return 0;
+        }
+        fixed (NativeCalls.NativeInputEvent* eventsPtr = events)
+        {
+            return (int)NativeCalls.Engine_ReadInputEvents(_nativeEngineCorePtr, (IntPtr)eventsPtr, (uint)events.Length);
+        }
+    }
+
+    // Renders on a dedicated thread that owns the graphics context, so window drags and resizes no longer stall
+    // rendering. Update still pumps the window events and must stay on the thread that calls this.
+    public void SetRenderThreadEnabled(bool enabled)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr != IntPtr.Zero)
+        {
+            NativeCalls.Engine_SetRenderThreadEnabled(_nativeEngineCorePtr, enabled ? 1u : 0u);
+        }
+    }
+
+    // Opens another window, or an offscreen target when offscreen is set, drawn by every Render with the same device
+    // and resources as the main window. Returns the viewport id, or 0 on failure.
+    public uint CreateViewport(int width, int height, string? title = null, bool offscreen = false)
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero
+            ? NativeCalls.Engine_CreateViewport(_nativeEngineCorePtr, width, height, title, offscreen ? 1u : 0u)
+            : 0;
+    }
+
+    public void DestroyViewport(uint viewportId)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr != IntPtr.Zero)
+        {
+            NativeCalls.Engine_DestroyViewport(_nativeEngineCorePtr, viewportId);
+        }
+    }
+
+    // Resizes an offscreen viewport, e.g. when its editor panel changes size. Window viewports follow their window.
+    public bool ResizeViewport(uint viewportId, int width, int height)
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero &&
+               NativeCalls.Engine_ResizeViewport(_nativeEngineCorePtr, viewportId, width, height) != 0;
+    }
+
+    // Texture holding an offscreen viewport's image, for display in a UI panel; 0 until it was first rendered.
+    public uint GetViewportColorTexture(uint viewportId)
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero ? NativeCalls.Engine_GetViewportColorTexture(_nativeEngineCorePtr, viewportId) : 0;
+    }
+
+    public bool ViewportShouldClose(uint viewportId)
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero && NativeCalls.Engine_ViewportShouldClose(_nativeEngineCorePtr, viewportId) != 0;
+    }
+
+    // Like ReadInputEvents, for the events of a window viewport.
+    public unsafe int ReadViewportInputEvents(uint viewportId, Span<NativeCalls.NativeInputEvent> events)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return 0;
+        }
+        fixed (NativeCalls.NativeInputEvent* eventsPtr = events)
+        {
+            return (int)NativeCalls.Engine_ReadViewportInputEvents(_nativeEngineCorePtr, viewportId, (IntPtr)eventsPtr, (uint)events.Length);
+        }
+    }
+
+    // Sets the present mode; maxFrameRate only applies to Capped. With lowLatency, Update waits until just before the
+    // predicted present to poll input, so frames show fresher input at the same frame rate.
+    public void SetPresentOptions(NativeCalls.PresentMode mode, float maxFrameRate = 0.0f, bool lowLatency = false)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr != IntPtr.Zero)
+        {
+            NativeCalls.Engine_SetPresentOptions(_nativeEngineCorePtr, mode, maxFrameRate, lowLatency ? 1u : 0u);
+        }
+    }
+
+    // True once the main window was asked to close, or an input replay played its last frame.
+    public bool ShouldClose()
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr == IntPtr.Zero || NativeCalls.Engine_ShouldClose(_nativeEngineCorePtr) != 0;
+    }
+
+    // Records the input events and delta time of every following Update until StopInputRecording.
+    public bool StartInputRecording()
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero && NativeCalls.Engine_StartInputRecording(_nativeEngineCorePtr) != 0;
+    }
+
+    // Writes the recording to path, or discards it when path is null.
+    public bool StopInputRecording(string? path)
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero && NativeCalls.Engine_StopInputRecording(_nativeEngineCorePtr, path) != 0;
+    }
+
+    // Replays a recording instead of live input, one recorded frame per Update. Advance gameplay by
+    // GetFrameDeltaTime() rather than the measured time to repeat the recorded session exactly.
+    public bool StartInputReplay(string path)
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero && NativeCalls.Engine_StartInputReplay(_nativeEngineCorePtr, path) != 0;
+    }
+
+    // The delta time the last Update ran with; the recorded one during a replay.
+    public float GetFrameDeltaTime()
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero ? NativeCalls.Engine_GetFrameDeltaTime(_nativeEngineCorePtr) : 0.0f;
+    }
+
+    // Allocates the entity transform arrays shared with native code in place, replacing the previous ones, whose
+    // TransformArrays must no longer be used. A capacity of 0 frees them and returns null.
+    public TransformArrays? CreateTransformArrays(int capacity)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return null;
+        }
+        IntPtr arrays = NativeCalls.Engine_CreateTransformArrays(_nativeEngineCorePtr, (uint)Math.Max(capacity, 0));
+        return arrays != IntPtr.Zero ? new TransformArrays(arrays) : null;
+    }
+
+    // Allocates the ring commands are enqueued into without a native call each; every Update executes them in one
+    // pass. Replaces the previous ring, whose CommandRing must no longer be used. A capacity of 0 frees it.
+    public CommandRing? CreateCommandRing(int capacity)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return null;
+        }
+        IntPtr ring = NativeCalls.Engine_CreateCommandRing(_nativeEngineCorePtr, (uint)Math.Max(capacity, 0));
+        return ring != IntPtr.Zero ? new CommandRing(ring) : null;
+    }
+
+    // Time from the main window's input events to the present of the frame that consumed them, over the most recent
+    // events. Compare before and after a pacing change.
+    public NativeCalls.NativeLatencyStats GetInputLatencyStats()
+    {
+        ThrowIfDisposed();
+        NativeCalls.NativeLatencyStats stats = default;
+        if (_nativeEngineCorePtr != IntPtr.Zero)
+        {
+            NativeCalls.Engine_GetInputLatencyStats(_nativeEngineCorePtr, out stats);
+        }
+        return stats;
+    }
+
+    public void ResetInputLatencyStats()
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr != IntPtr.Zero)
+        {
+            NativeCalls.Engine_ResetInputLatencyStats(_nativeEngineCorePtr);
+        }
+    }
+
+    // Buffers up to capacity contact events between reads; 0 turns reporting off. Persist events are opt-in since
+    // every touching pair reports one each fixed step.
+    public void ConfigureContactEvents(int capacity, bool reportPersist)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr != IntPtr.Zero)
+        {
+            NativeCalls.Engine_ConfigureContactEvents(_nativeEngineCorePtr, (uint)Math.Max(capacity, 0), reportPersist ? 1u : 0u);
+        }
+    }
+
+    // Moves the oldest buffered contact events into the span and returns how many; call again while it fills the span.
+    public unsafe int ReadContactEvents(Span<NativeCalls.NativeContactEvent> events)
+    {
+        ThrowIfDisposed();
+        if (_nativeEngineCorePtr == IntPtr.Zero)
+        {
+            return 0;
+        }
+        fixed (NativeCalls.NativeContactEvent* eventsPtr = events)
+        {
+            return (int)NativeCalls.Engine_ReadContactEvents(_nativeEngineCorePtr, (IntPtr)eventsPtr, (uint)events.Length);
+        }
+    }
+
+    // Contact events lost because the buffer was full; a growing count means it should be larger or read more often.
+    public ulong GetDroppedContactEventCount()
+    {
+        ThrowIfDisposed();
+        return _nativeEngineCorePtr != IntPtr.Zero ? NativeCalls.Engine_GetDroppedContactEventCount(_nativeEngineCorePtr) : 0;
+    }
+
+    // Number of bodies every non-empty span can hold. Fixing an empty span yields a null pointer, which skips it natively.
+    private static int GetStateCapacity(int ids, int positions, int rotations, int linearVelocities, int angularVelocities)
+    {
+        int capacity = ids;
+        if (positions > 0) capacity = Math.Min(capacity, positions / 3);
+        if (rotations > 0) capacity = Math.Min(capacity, rotations / 4);
+        if (linearVelocities > 0) capacity = Math.Min(capacity, linearVelocities / 3);
+        if (angularVelocities > 0) capacity = Math.Min(capacity, angularVelocities / 3);
+        return capacity;
+    }
+
     protected virtual void Dispose(bool disposing)
     {
         if (!_disposed)
@@ -78,4 +78,249 @@ public static partial class NativeCalls
     [LibraryImport("piece_core.dll", EntryPoint = "Engine_Render")] // Added
     [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
     public static partial void Engine_Render(IntPtr engineCorePtr); // Added
+
+    // Bulk physics body state
+    [StructLayout(LayoutKind.Sequential)]
+    public struct NativeBodyStateArrays
+    {
+        public IntPtr Ids;               // uint per body
+        public IntPtr Positions;         // 3 floats per body
+        public IntPtr Rotations;         // 4 floats (x, y, z, w) per body
+        public IntPtr LinearVelocities;  // 3 floats per body
+        public IntPtr AngularVelocities; // 3 floats per body
+    }
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_GetBodyCount")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_GetBodyCount(IntPtr engineCorePtr);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_GetAwakeBodyCount")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_GetAwakeBodyCount(IntPtr engineCorePtr);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ReadBodyStates")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_ReadBodyStates(IntPtr engineCorePtr, in NativeBodyStateArrays states, uint capacity, uint movedOnly);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_WriteBodyStates")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial void Engine_WriteBodyStates(IntPtr engineCorePtr, in NativeBodyStateArrays states, uint count);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_SavePhysicsSnapshot")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial ulong Engine_SavePhysicsSnapshot(IntPtr engineCorePtr, IntPtr buffer, ulong capacity);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_RestorePhysicsSnapshot")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_RestorePhysicsSnapshot(IntPtr engineCorePtr, IntPtr snapshot, ulong size);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_SetPhysicsThreadEnabled")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial void Engine_SetPhysicsThreadEnabled(IntPtr engineCorePtr, uint enabled);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ReadInterpolatedBodyStates")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_ReadInterpolatedBodyStates(IntPtr engineCorePtr, in NativeBodyStateArrays states, uint capacity);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_SetPhysicsDeterministic")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial void Engine_SetPhysicsDeterministic(IntPtr engineCorePtr, uint enabled);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_GetPhysicsStateHash")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial ulong Engine_GetPhysicsStateHash(IntPtr engineCorePtr);
+
+    // Input events of the current frame, copied in one call
+    public enum InputEventType : uint
+    {
+        Key = 0,
+        MouseButton = 1,
+        CursorMove = 2,
+        Scroll = 3,
+        Text = 4,
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct NativeInputEvent
+    {
+        public long TimestampNs;    // Native steady clock
+        public InputEventType Type;
+        public int Code;            // Key or mouse button code, or the code point of a text event
+        public uint Action;         // 0 release, 1 press, 2 repeat
+        public int Mods;            // Shift 1, control 2, alt 4, super 8
+        public float X, Y;          // Cursor position or scroll offsets
+    }
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ReadInputEvents")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_ReadInputEvents(IntPtr engineCorePtr, IntPtr events, uint capacity);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_SetRenderThreadEnabled")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial void Engine_SetRenderThreadEnabled(IntPtr engineCorePtr, uint enabled);
+
+    // Extra window and offscreen viewports sharing the engine's graphics device
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_CreateViewport", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_CreateViewport(IntPtr engineCorePtr, int width, int height, string? title, uint offscreen);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_DestroyViewport")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial void Engine_DestroyViewport(IntPtr engineCorePtr, uint viewportId);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ResizeViewport")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_ResizeViewport(IntPtr engineCorePtr, uint viewportId, int width, int height);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_GetViewportColorTexture")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_GetViewportColorTexture(IntPtr engineCorePtr, uint viewportId);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ViewportShouldClose")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_ViewportShouldClose(IntPtr engineCorePtr, uint viewportId);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ReadViewportInputEvents")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_ReadViewportInputEvents(IntPtr engineCorePtr, uint viewportId, IntPtr events, uint capacity);
+
+    // Present modes and frame pacing
+    public enum PresentMode : uint
+    {
+        VSync = 0,
+        Adaptive = 1,   // Late frames tear instead of waiting a refresh, where supported
+        Uncapped = 2,
+        Capped = 3,     // At most the given frame rate
+    }
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_SetPresentOptions")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial void Engine_SetPresentOptions(IntPtr engineCorePtr, PresentMode mode, float maxFrameRate, uint lowLatency);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ShouldClose")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_ShouldClose(IntPtr engineCorePtr);
+
+    // Input recording and frame-exact replay
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_StartInputRecording")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_StartInputRecording(IntPtr engineCorePtr);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_StopInputRecording", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_StopInputRecording(IntPtr engineCorePtr, string? path);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_StartInputReplay", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_StartInputReplay(IntPtr engineCorePtr, string path);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_GetFrameDeltaTime")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial float Engine_GetFrameDeltaTime(IntPtr engineCorePtr);
+
+    // Entity transform arrays in native memory, shared in place
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct NativeTransformArrays
+    {
+        public float* Positions;    // 3 floats per entity
+        public float* Rotations;    // 4 floats (x, y, z, w) per entity
+        public float* Scales;       // 3 floats per entity
+        public uint* Flags;         // Active 1, managed write 2, native write 4; bits 16+ free
+        public ulong ManagedVersion;
+        public ulong NativeVersion;
+        public uint Capacity;
+    }
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_CreateTransformArrays")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial IntPtr Engine_CreateTransformArrays(IntPtr engineCorePtr, uint capacity);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_GetTransformArrays")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial IntPtr Engine_GetTransformArrays(IntPtr engineCorePtr);
+
+    // Command ring managed code enqueues commands into without calling into native code
+    public enum CommandType : uint
+    {
+        Spawn = 0,
+        Destroy = 1,
+        SetTransform = 2,
+        ApplyImpulse = 3,
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct NativeCommand
+    {
+        public CommandType Type;
+        public uint Entity;         // Transform slot, for every command but ApplyImpulse
+        public uint Target;         // Body id for ApplyImpulse
+        public uint Flags;          // Reserved
+        public fixed float Values[12]; // Position, rotation, scale; or impulse
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct NativeCommandRing
+    {
+        public NativeCommand* Commands;
+        public uint Capacity;       // Power of two
+        public ulong* WriteIndex;   // Advanced by the producer
+        public ulong* ReadIndex;    // Advanced by native code
+    }
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_CreateCommandRing")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial IntPtr Engine_CreateCommandRing(IntPtr engineCorePtr, uint capacity);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_GetCommandRing")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial IntPtr Engine_GetCommandRing(IntPtr engineCorePtr);
+
+    // Input-to-present latency percentiles
+    [StructLayout(LayoutKind.Sequential)]
+    public struct NativeLatencyStats
+    {
+        public ulong SampleCount;   // Events measured since the last reset
+        public float P50Ms, P90Ms, P99Ms, MaxMs;
+    }
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_GetInputLatencyStats")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial void Engine_GetInputLatencyStats(IntPtr engineCorePtr, out NativeLatencyStats stats);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ResetInputLatencyStats")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial void Engine_ResetInputLatencyStats(IntPtr engineCorePtr);
+
+    // Contact events, copied in batches
+    public enum ContactEventType : uint
+    {
+        Begin = 0,
+        Persist = 1,
+        End = 2,
+        SensorBegin = 3,
+        SensorEnd = 4,
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct NativeContactEvent
+    {
+        public ContactEventType Type;
+        public uint BodyA;          // The sensor for sensor events
+        public uint BodyB;
+        public float PointX, PointY, PointZ;
+        public float NormalX, NormalY, NormalZ; // From BodyA to BodyB
+        public float ApproachSpeed;
+    }
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ConfigureContactEvents")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial void Engine_ConfigureContactEvents(IntPtr engineCorePtr, uint capacity, uint reportPersist);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_ReadContactEvents")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial uint Engine_ReadContactEvents(IntPtr engineCorePtr, IntPtr events, uint capacity);
+
+    [LibraryImport("piece_core.dll", EntryPoint = "Engine_GetDroppedContactEventCount")]
+    [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+    public static partial ulong Engine_GetDroppedContactEventCount(IntPtr engineCorePtr);
 }
@@ -0,0 +1,64 @@
+using System.Numerics;
+
+namespace Piece.Core;
+
+/// <summary>
+/// Entity positions, rotations, scales and flags in native memory, read and written in place through spans.
+/// Write transforms between <see cref="Engine.Update"/> calls, call <see cref="MarkChanged"/> for each written entity
+/// and <see cref="CommitChanges"/> once per batch; native systems pick them up without copying.
+/// </summary>
+public sealed unsafe class TransformArrays
+{
+    public const uint ActiveFlag = 1;
+    public const uint ManagedDirtyFlag = 2;
+    public const uint NativeDirtyFlag = 4;
+    public const int UserFlagsShift = 16;  // Bits from here up are free for gameplay code
+
+    private readonly NativeCalls.NativeTransformArrays* _native;
+    private ulong _seenNativeVersion;
+
+    internal TransformArrays(IntPtr native)
+    {
+        _native = (NativeCalls.NativeTransformArrays*)native;
+    }
+
+    public int Capacity => (int)_native->Capacity;
+
+    // The native arrays never move, so the spans need no pinning.
+    public Span<Vector3> Positions => new(_native->Positions, Capacity);
+    public Span<Quaternion> Rotations => new(_native->Rotations, Capacity);
+    public Span<Vector3> Scales => new(_native->Scales, Capacity);
+    public Span<uint> Flags => new(_native->Flags, Capacity);
+
+    public void MarkChanged(int index)
+    {
+        Flags[index] |= ManagedDirtyFlag;
+    }
+
+    public void CommitChanges()
+    {
+        _native->ManagedVersion++;
+    }
+
+    // Fills indices with the entities native code wrote since the last call and clears their dirty bits. The flags
+    // are only scanned when native code published changes.
+    public int TakeNativeChanges(List<int> indices)
+    {
+        indices.Clear();
+        if (_native->NativeVersion == _seenNativeVersion)
+        {
+            return 0;
+        }
+        _seenNativeVersion = _native->NativeVersion;
+        Span<uint> flags = Flags;
+        for (int i = 0; i < flags.Length; i++)
+        {
+            if ((flags[i] & NativeDirtyFlag) != 0)
+            {
+                flags[i] &= ~NativeDirtyFlag;
+                indices.Add(i);
+            }
+        }
+        return indices.Count;
+    }
+}
@@ -0,0 +1,11 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace Piece.Headless;
+
+internal static partial class HeadlessPInvoke
+{
+    [LibraryImport("wal_headless", EntryPoint = "CreateHeadlessWindowFactory")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    public static partial IntPtr CreateFactory(IntPtr options);
+}
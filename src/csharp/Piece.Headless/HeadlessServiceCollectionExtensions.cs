@@ -0,0 +1,16 @@
+using System;
+using Microsoft.Extensions.DependencyInjection;
+using Piece.Core;
+
+namespace Piece.Headless;
+
+public static class HeadlessServiceCollectionExtensions
+{
+    public static IServiceCollection AddHeadlessWindow(this IServiceCollection services)
+    {
+        // No options: the factory falls back to its default framebuffer size.
+        IntPtr factoryPtr = HeadlessPInvoke.CreateFactory(IntPtr.Zero);
+        NativeCalls.SetWindowFactory(factoryPtr);
+        return services;
+    }
+}
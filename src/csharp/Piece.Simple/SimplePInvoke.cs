@@ -0,0 +1,11 @@
+using System.Runtime.InteropServices;
+
+namespace Piece.Simple;
+
+internal static class SimplePInvoke
+{
+    private const string NativeLib = "pal_simple";
+
+    [DllImport(NativeLib, EntryPoint = "CreateSimplePhysicsWorldFactory", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern IntPtr CreateFactory();
+}
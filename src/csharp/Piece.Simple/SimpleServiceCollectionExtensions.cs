@@ -0,0 +1,17 @@
+using System;
+
+
+using Microsoft.Extensions.DependencyInjection;
+using Piece.Core;
+
+namespace Piece.Simple;
+
+public static class SimpleServiceCollectionExtensions
+{
+    public static IServiceCollection AddSimplePhysics(this IServiceCollection services)
+    {
+        IntPtr factoryPtr = SimplePInvoke.CreateFactory();
+        NativeCalls.SetPhysicsWorldFactory(factoryPtr);
+        return services;
+    }
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <pal/simple/dynamic_aabb_tree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Piece::PAL;
+
+namespace
+{
+Aabb MakeBox(const glm::vec3 &center, float half_size)
+{
+    return {center - glm::vec3(half_size), center + glm::vec3(half_size)};
+}
+
+std::vector<uint32_t> QueryAll(const DynamicAabbTree &tree, const Aabb &aabb)
+{
+    std::vector<uint32_t> hits;
+    tree.Query(aabb, [&](int32_t proxy) {
+        hits.push_back(tree.GetUserData(proxy));
+        return true;
+    });
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+} // namespace
+
+TEST(DynamicAabbTreeTest, QueryMatchesBruteForceThroughMovesAndRemovals)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> step(-2.0f, 2.0f);
+
+    DynamicAabbTree tree(0.1f);
+    std::vector<glm::vec3> centers;
+    std::vector<int32_t> proxies;
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        centers.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+        proxies.push_back(tree.CreateProxy(MakeBox(centers.back(), 0.5f), i));
+    }
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        glm::vec3 displacement(step(rng), step(rng), step(rng));
+        centers[i] += displacement;
+        tree.MoveProxy(proxies[i], MakeBox(centers[i], 0.5f), displacement);
+    }
+    std::vector<bool> alive(500, true);
+    for (uint32_t i = 0; i < 500; i += 3)
+    {
+        tree.DestroyProxy(proxies[i]);
+        alive[i] = false;
+    }
+
+    ASSERT_EQ(tree.GetProxyCount(), 333u);
+    // An AVL-balanced tree of n leaves is at most about 1.44 log2(n) high.
+    EXPECT_LE(tree.GetHeight(), static_cast<int32_t>(std::ceil(1.45f * std::log2(333.0f))) + 1);
+
+    for (uint32_t q = 0; q < 50; ++q)
+    {
+        Aabb query = MakeBox(glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)), 8.0f);
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < 500; ++i)
+        {
+            if (alive[i] && tree.GetFatAabb(proxies[i]).Overlaps(query))
+            {
+                expected.push_back(i);
+            }
+            // Every live object must stay inside its fat AABB.
+            if (alive[i])
+            {
+                ASSERT_TRUE(tree.GetFatAabb(proxies[i]).Contains(MakeBox(centers[i], 0.5f)));
+            }
+        }
+        EXPECT_EQ(QueryAll(tree, query), expected);
+    }
+}
+
+TEST(DynamicAabbTreeTest, SmallMovesKeepTheLeaf)
+{
+    DynamicAabbTree tree(0.1f);
+    int32_t proxy = tree.CreateProxy(MakeBox(glm::vec3(0.0f), 0.5f), 42);
+
+    EXPECT_FALSE(tree.MoveProxy(proxy, MakeBox(glm::vec3(0.05f, 0.0f, 0.0f), 0.5f), glm::vec3(0.05f, 0.0f, 0.0f)));
+    EXPECT_TRUE(tree.MoveProxy(proxy, MakeBox(glm::vec3(1.0f, 0.0f, 0.0f), 0.5f), glm::vec3(0.95f, 0.0f, 0.0f)));
+    // The leaf is stretched along the motion so the next steps fit without reinsertion.
+    EXPECT_GT(tree.GetFatAabb(proxy).max.x, 1.5f + 3.0f * 0.95f);
+    EXPECT_EQ(tree.GetUserData(proxy), 42u);
+}
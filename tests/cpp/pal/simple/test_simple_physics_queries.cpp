@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+#include <pal/simple/simple_physics_world.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Piece::PAL;
+
+namespace
+{
+// Runs every task on fresh threads that claim sub-ranges until none are left.
+class ThreadTaskScheduler : public IPhysicsTaskScheduler
+{
+  public:
+    uint32_t GetWorkerCount() const override
+    {
+        return kThreads + 1;
+    }
+
+    void *EnqueueTask(TaskFunction task, int item_count, int min_range, void *task_context) override
+    {
+        auto *run = new Run{task, item_count, min_range, task_context};
+        for (uint32_t t = 0; t < kThreads; ++t)
+        {
+            run->threads.emplace_back([run, t] { run->Work(t + 1); });
+        }
+        return run;
+    }
+
+    void FinishTask(void *task_handle) override
+    {
+        auto *run = static_cast<Run *>(task_handle);
+        run->Work(0);
+        for (std::thread &thread : run->threads)
+        {
+            thread.join();
+        }
+        ++finished_tasks;
+        delete run;
+    }
+
+    uint32_t finished_tasks = 0;
+
+  private:
+    static constexpr uint32_t kThreads = 3;
+
+    struct Run
+    {
+        TaskFunction task;
+        int item_count;
+        int min_range;
+        void *context;
+        std::atomic<int> next{0};
+        std::vector<std::thread> threads;
+
+        Run(TaskFunction t, int count, int range, void *ctx) : task(t), item_count(count), min_range(range), context(ctx)
+        {
+        }
+
+        void Work(uint32_t worker)
+        {
+            for (int start = next.fetch_add(min_range); start < item_count; start = next.fetch_add(min_range))
+            {
+                task(start, std::min(start + min_range, item_count), worker, context);
+            }
+        }
+    };
+};
+
+class SimplePhysicsQueryTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        Piece::Core::NativePhysicsOptions options = {1.0f / 60.0f, 4, 4};
+        world = std::make_unique<SimplePhysicsWorld>(options);
+        world->SetTaskScheduler(&scheduler);
+        world->Init();
+    }
+
+    std::unique_ptr<IPhysicsBody> AddBox(const glm::vec3 &position, const glm::vec3 &half_extents)
+    {
+        RigidBodyCreationInfo info;
+        info.body_type = BodyType::Static;
+        info.position = position;
+        info.half_extents = half_extents;
+        return world->CreatePhysicsBody(info);
+    }
+
+    std::unique_ptr<IPhysicsBody> AddSphere(const glm::vec3 &position, float radius)
+    {
+        RigidBodyCreationInfo info;
+        info.body_type = BodyType::Static;
+        info.shape = ColliderShapeType::Sphere;
+        info.position = position;
+        info.radius = radius;
+        return world->CreatePhysicsBody(info);
+    }
+
+    ThreadTaskScheduler scheduler;
+    std::unique_ptr<SimplePhysicsWorld> world;
+};
+} // namespace
+
+TEST_F(SimplePhysicsQueryTest, RayHitsNearestColliderWithNormal)
+{
+    auto near_box = AddBox(glm::vec3(5.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+    auto far_sphere = AddSphere(glm::vec3(10.0f, 0.0f, 0.0f), 1.0f);
+    auto other = AddSphere(glm::vec3(0.0f, 10.0f, 0.0f), 2.0f);
+
+    RayCastInput rays[3];
+    rays[0].direction = glm::vec3(1.0f, 0.0f, 0.0f);
+    rays[0].max_distance = 100.0f;
+    rays[1].direction = glm::vec3(0.0f, 1.0f, 0.0f);
+    rays[1].max_distance = 100.0f;
+    rays[2].direction = glm::vec3(0.0f, 1.0f, 0.0f);
+    rays[2].max_distance = 7.0f; // Stops short of the sphere at y = 8.
+    RayCastHit hits[3];
+    world->CastRays(rays, 3, hits);
+
+    EXPECT_EQ(hits[0].body, near_box->GetId());
+    EXPECT_NEAR(hits[0].distance, 4.0f, 1e-5f);
+    EXPECT_EQ(hits[0].normal, glm::vec3(-1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(hits[1].body, other->GetId());
+    EXPECT_NEAR(hits[1].distance, 8.0f, 1e-5f);
+    EXPECT_NEAR(hits[1].normal.y, -1.0f, 1e-5f);
+    EXPECT_EQ(hits[2].body, kInvalidBodyId);
+}
+
+TEST_F(SimplePhysicsQueryTest, ParallelRayBatchMatchesBruteForce)
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coordinate(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> size(0.2f, 2.0f);
+    std::vector<std::unique_ptr<IPhysicsBody>> bodies;
+    std::vector<glm::vec3> centers, extents;
+    for (int i = 0; i < 400; ++i)
+    {
+        centers.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+        extents.emplace_back(size(rng), size(rng), size(rng));
+        bodies.push_back(AddBox(centers.back(), extents.back()));
+    }
+
+    std::vector<RayCastInput> rays(1000);
+    for (RayCastInput &ray : rays)
+    {
+        ray.origin = glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng));
+        ray.direction = glm::normalize(glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)));
+        ray.max_distance = 60.0f;
+    }
+    std::vector<RayCastHit> hits(rays.size());
+    world->CastRays(rays.data(), static_cast<uint32_t>(rays.size()), hits.data());
+    EXPECT_EQ(scheduler.finished_tasks, 1u);
+
+    for (size_t r = 0; r < rays.size(); ++r)
+    {
+        // Brute-force slab test against every box, skipping boxes that contain the origin.
+        float best = rays[r].max_distance;
+        BodyId best_body = kInvalidBodyId;
+        for (size_t b = 0; b < bodies.size(); ++b)
+        {
+            float t_enter = -1e30f, t_exit = 1e30f;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                float inverse = 1.0f / rays[r].direction[axis];
+                float t1 = (centers[b][axis] - extents[b][axis] - rays[r].origin[axis]) * inverse;
+                float t2 = (centers[b][axis] + extents[b][axis] - rays[r].origin[axis]) * inverse;
+                t_enter = std::max(t_enter, std::min(t1, t2));
+                t_exit = std::min(t_exit, std::max(t1, t2));
+            }
+            if (t_enter >= 0.0f && t_enter <= t_exit && t_enter <= best)
+            {
+                best = t_enter;
+                best_body = bodies[b]->GetId();
+            }
+        }
+        ASSERT_EQ(hits[r].body, best_body) << "ray " << r;
+        if (best_body != kInvalidBodyId)
+        {
+            EXPECT_NEAR(hits[r].distance, best, 1e-3f);
+        }
+    }
+}
+
+TEST_F(SimplePhysicsQueryTest, ShapeCastStopsAtContact)
+{
+    auto wall = AddBox(glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(1.0f, 5.0f, 5.0f));
+    auto ball = AddSphere(glm::vec3(0.0f, 0.0f, 10.0f), 1.0f);
+
+    ShapeCastInput casts[2];
+    casts[0].shape = ColliderShapeType::Box;
+    casts[0].half_extents = glm::vec3(0.5f);
+    casts[0].direction = glm::vec3(1.0f, 0.0f, 0.0f);
+    casts[0].max_distance = 20.0f;
+    casts[1].shape = ColliderShapeType::Sphere;
+    casts[1].radius = 0.5f;
+    casts[1].direction = glm::vec3(0.0f, 0.0f, 1.0f);
+    casts[1].max_distance = 20.0f;
+    RayCastHit hits[2];
+    world->CastShapes(casts, 2, hits);
+
+    EXPECT_EQ(hits[0].body, wall->GetId());
+    EXPECT_NEAR(hits[0].distance, 8.5f, 1e-5f);
+    EXPECT_NEAR(hits[0].point.x, 8.5f, 1e-5f);
+    EXPECT_EQ(hits[1].body, ball->GetId());
+    EXPECT_NEAR(hits[1].distance, 8.5f, 1e-5f);
+}
+
+TEST_F(SimplePhysicsQueryTest, OverlapsUseExactShapesAndRespectCapacity)
+{
+    auto box = AddBox(glm::vec3(0.0f), glm::vec3(1.0f));
+    auto sphere = AddSphere(glm::vec3(3.0f, 0.0f, 0.0f), 1.0f);
+    // Inside the query's bounding box but outside the query sphere.
+    auto corner = AddSphere(glm::vec3(1.9f, 1.9f, 0.0f), 0.1f);
+
+    OverlapInput queries[2];
+    queries[0].shape = ColliderShapeType::Sphere;
+    queries[0].center = glm::vec3(1.5f, 0.0f, 0.0f);
+    queries[0].radius = 0.6f;
+    queries[1].shape = ColliderShapeType::Box;
+    queries[1].center = glm::vec3(1.5f, 0.0f, 0.0f);
+    queries[1].half_extents = glm::vec3(10.0f);
+    BodyId results[2 * 2];
+    uint32_t counts[2];
+    world->QueryOverlaps(queries, 2, results, 2, counts);
+
+    ASSERT_EQ(counts[0], 2u);
+    std::vector<BodyId> first(results, results + 2);
+    std::sort(first.begin(), first.end());
+    std::vector<BodyId> expected = {box->GetId(), sphere->GetId()};
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(first, expected);
+    EXPECT_EQ(counts[1], 2u); // Three bodies overlap; the capacity is two.
+}
+
+TEST(SimplePhysicsDeterminismTest, ParallelStepsMatchSingleThreadedHashes)
+{
+    // A jittered pile falling onto ground and into sleeping boxes, stepped once without and once with workers.
+    auto simulate = [](IPhysicsTaskScheduler *scheduler) {
+        Piece::Core::NativePhysicsOptions options = {1.0f / 60.0f, 4, 4};
+        auto world = std::make_unique<SimplePhysicsWorld>(options);
+        world->SetTaskScheduler(scheduler);
+        world->Init();
+        world->SetDeterministic(true);
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+        std::vector<std::unique_ptr<IPhysicsBody>> bodies;
+        RigidBodyCreationInfo info;
+        info.body_type = BodyType::Static;
+        info.half_extents = glm::vec3(20.0f, 0.5f, 20.0f);
+        bodies.push_back(world->CreatePhysicsBody(info));
+        info.body_type = BodyType::Dynamic;
+        info.half_extents = glm::vec3(0.5f);
+        info.is_awake = false;
+        for (int i = 0; i < 40; ++i)
+        {
+            info.position =
+                glm::vec3(static_cast<float>(i % 8) * 1.2f - 4.0f, 1.0f, static_cast<float>(i / 8) * 1.2f - 3.0f);
+            bodies.push_back(world->CreatePhysicsBody(info));
+        }
+        info.is_awake = true;
+        for (int i = 0; i < 300; ++i)
+        {
+            info.position = glm::vec3(static_cast<float>(i % 10) - 4.5f + jitter(rng),
+                                      3.0f + static_cast<float>(i / 100) * 1.5f,
+                                      static_cast<float>(i / 10 % 10) - 4.5f + jitter(rng));
+            bodies.push_back(world->CreatePhysicsBody(info));
+        }
+
+        std::vector<uint64_t> hashes;
+        for (int i = 0; i < 90; ++i)
+        {
+            world->Step(1.0f / 60.0f);
+            hashes.push_back(world->GetStateHash());
+        }
+        EXPECT_EQ(world->GetAwakeBodyCount(), 340u);
+        return hashes;
+    };
+
+    std::vector<uint64_t> serial = simulate(nullptr);
+    ThreadTaskScheduler scheduler;
+    std::vector<uint64_t> parallel = simulate(&scheduler);
+    EXPECT_GT(scheduler.finished_tasks, 90u);
+    ASSERT_EQ(parallel.size(), serial.size());
+    for (size_t i = 0; i < serial.size(); ++i)
+    {
+        ASSERT_EQ(parallel[i], serial[i]) << "step " << i;
+    }
+    EXPECT_NE(serial.front(), serial.back());
+}
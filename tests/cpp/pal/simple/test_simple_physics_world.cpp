@@ -0,0 +1,375 @@
+#include <gtest/gtest.h>
+#include <pal/simple/simple_physics_world.h>
+#include <pal/simple/simple_physics_world_factory.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace Piece::PAL;
+
+namespace
+{
+constexpr float kStep = 1.0f / 60.0f;
+
+std::unique_ptr<SimplePhysicsWorld> CreateWorld()
+{
+    Piece::Core::NativePhysicsOptions options = {kStep, 4, 4};
+    auto world = std::make_unique<SimplePhysicsWorld>(options);
+    world->Init();
+    return world;
+}
+
+RigidBodyCreationInfo MakeBody(BodyType type, const glm::vec3 &position, const glm::vec3 &half_extents)
+{
+    RigidBodyCreationInfo info;
+    info.body_type = type;
+    info.position = position;
+    info.half_extents = half_extents;
+    return info;
+}
+} // namespace
+
+TEST(SimplePhysicsWorldTest, BoxComesToRestOnStaticGround)
+{
+    auto world = CreateWorld();
+    auto ground = world->CreatePhysicsBody(MakeBody(BodyType::Static, glm::vec3(0.0f), glm::vec3(10.0f, 0.5f, 10.0f)));
+    auto box = world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(0.5f)));
+
+    for (int i = 0; i < 180; ++i)
+    {
+        world->Step(kStep);
+    }
+
+    EXPECT_NEAR(box->GetPosition().y, 1.0f, 0.02f);
+    EXPECT_NEAR(box->GetLinearVelocity().y, 0.0f, 0.2f);
+    EXPECT_EQ(ground->GetPosition(), glm::vec3(0.0f));
+}
+
+TEST(SimplePhysicsWorldTest, SpheresPushEachOtherApart)
+{
+    auto world = CreateWorld();
+    world->SetGravity(glm::vec3(0.0f));
+    RigidBodyCreationInfo info;
+    info.shape = ColliderShapeType::Sphere;
+    info.radius = 1.0f;
+    info.position = glm::vec3(-0.9f, 0.0f, 0.0f);
+    auto left = world->CreatePhysicsBody(info);
+    info.position = glm::vec3(0.9f, 0.0f, 0.0f);
+    auto right = world->CreatePhysicsBody(info);
+
+    for (int i = 0; i < 60; ++i)
+    {
+        world->Step(kStep);
+    }
+
+    float gap = glm::distance(left->GetPosition(), right->GetPosition());
+    EXPECT_GE(gap, 2.0f - 0.02f);
+    EXPECT_NEAR(left->GetPosition().x + right->GetPosition().x, 0.0f, 1e-4f);
+}
+
+TEST(SimplePhysicsWorldTest, BulkReadReportsMovedBodiesAndStableIds)
+{
+    auto world = CreateWorld();
+    auto ground = world->CreatePhysicsBody(MakeBody(BodyType::Static, glm::vec3(0.0f), glm::vec3(10.0f, 0.5f, 10.0f)));
+    auto first = world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, glm::vec3(-3.0f, 5.0f, 0.0f), glm::vec3(0.5f)));
+    auto second = world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, glm::vec3(3.0f, 5.0f, 0.0f), glm::vec3(0.5f)));
+    first.reset(); // The last body moves into the freed slot; its id must not change.
+
+    world->Step(kStep);
+
+    BodyId ids[4];
+    glm::vec3 positions[4];
+    BodyStateArrays states;
+    states.ids = ids;
+    states.positions = positions;
+    ASSERT_EQ(world->GetBodyCount(), 2u);
+    ASSERT_EQ(world->ReadBodyStates(states, 4, false), 2u);
+
+    ASSERT_EQ(world->ReadBodyStates(states, 4, true), 1u);
+    EXPECT_EQ(ids[0], second->GetId());
+    EXPECT_EQ(positions[0], second->GetPosition());
+    EXPECT_LT(positions[0].y, 5.0f);
+
+    glm::vec3 teleport(1.0f, 2.0f, 3.0f);
+    BodyId second_id = second->GetId();
+    BodyStateArrays write;
+    write.ids = &second_id;
+    write.positions = &teleport;
+    world->WriteBodyStates(write, 1);
+    EXPECT_EQ(second->GetPosition(), teleport);
+}
+
+TEST(SimplePhysicsWorldTest, BatchedImpulsesMatchPerBodyImpulses)
+{
+    auto world = CreateWorld();
+    world->SetGravity(glm::vec3(0.0f));
+    auto ground = world->CreatePhysicsBody(MakeBody(BodyType::Static, glm::vec3(0.0f), glm::vec3(10.0f, 0.5f, 10.0f)));
+    auto batched = world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, glm::vec3(-3.0f, 5.0f, 0.0f), glm::vec3(0.5f)));
+    auto single = world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, glm::vec3(3.0f, 5.0f, 0.0f), glm::vec3(0.5f)));
+
+    BodyId ids[3] = {batched->GetId(), ground->GetId(), 1000};
+    glm::vec3 impulses[3] = {glm::vec3(2.0f, 0.0f, 1.0f), glm::vec3(5.0f), glm::vec3(5.0f)};
+    world->ApplyImpulses(ids, impulses, 3);
+    single->ApplyImpulse(impulses[0]);
+
+    EXPECT_NE(batched->GetLinearVelocity(), glm::vec3(0.0f));
+    EXPECT_EQ(batched->GetLinearVelocity(), single->GetLinearVelocity());
+    EXPECT_EQ(ground->GetLinearVelocity(), glm::vec3(0.0f));
+}
+
+TEST(SimplePhysicsWorldTest, RestingStackFallsAsleepAndWakesOnContact)
+{
+    auto world = CreateWorld();
+    auto ground = world->CreatePhysicsBody(MakeBody(BodyType::Static, glm::vec3(0.0f), glm::vec3(10.0f, 0.5f, 10.0f)));
+    std::vector<std::unique_ptr<IPhysicsBody>> stack;
+    for (int i = 0; i < 3; ++i)
+    {
+        stack.push_back(world->CreatePhysicsBody(
+            MakeBody(BodyType::Dynamic, glm::vec3(0.0f, 1.0f + 1.0f * static_cast<float>(i), 0.0f), glm::vec3(0.5f))));
+    }
+    RigidBodyCreationInfo restless = MakeBody(BodyType::Dynamic, glm::vec3(5.0f, 1.0f, 0.0f), glm::vec3(0.5f));
+    restless.enable_sleep = false;
+    auto player = world->CreatePhysicsBody(restless);
+    EXPECT_FALSE(ground->IsAwake());
+    EXPECT_EQ(world->GetAwakeBodyCount(), 4u);
+
+    for (int i = 0; i < 180; ++i)
+    {
+        world->Step(kStep);
+    }
+
+    // The stack sleeps as one island; only the body that opted out is still simulated.
+    EXPECT_EQ(world->GetAwakeBodyCount(), 1u);
+    EXPECT_TRUE(player->IsAwake());
+    for (const auto &body : stack)
+    {
+        EXPECT_FALSE(body->IsAwake());
+    }
+    BodyId ids[5];
+    BodyStateArrays states;
+    states.ids = ids;
+    world->Step(kStep);
+    EXPECT_EQ(world->ReadBodyStates(states, 5, true), 0u);
+
+    // A box dropped onto the top wakes the whole island.
+    auto dropped = world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, glm::vec3(0.0f, 4.5f, 0.0f), glm::vec3(0.5f)));
+    for (int i = 0; i < 30 && !stack[0]->IsAwake(); ++i)
+    {
+        world->Step(kStep);
+    }
+    EXPECT_TRUE(stack[0]->IsAwake());
+    EXPECT_EQ(world->GetAwakeBodyCount(), 5u);
+
+    for (int i = 0; i < 240; ++i)
+    {
+        world->Step(kStep);
+    }
+    EXPECT_EQ(world->GetAwakeBodyCount(), 1u);
+    EXPECT_NEAR(dropped->GetPosition().y, stack[2]->GetPosition().y + 1.0f, 0.02f);
+}
+
+TEST(SimplePhysicsWorldTest, SleepingBodiesWakeOnImpulseRemovalAndSettingChanges)
+{
+    auto world = CreateWorld();
+    auto ground = world->CreatePhysicsBody(MakeBody(BodyType::Static, glm::vec3(0.0f), glm::vec3(10.0f, 0.5f, 10.0f)));
+    RigidBodyCreationInfo info = MakeBody(BodyType::Dynamic, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.5f));
+    info.is_awake = false;
+    auto bottom = world->CreatePhysicsBody(info);
+    info.position.y = 2.0f;
+    auto top = world->CreatePhysicsBody(info);
+    auto lone = world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, glm::vec3(5.0f, 1.0f, 0.0f), glm::vec3(0.5f)));
+
+    EXPECT_EQ(world->GetAwakeBodyCount(), 1u);
+    lone->SetAwake(false);
+    EXPECT_EQ(world->GetAwakeBodyCount(), 0u);
+    world->Step(kStep);
+    EXPECT_EQ(top->GetPosition().y, 2.0f);
+
+    lone->ApplyImpulse(glm::vec3(0.0f, 1.0f, 0.0f));
+    EXPECT_TRUE(lone->IsAwake());
+    EXPECT_GT(lone->GetLinearVelocity().y, 0.0f);
+
+    bottom.reset(); // The body above must not stay asleep in mid-air.
+    EXPECT_TRUE(top->IsAwake());
+    world->Step(kStep);
+    EXPECT_LT(top->GetPosition().y, 2.0f);
+
+    top->SetSleepThreshold(0.25f);
+    EXPECT_EQ(top->GetSleepThreshold(), 0.25f);
+    top->SetAwake(false);
+    world->SetSleepingEnabled(false);
+    EXPECT_TRUE(top->IsAwake());
+    EXPECT_EQ(world->GetAwakeBodyCount(), 2u);
+}
+
+TEST(SimplePhysicsWorldTest, SnapshotRestoreReplaysTheSameSimulation)
+{
+    auto world = CreateWorld();
+    auto ground = world->CreatePhysicsBody(MakeBody(BodyType::Static, glm::vec3(0.0f), glm::vec3(10.0f, 0.5f, 10.0f)));
+    std::vector<std::unique_ptr<IPhysicsBody>> boxes;
+    for (int i = 0; i < 8; ++i)
+    {
+        boxes.push_back(world->CreatePhysicsBody(MakeBody(
+            BodyType::Dynamic, glm::vec3(0.3f * static_cast<float>(i), 1.0f + 1.1f * static_cast<float>(i), 0.0f),
+            glm::vec3(0.5f))));
+    }
+    for (int i = 0; i < 20; ++i)
+    {
+        world->Step(kStep);
+    }
+
+    size_t size = world->SaveSnapshot(nullptr, 0);
+    std::vector<uint8_t> snapshot(size);
+    EXPECT_EQ(world->SaveSnapshot(snapshot.data(), snapshot.size()), size);
+    std::vector<glm::vec3> saved;
+    for (const auto &box : boxes)
+    {
+        saved.push_back(box->GetPosition());
+    }
+    uint64_t saved_hash = world->GetStateHash();
+
+    auto simulate = [&]() {
+        boxes[0]->ApplyImpulse(glm::vec3(2.0f, 0.0f, 0.0f));
+        std::vector<glm::vec3> positions;
+        for (int i = 0; i < 120; ++i)
+        {
+            world->Step(kStep);
+        }
+        for (const auto &box : boxes)
+        {
+            positions.push_back(box->GetPosition());
+        }
+        return positions;
+    };
+    std::vector<glm::vec3> first = simulate();
+
+    uint64_t first_hash = world->GetStateHash();
+
+    ASSERT_TRUE(world->RestoreSnapshot(snapshot.data(), snapshot.size()));
+    EXPECT_EQ(world->GetStateHash(), saved_hash);
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        EXPECT_EQ(boxes[i]->GetPosition(), saved[i]);
+    }
+    BodyId ids[16];
+    BodyStateArrays states;
+    states.ids = ids;
+    EXPECT_EQ(world->ReadBodyStates(states, 16, true), 9u);
+    EXPECT_EQ(simulate(), first);
+    EXPECT_EQ(world->GetStateHash(), first_hash);
+
+    // Snapshots only apply to the bodies they were taken with.
+    EXPECT_FALSE(world->RestoreSnapshot(snapshot.data(), snapshot.size() - 1));
+    auto extra = world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, glm::vec3(20.0f), glm::vec3(0.5f)));
+    EXPECT_FALSE(world->RestoreSnapshot(snapshot.data(), snapshot.size()));
+    extra.reset();
+    EXPECT_TRUE(world->RestoreSnapshot(snapshot.data(), snapshot.size()));
+}
+
+TEST(SimplePhysicsWorldTest, ContactEventsReportBeginPersistEndAndSensors)
+{
+    auto world = CreateWorld();
+    ContactEventOptions options;
+    options.capacity = 4096;
+    options.report_persist = true;
+    world->ConfigureContactEvents(options);
+    auto ground = world->CreatePhysicsBody(MakeBody(BodyType::Static, glm::vec3(0.0f), glm::vec3(10.0f, 0.5f, 10.0f)));
+    RigidBodyCreationInfo sensor_info =
+        MakeBody(BodyType::Static, glm::vec3(0.0f, 3.0f, 0.0f), glm::vec3(1.0f, 0.25f, 1.0f));
+    sensor_info.is_sensor = true;
+    auto sensor = world->CreatePhysicsBody(sensor_info);
+    auto box = world->CreatePhysicsBody(MakeBody(BodyType::Dynamic, glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(0.5f)));
+
+    std::vector<ContactEvent> events;
+    auto drain = [&] {
+        ContactEvent batch[16];
+        while (uint32_t count = world->ReadContactEvents(batch, 16))
+        {
+            events.insert(events.end(), batch, batch + count);
+        }
+    };
+    for (int i = 0; i < 240; ++i)
+    {
+        world->Step(kStep);
+        drain();
+    }
+    EXPECT_FALSE(box->IsAwake());
+
+    // The box falls through the sensor without being slowed and lands on the ground.
+    ASSERT_GE(events.size(), 4u);
+    EXPECT_EQ(events[0].type, ContactEventType::SensorBegin);
+    EXPECT_EQ(events[0].body_a, sensor->GetId());
+    EXPECT_EQ(events[0].body_b, box->GetId());
+    EXPECT_EQ(events[1].type, ContactEventType::SensorEnd);
+    EXPECT_EQ(events[2].type, ContactEventType::Begin);
+    EXPECT_EQ(events[2].body_a, ground->GetId());
+    EXPECT_EQ(events[2].body_b, box->GetId());
+    EXPECT_NEAR(events[2].normal.y, 1.0f, 1e-4f);
+    EXPECT_NEAR(events[2].point.y, 0.5f, 0.05f);
+    EXPECT_GT(events[2].approach_speed, 3.0f);
+    for (size_t i = 3; i < events.size(); ++i)
+    {
+        EXPECT_EQ(events[i].type, ContactEventType::Persist);
+        EXPECT_EQ(events[i].approach_speed, 0.0f);
+    }
+
+    // Sleeping pairs stay touching without events until a body goes away.
+    events.clear();
+    world->Step(kStep);
+    drain();
+    EXPECT_TRUE(events.empty());
+    BodyId box_id = box->GetId();
+    box.reset();
+    world->Step(kStep);
+    drain();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, ContactEventType::End);
+    EXPECT_EQ(events[0].body_a, ground->GetId());
+    EXPECT_EQ(events[0].body_b, box_id);
+    EXPECT_EQ(world->GetDroppedContactEventCount(), 0u);
+}
+
+TEST(SimplePhysicsWorldTest, FullContactEventBufferDropsNewEvents)
+{
+    auto world = CreateWorld();
+    world->SetGravity(glm::vec3(0.0f));
+    ContactEventOptions options;
+    options.capacity = 2;
+    options.report_persist = true;
+    world->ConfigureContactEvents(options);
+    auto wall = world->CreatePhysicsBody(MakeBody(BodyType::Static, glm::vec3(0.0f), glm::vec3(0.5f, 10.0f, 10.0f)));
+    std::vector<std::unique_ptr<IPhysicsBody>> boxes;
+    for (int i = 0; i < 3; ++i)
+    {
+        RigidBodyCreationInfo info = MakeBody(BodyType::Dynamic, glm::vec3(0.9f, 3.0f * i, 0.0f), glm::vec3(0.5f));
+        boxes.push_back(world->CreatePhysicsBody(info));
+    }
+
+    world->Step(kStep);
+    ContactEvent events[4];
+    ASSERT_EQ(world->ReadContactEvents(events, 4), 2u);
+    EXPECT_EQ(events[0].type, ContactEventType::Begin);
+    EXPECT_EQ(events[0].body_b, boxes[0]->GetId());
+    EXPECT_EQ(events[1].body_b, boxes[1]->GetId());
+    EXPECT_EQ(world->GetDroppedContactEventCount(), 1u);
+    EXPECT_EQ(world->ReadContactEvents(events, 4), 0u);
+
+    // Turning reporting off and on again starts over, so the touching pairs begin anew.
+    world->ConfigureContactEvents(ContactEventOptions());
+    world->Step(kStep);
+    world->ConfigureContactEvents(options);
+    EXPECT_EQ(world->GetDroppedContactEventCount(), 0u);
+}
+
+TEST(SimplePhysicsWorldTest, FactoryExportCreatesWorld)
+{
+    std::unique_ptr<Piece::Core::IPhysicsWorldFactory> factory(CreateSimplePhysicsWorldFactory());
+    ASSERT_NE(factory, nullptr);
+    auto world = factory->CreatePhysicsWorld(nullptr);
+    ASSERT_NE(world, nullptr);
+    EXPECT_EQ(world->CreatePhysicsBody(RigidBodyCreationInfo()), nullptr); // Not initialized yet.
+    world->Init();
+    EXPECT_NE(world->CreatePhysicsBody(RigidBodyCreationInfo()), nullptr);
+}
@@ -3,11 +3,20 @@
 #include <pal/iphysics_body.h>
 #include <piece_core/core/service_locator.h>
 #include <piece_core/engine_core.h>
+#include <piece_core/native_exports.h>
 #include <ral/interfaces/iindex_buffer.h>
 #include <ral/interfaces/ishader.h>
 #include <ral/interfaces/ishader_program.h>
 #include <ral/interfaces/ivertex_buffer.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 // Mocks for low-level interfaces
 class MockWindow : public Piece::WAL::IWindow
 {
@@ -15,13 +24,24 @@ class MockWindow : public Piece::WAL::IWindow
     MOCK_METHOD(bool, Init, (int width, int height, const std::string &title), (override));
     MOCK_METHOD(void, PollEvents, (), (override));
     MOCK_METHOD(void, SwapBuffers, (), (override));
+    MOCK_METHOD(void, SetPresentOptions, (const Piece::WAL::PresentOptions &options), (override));
     MOCK_METHOD(bool, ShouldClose, (), (const, override));
+    MOCK_METHOD((std::pair<int, int>), GetFramebufferSize, (), (const, override));
+    MOCK_METHOD(void, SetContextCurrent, (bool current), (override));
+    MOCK_METHOD(void, SetNotificationCallback, (std::function<void(Piece::WAL::WindowNotification)> callback),
+                (override));
     MOCK_METHOD(void *, GetNativeWindow, (), (const, override));
     MOCK_METHOD(bool, IsKeyPressed, (Piece::WAL::KeyCode keycode), (const, override));
     MOCK_METHOD(bool, IsMouseButtonPressed, (Piece::WAL::KeyCode button), (const, override));
     MOCK_METHOD((std::pair<float, float>), GetMousePosition, (), (const, override));
     MOCK_METHOD(float, GetMouseX, (), (const, override));
     MOCK_METHOD(float, GetMouseY, (), (const, override));
+    MOCK_METHOD(bool, WasKeyPressedThisFrame, (Piece::WAL::KeyCode keycode), (const, override));
+    MOCK_METHOD(bool, WasKeyReleasedThisFrame, (Piece::WAL::KeyCode keycode), (const, override));
+    MOCK_METHOD(bool, WasMouseButtonPressedThisFrame, (Piece::WAL::KeyCode button), (const, override));
+    MOCK_METHOD(bool, WasMouseButtonReleasedThisFrame, (Piece::WAL::KeyCode button), (const, override));
+    MOCK_METHOD(const Piece::WAL::InputState &, GetInputState, (), (const, override));
+    MOCK_METHOD(uint32_t, ReadInputEvents, (Piece::WAL::InputEvent * events, uint32_t capacity), (const, override));
 };
 
 class MockGraphicsDevice : public Piece::RAL::IGraphicsDevice
@@ -31,18 +51,58 @@ class MockGraphicsDevice : public Piece::RAL::IGraphicsDevice
     MOCK_METHOD(void, BeginFrame, (), (override));
     MOCK_METHOD(void, EndFrame, (), (override));
     MOCK_METHOD(Piece::RAL::IRenderContext *, GetImmediateContext, (), (override));
-    MOCK_METHOD(std::unique_ptr<Piece::RAL::IVertexBuffer>, CreateVertexBuffer, (), (override));
-    MOCK_METHOD(std::unique_ptr<Piece::RAL::IIndexBuffer>, CreateIndexBuffer, (), (override));
-    MOCK_METHOD(std::unique_ptr<Piece::RAL::IShader>, CreateShader, (), (override));
-    MOCK_METHOD(std::unique_ptr<Piece::RAL::IShaderProgram>, CreateShaderProgram, (), (override));
+    MOCK_METHOD(Piece::RAL::VertexBufferHandle, CreateVertexBuffer,
+                (const void *data, uint32_t vertex_count, const Piece::RAL::VertexLayout &layout), (override));
+    MOCK_METHOD(void, DestroyVertexBuffer, (Piece::RAL::VertexBufferHandle handle), (override));
+    MOCK_METHOD(Piece::RAL::IVertexBuffer *, GetVertexBuffer, (Piece::RAL::VertexBufferHandle handle), (override));
+    MOCK_METHOD(Piece::RAL::IndexBufferHandle, CreateIndexBuffer,
+                (const void *data, uint32_t index_count, Piece::RAL::IndexFormat format), (override));
+    MOCK_METHOD(void, DestroyIndexBuffer, (Piece::RAL::IndexBufferHandle handle), (override));
+    MOCK_METHOD(Piece::RAL::IIndexBuffer *, GetIndexBuffer, (Piece::RAL::IndexBufferHandle handle), (override));
+    MOCK_METHOD(Piece::RAL::ShaderHandle, CreateShader, (), (override));
+    MOCK_METHOD(void, DestroyShader, (Piece::RAL::ShaderHandle handle), (override));
+    MOCK_METHOD(Piece::RAL::IShader *, GetShader, (Piece::RAL::ShaderHandle handle), (override));
+    MOCK_METHOD(Piece::RAL::ShaderProgramHandle, CreateShaderProgram, (), (override));
+    MOCK_METHOD(void, DestroyShaderProgram, (Piece::RAL::ShaderProgramHandle handle), (override));
+    MOCK_METHOD(Piece::RAL::IShaderProgram *, GetShaderProgram, (Piece::RAL::ShaderProgramHandle handle), (override));
+    MOCK_METHOD(Piece::RAL::RenderTargetHandle, CreateRenderTarget, (const Piece::RAL::RenderTargetDesc &desc),
+                (override));
+    MOCK_METHOD(void, DestroyRenderTarget, (Piece::RAL::RenderTargetHandle handle), (override));
+    MOCK_METHOD(Piece::RAL::IRenderTarget *, GetRenderTarget, (Piece::RAL::RenderTargetHandle handle), (override));
+    MOCK_METHOD(void, SetRenderTarget, (Piece::RAL::RenderTargetHandle handle), (override));
 };
 
 class MockPhysicsWorld : public Piece::PAL::IPhysicsWorld
 {
   public:
+    MOCK_METHOD(void, SetTaskScheduler, (Piece::PAL::IPhysicsTaskScheduler * scheduler), (override));
     MOCK_METHOD(void, Init, (), (override));
     MOCK_METHOD(void, Step, (float delta_time), (override));
-    MOCK_METHOD(std::unique_ptr<Piece::PAL::IPhysicsBody>, CreatePhysicsBody, (), (override));
+    MOCK_METHOD(std::unique_ptr<Piece::PAL::IPhysicsBody>, CreatePhysicsBody,
+                (const Piece::PAL::RigidBodyCreationInfo &info), (override));
+    MOCK_METHOD(uint32_t, GetBodyCount, (), (const, override));
+    MOCK_METHOD(uint32_t, GetAwakeBodyCount, (), (const, override));
+    MOCK_METHOD(void, SetSleepingEnabled, (bool enabled), (override));
+    MOCK_METHOD(void, SetDeterministic, (bool enabled), (override));
+    MOCK_METHOD(uint64_t, GetStateHash, (), (const, override));
+    MOCK_METHOD(uint32_t, ReadBodyStates,
+                (const Piece::PAL::BodyStateArrays &states, uint32_t capacity, bool moved_only), (override));
+    MOCK_METHOD(void, WriteBodyStates, (const Piece::PAL::BodyStateArrays &states, uint32_t count), (override));
+    MOCK_METHOD(void, ApplyImpulses, (const Piece::PAL::BodyId *ids, const glm::vec3 *impulses, uint32_t count),
+                (override));
+    MOCK_METHOD(void, CastRays, (const Piece::PAL::RayCastInput *rays, uint32_t count, Piece::PAL::RayCastHit *hits),
+                (override));
+    MOCK_METHOD(void, CastShapes,
+                (const Piece::PAL::ShapeCastInput *casts, uint32_t count, Piece::PAL::RayCastHit *hits), (override));
+    MOCK_METHOD(void, QueryOverlaps,
+                (const Piece::PAL::OverlapInput *queries, uint32_t count, Piece::PAL::BodyId *results,
+                 uint32_t max_results_per_query, uint32_t *result_counts),
+                (override));
+    MOCK_METHOD(void, ConfigureContactEvents, (const Piece::PAL::ContactEventOptions &options), (override));
+    MOCK_METHOD(uint32_t, ReadContactEvents, (Piece::PAL::ContactEvent * events, uint32_t capacity), (override));
+    MOCK_METHOD(uint64_t, GetDroppedContactEventCount, (), (const, override));
+    MOCK_METHOD(size_t, SaveSnapshot, (void *buffer, size_t capacity), (override));
+    MOCK_METHOD(bool, RestoreSnapshot, (const void *snapshot, size_t size), (override));
 };
 
 // Mocks for factories
@@ -111,6 +171,11 @@ TEST_F(EngineCoreTest, InitializationCreatesBackends)
     EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
         .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
 
+    // The physics world gets the job system scheduler before it is initialized
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*physics_mock, SetTaskScheduler(::testing::NotNull())).Times(1);
+    EXPECT_CALL(*physics_mock, Init()).Times(1);
+
     Piece::Core::EngineCore engine_core;
 }
 
@@ -125,7 +190,11 @@ TEST_F(EngineCoreTest, UpdateAndRenderCallsBackendMethods)
         .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
 
     // Set expectations for update and render calls
+    EXPECT_CALL(*window_mock, PollEvents()).Times(1);
     EXPECT_CALL(*physics_mock, Step(::testing::_)).Times(1);
+    EXPECT_CALL(*graphics_mock, BeginFrame()).Times(1);
+    EXPECT_CALL(*graphics_mock, EndFrame()).Times(1);
+    EXPECT_CALL(*window_mock, SwapBuffers()).Times(1);
 
     // Create EngineCore
     Piece::Core::EngineCore engine_core;
@@ -134,3 +203,561 @@ TEST_F(EngineCoreTest, UpdateAndRenderCallsBackendMethods)
     engine_core.Update(0.016f);
     engine_core.Render();
 }
+
+TEST_F(EngineCoreTest, PhysicsThreadStepsAndPublishesInterpolatedTransforms)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    // One body moving one unit along x per step.
+    std::atomic<int> steps{0};
+    EXPECT_CALL(*physics_mock, Step(::testing::FloatEq(1.0f / 60.0f)))
+        .WillRepeatedly(::testing::Invoke([&](float) { ++steps; }));
+    EXPECT_CALL(*physics_mock, Step(0.5f)).Times(0);
+    EXPECT_CALL(*physics_mock, GetBodyCount()).WillRepeatedly(::testing::Return(1u));
+    EXPECT_CALL(*physics_mock, ReadBodyStates(::testing::_, 1u, false))
+        .WillRepeatedly(::testing::Invoke([&](const Piece::PAL::BodyStateArrays &states, uint32_t, bool) {
+            states.ids[0] = 5;
+            states.positions[0] = glm::vec3(static_cast<float>(steps.load()), 0.0f, 0.0f);
+            states.rotations[0] = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+            return 1u;
+        }));
+
+    Piece::Core::EngineCore engine_core;
+    uint32_t id = 0;
+    float position[3] = {-1.0f, -1.0f, -1.0f};
+    Piece::Core::NativeBodyStateArrays states = {&id, position, nullptr, nullptr, nullptr};
+    EXPECT_EQ(Engine_ReadInterpolatedBodyStates(&engine_core, &states, 1), 0u);
+
+    Engine_SetPhysicsThreadEnabled(&engine_core, 1);
+    ASSERT_NE(engine_core.GetPhysicsThread(), nullptr);
+    // Update leaves stepping to the thread.
+    engine_core.Update(0.5f);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (engine_core.GetPhysicsThread()->GetStepCount() < 3 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_GE(engine_core.GetPhysicsThread()->GetStepCount(), 3u);
+
+    ASSERT_EQ(Engine_ReadInterpolatedBodyStates(&engine_core, &states, 1), 1u);
+    EXPECT_EQ(id, 5u);
+    // Interpolated between the last two published steps.
+    EXPECT_GE(position[0], 1.0f);
+    EXPECT_LE(position[0], static_cast<float>(steps.load()));
+
+    {
+        auto lock = engine_core.LockPhysicsWorld();
+        uint64_t locked_steps = engine_core.GetPhysicsThread()->GetStepCount();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_EQ(engine_core.GetPhysicsThread()->GetStepCount(), locked_steps);
+    }
+
+    Engine_SetPhysicsThreadEnabled(&engine_core, 0);
+    EXPECT_EQ(engine_core.GetPhysicsThread(), nullptr);
+    EXPECT_EQ(Engine_ReadInterpolatedBodyStates(&engine_core, &states, 1), 0u);
+}
+
+TEST_F(EngineCoreTest, BodyStateExportsForwardArraysToPhysicsWorld)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    Piece::Core::EngineCore engine_core;
+
+    uint32_t ids[4];
+    float positions[4 * 3];
+    float rotations[4 * 4];
+    Piece::Core::NativeBodyStateArrays states = {ids, positions, rotations, nullptr, nullptr};
+
+    auto same_memory = [&](const Piece::PAL::BodyStateArrays &arrays) {
+        return arrays.ids == ids && static_cast<void *>(arrays.positions) == positions &&
+               static_cast<void *>(arrays.rotations) == rotations && arrays.linear_velocities == nullptr &&
+               arrays.angular_velocities == nullptr;
+    };
+    EXPECT_CALL(*physics_mock, GetBodyCount()).WillOnce(::testing::Return(4u));
+    EXPECT_CALL(*physics_mock, GetAwakeBodyCount()).WillOnce(::testing::Return(3u));
+    EXPECT_CALL(*physics_mock, ReadBodyStates(::testing::Truly(same_memory), 4u, true))
+        .WillOnce(::testing::Return(2u));
+    EXPECT_CALL(*physics_mock, WriteBodyStates(::testing::Truly(same_memory), 2u)).Times(1);
+
+    EXPECT_EQ(Engine_GetBodyCount(&engine_core), 4u);
+    EXPECT_EQ(Engine_GetAwakeBodyCount(&engine_core), 3u);
+    EXPECT_EQ(Engine_ReadBodyStates(&engine_core, &states, 4, 1), 2u);
+    Engine_WriteBodyStates(&engine_core, &states, 2);
+    EXPECT_EQ(Engine_ReadBodyStates(&engine_core, nullptr, 4, 0), 0u);
+
+    uint8_t snapshot[16];
+    EXPECT_CALL(*physics_mock, SaveSnapshot(static_cast<void *>(snapshot), sizeof(snapshot)))
+        .WillOnce(::testing::Return(size_t{12}));
+    EXPECT_CALL(*physics_mock, RestoreSnapshot(static_cast<const void *>(snapshot), size_t{12}))
+        .WillOnce(::testing::Return(true));
+    EXPECT_EQ(Engine_SavePhysicsSnapshot(&engine_core, snapshot, sizeof(snapshot)), 12u);
+    EXPECT_EQ(Engine_RestorePhysicsSnapshot(&engine_core, snapshot, 12), 1u);
+
+    EXPECT_CALL(*physics_mock, SetDeterministic(true)).Times(1);
+    EXPECT_CALL(*physics_mock, GetStateHash()).WillOnce(::testing::Return(0x1234567890ABCDEFull));
+    Engine_SetPhysicsDeterministic(&engine_core, 1);
+    EXPECT_EQ(Engine_GetPhysicsStateHash(&engine_core), 0x1234567890ABCDEFull);
+
+    Piece::Core::NativeContactEvent events[8];
+    auto contact_options = [](const Piece::PAL::ContactEventOptions &options) {
+        return options.capacity == 64 && options.report_persist;
+    };
+    EXPECT_CALL(*physics_mock, ConfigureContactEvents(::testing::Truly(contact_options))).Times(1);
+    EXPECT_CALL(*physics_mock,
+                ReadContactEvents(reinterpret_cast<Piece::PAL::ContactEvent *>(static_cast<void *>(events)), 8u))
+        .WillOnce(::testing::Return(5u));
+    EXPECT_CALL(*physics_mock, GetDroppedContactEventCount()).WillOnce(::testing::Return(uint64_t{3}));
+    Engine_ConfigureContactEvents(&engine_core, 64, 1);
+    EXPECT_EQ(Engine_ReadContactEvents(&engine_core, events, 8), 5u);
+    EXPECT_EQ(Engine_GetDroppedContactEventCount(&engine_core), 3u);
+    EXPECT_EQ(Engine_ReadContactEvents(&engine_core, nullptr, 8), 0u);
+}
+
+TEST_F(EngineCoreTest, InputEventExportCopiesFrameEventsFromWindow)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    Piece::Core::EngineCore engine_core;
+
+    Piece::Core::NativeInputEvent events[2] = {};
+    EXPECT_CALL(*window_mock, ReadInputEvents(::testing::_, 2u))
+        .WillOnce(::testing::Invoke([](Piece::WAL::InputEvent *out, uint32_t) {
+            out[0].timestamp_ns = 42;
+            out[0].type = Piece::WAL::InputEventType::Key;
+            out[0].code = static_cast<int32_t>(Piece::WAL::KeyCode::kA);
+            out[0].action = Piece::WAL::InputAction::Press;
+            out[1].type = Piece::WAL::InputEventType::CursorMove;
+            out[1].x = 3.0f;
+            out[1].y = 4.0f;
+            return 5u;
+        }));
+    EXPECT_EQ(Engine_ReadInputEvents(&engine_core, events, 2), 5u);
+    EXPECT_EQ(events[0].timestamp_ns, 42);
+    EXPECT_EQ(events[0].type, 0u);
+    EXPECT_EQ(events[0].code, 65);
+    EXPECT_EQ(events[0].action, 1u);
+    EXPECT_EQ(events[1].type, 2u);
+    EXPECT_EQ(events[1].x, 3.0f);
+    EXPECT_EQ(events[1].y, 4.0f);
+    EXPECT_EQ(Engine_ReadInputEvents(nullptr, events, 2), 0u);
+}
+
+TEST_F(EngineCoreTest, PresentOptionsExportConfiguresWindow)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    Piece::Core::EngineCore engine_core;
+
+    Piece::WAL::PresentOptions received;
+    EXPECT_CALL(*window_mock, SetPresentOptions(::testing::_))
+        .WillOnce(::testing::SaveArg<0>(&received));
+    Engine_SetPresentOptions(&engine_core, static_cast<uint32_t>(Piece::WAL::PresentMode::Capped), 120.0f, 1);
+    EXPECT_EQ(received.mode, Piece::WAL::PresentMode::Capped);
+    EXPECT_EQ(received.max_frame_rate, 120.0f);
+    EXPECT_TRUE(received.low_latency);
+
+    // Unknown modes are ignored.
+    Engine_SetPresentOptions(&engine_core, 7, 0.0f, 0);
+    Engine_SetPresentOptions(nullptr, 0, 0.0f, 0);
+}
+
+TEST_F(EngineCoreTest, InputReplayRepeatsRecordedFramesAndDeltaTimes)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    Piece::Core::EngineCore engine_core;
+    std::string path = "input_replay_test.pirc";
+
+    // Record two frames: a key press with the first, nothing with the second.
+    Piece::WAL::InputState live_state;
+    EXPECT_CALL(*window_mock, GetInputState()).WillRepeatedly(::testing::ReturnRef(live_state));
+    EXPECT_CALL(*window_mock, ReadInputEvents(::testing::_, ::testing::_))
+        .WillRepeatedly(::testing::Return(0u));
+    EXPECT_CALL(*window_mock, ReadInputEvents(nullptr, 0u)).WillOnce(::testing::Return(1u)).RetiresOnSaturation();
+    EXPECT_CALL(*window_mock, ReadInputEvents(::testing::NotNull(), 1u))
+        .WillOnce(::testing::Invoke([](Piece::WAL::InputEvent *out, uint32_t) {
+            out[0].timestamp_ns = Piece::WAL::InputEventQueue::Now();
+            out[0].type = Piece::WAL::InputEventType::Key;
+            out[0].code = static_cast<int32_t>(Piece::WAL::KeyCode::kSpace);
+            out[0].action = Piece::WAL::InputAction::Press;
+            return 1u;
+        }));
+    ASSERT_EQ(Engine_StartInputRecording(&engine_core), 1u);
+    engine_core.Update(0.010f);
+    engine_core.Update(0.020f);
+    ASSERT_EQ(Engine_StopInputRecording(&engine_core, path.c_str()), 1u);
+    EXPECT_EQ(Engine_StopInputRecording(&engine_core, path.c_str()), 0u);
+
+    // The replay runs the recorded frames whatever delta time the caller measures, then ends the session.
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*physics_mock, Step(0.010f));
+    EXPECT_CALL(*physics_mock, Step(0.020f));
+    ASSERT_EQ(Engine_StartInputReplay(&engine_core, path.c_str()), 1u);
+    EXPECT_EQ(Engine_ShouldClose(&engine_core), 0u);
+
+    engine_core.Update(1.0f);
+    EXPECT_EQ(Engine_GetFrameDeltaTime(&engine_core), 0.010f);
+    EXPECT_TRUE(engine_core.GetWindow()->WasKeyPressedThisFrame(Piece::WAL::KeyCode::kSpace));
+    Piece::Core::NativeInputEvent events[2] = {};
+    ASSERT_EQ(Engine_ReadInputEvents(&engine_core, events, 2), 1u);
+    EXPECT_EQ(events[0].code, static_cast<int32_t>(Piece::WAL::KeyCode::kSpace));
+    EXPECT_EQ(Engine_ShouldClose(&engine_core), 0u);
+
+    engine_core.Update(1.0f);
+    EXPECT_EQ(Engine_GetFrameDeltaTime(&engine_core), 0.020f);
+    EXPECT_FALSE(engine_core.GetWindow()->WasKeyPressedThisFrame(Piece::WAL::KeyCode::kSpace));
+    EXPECT_TRUE(engine_core.GetWindow()->IsKeyPressed(Piece::WAL::KeyCode::kSpace));
+    EXPECT_EQ(Engine_ShouldClose(&engine_core), 1u);
+
+    EXPECT_EQ(Engine_StartInputReplay(&engine_core, "missing.pirc"), 0u);
+    std::remove(path.c_str());
+}
+
+TEST_F(EngineCoreTest, InputLatencyIsMeasuredFromEventToPresentOfTheConsumingFrame)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    Piece::Core::EngineCore engine_core;
+
+    // Two events polled 20 ms and 10 ms before the frame presents, which takes 5 ms to swap.
+    EXPECT_CALL(*window_mock, ReadInputEvents(::testing::_, ::testing::_)).WillRepeatedly(::testing::Return(0u));
+    EXPECT_CALL(*window_mock, ReadInputEvents(nullptr, 0u)).WillOnce(::testing::Return(2u)).RetiresOnSaturation();
+    EXPECT_CALL(*window_mock, ReadInputEvents(::testing::NotNull(), 2u))
+        .WillOnce(::testing::Invoke([](Piece::WAL::InputEvent *out, uint32_t) {
+            int64_t now = Piece::WAL::InputEventQueue::Now();
+            out[0].timestamp_ns = now - 15000000;
+            out[1].timestamp_ns = now - 5000000;
+            return 2u;
+        }));
+    EXPECT_CALL(*window_mock, SwapBuffers()).WillRepeatedly(::testing::Invoke([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }));
+
+    Piece::Core::NativeLatencyStats stats = {};
+    Engine_GetInputLatencyStats(&engine_core, &stats);
+    EXPECT_EQ(stats.sample_count, 0u);
+    EXPECT_EQ(stats.p99_ms, 0.0f);
+
+    engine_core.Update(0.016f);
+    // Nothing is measured until a frame presents the events.
+    Engine_GetInputLatencyStats(&engine_core, &stats);
+    EXPECT_EQ(stats.sample_count, 0u);
+
+    engine_core.Render();
+    Engine_GetInputLatencyStats(&engine_core, &stats);
+    EXPECT_EQ(stats.sample_count, 2u);
+    EXPECT_GE(stats.p50_ms, 10.0f);
+    EXPECT_GE(stats.max_ms, 20.0f);
+    EXPECT_LT(stats.p50_ms, stats.max_ms);
+    EXPECT_EQ(stats.p99_ms, stats.max_ms);
+
+    // Frames without new input add no samples.
+    engine_core.Update(0.016f);
+    engine_core.Render();
+    Engine_GetInputLatencyStats(&engine_core, &stats);
+    EXPECT_EQ(stats.sample_count, 2u);
+
+    Engine_ResetInputLatencyStats(&engine_core);
+    Engine_GetInputLatencyStats(&engine_core, &stats);
+    EXPECT_EQ(stats.sample_count, 0u);
+    EXPECT_EQ(stats.max_ms, 0.0f);
+    Engine_GetInputLatencyStats(nullptr, &stats);
+    Engine_GetInputLatencyStats(&engine_core, nullptr);
+}
+
+TEST_F(EngineCoreTest, TransformArraysExportSharesArraysThatUpdatePublishes)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    Piece::Core::EngineCore engine_core;
+    EXPECT_EQ(Engine_GetTransformArrays(&engine_core), nullptr);
+    Piece::Core::NativeTransformArrays *arrays = Engine_CreateTransformArrays(&engine_core, 100000);
+    ASSERT_NE(arrays, nullptr);
+    EXPECT_EQ(Engine_GetTransformArrays(&engine_core), arrays);
+    EXPECT_EQ(arrays->capacity, 100000u);
+
+    // Managed writes stay flagged across updates until a native system takes them.
+    arrays->positions[99999 * 3 + 1] = 4.0f;
+    arrays->flags[99999] |= Piece::Core::kTransformActive | Piece::Core::kTransformManagedDirty;
+    ++arrays->managed_version;
+    engine_core.Update(0.016f);
+    EXPECT_EQ(arrays->flags[99999],
+              static_cast<uint32_t>(Piece::Core::kTransformActive | Piece::Core::kTransformManagedDirty));
+    const std::vector<uint32_t> &changes = engine_core.GetTransformArrays()->TakeManagedChanges();
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0], 99999u);
+    EXPECT_EQ(arrays->positions[99999 * 3 + 1], 4.0f);
+
+    // Native writes are published at the end of the update.
+    engine_core.GetTransformArrays()->MarkNativeChange(7);
+    engine_core.Update(0.016f);
+    EXPECT_EQ(arrays->native_version, 1u);
+
+    EXPECT_EQ(Engine_CreateTransformArrays(&engine_core, 0), nullptr);
+    EXPECT_EQ(Engine_GetTransformArrays(&engine_core), nullptr);
+    EXPECT_EQ(Engine_CreateTransformArrays(nullptr, 10), nullptr);
+}
+
+TEST_F(EngineCoreTest, CommandRingIsDrainedAndExecutedInBatchesByUpdate)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    Piece::Core::EngineCore engine_core;
+    Piece::Core::NativeTransformArrays *arrays = Engine_CreateTransformArrays(&engine_core, 16);
+    Piece::Core::NativeCommandRing *ring = Engine_CreateCommandRing(&engine_core, 100);
+    ASSERT_NE(ring, nullptr);
+    EXPECT_EQ(Engine_GetCommandRing(&engine_core), ring);
+    EXPECT_EQ(ring->capacity, 128u);
+
+    // Written the way managed code does: fill the slot, then publish the write index.
+    auto enqueue = [ring](Piece::Core::CommandType type, uint32_t entity, uint32_t target, float x) {
+        Piece::Core::NativeCommand &command = ring->commands[*ring->write_index & (ring->capacity - 1)];
+        command = {};
+        command.type = static_cast<uint32_t>(type);
+        command.entity = entity;
+        command.target = target;
+        command.values[0] = x;
+        command.values[6] = 1.0f;
+        command.values[7] = command.values[8] = command.values[9] = 2.0f;
+        ++*ring->write_index;
+    };
+    enqueue(Piece::Core::CommandType::Spawn, 9, 0, 1.0f);
+    enqueue(static_cast<Piece::Core::CommandType>(4), 9, 3, 1.5f); // Unsupported type; dropped.
+    enqueue(Piece::Core::CommandType::Spawn, 2, 0, 2.0f);
+    enqueue(Piece::Core::CommandType::ApplyImpulse, 0, 7, 5.0f);
+    enqueue(Piece::Core::CommandType::SetTransform, 9, 0, 3.0f);
+    enqueue(Piece::Core::CommandType::SetTransform, 4, 0, 4.0f); // Not spawned; ignored.
+    enqueue(Piece::Core::CommandType::Spawn, 5, 0, 5.0f);
+    enqueue(Piece::Core::CommandType::Destroy, 5, 0, 0.0f);
+    enqueue(Piece::Core::CommandType::Spawn, 99, 0, 0.0f); // Out of range; ignored.
+    enqueue(Piece::Core::CommandType::Destroy, 2, 0, 0.0f);
+    enqueue(Piece::Core::CommandType::Spawn, 2, 0, 7.0f); // Reuses the slot destroyed just before.
+
+    EXPECT_CALL(*physics_mock, ApplyImpulses(::testing::_, ::testing::_, 1u))
+        .WillOnce(::testing::Invoke([](const Piece::PAL::BodyId *ids, const glm::vec3 *impulses, uint32_t) {
+            EXPECT_EQ(ids[0], 7u);
+            EXPECT_EQ(impulses[0], glm::vec3(5.0f, 0.0f, 0.0f));
+        }));
+    engine_core.Update(0.016f);
+
+    EXPECT_EQ(*ring->read_index, 11u);
+    EXPECT_EQ(arrays->positions[9 * 3], 3.0f);
+    EXPECT_EQ(arrays->rotations[9 * 4 + 3], 1.0f);
+    EXPECT_EQ(arrays->scales[9 * 3 + 1], 2.0f);
+    EXPECT_EQ(arrays->positions[2 * 3], 7.0f);
+    uint32_t dirty = Piece::Core::kTransformManagedDirty;
+    EXPECT_EQ(arrays->flags[2], Piece::Core::kTransformActive | dirty);
+    EXPECT_EQ(arrays->flags[9], Piece::Core::kTransformActive | dirty);
+    EXPECT_EQ(arrays->flags[4], 0u);
+    EXPECT_EQ(arrays->flags[5], dirty);
+    // The executed commands reach native systems as managed changes.
+    EXPECT_EQ(engine_core.GetTransformArrays()->TakeManagedChanges(), (std::vector<uint32_t>{2, 5, 9}));
+
+    // An empty ring costs one index comparison and changes nothing.
+    engine_core.Update(0.016f);
+    EXPECT_TRUE(engine_core.GetTransformArrays()->TakeManagedChanges().empty());
+
+    EXPECT_EQ(Engine_CreateCommandRing(&engine_core, 0), nullptr);
+    EXPECT_EQ(Engine_GetCommandRing(nullptr), nullptr);
+}
+
+TEST_F(EngineCoreTest, RenderThreadOwnsContextAndRendersSubmittedFramesAndResizes)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    Piece::Core::EngineCore engine_core;
+
+    // The main thread hands the context to the render thread and takes it back when the thread stops.
+    std::thread::id main_thread = std::this_thread::get_id();
+    std::atomic<int> render_thread_binds{0};
+    std::atomic<int> render_thread_releases{0};
+    EXPECT_CALL(*window_mock, SetContextCurrent(::testing::_))
+        .WillRepeatedly(::testing::Invoke([&](bool current) {
+            if (std::this_thread::get_id() != main_thread)
+            {
+                ++(current ? render_thread_binds : render_thread_releases);
+            }
+        }));
+    std::function<void(Piece::WAL::WindowNotification)> notify;
+    EXPECT_CALL(*window_mock, SetNotificationCallback(::testing::_))
+        .WillRepeatedly(::testing::Invoke([&](std::function<void(Piece::WAL::WindowNotification)> callback) {
+            if (callback)
+            {
+                notify = callback;
+            }
+        }));
+    std::atomic<int> swaps{0};
+    EXPECT_CALL(*window_mock, SwapBuffers()).WillRepeatedly(::testing::Invoke([&] {
+        EXPECT_NE(std::this_thread::get_id(), main_thread);
+        ++swaps;
+    }));
+
+    Engine_SetRenderThreadEnabled(&engine_core, 1);
+    ASSERT_NE(engine_core.GetRenderThread(), nullptr);
+    ASSERT_TRUE(notify);
+
+    auto wait_for_frames = [&](uint64_t frames) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (engine_core.GetRenderThread()->GetFrameCount() < frames && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return engine_core.GetRenderThread()->GetFrameCount();
+    };
+    engine_core.Render();
+    EXPECT_EQ(wait_for_frames(1), 1u);
+
+    // A resize renders a frame without the event thread submitting one; close requests do not.
+    notify(Piece::WAL::WindowNotification::CloseRequested);
+    notify(Piece::WAL::WindowNotification::Resized);
+    EXPECT_EQ(wait_for_frames(2), 2u);
+
+    Engine_SetRenderThreadEnabled(&engine_core, 0);
+    EXPECT_EQ(engine_core.GetRenderThread(), nullptr);
+    EXPECT_EQ(render_thread_binds.load(), 1);
+    EXPECT_EQ(render_thread_releases.load(), 1);
+    EXPECT_EQ(swaps.load(), 2);
+}
+
+TEST_F(EngineCoreTest, DestructionTakesTheContextBackBeforeReleasingResources)
+{
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    // The graphics device and resource manager free GL objects when destroyed, so the main thread must hold the
+    // context again by then.
+    std::thread::id main_thread = std::this_thread::get_id();
+    std::mutex mutex;
+    std::vector<std::string> calls;
+    EXPECT_CALL(*window_mock, SetContextCurrent(::testing::_))
+        .WillRepeatedly(::testing::Invoke([&](bool current) {
+            std::lock_guard<std::mutex> lock(mutex);
+            calls.push_back(std::string(std::this_thread::get_id() == main_thread ? "main" : "render") +
+                            (current ? " bind" : " release"));
+        }));
+    EXPECT_CALL(*window_mock, SetNotificationCallback(::testing::_)).Times(::testing::AnyNumber());
+    {
+        Piece::Core::EngineCore engine_core;
+        engine_core.SetRenderThreadEnabled(true);
+        ASSERT_NE(engine_core.GetRenderThread(), nullptr);
+    }
+    std::vector<std::string> expected = {"main release", "render bind", "render release", "main bind"};
+    EXPECT_EQ(calls, expected);
+}
+
+TEST_F(EngineCoreTest, ViewportsShareTheGraphicsDevice)
+{
+    auto *viewport_window = new MockWindow();
+    EXPECT_CALL(*window_factory_mock, CreateWindow(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(window_mock)))
+        .WillOnce(::testing::Return(std::unique_ptr<MockWindow>(viewport_window)));
+    EXPECT_CALL(*graphics_factory_mock, CreateGraphicsDevice(::testing::_, ::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockGraphicsDevice>(graphics_mock)));
+    EXPECT_CALL(*physics_factory_mock, CreatePhysicsWorld(::testing::_))
+        .WillOnce(::testing::Return(std::unique_ptr<MockPhysicsWorld>(physics_mock)));
+
+    Piece::Core::EngineCore engine_core;
+
+    // A window viewport presents without vsync and hands the context back to the main window.
+    Piece::WAL::PresentOptions viewport_present;
+    EXPECT_CALL(*viewport_window, SetPresentOptions(::testing::_)).WillOnce(::testing::SaveArg<0>(&viewport_present));
+    {
+        ::testing::InSequence sequence;
+        EXPECT_CALL(*viewport_window, SetContextCurrent(false));
+        EXPECT_CALL(*window_mock, SetContextCurrent(true));
+    }
+    uint32_t window_id = Engine_CreateViewport(&engine_core, 320, 200, "Viewport", 0);
+    ASSERT_NE(window_id, 0u);
+    EXPECT_EQ(viewport_present.mode, Piece::WAL::PresentMode::Uncapped);
+    EXPECT_EQ(engine_core.GetViewportWindow(window_id), viewport_window);
+
+    // The offscreen target is created by the next frame on the rendering thread.
+    uint32_t offscreen_id = Engine_CreateViewport(&engine_core, 256, 128, nullptr, 1);
+    ASSERT_NE(offscreen_id, 0u);
+    EXPECT_TRUE(engine_core.GetViewportRenderTarget(offscreen_id).IsNull());
+    EXPECT_EQ(Engine_ResizeViewport(&engine_core, window_id, 10, 10), 0u);
+    EXPECT_EQ(Engine_CreateViewport(&engine_core, 0, 128, nullptr, 1), 0u);
+
+    Piece::RAL::RenderTargetHandle target;
+    target.index = 3;
+    target.generation = 1;
+    Piece::RAL::RenderTargetDesc created_desc;
+    ::testing::Mock::VerifyAndClearExpectations(window_mock);
+    ::testing::Mock::VerifyAndClearExpectations(viewport_window);
+    {
+        ::testing::InSequence sequence;
+        EXPECT_CALL(*graphics_mock, CreateRenderTarget(::testing::_))
+            .WillOnce(::testing::DoAll(::testing::SaveArg<0>(&created_desc), ::testing::Return(target)));
+        EXPECT_CALL(*graphics_mock, SetRenderTarget(target));
+        EXPECT_CALL(*graphics_mock, SetRenderTarget(Piece::RAL::RenderTargetHandle{}));
+        EXPECT_CALL(*viewport_window, SetContextCurrent(true));
+        EXPECT_CALL(*viewport_window, SwapBuffers());
+        EXPECT_CALL(*window_mock, SetContextCurrent(true));
+        EXPECT_CALL(*window_mock, SwapBuffers());
+    }
+    EXPECT_CALL(*graphics_mock, BeginFrame()).Times(3);
+    EXPECT_CALL(*graphics_mock, EndFrame()).Times(3);
+    engine_core.Render();
+    EXPECT_EQ(created_desc.width, 256u);
+    EXPECT_EQ(created_desc.height, 128u);
+    EXPECT_EQ(engine_core.GetViewportRenderTarget(offscreen_id), target);
+
+    // Destroyed viewports are no longer drawn; their targets are released by the next frame on the context's thread.
+    Engine_DestroyViewport(&engine_core, offscreen_id);
+    Engine_DestroyViewport(&engine_core, window_id);
+    EXPECT_EQ(engine_core.GetViewportWindow(window_id), nullptr);
+    ::testing::Mock::VerifyAndClearExpectations(graphics_mock);
+    ::testing::Mock::VerifyAndClearExpectations(window_mock);
+    EXPECT_CALL(*graphics_mock, DestroyRenderTarget(target));
+    EXPECT_CALL(*window_mock, SwapBuffers());
+    engine_core.Render();
+}
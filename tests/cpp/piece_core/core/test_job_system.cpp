@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <piece_core/core/job_system.h>
+#include <piece_core/core/job_system_task_scheduler.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Piece::Core;
+
+TEST(JobSystemTest, RunsEverySubmittedJob)
+{
+    JobSystem jobs(4);
+    EXPECT_EQ(jobs.GetWorkerCount(), 4u);
+
+    JobCounter counter;
+    std::atomic<int> sum{0};
+    for (int i = 1; i <= 1000; ++i)
+    {
+        jobs.Submit([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.Wait(counter);
+    EXPECT_EQ(counter.pending.load(), 0u);
+    EXPECT_EQ(sum.load(), 500500);
+}
+
+TEST(JobSystemTest, NestedWaitDoesNotDeadlock)
+{
+    JobSystem jobs(1);
+    JobCounter outer;
+    std::atomic<int> inner_runs{0};
+    for (int i = 0; i < 4; ++i)
+    {
+        jobs.Submit(
+            [&] {
+                JobCounter inner;
+                for (int j = 0; j < 8; ++j)
+                {
+                    jobs.Submit([&inner_runs] { inner_runs.fetch_add(1); }, &inner);
+                }
+                jobs.Wait(inner);
+            },
+            &outer);
+    }
+    jobs.Wait(outer);
+    EXPECT_EQ(inner_runs.load(), 32);
+}
+
+TEST(JobSystemTest, WorkerBlockedInNestedWaitPicksUpLaterJobs)
+{
+    JobSystem jobs(2);
+    std::atomic<bool> spinning{false};
+    std::atomic<bool> released{false};
+    JobCounter spinner;
+    jobs.Submit(
+        [&] {
+            spinning = true;
+            while (!released)
+            {
+                std::this_thread::yield();
+            }
+        },
+        &spinner);
+    while (!spinning)
+    {
+        std::this_thread::yield();
+    }
+
+    // The other worker blocks in Wait with an empty queue, so only the job submitted next can release the spinner.
+    JobCounter waiter;
+    jobs.Submit([&] { jobs.Wait(spinner); }, &waiter);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    jobs.Submit([&] { released = true; });
+    jobs.Wait(waiter);
+    EXPECT_TRUE(released.load());
+}
+
+TEST(JobSystemTest, ParallelForCoversRangeExactlyOnce)
+{
+    JobSystem jobs(3);
+    std::vector<std::atomic<int>> hits(1001);
+    jobs.ParallelFor(static_cast<uint32_t>(hits.size()), 64, [&hits](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            hits[i].fetch_add(1);
+        }
+    });
+    for (const auto &hit : hits)
+    {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+namespace
+{
+// Shared state of the scheduler tests, passed as the task context.
+struct SchedulerTestContext
+{
+    std::vector<std::atomic<int>> *hits;
+    std::atomic<uint32_t> max_worker_index{0};
+    std::atomic<uint32_t> arrived{0};
+    uint32_t expected{0};
+};
+
+void CountItems(int start_index, int end_index, uint32_t worker_index, void *task_context)
+{
+    auto *context = static_cast<SchedulerTestContext *>(task_context);
+    for (int i = start_index; i < end_index; ++i)
+    {
+        (*context->hits)[i].fetch_add(1);
+    }
+    uint32_t seen = context->max_worker_index.load();
+    while (worker_index > seen && !context->max_worker_index.compare_exchange_weak(seen, worker_index))
+    {
+    }
+}
+
+// Blocks until every task of the group has started, like a solver stage that needs one thread per worker.
+void Rendezvous(int, int, uint32_t, void *task_context)
+{
+    auto *context = static_cast<SchedulerTestContext *>(task_context);
+    context->arrived.fetch_add(1);
+    while (context->arrived.load() < context->expected)
+    {
+        std::this_thread::yield();
+    }
+}
+} // namespace
+
+TEST(JobSystemTaskSchedulerTest, RunsEveryItemOnceWithValidWorkerIndices)
+{
+    JobSystem jobs(3);
+    JobSystemTaskScheduler scheduler(jobs);
+    EXPECT_EQ(scheduler.GetWorkerCount(), 4u);
+
+    std::vector<std::atomic<int>> hits(5000);
+    SchedulerTestContext context;
+    context.hits = &hits;
+    void *first = scheduler.EnqueueTask(&CountItems, 3000, 16, &context);
+    void *second = scheduler.EnqueueTask(&CountItems, 2000, 16, &context);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    scheduler.FinishTask(first);
+    scheduler.FinishTask(second);
+
+    int total = 0;
+    for (const auto &hit : hits)
+    {
+        total += hit.load();
+    }
+    EXPECT_EQ(total, 5000);
+    EXPECT_LT(context.max_worker_index.load(), scheduler.GetWorkerCount());
+    EXPECT_EQ(scheduler.EnqueueTask(&CountItems, 0, 1, &context), nullptr);
+}
+
+TEST(JobSystemTaskSchedulerTest, WorkerIndicesStayBelowTheCappedCount)
+{
+    JobSystem jobs(JobSystemTaskScheduler::kMaxWorkerCount + 8);
+    JobSystemTaskScheduler scheduler(jobs);
+    EXPECT_EQ(scheduler.GetWorkerCount(), JobSystemTaskScheduler::kMaxWorkerCount);
+
+    std::vector<std::atomic<int>> hits(20000);
+    SchedulerTestContext context;
+    context.hits = &hits;
+    void *first = scheduler.EnqueueTask(&CountItems, 10000, 1, &context);
+    void *second = scheduler.EnqueueTask(&CountItems, 10000, 1, &context);
+    scheduler.FinishTask(first);
+    scheduler.FinishTask(second);
+
+    int total = 0;
+    for (const auto &hit : hits)
+    {
+        total += hit.load();
+    }
+    EXPECT_EQ(total, 20000);
+    EXPECT_LT(context.max_worker_index.load(), scheduler.GetWorkerCount());
+}
+
+TEST(JobSystemTaskSchedulerTest, OneTaskPerWorkerCompletesWhileTheCallerHelps)
+{
+    JobSystem jobs(2);
+    JobSystemTaskScheduler scheduler(jobs);
+
+    for (int round = 0; round < 50; ++round)
+    {
+        SchedulerTestContext context;
+        context.expected = scheduler.GetWorkerCount();
+        std::vector<void *> tasks;
+        for (uint32_t i = 0; i < context.expected; ++i)
+        {
+            tasks.push_back(scheduler.EnqueueTask(&Rendezvous, 1, 1, &context));
+        }
+        for (void *task : tasks)
+        {
+            scheduler.FinishTask(task);
+        }
+        EXPECT_EQ(context.arrived.load(), context.expected);
+    }
+}
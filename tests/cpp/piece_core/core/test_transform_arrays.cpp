@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <piece_core/core/transform_arrays.h>
+
+#include <cstdint>
+
+using namespace Piece::Core;
+
+TEST(TransformArraysTest, ArraysAreAlignedAndStartAtTheIdentity)
+{
+    TransformArrays arrays(5);
+    NativeTransformArrays *native = arrays.GetNative();
+    ASSERT_EQ(native->capacity, 5u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(native->positions) % TransformArrays::kAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(native->rotations) % TransformArrays::kAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(native->scales) % TransformArrays::kAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(native->flags) % TransformArrays::kAlignment, 0u);
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(native->positions[i * 3 + 0], 0.0f);
+        EXPECT_EQ(native->rotations[i * 4 + 2], 0.0f);
+        EXPECT_EQ(native->rotations[i * 4 + 3], 1.0f);
+        EXPECT_EQ(native->scales[i * 3 + 1], 1.0f);
+        EXPECT_EQ(native->flags[i], 0u);
+    }
+    EXPECT_EQ(native->managed_version, 0u);
+    EXPECT_EQ(native->native_version, 0u);
+}
+
+TEST(TransformArraysTest, ManagedChangesAreTakenOnlyAfterTheVersionMoves)
+{
+    TransformArrays arrays(8);
+    NativeTransformArrays *native = arrays.GetNative();
+
+    // Written as managed code does: dirty bits per entity, then one version bump for the batch.
+    native->positions[5 * 3] = 2.0f;
+    native->flags[5] |= kTransformActive | kTransformManagedDirty;
+    native->flags[1] |= kTransformActive | kTransformManagedDirty;
+    EXPECT_TRUE(arrays.TakeManagedChanges().empty());
+
+    ++native->managed_version;
+    const std::vector<uint32_t> &changes = arrays.TakeManagedChanges();
+    ASSERT_EQ(changes.size(), 2u);
+    EXPECT_EQ(changes[0], 1u);
+    EXPECT_EQ(changes[1], 5u);
+    EXPECT_EQ(native->flags[5], static_cast<uint32_t>(kTransformActive));
+    EXPECT_EQ(arrays.GetManagedChanges().size(), 2u);
+
+    EXPECT_TRUE(arrays.TakeManagedChanges().empty());
+}
+
+TEST(TransformArraysTest, NativeChangesBumpTheVersionOncePerPublish)
+{
+    TransformArrays arrays(4);
+    NativeTransformArrays *native = arrays.GetNative();
+    arrays.PublishNativeChanges();
+    EXPECT_EQ(native->native_version, 0u);
+
+    arrays.MarkNativeChange(0);
+    arrays.MarkNativeChange(3);
+    arrays.PublishNativeChanges();
+    EXPECT_EQ(native->native_version, 1u);
+    EXPECT_EQ(native->flags[0] & kTransformNativeDirty, static_cast<uint32_t>(kTransformNativeDirty));
+    EXPECT_EQ(native->flags[3] & kTransformNativeDirty, static_cast<uint32_t>(kTransformNativeDirty));
+    EXPECT_EQ(native->flags[1], 0u);
+
+    arrays.PublishNativeChanges();
+    EXPECT_EQ(native->native_version, 1u);
+}
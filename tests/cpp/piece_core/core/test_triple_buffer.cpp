@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <piece_core/core/triple_buffer.h>
+
+#include <thread>
+
+using namespace Piece::Core;
+
+TEST(TripleBufferTest, ReaderSeesOnlyTheNewestPublishedValue)
+{
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.Update());
+    EXPECT_EQ(buffer.GetReadBuffer(), 0);
+
+    buffer.GetWriteBuffer() = 1;
+    buffer.Publish();
+    buffer.GetWriteBuffer() = 2;
+    buffer.Publish();
+    // The write buffer is never one the reader holds.
+    buffer.GetWriteBuffer() = 3;
+
+    EXPECT_TRUE(buffer.Update());
+    EXPECT_EQ(buffer.GetReadBuffer(), 2);
+    EXPECT_FALSE(buffer.Update());
+    EXPECT_EQ(buffer.GetReadBuffer(), 2);
+
+    buffer.Publish();
+    EXPECT_TRUE(buffer.Update());
+    EXPECT_EQ(buffer.GetReadBuffer(), 3);
+}
+
+TEST(TripleBufferTest, ConcurrentReaderNeverSeesTornOrOlderValues)
+{
+    struct Value
+    {
+        uint64_t sequence = 0;
+        uint64_t check = 0;
+    };
+    TripleBuffer<Value> buffer;
+    constexpr uint64_t kCount = 200000;
+
+    std::thread producer([&] {
+        for (uint64_t i = 1; i <= kCount; ++i)
+        {
+            Value &value = buffer.GetWriteBuffer();
+            value.sequence = i;
+            value.check = ~i;
+            buffer.Publish();
+        }
+    });
+
+    // The last value stays published until it is picked up, so the loop always ends.
+    uint64_t last = 0;
+    uint64_t updates = 0;
+    uint64_t torn = 0;
+    uint64_t stale = 0;
+    while (last < kCount)
+    {
+        if (buffer.Update())
+        {
+            const Value &value = buffer.GetReadBuffer();
+            torn += value.check != ~value.sequence;
+            stale += value.sequence <= last;
+            last = value.sequence;
+            ++updates;
+        }
+    }
+    producer.join();
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(stale, 0u);
+    EXPECT_EQ(last, kCount);
+    EXPECT_GT(updates, 0u);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <piece_core/resources/asset_pack.h>
+#include <piece_core/resources/mesh_asset.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Piece::Core;
+
+namespace
+{
+// Returns a per-test pack path in the working directory.
+std::string TempPackPath()
+{
+    const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+    return std::string("asset_pack_") + info->name() + ".pak";
+}
+
+// Builds data that compresses well: a repeating pattern spanning several compression blocks.
+std::vector<uint8_t> MakeCompressible(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<uint8_t>((i / 7) % 13);
+    }
+    return data;
+}
+
+// Builds data that does not compress.
+std::vector<uint8_t> MakeRandom(size_t size)
+{
+    std::mt19937 rng(1234);
+    std::vector<uint8_t> data(size);
+    for (auto &byte : data)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return data;
+}
+} // namespace
+
+TEST(AssetPackTest, RoundTripsCompressedAndUncompressedEntries)
+{
+    std::string path = TempPackPath();
+    std::vector<uint8_t> compressible = MakeCompressible(3 * kAssetPackBlockSize + 123);
+    std::vector<uint8_t> random = MakeRandom(10000);
+
+    AssetPackWriter writer;
+    ASSERT_TRUE(writer.AddEntry("textures/pattern.bin", AssetType::Texture, compressible.data(), compressible.size(),
+                                true));
+    ASSERT_TRUE(writer.AddEntry("raw/noise.bin", AssetType::Raw, random.data(), random.size(), true));
+    EXPECT_FALSE(writer.AddEntry("raw/noise.bin", AssetType::Raw, random.data(), random.size(), false));
+    ASSERT_TRUE(writer.Write(path));
+
+    AssetPack pack;
+    ASSERT_TRUE(pack.Open(path));
+    EXPECT_EQ(pack.GetEntryCount(), 2u);
+    EXPECT_EQ(pack.Find("missing.bin"), nullptr);
+
+    const AssetPackEntry *pattern = pack.Find("textures/pattern.bin");
+    ASSERT_NE(pattern, nullptr);
+    EXPECT_EQ(pattern->type, AssetType::Texture);
+    EXPECT_TRUE(pattern->flags & kAssetPackEntryCompressed);
+    EXPECT_LT(pattern->stored_size, pattern->size);
+    EXPECT_EQ(pack.GetData(*pattern), nullptr);
+    std::vector<uint8_t> decompressed(pattern->size);
+    EXPECT_FALSE(pack.Read(*pattern, decompressed.data(), decompressed.size() - 1));
+    ASSERT_TRUE(pack.Read(*pattern, decompressed.data(), decompressed.size()));
+    EXPECT_EQ(decompressed, compressible);
+
+    // Incompressible data is kept uncompressed and exposed straight from the mapping, suitably aligned.
+    const AssetPackEntry *noise = pack.Find(HashAssetName("raw/noise.bin"));
+    ASSERT_NE(noise, nullptr);
+    EXPECT_FALSE(noise->flags & kAssetPackEntryCompressed);
+    const void *mapped = pack.GetData(*noise);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped) % 64, 0u);
+    EXPECT_EQ(std::memcmp(mapped, random.data(), random.size()), 0);
+
+    pack.Close();
+    EXPECT_FALSE(pack.IsOpen());
+    std::remove(path.c_str());
+}
+
+TEST(AssetPackTest, RejectsCorruptFiles)
+{
+    std::string path = TempPackPath();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "definitely not a pack file, but long enough to hold a header......";
+    }
+    AssetPack pack;
+    EXPECT_FALSE(pack.Open(path));
+    EXPECT_FALSE(pack.IsOpen());
+    EXPECT_FALSE(pack.Open("does/not/exist.pak"));
+
+    // A table of contents entry whose range wraps past the end of the address space, or an uncompressed entry whose
+    // size disagrees with its stored size, would let GetData and Read run past the mapping.
+    std::vector<uint8_t> random = MakeRandom(1000);
+    AssetPackWriter writer;
+    ASSERT_TRUE(writer.AddEntry("raw/noise.bin", AssetType::Raw, random.data(), random.size(), false));
+    ASSERT_TRUE(writer.Write(path));
+    std::vector<uint8_t> original;
+    {
+        std::ifstream file(path, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GE(original.size(), sizeof(AssetPackHeader));
+    AssetPackHeader header;
+    std::memcpy(&header, original.data(), sizeof(header));
+    auto open_patched = [&](size_t field_offset, uint64_t value) {
+        std::vector<uint8_t> patched = original;
+        std::memcpy(patched.data() + header.toc_offset + field_offset, &value, sizeof(value));
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(patched.data()), static_cast<std::streamsize>(patched.size()));
+        }
+        AssetPack patched_pack;
+        return patched_pack.Open(path);
+    };
+    EXPECT_TRUE(open_patched(offsetof(AssetPackEntry, size), random.size()));
+    EXPECT_FALSE(open_patched(offsetof(AssetPackEntry, offset), ~uint64_t{0} - 10));
+    EXPECT_FALSE(open_patched(offsetof(AssetPackEntry, size), random.size() + 1));
+    std::remove(path.c_str());
+}
+
+TEST(AssetPackTest, CookedMeshIsUsableInPlace)
+{
+    MeshData mesh;
+    mesh.positions = {glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)};
+    mesh.normals = {glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f)};
+    mesh.indices = {0, 1, 2};
+    OptimizedMesh optimized = OptimizeMesh(mesh);
+    std::vector<uint8_t> blob = SerializeMeshAsset(optimized);
+
+    std::string path = TempPackPath();
+    AssetPackWriter writer;
+    ASSERT_TRUE(writer.AddEntry("meshes/triangle.mesh", AssetType::Mesh, blob.data(), blob.size(), false));
+    ASSERT_TRUE(writer.Write(path));
+
+    AssetPack pack;
+    ASSERT_TRUE(pack.Open(path));
+    const AssetPackEntry *entry = pack.Find("meshes/triangle.mesh");
+    ASSERT_NE(entry, nullptr);
+    const void *data = pack.GetData(*entry);
+    ASSERT_NE(data, nullptr);
+
+    MeshAssetView view;
+    ASSERT_TRUE(ParseMeshAsset(data, entry->size, view));
+    EXPECT_EQ(view.header->vertex_count, optimized.vertex_count);
+    EXPECT_EQ(view.header->index_count, 3u);
+    EXPECT_EQ(view.header->layout.stride, optimized.layout.stride);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view.vertex_data) % 16, 0u);
+    EXPECT_EQ(std::memcmp(view.vertex_data, optimized.vertex_data.data(), optimized.vertex_data.size()), 0);
+    EXPECT_EQ(std::memcmp(view.index_data, optimized.index_data.data(), optimized.index_data.size()), 0);
+    EXPECT_FALSE(ParseMeshAsset(data, entry->size - 1, view));
+
+    // Offsets near the end of the address space must not wrap past the size checks.
+    for (size_t field : {offsetof(MeshAssetHeader, vertex_data_offset), offsetof(MeshAssetHeader, index_data_offset)})
+    {
+        std::vector<uint8_t> corrupt = blob;
+        uint64_t offset = ~uint64_t{0} - 1;
+        std::memcpy(corrupt.data() + field, &offset, sizeof(offset));
+        EXPECT_FALSE(ParseMeshAsset(corrupt.data(), corrupt.size(), view));
+    }
+
+    pack.Close();
+    std::remove(path.c_str());
+}
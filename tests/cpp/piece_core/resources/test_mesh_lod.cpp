@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <piece_core/resources/mesh_asset.h>
+#include <piece_core/resources/mesh_lod.h>
+#include <piece_core/resources/mesh_optimizer.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace Piece::Core;
+
+namespace
+{
+// Builds a flat size x size grid of quads on the XY plane facing +Z.
+MeshData MakeGrid(uint32_t size)
+{
+    MeshData mesh;
+    for (uint32_t y = 0; y <= size; ++y)
+    {
+        for (uint32_t x = 0; x <= size; ++x)
+        {
+            mesh.positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+        }
+    }
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            uint32_t i0 = y * (size + 1) + x;
+            uint32_t i2 = i0 + size + 1;
+            mesh.indices.insert(mesh.indices.end(), {i0, i0 + 1, i2, i0 + 1, i2 + 1, i2});
+        }
+    }
+    return mesh;
+}
+
+// Builds a unit latitude/longitude sphere. The longitude seam duplicates its vertices, as a UV seam would.
+MeshData MakeSphere(uint32_t rings, uint32_t segments)
+{
+    const float pi = 3.14159265f;
+    MeshData mesh;
+    for (uint32_t r = 0; r <= rings; ++r)
+    {
+        float theta = pi * r / rings;
+        for (uint32_t s = 0; s <= segments; ++s)
+        {
+            float phi = 2.0f * pi * (s % segments) / segments;
+            mesh.positions.emplace_back(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+                                        std::cos(theta));
+        }
+    }
+    for (uint32_t r = 0; r < rings; ++r)
+    {
+        for (uint32_t s = 0; s < segments; ++s)
+        {
+            uint32_t i0 = r * (segments + 1) + s;
+            uint32_t i2 = i0 + segments + 1;
+            if (r != 0)
+            {
+                mesh.indices.insert(mesh.indices.end(), {i0, i2, i0 + 1});
+            }
+            if (r + 1 != rings)
+            {
+                mesh.indices.insert(mesh.indices.end(), {i0 + 1, i2, i2 + 1});
+            }
+        }
+    }
+    return mesh;
+}
+
+// Sums the signed Z component of the triangle areas of a mesh.
+float SignedAreaZ(const std::vector<uint32_t> &indices, size_t count, const std::vector<glm::vec3> &positions)
+{
+    float area = 0.0f;
+    for (size_t i = 0; i < count; i += 3)
+    {
+        glm::vec3 normal = glm::cross(positions[indices[i + 1]] - positions[indices[i]],
+                                      positions[indices[i + 2]] - positions[indices[i]]);
+        EXPECT_GT(normal.z, 0.0f) << "triangle " << i / 3 << " flipped or degenerate";
+        area += 0.5f * normal.z;
+    }
+    return area;
+}
+} // namespace
+
+TEST(MeshLodTest, SimplifiesFlatGridWithoutErrorOrFlips)
+{
+    MeshData grid = MakeGrid(32);
+    std::vector<uint32_t> lod(grid.indices.size());
+    float error = -1.0f;
+    size_t count = SimplifyMesh(lod.data(), grid.indices.data(), grid.indices.size(), grid.positions.data(),
+                                grid.positions.size(), grid.indices.size() / 8, 0.01f, &error);
+
+    EXPECT_LE(count, grid.indices.size() / 8);
+    EXPECT_GT(count, 0u);
+    EXPECT_EQ(count % 3, 0u);
+    EXPECT_LT(error, 1.0e-3f);
+    // Collapsing onto coplanar vertices along straight borders keeps the covered area exact.
+    EXPECT_NEAR(SignedAreaZ(lod, count, grid.positions), 32.0f * 32.0f, 1.0e-2f);
+}
+
+TEST(MeshLodTest, RespectsErrorBudgetOnCurvedSurfaces)
+{
+    MeshData sphere = MakeSphere(24, 48);
+    std::vector<uint32_t> lod(sphere.indices.size());
+
+    float tight_error = 0.0f;
+    size_t tight = SimplifyMesh(lod.data(), sphere.indices.data(), sphere.indices.size(), sphere.positions.data(),
+                                sphere.positions.size(), 0, 1.0e-6f, &tight_error);
+    EXPECT_EQ(tight, sphere.indices.size());
+    EXPECT_EQ(tight_error, 0.0f);
+
+    float loose_error = 0.0f;
+    size_t loose = SimplifyMesh(lod.data(), sphere.indices.data(), sphere.indices.size(), sphere.positions.data(),
+                                sphere.positions.size(), sphere.indices.size() / 4, 0.05f, &loose_error);
+    EXPECT_LT(loose, sphere.indices.size() / 2);
+    EXPECT_GT(loose_error, 0.0f);
+    EXPECT_LE(loose_error, 0.05f);
+    for (size_t i = 0; i < loose; ++i)
+    {
+        EXPECT_LT(lod[i], sphere.positions.size());
+    }
+}
+
+TEST(MeshLodTest, OptimizeMeshBuildsLodChainInSharedBuffers)
+{
+    MeshData sphere = MakeSphere(32, 64);
+    MeshOptimizerOptions options;
+    options.lod_count = 4;
+    options.lod_target_error = 0.05f;
+    OptimizedMesh optimized = OptimizeMesh(sphere, options);
+
+    ASSERT_GE(optimized.lods.size(), 3u);
+    EXPECT_EQ(optimized.lods[0].index_offset, 0u);
+    EXPECT_EQ(optimized.lods[0].error, 0.0f);
+    uint32_t expected_offset = 0;
+    for (size_t i = 0; i < optimized.lods.size(); ++i)
+    {
+        EXPECT_EQ(optimized.lods[i].index_offset, expected_offset);
+        expected_offset += optimized.lods[i].index_count;
+        if (i > 0)
+        {
+            EXPECT_LT(optimized.lods[i].index_count, optimized.lods[i - 1].index_count);
+            EXPECT_GE(optimized.lods[i].error, optimized.lods[i - 1].error);
+        }
+    }
+    EXPECT_EQ(optimized.index_count, expected_offset);
+
+    const uint16_t *indices = reinterpret_cast<const uint16_t *>(optimized.index_data.data());
+    for (uint32_t i = 0; i < optimized.index_count; ++i)
+    {
+        EXPECT_LT(indices[i], optimized.vertex_count);
+    }
+
+    std::vector<uint8_t> blob = SerializeMeshAsset(optimized);
+    MeshAssetView view;
+    ASSERT_TRUE(ParseMeshAsset(blob.data(), blob.size(), view));
+    ASSERT_EQ(view.header->lod_count, optimized.lods.size());
+    EXPECT_EQ(view.header->lods[1].index_count, optimized.lods[1].index_count);
+}
+
+TEST(MeshLodTest, SelectLodUsesProjectedErrorWithHysteresis)
+{
+    const MeshLod lods[] = {{0, 600, 0.0f}, {600, 300, 0.01f}, {900, 150, 0.04f}, {1050, 75, 0.16f}};
+    LodSelectionParams params;
+    params.projection_scale = 1000.0f;
+    params.pixel_error = 1.0f;
+    params.hysteresis = 0.25f;
+
+    // Level i fits the budget once its error covers at most one pixel: beyond 10, 40 and 160 units.
+    EXPECT_EQ(SelectLod(lods, 4, 5.0f, 0, params), 0u);
+    EXPECT_EQ(SelectLod(lods, 4, 250.0f, 0, params), 3u);
+    EXPECT_EQ(SelectLod(lods, 4, 50.0f, 3, params), 2u);
+
+    // Coarsening waits until the error drops to 75% of the budget; refining happens immediately.
+    EXPECT_EQ(SelectLod(lods, 4, 11.0f, 0, params), 0u);
+    EXPECT_EQ(SelectLod(lods, 4, 14.0f, 0, params), 1u);
+    EXPECT_EQ(SelectLod(lods, 4, 11.0f, 1, params), 1u);
+    EXPECT_EQ(SelectLod(lods, 4, 9.0f, 1, params), 0u);
+
+    EXPECT_NEAR(ComputeLodProjectionScale(3.14159265f / 2.0f, 1000.0f), 500.0f, 1.0e-2f);
+}
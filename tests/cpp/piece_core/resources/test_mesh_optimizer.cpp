@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <piece_core/resources/mesh_optimizer.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+
+using namespace Piece::Core;
+
+namespace
+{
+// Builds a size x size grid of quads on the XY plane with integer coordinates, in shuffled triangle order.
+MeshData MakeShuffledGrid(uint32_t size)
+{
+    MeshData mesh;
+    for (uint32_t y = 0; y <= size; ++y)
+    {
+        for (uint32_t x = 0; x <= size; ++x)
+        {
+            mesh.positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+            mesh.normals.emplace_back(0.0f, 0.0f, 1.0f);
+            mesh.uvs.emplace_back(static_cast<float>(x) / size, static_cast<float>(y) / size);
+        }
+    }
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            uint32_t i0 = y * (size + 1) + x;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + size + 1;
+            uint32_t i3 = i2 + 1;
+            triangles.push_back({i0, i1, i2});
+            triangles.push_back({i1, i3, i2});
+        }
+    }
+    std::mt19937 rng(42);
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+    for (const auto &triangle : triangles)
+    {
+        mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end());
+    }
+    return mesh;
+}
+
+// Returns the triangles of an index buffer with each triangle rotated so its smallest index comes first.
+std::vector<std::array<uint32_t, 3>> CanonicalTriangles(const std::vector<uint32_t> &indices)
+{
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        std::array<uint32_t, 3> t = {indices[i], indices[i + 1], indices[i + 2]};
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        triangles.push_back(t);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+} // namespace
+
+TEST(MeshOptimizerTest, VertexCacheOptimizationImprovesAcmrAndKeepsTriangles)
+{
+    MeshData mesh = MakeShuffledGrid(32);
+    std::vector<uint32_t> original = mesh.indices;
+
+    float before = AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.positions.size(), 16);
+    OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.positions.size(), 16);
+    float after = AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.positions.size(), 16);
+
+    EXPECT_LT(after, before);
+    EXPECT_LT(after, 0.8f);
+    EXPECT_EQ(CanonicalTriangles(mesh.indices), CanonicalTriangles(original));
+}
+
+TEST(MeshOptimizerTest, OverdrawOptimizationStaysWithinThreshold)
+{
+    MeshData mesh = MakeShuffledGrid(32);
+    std::vector<uint32_t> original = mesh.indices;
+    OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.positions.size(), 16);
+    float cache_acmr = AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.positions.size(), 16);
+
+    OptimizeOverdraw(mesh.indices.data(), mesh.indices.size(), mesh.positions.data(), mesh.positions.size(), 16, 1.05f);
+    float overdraw_acmr = AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.positions.size(), 16);
+
+    EXPECT_LT(overdraw_acmr, cache_acmr * 1.25f);
+    EXPECT_EQ(CanonicalTriangles(mesh.indices), CanonicalTriangles(original));
+}
+
+TEST(MeshOptimizerTest, VertexFetchOrdersByFirstUseAndDropsUnused)
+{
+    MeshData mesh;
+    mesh.positions = {glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(2.0f), glm::vec3(3.0f), glm::vec3(4.0f)};
+    mesh.indices = {4, 2, 0, 0, 2, 3};
+
+    OptimizeVertexFetch(mesh);
+
+    ASSERT_EQ(mesh.positions.size(), 4u);
+    EXPECT_EQ(mesh.indices, (std::vector<uint32_t>{0, 1, 2, 2, 1, 3}));
+    EXPECT_EQ(mesh.positions[0], glm::vec3(4.0f));
+    EXPECT_EQ(mesh.positions[3], glm::vec3(3.0f));
+}
+
+TEST(MeshOptimizerTest, HalfFloatRoundTrip)
+{
+    EXPECT_EQ(FloatToHalf(0.0f), 0x0000);
+    EXPECT_EQ(FloatToHalf(1.0f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(-2.0f), 0xC000);
+    EXPECT_EQ(FloatToHalf(65504.0f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(1.0e6f), 0x7C00);
+    EXPECT_EQ(HalfToFloat(0x0001), 1.0f / 16777216.0f);
+
+    for (float value : {0.5f, 3.25f, -1234.0f, 1.0e-5f, 0.333f})
+    {
+        float round_trip = HalfToFloat(FloatToHalf(value));
+        EXPECT_NEAR(round_trip, value, std::abs(value) * 1.0e-3f + 1.0e-7f);
+    }
+}
+
+TEST(MeshOptimizerTest, OctahedralNormalRoundTrip)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (int i = 0; i < 1000; ++i)
+    {
+        glm::vec3 n(dist(rng), dist(rng), dist(rng));
+        if (glm::length(n) < 1.0e-3f)
+        {
+            continue;
+        }
+        n = glm::normalize(n);
+        int16_t encoded[2];
+        EncodeOctahedral(n, encoded);
+        glm::vec3 decoded = DecodeOctahedral(encoded);
+        EXPECT_GT(glm::dot(n, decoded), 0.99999f);
+    }
+}
+
+TEST(MeshOptimizerTest, OptimizeMeshProducesQuantizedInterleavedLayout)
+{
+    MeshData mesh = MakeShuffledGrid(16);
+    OptimizedMesh optimized = OptimizeMesh(mesh);
+
+    ASSERT_EQ(optimized.layout.attribute_count, 3u);
+    EXPECT_EQ(optimized.layout.stride, 16u);
+    EXPECT_EQ(optimized.layout.Find(Piece::RAL::VertexSemantic::Position)->format, Piece::RAL::VertexFormat::Half4);
+    EXPECT_EQ(optimized.layout.Find(Piece::RAL::VertexSemantic::Normal)->format,
+              Piece::RAL::VertexFormat::Snorm16x2);
+    EXPECT_EQ(optimized.layout.Find(Piece::RAL::VertexSemantic::TexCoord0)->format, Piece::RAL::VertexFormat::Half2);
+    EXPECT_EQ(optimized.vertex_count, mesh.positions.size());
+    EXPECT_EQ(optimized.vertex_data.size(), optimized.vertex_count * 16u);
+    EXPECT_EQ(optimized.index_format, Piece::RAL::IndexFormat::UInt16);
+    EXPECT_EQ(optimized.index_count, mesh.indices.size());
+    EXPECT_EQ(optimized.bounds_max, glm::vec3(16.0f, 16.0f, 0.0f));
+
+    // Integer grid coordinates are exact in half precision, so decoded triangles must match the source exactly.
+    auto triangle_key = [](const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c) {
+        glm::vec3 sum = a + b + c;
+        return std::array<float, 3>{sum.x, sum.y, sum.z};
+    };
+    std::vector<std::array<float, 3>> expected;
+    for (size_t i = 0; i < mesh.indices.size(); i += 3)
+    {
+        expected.push_back(triangle_key(mesh.positions[mesh.indices[i]], mesh.positions[mesh.indices[i + 1]],
+                                        mesh.positions[mesh.indices[i + 2]]));
+    }
+    auto decode_position = [&](uint16_t index) {
+        uint16_t packed[4];
+        std::memcpy(packed, optimized.vertex_data.data() + index * optimized.layout.stride, sizeof(packed));
+        return glm::vec3(HalfToFloat(packed[0]), HalfToFloat(packed[1]), HalfToFloat(packed[2]));
+    };
+    const uint16_t *indices = reinterpret_cast<const uint16_t *>(optimized.index_data.data());
+    std::vector<std::array<float, 3>> actual;
+    for (uint32_t i = 0; i < optimized.index_count; i += 3)
+    {
+        actual.push_back(triangle_key(decode_position(indices[i]), decode_position(indices[i + 1]),
+                                      decode_position(indices[i + 2])));
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(MeshOptimizerTest, OptimizeMeshDropsTrianglesWithOutOfRangeIndices)
+{
+    MeshData mesh = MakeShuffledGrid(4);
+    size_t valid_index_count = mesh.indices.size();
+    uint32_t vertex_count = static_cast<uint32_t>(mesh.positions.size());
+    mesh.indices.insert(mesh.indices.begin() + 3, {0, vertex_count, 1});
+    mesh.indices.insert(mesh.indices.end(), {vertex_count + 100, 2, 3});
+
+    OptimizedMesh optimized = OptimizeMesh(mesh);
+    EXPECT_EQ(optimized.index_count, valid_index_count);
+    EXPECT_EQ(optimized.vertex_count, vertex_count);
+
+    MeshData invalid;
+    invalid.positions = {glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)};
+    invalid.indices = {0, 1, 3};
+    OptimizedMesh empty = OptimizeMesh(invalid);
+    EXPECT_EQ(empty.index_count, 0u);
+    EXPECT_TRUE(empty.vertex_data.empty());
+}
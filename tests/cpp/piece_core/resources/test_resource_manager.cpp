@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+#include <piece_core/resources/asset_pack.h>
+#include <piece_core/resources/mesh_asset.h>
+#include <piece_core/resources/resource_manager.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Piece::Core;
+using Piece::RAL::IndexBufferHandle;
+using Piece::RAL::VertexBufferHandle;
+
+namespace
+{
+// Counts buffer creations and destructions instead of talking to a GPU.
+class FakeGraphicsDevice : public Piece::RAL::IGraphicsDevice
+{
+  public:
+    void Init() override
+    {
+    }
+    void BeginFrame() override
+    {
+    }
+    void EndFrame() override
+    {
+    }
+    Piece::RAL::IRenderContext *GetImmediateContext() override
+    {
+        return nullptr;
+    }
+    VertexBufferHandle CreateVertexBuffer(const void *, uint32_t vertex_count, const Piece::RAL::VertexLayout &) override
+    {
+        uploaded_vertices += vertex_count;
+        VertexBufferHandle handle;
+        handle.index = live_vertex_buffers++;
+        handle.generation = 1;
+        return handle;
+    }
+    void DestroyVertexBuffer(VertexBufferHandle) override
+    {
+        --live_vertex_buffers;
+    }
+    Piece::RAL::IVertexBuffer *GetVertexBuffer(VertexBufferHandle) override
+    {
+        return nullptr;
+    }
+    IndexBufferHandle CreateIndexBuffer(const void *, uint32_t, Piece::RAL::IndexFormat) override
+    {
+        IndexBufferHandle handle;
+        handle.index = live_index_buffers++;
+        handle.generation = 1;
+        return handle;
+    }
+    void DestroyIndexBuffer(IndexBufferHandle) override
+    {
+        --live_index_buffers;
+    }
+    Piece::RAL::IIndexBuffer *GetIndexBuffer(IndexBufferHandle) override
+    {
+        return nullptr;
+    }
+    Piece::RAL::ShaderHandle CreateShader() override
+    {
+        return {};
+    }
+    void DestroyShader(Piece::RAL::ShaderHandle) override
+    {
+    }
+    Piece::RAL::IShader *GetShader(Piece::RAL::ShaderHandle) override
+    {
+        return nullptr;
+    }
+    Piece::RAL::ShaderProgramHandle CreateShaderProgram() override
+    {
+        return {};
+    }
+    void DestroyShaderProgram(Piece::RAL::ShaderProgramHandle) override
+    {
+    }
+    Piece::RAL::IShaderProgram *GetShaderProgram(Piece::RAL::ShaderProgramHandle) override
+    {
+        return nullptr;
+    }
+    Piece::RAL::RenderTargetHandle CreateRenderTarget(const Piece::RAL::RenderTargetDesc &) override
+    {
+        return {};
+    }
+    void DestroyRenderTarget(Piece::RAL::RenderTargetHandle) override
+    {
+    }
+    Piece::RAL::IRenderTarget *GetRenderTarget(Piece::RAL::RenderTargetHandle) override
+    {
+        return nullptr;
+    }
+    void SetRenderTarget(Piece::RAL::RenderTargetHandle) override
+    {
+    }
+
+    uint32_t live_vertex_buffers = 0;
+    uint32_t live_index_buffers = 0;
+    uint32_t uploaded_vertices = 0;
+};
+
+// Cooks a single quad with the given side length.
+std::vector<uint8_t> CookQuad(float size)
+{
+    MeshData mesh;
+    mesh.positions = {glm::vec3(0.0f), glm::vec3(size, 0.0f, 0.0f), glm::vec3(0.0f, size, 0.0f),
+                      glm::vec3(size, size, 0.0f)};
+    mesh.indices = {0, 1, 2, 1, 3, 2};
+    return SerializeMeshAsset(OptimizeMesh(mesh));
+}
+
+// Polls a condition until it holds or a generous timeout expires.
+bool WaitFor(const std::function<bool()> &condition)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+class ResourceManagerTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        pack_path_ = "resource_manager_" + name + ".pak";
+        loose_path_ = "resource_manager_" + name + ".mesh";
+
+        std::vector<uint8_t> quad = CookQuad(1.0f);
+        std::vector<uint8_t> big_quad = CookQuad(4.0f);
+        AssetPackWriter writer;
+        writer.AddEntry("meshes/quad.mesh", AssetType::Mesh, quad.data(), quad.size(), false);
+        writer.AddEntry("meshes/big_quad.mesh", AssetType::Mesh, big_quad.data(), big_quad.size(), true);
+        writer.AddEntry("textures/not_a_mesh.bin", AssetType::Texture, quad.data(), quad.size(), false);
+        ASSERT_TRUE(writer.Write(pack_path_));
+
+        std::ofstream loose(loose_path_, std::ios::binary);
+        loose.write(reinterpret_cast<const char *>(quad.data()), static_cast<std::streamsize>(quad.size()));
+    }
+
+    void TearDown() override
+    {
+        std::remove(pack_path_.c_str());
+        std::remove(loose_path_.c_str());
+    }
+
+    // Runs Update until the mesh leaves the in-flight states.
+    bool WaitUntilSettled(ResourceManager &manager, MeshHandle handle)
+    {
+        return WaitFor([&] {
+            manager.Update();
+            ResourceState state = manager.GetState(handle);
+            return state == ResourceState::Ready || state == ResourceState::Failed;
+        });
+    }
+
+    std::string pack_path_;
+    std::string loose_path_;
+    JobSystem jobs_{2};
+    FakeGraphicsDevice device_;
+};
+} // namespace
+
+TEST_F(ResourceManagerTest, LoadsFromPacksAndLooseFiles)
+{
+    {
+        ResourceManager manager(jobs_, device_);
+        ASSERT_TRUE(manager.MountPack(pack_path_));
+
+        MeshHandle quad = manager.LoadMesh("meshes/quad.mesh");
+        MeshHandle big_quad = manager.LoadMesh("meshes/big_quad.mesh");
+        MeshHandle loose = manager.LoadMesh(loose_path_);
+        EXPECT_FALSE(quad.IsNull());
+        EXPECT_NE(quad, big_quad);
+
+        ASSERT_TRUE(WaitUntilSettled(manager, quad));
+        ASSERT_TRUE(WaitUntilSettled(manager, big_quad));
+        ASSERT_TRUE(WaitUntilSettled(manager, loose));
+        EXPECT_EQ(manager.GetState(quad), ResourceState::Ready);
+        EXPECT_EQ(manager.GetState(big_quad), ResourceState::Ready);
+        EXPECT_EQ(manager.GetState(loose), ResourceState::Ready);
+
+        MeshResourceInfo info;
+        ASSERT_TRUE(manager.GetMesh(big_quad, info));
+        EXPECT_EQ(info.index_count, 6u);
+        EXPECT_EQ(info.bounds_max, glm::vec3(4.0f, 4.0f, 0.0f));
+        EXPECT_EQ(device_.live_vertex_buffers, 3u);
+        EXPECT_EQ(device_.live_index_buffers, 3u);
+    }
+    EXPECT_EQ(device_.live_vertex_buffers, 0u);
+    EXPECT_EQ(device_.live_index_buffers, 0u);
+}
+
+TEST_F(ResourceManagerTest, DeduplicatesRequests)
+{
+    ResourceManager manager(jobs_, device_);
+    ASSERT_TRUE(manager.MountPack(pack_path_));
+
+    MeshHandle first = manager.LoadMesh("meshes/quad.mesh");
+    MeshHandle second = manager.LoadMesh("meshes/quad.mesh");
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(manager.GetResourceCount(), 1u);
+    ASSERT_TRUE(WaitUntilSettled(manager, first));
+    EXPECT_EQ(device_.live_vertex_buffers, 1u);
+    EXPECT_EQ(device_.uploaded_vertices, 4u);
+}
+
+TEST_F(ResourceManagerTest, ReportsMissingAndMistypedAssetsAsFailed)
+{
+    ResourceManager manager(jobs_, device_);
+    ASSERT_TRUE(manager.MountPack(pack_path_));
+
+    MeshHandle missing = manager.LoadMesh("meshes/missing.mesh");
+    MeshHandle texture = manager.LoadMesh("textures/not_a_mesh.bin");
+    ASSERT_TRUE(WaitUntilSettled(manager, missing));
+    ASSERT_TRUE(WaitUntilSettled(manager, texture));
+    EXPECT_EQ(manager.GetState(missing), ResourceState::Failed);
+    EXPECT_EQ(manager.GetState(texture), ResourceState::Failed);
+    MeshResourceInfo info;
+    EXPECT_FALSE(manager.GetMesh(missing, info));
+}
+
+TEST_F(ResourceManagerTest, EvictsAfterLastReleaseAndDelay)
+{
+    ResourceManager manager(jobs_, device_);
+    ASSERT_TRUE(manager.MountPack(pack_path_));
+    manager.SetEvictionDelay(2);
+
+    MeshHandle quad = manager.LoadMesh("meshes/quad.mesh");
+    manager.AddRef(quad);
+    ASSERT_TRUE(WaitUntilSettled(manager, quad));
+
+    manager.Release(quad);
+    manager.Update();
+    manager.Update();
+    EXPECT_EQ(manager.GetState(quad), ResourceState::Ready);
+
+    // Dropping the last reference starts the eviction delay; a new request in that window revives the mesh.
+    manager.Release(quad);
+    manager.Update();
+    EXPECT_EQ(manager.LoadMesh("meshes/quad.mesh"), quad);
+    manager.Update();
+    manager.Update();
+    EXPECT_EQ(manager.GetState(quad), ResourceState::Ready);
+
+    manager.Release(quad);
+    manager.Update();
+    EXPECT_EQ(manager.GetState(quad), ResourceState::Ready);
+    manager.Update();
+    EXPECT_EQ(manager.GetResourceCount(), 0u);
+    EXPECT_EQ(manager.GetState(quad), ResourceState::Failed);
+    EXPECT_EQ(device_.live_vertex_buffers, 0u);
+
+    // The path can be loaded again under a new handle.
+    MeshHandle reloaded = manager.LoadMesh("meshes/quad.mesh");
+    EXPECT_NE(reloaded, quad);
+    ASSERT_TRUE(WaitUntilSettled(manager, reloaded));
+}
+
+TEST_F(ResourceManagerTest, UploadBudgetSpreadsUploadsAcrossFrames)
+{
+    ResourceManager manager(jobs_, device_);
+    ASSERT_TRUE(manager.MountPack(pack_path_));
+    manager.SetUploadBudget(1);
+
+    MeshHandle quad = manager.LoadMesh("meshes/quad.mesh");
+    MeshHandle big_quad = manager.LoadMesh("meshes/big_quad.mesh");
+    MeshHandle loose = manager.LoadMesh(loose_path_);
+    ASSERT_TRUE(WaitFor([&] {
+        return manager.GetState(quad) == ResourceState::Decoded &&
+               manager.GetState(big_quad) == ResourceState::Decoded && manager.GetState(loose) == ResourceState::Decoded;
+    }));
+
+    for (uint32_t frame = 1; frame <= 3; ++frame)
+    {
+        manager.Update();
+        EXPECT_EQ(device_.live_vertex_buffers, frame);
+    }
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <ral/resource_pool.h>
+
+#include <string>
+
+using namespace Piece::RAL;
+
+namespace
+{
+struct TestResource
+{
+    TestResource() = default;
+    explicit TestResource(std::string n) : name(std::move(n))
+    {
+    }
+
+    std::string name;
+};
+
+using TestHandle = ResourceHandle<struct TestResourceTag>;
+using TestPool = ResourcePool<TestResource, TestHandle>;
+} // namespace
+
+TEST(ResourcePoolTest, DefaultHandleIsNullAndInvalid)
+{
+    TestPool pool;
+    TestHandle handle;
+
+    ASSERT_TRUE(handle.IsNull());
+    ASSERT_FALSE(pool.IsValid(handle));
+    ASSERT_EQ(pool.TryGet(handle), nullptr);
+}
+
+TEST(ResourcePoolTest, CreateAndResolve)
+{
+    TestPool pool;
+    TestHandle a = pool.Create("a");
+    TestHandle b = pool.Create("b");
+
+    ASSERT_FALSE(a.IsNull());
+    ASSERT_NE(a, b);
+    ASSERT_EQ(pool.GetLiveCount(), 2u);
+    ASSERT_EQ(pool.Get(a).name, "a");
+    ASSERT_EQ(pool.TryGet(b)->name, "b");
+}
+
+TEST(ResourcePoolTest, DestroyInvalidatesHandle)
+{
+    TestPool pool;
+    TestHandle handle = pool.Create("a");
+
+    ASSERT_TRUE(pool.Destroy(handle));
+    ASSERT_FALSE(pool.IsValid(handle));
+    ASSERT_EQ(pool.TryGet(handle), nullptr);
+    ASSERT_FALSE(pool.Destroy(handle));
+    ASSERT_EQ(pool.GetLiveCount(), 0u);
+}
+
+TEST(ResourcePoolTest, RecycledSlotDoesNotAliasStaleHandle)
+{
+    TestPool pool;
+    TestHandle stale = pool.Create("old");
+    pool.Destroy(stale);
+
+    TestHandle fresh = pool.Create("new");
+
+    ASSERT_EQ(fresh.index, stale.index);
+    ASSERT_NE(fresh.generation, stale.generation);
+    ASSERT_FALSE(pool.IsValid(stale));
+    ASSERT_EQ(pool.Get(fresh).name, "new");
+    ASSERT_EQ(pool.GetCapacity(), 1u);
+}
+
+TEST(ResourcePoolTest, ForEachVisitsOnlyLiveResources)
+{
+    TestPool pool;
+    TestHandle a = pool.Create("a");
+    pool.Create("b");
+    pool.Create("c");
+    pool.Destroy(a);
+
+    std::string visited;
+    pool.ForEach([&](TestHandle, TestResource &resource) { visited += resource.name; });
+
+    ASSERT_EQ(visited, "bc");
+}
+
+#ifndef NDEBUG
+TEST(ResourcePoolDeathTest, GetAssertsOnStaleHandleInDebug)
+{
+    TestPool pool;
+    TestHandle handle = pool.Create("a");
+    pool.Destroy(handle);
+
+    ASSERT_DEATH(pool.Get(handle), "Stale or invalid resource handle");
+}
+#endif
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <wal/frame_pacer.h>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+using Piece::WAL::FramePacer;
+using Piece::WAL::PresentMode;
+using Piece::WAL::PresentOptions;
+using Clock = FramePacer::Clock;
+
+TEST(FramePacerTest, UncappedAndPlainVSyncStartRightAway)
+{
+    FramePacer pacer;
+    Clock::time_point now = Clock::now();
+    pacer.Configure(PresentOptions{PresentMode::Uncapped, 0.0f, true}, 16ms);
+    pacer.BeginFrame(now);
+    pacer.EndFrame(now + 2ms, now + 3ms);
+    EXPECT_EQ(pacer.GetFrameStartTarget(now + 3ms), now + 3ms);
+
+    // The blocking swap paces plain vsync.
+    pacer.Configure(PresentOptions{PresentMode::VSync, 0.0f, false}, 16ms);
+    pacer.BeginFrame(now);
+    pacer.EndFrame(now + 2ms, now + 16ms);
+    EXPECT_EQ(pacer.GetFrameStartTarget(now + 16ms), now + 16ms);
+}
+
+TEST(FramePacerTest, CappedFramesKeepAFixedScheduleAndRestartAfterAHitch)
+{
+    FramePacer pacer;
+    pacer.Configure(PresentOptions{PresentMode::Capped, 100.0f, false}, 16ms);
+    Clock::time_point start = Clock::now();
+
+    pacer.BeginFrame(start);
+    pacer.EndFrame(start + 3ms, start + 3ms);
+    EXPECT_EQ(pacer.GetFrameStartTarget(start + 3ms), start + 10ms);
+
+    // A frame that started late does not push the schedule back.
+    pacer.BeginFrame(start + 11ms);
+    pacer.EndFrame(start + 14ms, start + 14ms);
+    EXPECT_EQ(pacer.GetFrameStartTarget(start + 14ms), start + 20ms);
+
+    // After missing more than a whole interval, the schedule starts over instead of bursting frames.
+    pacer.BeginFrame(start + 45ms);
+    EXPECT_EQ(pacer.GetFrameStartTarget(start + 46ms), start + 55ms);
+}
+
+TEST(FramePacerTest, LowLatencyStartsThePredictedWorkTimeBeforeThePresent)
+{
+    FramePacer pacer;
+    pacer.Configure(PresentOptions{PresentMode::VSync, 0.0f, true}, 16ms);
+    Clock::time_point start = Clock::now();
+
+    // Nothing to predict from before the first present.
+    EXPECT_EQ(pacer.GetFrameStartTarget(start), start);
+
+    pacer.BeginFrame(start);
+    pacer.EndFrame(start + 4ms, start + 16ms);
+    Clock::time_point first = pacer.GetFrameStartTarget(start + 16ms);
+    EXPECT_EQ(pacer.GetPredictedWorkTime(), 5ms);
+    EXPECT_EQ(first, start + 27ms);
+
+    // The prediction covers the slowest recent frame.
+    pacer.BeginFrame(first);
+    pacer.EndFrame(first + 2ms, start + 32ms);
+    EXPECT_EQ(pacer.GetPredictedWorkTime(), 5ms);
+    EXPECT_EQ(pacer.GetFrameStartTarget(start + 32ms), start + 43ms);
+
+    // Work longer than a refresh leaves no time to wait.
+    pacer.BeginFrame(start + 43ms);
+    pacer.EndFrame(start + 63ms, start + 64ms);
+    EXPECT_EQ(pacer.GetFrameStartTarget(start + 64ms), start + 64ms);
+}
+
+TEST(FramePacerTest, WaitUntilReturnsAtTheDeadline)
+{
+    FramePacer pacer;
+    for (int i = 0; i < 3; ++i)
+    {
+        Clock::time_point deadline = Clock::now() + 5ms;
+        pacer.WaitUntil(deadline);
+        Clock::time_point now = Clock::now();
+        EXPECT_GE(now, deadline);
+        // Generous bound: the spin makes it far tighter on an idle machine.
+        EXPECT_LT(now - deadline, 5ms);
+    }
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <piece_core/native_interop_types.h>
+#include <wal/glfw/glfw_platform.h>
 #include <wal/glfw/glfw_window.h>
 #include <wal/glfw/glfw_window_factory.h>
 
@@ -41,3 +42,20 @@ TEST_F(GlfwWindowTest, FactoryCreatesWindow)
     ASSERT_NE(window->GetNativeWindow(), nullptr);
     ASSERT_FALSE(window->ShouldClose());
 }
+
+TEST_F(GlfwWindowTest, WindowsShareOneGlfwInitialization)
+{
+    uint32_t base_references = Piece::WAL::GlfwPlatform::GetReferenceCount();
+    Piece::WAL::GlfwWindow first;
+    ASSERT_TRUE(first.Init(320, 240, "First"));
+    {
+        Piece::WAL::GlfwWindow second;
+        ASSERT_TRUE(second.Init(320, 240, "Second"));
+        EXPECT_EQ(Piece::WAL::GlfwPlatform::GetReferenceCount(), base_references + 2);
+    }
+
+    // Closing one window leaves GLFW running for the other.
+    EXPECT_EQ(Piece::WAL::GlfwPlatform::GetReferenceCount(), base_references + 1);
+    first.PollEvents();
+    EXPECT_FALSE(first.ShouldClose());
+}
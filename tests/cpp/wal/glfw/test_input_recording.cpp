@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+#include <wal/input_recording.h>
+#include <wal/replay_window.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Piece::WAL;
+
+namespace
+{
+
+// A window whose frame events are set by the test; counts polls and presents.
+class StubWindow : public IWindow
+{
+  public:
+    bool Init(int, int, const std::string &) override
+    {
+        return true;
+    }
+    void PollEvents() override
+    {
+        ++polls;
+    }
+    void SwapBuffers() override
+    {
+        ++swaps;
+    }
+    void SetPresentOptions(const PresentOptions &) override
+    {
+    }
+    bool ShouldClose() const override
+    {
+        return false;
+    }
+    std::pair<int, int> GetFramebufferSize() const override
+    {
+        return {640, 480};
+    }
+    void SetContextCurrent(bool) override
+    {
+    }
+    void SetNotificationCallback(std::function<void(WindowNotification)>) override
+    {
+    }
+    void *GetNativeWindow() const override
+    {
+        return nullptr;
+    }
+    bool IsKeyPressed(KeyCode keycode) const override
+    {
+        return state.IsKeyDown(keycode);
+    }
+    bool IsMouseButtonPressed(KeyCode button) const override
+    {
+        return state.IsMouseButtonDown(button);
+    }
+    std::pair<float, float> GetMousePosition() const override
+    {
+        return state.GetCursorPosition();
+    }
+    float GetMouseX() const override
+    {
+        return state.GetCursorPosition().first;
+    }
+    float GetMouseY() const override
+    {
+        return state.GetCursorPosition().second;
+    }
+    bool WasKeyPressedThisFrame(KeyCode keycode) const override
+    {
+        return state.WasKeyPressed(keycode);
+    }
+    bool WasKeyReleasedThisFrame(KeyCode keycode) const override
+    {
+        return state.WasKeyReleased(keycode);
+    }
+    bool WasMouseButtonPressedThisFrame(KeyCode button) const override
+    {
+        return state.WasMouseButtonPressed(button);
+    }
+    bool WasMouseButtonReleasedThisFrame(KeyCode button) const override
+    {
+        return state.WasMouseButtonReleased(button);
+    }
+    const InputState &GetInputState() const override
+    {
+        return state;
+    }
+    uint32_t ReadInputEvents(InputEvent *events, uint32_t capacity) const override
+    {
+        return queue.Copy(events, capacity);
+    }
+
+    InputState state;
+    InputEventQueue queue;
+    int polls = 0;
+    int swaps = 0;
+};
+
+InputEvent MakeEvent(InputEventType type, int32_t code, InputAction action, float x = 0.0f, float y = 0.0f)
+{
+    InputEvent event;
+    event.timestamp_ns = InputEventQueue::Now();
+    event.type = type;
+    event.code = code;
+    event.action = action;
+    event.x = x;
+    event.y = y;
+    return event;
+}
+
+// Records three frames: a key press and a cursor move, nothing, then the key release and a scroll.
+InputRecording RecordSession()
+{
+    StubWindow window;
+    window.state.ResetCursorPosition(10.0f, 20.0f);
+    InputRecording recording;
+    recording.Start(window.GetInputState());
+
+    window.queue.BeginFrame();
+    window.queue.Push(MakeEvent(InputEventType::Key, static_cast<int32_t>(KeyCode::kW), InputAction::Press));
+    window.queue.Push(MakeEvent(InputEventType::CursorMove, 0, InputAction::Release, 15.0f, 25.0f));
+    recording.RecordFrame(0.016f, window);
+    window.queue.BeginFrame();
+    recording.RecordFrame(0.017f, window);
+    window.queue.BeginFrame();
+    window.queue.Push(MakeEvent(InputEventType::Key, static_cast<int32_t>(KeyCode::kW), InputAction::Release));
+    window.queue.Push(MakeEvent(InputEventType::Scroll, 0, InputAction::Release, 0.0f, -1.0f));
+    recording.RecordFrame(0.015f, window);
+    return recording;
+}
+
+std::string TempRecordingPath()
+{
+    const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+    return std::string("input_recording_") + info->name() + ".pirc";
+}
+
+} // namespace
+
+TEST(InputRecordingTest, SavedRecordingLoadsIdentically)
+{
+    InputRecording recording = RecordSession();
+    ASSERT_EQ(recording.GetFrameCount(), 3u);
+    std::string path = TempRecordingPath();
+    ASSERT_TRUE(recording.Save(path));
+
+    InputRecording loaded;
+    ASSERT_TRUE(loaded.Load(path));
+    ASSERT_EQ(loaded.GetFrameCount(), 3u);
+    EXPECT_EQ(loaded.GetInitialCursorPosition(), std::make_pair(10.0f, 20.0f));
+    for (uint32_t frame = 0; frame < 3; ++frame)
+    {
+        EXPECT_EQ(loaded.GetFrame(frame).delta_time, recording.GetFrame(frame).delta_time);
+        ASSERT_EQ(loaded.GetFrame(frame).event_count, recording.GetFrame(frame).event_count);
+        for (uint32_t i = 0; i < loaded.GetFrame(frame).event_count; ++i)
+        {
+            const InputEvent &a = loaded.GetFrameEvents(frame)[i];
+            const InputEvent &b = recording.GetFrameEvents(frame)[i];
+            EXPECT_EQ(a.timestamp_ns, b.timestamp_ns);
+            EXPECT_EQ(a.type, b.type);
+            EXPECT_EQ(a.code, b.code);
+            EXPECT_EQ(a.action, b.action);
+            EXPECT_EQ(a.x, b.x);
+            EXPECT_EQ(a.y, b.y);
+        }
+    }
+    // Timestamps are relative to the start of the recording.
+    EXPECT_GE(loaded.GetFrameEvents(0)[0].timestamp_ns, 0);
+    EXPECT_LT(loaded.GetFrameEvents(0)[0].timestamp_ns, 1000000000);
+    std::remove(path.c_str());
+}
+
+TEST(InputRecordingTest, LoadRejectsTruncatedAndForeignFiles)
+{
+    std::string path = TempRecordingPath();
+    ASSERT_TRUE(RecordSession().Save(path));
+    std::vector<char> bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 1));
+    }
+    InputRecording loaded;
+    EXPECT_FALSE(loaded.Load(path));
+    EXPECT_EQ(loaded.GetFrameCount(), 0u);
+
+    bytes[0] = 'X';
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    EXPECT_FALSE(loaded.Load(path));
+    EXPECT_FALSE(loaded.Load("missing_recording.pirc"));
+    std::remove(path.c_str());
+}
+
+TEST(ReplayWindowTest, ReplaysFramesExactlyThenCloses)
+{
+    auto stub = std::make_unique<StubWindow>();
+    StubWindow *inner = stub.get();
+    ReplayWindow window(std::move(stub), RecordSession());
+    EXPECT_EQ(window.GetMousePosition(), std::make_pair(10.0f, 20.0f));
+    EXPECT_FALSE(window.ShouldClose());
+
+    window.PollEvents();
+    EXPECT_EQ(inner->polls, 1);
+    EXPECT_EQ(window.GetFrameDeltaTime(), 0.016f);
+    EXPECT_TRUE(window.WasKeyPressedThisFrame(KeyCode::kW));
+    EXPECT_TRUE(window.IsKeyPressed(KeyCode::kW));
+    EXPECT_EQ(window.GetInputState().GetCursorDelta(), std::make_pair(5.0f, 5.0f));
+    EXPECT_EQ(window.ReadInputEvents(nullptr, 0), 2u);
+    EXPECT_FALSE(window.ShouldClose());
+
+    window.PollEvents();
+    EXPECT_EQ(window.GetFrameDeltaTime(), 0.017f);
+    EXPECT_FALSE(window.WasKeyPressedThisFrame(KeyCode::kW));
+    EXPECT_TRUE(window.IsKeyPressed(KeyCode::kW));
+    EXPECT_EQ(window.ReadInputEvents(nullptr, 0), 0u);
+
+    window.PollEvents();
+    EXPECT_EQ(window.GetFrameDeltaTime(), 0.015f);
+    EXPECT_TRUE(window.WasKeyReleasedThisFrame(KeyCode::kW));
+    EXPECT_FALSE(window.IsKeyPressed(KeyCode::kW));
+    EXPECT_EQ(window.GetInputState().GetScrollDelta(), std::make_pair(0.0f, -1.0f));
+    EXPECT_TRUE(window.IsFinished());
+    EXPECT_TRUE(window.ShouldClose());
+
+    // Presentation still goes to the wrapped window.
+    window.SwapBuffers();
+    EXPECT_EQ(inner->swaps, 1);
+    EXPECT_EQ(window.GetFramebufferSize(), std::make_pair(640, 480));
+}
+
+TEST(ReplayWindowTest, ReplayedEventsKeepTheirRecordedSpacing)
+{
+    InputRecording recording = RecordSession();
+    int64_t recorded_gap = recording.GetFrameEvents(2)[0].timestamp_ns - recording.GetFrameEvents(0)[0].timestamp_ns;
+    ReplayWindow window(std::make_unique<StubWindow>(), recording);
+
+    InputEvent first;
+    window.PollEvents();
+    window.ReadInputEvents(&first, 1);
+    window.PollEvents();
+    window.PollEvents();
+    InputEvent third;
+    window.ReadInputEvents(&third, 1);
+    EXPECT_EQ(third.timestamp_ns - first.timestamp_ns, recorded_gap);
+    EXPECT_GE(first.timestamp_ns, recording.GetFrameEvents(0)[0].timestamp_ns);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <wal/input_event_queue.h>
+#include <wal/input_state.h>
+
+using Piece::WAL::InputState;
+using Piece::WAL::KeyCode;
+
+TEST(InputStateTest, TracksHeldKeysAndPerFrameEdges)
+{
+    InputState input;
+    input.BeginFrame();
+    input.SetKey(KeyCode::kW, true);
+    EXPECT_TRUE(input.IsKeyDown(KeyCode::kW));
+    EXPECT_TRUE(input.WasKeyPressed(KeyCode::kW));
+    EXPECT_FALSE(input.WasKeyReleased(KeyCode::kW));
+    EXPECT_FALSE(input.IsKeyDown(KeyCode::kS));
+
+    // Held across frames and through repeats without new presses.
+    input.BeginFrame();
+    input.SetKey(KeyCode::kW, true);
+    EXPECT_TRUE(input.IsKeyDown(KeyCode::kW));
+    EXPECT_FALSE(input.WasKeyPressed(KeyCode::kW));
+
+    input.BeginFrame();
+    input.SetKey(KeyCode::kW, false);
+    EXPECT_FALSE(input.IsKeyDown(KeyCode::kW));
+    EXPECT_TRUE(input.WasKeyReleased(KeyCode::kW));
+
+    // A tap within one frame shows both edges.
+    input.BeginFrame();
+    input.SetKey(KeyCode::kSpace, true);
+    input.SetKey(KeyCode::kSpace, false);
+    EXPECT_FALSE(input.IsKeyDown(KeyCode::kSpace));
+    EXPECT_TRUE(input.WasKeyPressed(KeyCode::kSpace));
+    EXPECT_TRUE(input.WasKeyReleased(KeyCode::kSpace));
+
+    input.BeginFrame();
+    EXPECT_FALSE(input.WasKeyPressed(KeyCode::kSpace));
+    EXPECT_FALSE(input.WasKeyReleased(KeyCode::kSpace));
+}
+
+TEST(InputStateTest, IgnoresOutOfRangeCodes)
+{
+    InputState input;
+    input.SetKey(KeyCode::Unknown, true);
+    input.SetKey(static_cast<KeyCode>(100000), true);
+    input.SetMouseButton(static_cast<KeyCode>(-5), true);
+    EXPECT_FALSE(input.IsKeyDown(KeyCode::Unknown));
+    EXPECT_FALSE(input.IsKeyDown(static_cast<KeyCode>(100000)));
+    EXPECT_FALSE(input.IsMouseButtonDown(static_cast<KeyCode>(-5)));
+
+    input.SetKey(KeyCode::kMenu, true);
+    input.SetMouseButton(KeyCode::kLastMouseButton, true);
+    EXPECT_TRUE(input.IsKeyDown(KeyCode::kMenu));
+    EXPECT_TRUE(input.IsMouseButtonDown(KeyCode::kLastMouseButton));
+    EXPECT_TRUE(input.WasMouseButtonPressed(KeyCode::kLastMouseButton));
+    EXPECT_FALSE(input.IsMouseButtonDown(KeyCode::kMouse1));
+}
+
+TEST(InputStateTest, CursorDeltaAndScrollResetEachFrame)
+{
+    InputState input;
+    input.ResetCursorPosition(100.0f, 50.0f);
+    input.BeginFrame();
+    input.SetCursorPosition(104.0f, 47.0f);
+    input.SetCursorPosition(110.0f, 45.0f);
+    input.AddScroll(0.0f, 1.0f);
+    input.AddScroll(0.0f, 2.0f);
+    EXPECT_EQ(input.GetCursorPosition(), std::make_pair(110.0f, 45.0f));
+    EXPECT_EQ(input.GetCursorDelta(), std::make_pair(10.0f, -5.0f));
+    EXPECT_EQ(input.GetScrollDelta(), std::make_pair(0.0f, 3.0f));
+
+    input.BeginFrame();
+    EXPECT_EQ(input.GetCursorPosition(), std::make_pair(110.0f, 45.0f));
+    EXPECT_EQ(input.GetCursorDelta(), std::make_pair(0.0f, 0.0f));
+    EXPECT_EQ(input.GetScrollDelta(), std::make_pair(0.0f, 0.0f));
+}
+
+TEST(InputEventQueueTest, CopiesTheFrameInOrderAndReportsTheFullCount)
+{
+    using Piece::WAL::InputEvent;
+    using Piece::WAL::InputEventQueue;
+    using Piece::WAL::InputEventType;
+
+    InputEventQueue queue;
+    queue.BeginFrame();
+    for (int32_t i = 0; i < 3; ++i)
+    {
+        InputEvent event;
+        event.timestamp_ns = InputEventQueue::Now();
+        event.type = InputEventType::Text;
+        event.code = 'a' + i;
+        queue.Push(event);
+    }
+
+    InputEvent events[2];
+    EXPECT_EQ(queue.Copy(nullptr, 0), 3u);
+    ASSERT_EQ(queue.Copy(events, 2), 3u);
+    EXPECT_EQ(events[0].code, 'a');
+    EXPECT_EQ(events[1].code, 'b');
+    EXPECT_LE(events[0].timestamp_ns, events[1].timestamp_ns);
+
+    queue.BeginFrame();
+    EXPECT_EQ(queue.Copy(events, 2), 0u);
+}
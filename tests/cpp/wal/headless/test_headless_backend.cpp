@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <piece_core/native_interop_types.h>
+#include <wal/headless/headless_window.h>
+#include <wal/headless/headless_window_factory.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace Piece::Core;
+
+namespace
+{
+
+// Loaded through EGL like the backend does, so the test needs no OpenGL loader.
+using ClearColorProc = void(EGLAPIENTRY *)(float, float, float, float);
+using ClearProc = void(EGLAPIENTRY *)(unsigned int);
+constexpr unsigned int kGlColorBufferBit = 0x4000;
+
+void Clear(float r, float g, float b)
+{
+    auto clear_color = reinterpret_cast<ClearColorProc>(eglGetProcAddress("glClearColor"));
+    auto clear = reinterpret_cast<ClearProc>(eglGetProcAddress("glClear"));
+    ASSERT_NE(clear_color, nullptr);
+    ASSERT_NE(clear, nullptr);
+    clear_color(r, g, b, 1.0f);
+    clear(kGlColorBufferBit);
+}
+
+} // namespace
+
+TEST(HeadlessWindowTest, CanCreateWindow)
+{
+    Piece::WAL::HeadlessWindow window;
+    ASSERT_TRUE(window.Init(64, 48, "Headless Test"));
+    EXPECT_NE(window.GetNativeWindow(), nullptr);
+    EXPECT_FALSE(window.ShouldClose());
+    EXPECT_EQ(window.GetFramebufferSize(), std::make_pair(64, 48));
+
+    window.PollEvents();
+    EXPECT_EQ(window.ReadInputEvents(nullptr, 0), 0u);
+    window.RequestClose();
+    EXPECT_TRUE(window.ShouldClose());
+}
+
+TEST(HeadlessWindowTest, FactoryCreatesWindow)
+{
+    NativeWindowOptions options = {32, 32, 0, "Factory Test"};
+    Piece::Core::HeadlessWindowFactory factory(&options);
+    auto window = factory.CreateWindow(&options);
+
+    ASSERT_NE(window, nullptr);
+    EXPECT_EQ(window->GetFramebufferSize(), std::make_pair(32, 32));
+    EXPECT_FALSE(window->ShouldClose());
+}
+
+TEST(HeadlessWindowTest, RenderedFrameCanBeReadBack)
+{
+    Piece::WAL::HeadlessWindow window;
+    ASSERT_TRUE(window.Init(16, 8, "Readback"));
+    if (window.IsSurfaceless())
+    {
+        GTEST_SKIP() << "The EGL driver has no pbuffers, so there is no default framebuffer to read.";
+    }
+
+    Clear(1.0f, 0.0f, 1.0f);
+    window.SwapBuffers();
+    std::vector<uint8_t> pixels(16 * 8 * 4);
+    EXPECT_FALSE(window.ReadPixels(pixels.data(), pixels.size() - 1));
+    ASSERT_TRUE(window.ReadPixels(pixels.data(), pixels.size()));
+    for (size_t i = 0; i < pixels.size(); i += 4)
+    {
+        ASSERT_EQ(pixels[i], 255);
+        ASSERT_EQ(pixels[i + 1], 0);
+        ASSERT_EQ(pixels[i + 2], 255);
+        ASSERT_EQ(pixels[i + 3], 255);
+    }
+}
+
+TEST(HeadlessWindowTest, WindowsOutliveEachOther)
+{
+    Piece::WAL::HeadlessWindow first;
+    ASSERT_TRUE(first.Init(8, 8, "First"));
+    {
+        Piece::WAL::HeadlessWindow second;
+        ASSERT_TRUE(second.Init(8, 8, "Second"));
+        second.SwapBuffers();
+    }
+
+    // The display stays open for the remaining window.
+    first.SetContextCurrent(true);
+    Clear(0.0f, 1.0f, 0.0f);
+    first.SwapBuffers();
+    EXPECT_FALSE(first.ShouldClose());
+}
+
+TEST(HeadlessWindowTest, VSyncIsPacedAtTheSimulatedRefreshRate)
+{
+    Piece::WAL::HeadlessWindow window;
+    ASSERT_TRUE(window.Init(8, 8, "Paced"));
+    window.SetPresentOptions({Piece::WAL::PresentMode::VSync, 0.0f, false});
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        window.PollEvents();
+        window.SwapBuffers();
+    }
+    // Four frame starts are three refresh periods apart at the least.
+    EXPECT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::microseconds(3 * 1000000 / Piece::WAL::HeadlessWindow::kRefreshRate - 1000));
+}